@@ -4,6 +4,7 @@
 #include "ingest/spsc_ring.hpp"
 #include "ingest/fix_parser.hpp"
 #include "core/exec_event.hpp"
+#include "util/alloc_guard.hpp"
 #include "util/soh.hpp"
 
 int main() {
@@ -14,14 +15,25 @@ int main() {
 
     constexpr std::size_t iterations = 100000;
     auto start = std::chrono::steady_clock::now();
-    for (std::size_t i = 0; i < iterations; ++i) {
-        ingest::parse_exec_report(msg.data(), msg.size(), evt);
-        ring.try_push(evt);
-        ring.try_pop(evt);
+    {
+        util::ScopedHotPhase hot_phase;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            ingest::parse_exec_report(msg.data(), msg.size(), evt);
+            ring.try_push(evt);
+            ring.try_pop(evt);
+        }
     }
     auto end = std::chrono::steady_clock::now();
     auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     std::cout << "Benchmark loop " << iterations << " iterations took " << ns << " ns (" << (ns / iterations)
               << " ns/iter)\n";
+    if (util::AllocGuard::enabled) {
+        const auto allocs = util::AllocGuard::total_hot_allocations();
+        std::cout << "Hot-phase allocations: " << allocs << " (" << util::AllocGuard::total_hot_bytes()
+                  << " bytes)\n";
+        if (allocs != 0) {
+            return 1;
+        }
+    }
     return 0;
 }
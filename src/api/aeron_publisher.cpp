@@ -1,5 +1,6 @@
 #include <array>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -10,7 +11,12 @@
 #include <Aeron.h>
 #include <concurrent/AtomicBuffer.h>
 
+#include "core/event_capture.hpp"
+#include "core/wire_codec.hpp"
 #include "core/wire_exec_event.hpp"
+#include "util/rdtsc.hpp"
+#include "util/tsc_calibration.hpp"
+#include "util/tsc_pacer.hpp"
 
 namespace {
 
@@ -39,18 +45,144 @@ core::WireExecEvent make_wire_exec(std::size_t seq) {
 }
 
 bool publish(aeron::Publication& pub, const core::WireExecEvent& evt) {
-    std::array<std::uint8_t, sizeof(core::WireExecEvent)> buffer{};
-    std::memcpy(buffer.data(), &evt, sizeof(core::WireExecEvent));
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buffer{};
+    core::ExecEventEncoder::encode(buffer.data(), core::from_wire(evt, core::Source::Primary, 0));
 
     aeron::concurrent::AtomicBuffer atomic_buffer(buffer.data(), buffer.size());
     return pub.offer(atomic_buffer, 0, static_cast<aeron::util::index_t>(buffer.size())) > 0;
 }
 
+std::shared_ptr<aeron::Publication> await_publication(aeron::Aeron& client, const std::string& channel,
+                                                      std::int32_t stream_id) {
+    const auto pub_reg_id = client.addPublication(channel, stream_id);
+    std::shared_ptr<aeron::Publication> pub;
+    const auto wait_deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!pub && std::chrono::steady_clock::now() < wait_deadline) {
+        pub = client.findPublication(pub_reg_id);
+        if (!pub) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
+    }
+    if (!pub) {
+        std::cerr << "Publication not available for " << channel << " stream " << stream_id << std::endl;
+    }
+    return pub;
+}
+
+// Retries a back-pressured offer for up to 1s. Counts every retry.
+bool publish_with_retry(aeron::Publication& pub, const core::WireExecEvent& evt, std::uint64_t& retries) {
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+    while (!publish(pub, evt)) {
+        ++retries;
+        if (std::chrono::steady_clock::now() > give_up) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct StreamReplayStats {
+    std::uint64_t published{0};
+    std::uint64_t failed{0};
+    std::uint64_t skipped{0};  // Records for a stream that was not configured
+};
+
+// Replays a capture file (see core/event_capture.hpp) onto the primary, drop-copy
+// and optional prime-broker publications in recorded order, pacing each record at
+// its original offset divided by speed (speed 0 = as fast as possible).
+int run_replay(int argc, char** argv) {
+    if (argc < 7) {
+        std::cerr << "Usage: " << argv[0]
+                  << " replay <capture_file> <primary_channel> <primary_stream_id> <dropcopy_channel>"
+                  << " <dropcopy_stream_id> [speed] [<prime_broker_channel> <prime_broker_stream_id>]\n"
+                  << "speed: 1 = recorded timing (default), 10 = ten times faster, 0 = as fast as possible"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<core::CaptureRecord> records;
+    std::string error;
+    if (!core::load_capture_records(argv[2], records, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    if (records.empty()) {
+        std::cerr << argv[2] << " holds no records" << std::endl;
+        return 1;
+    }
+    const double speed = argc > 7 ? std::strtod(argv[7], nullptr) : 1.0;
+    const bool with_prime_broker = argc > 9;
+
+    // Pacing and lag are measured on the TSC; calibrate it before the first record
+    util::TscCalibration::instance().calibrate_blocking();
+
+    aeron::Context ctx;
+    auto client = aeron::Aeron::connect(ctx);
+    std::shared_ptr<aeron::Publication> pubs[core::SOURCE_COUNT];
+    pubs[core::source_index(core::Source::Primary)] =
+        await_publication(*client, argv[3], static_cast<std::int32_t>(std::stoi(argv[4])));
+    pubs[core::source_index(core::Source::DropCopy)] =
+        await_publication(*client, argv[5], static_cast<std::int32_t>(std::stoi(argv[6])));
+    if (with_prime_broker) {
+        pubs[core::source_index(core::Source::PrimeBroker)] =
+            await_publication(*client, argv[8], static_cast<std::int32_t>(std::stoi(argv[9])));
+    }
+    if (!pubs[0] || !pubs[1] || (with_prime_broker && !pubs[2])) {
+        return 1;
+    }
+
+    StreamReplayStats stats[core::SOURCE_COUNT];
+    util::LagHistogram lag;
+    std::uint64_t retries = 0;
+
+    util::TscPacer pacer(records.front().ingest_ns, speed);
+    const std::uint64_t start_tsc = util::rdtsc();
+    pacer.start(start_tsc);
+
+    for (const core::CaptureRecord& rec : records) {
+        const std::size_t side = rec.source;
+        aeron::Publication* pub = pubs[side].get();
+        if (!pub) {
+            ++stats[side].skipped;
+            continue;
+        }
+        const std::uint64_t due = pacer.due_tsc(rec.ingest_ns);
+        (void)util::TscPacer::wait_until(due);
+        if (publish_with_retry(*pub, rec.wire, retries)) {
+            ++stats[side].published;
+        } else {
+            ++stats[side].failed;
+        }
+        // Lag: how far behind its due time the record actually went out
+        const std::uint64_t now = util::rdtsc();
+        lag.record(now > due ? util::tsc_to_ns(now - due) : 0);
+    }
+
+    const double elapsed_s = static_cast<double>(util::tsc_to_ns(util::rdtsc() - start_tsc)) / 1e9;
+    const double recorded_s = static_cast<double>(records.back().ingest_ns - records.front().ingest_ns) / 1e9;
+    std::cout << "Replayed " << records.size() << " records (" << recorded_s << "s recorded) in " << elapsed_s
+              << "s at speed " << (speed > 0.0 ? std::to_string(speed) : std::string("max")) << ", "
+              << (elapsed_s > 0.0 ? static_cast<double>(lag.count()) / elapsed_s : 0.0) << " msg/s\n";
+    for (std::size_t i = 0; i < core::SOURCE_COUNT; ++i) {
+        std::cout << "  " << core::source_name(static_cast<core::Source>(i)) << " published=" << stats[i].published
+                  << " failed=" << stats[i].failed << " skipped=" << stats[i].skipped << "\n";
+    }
+    std::cout << "  publish lag ns p50<=" << lag.quantile_upper_ns(0.50) << " p99<=" << lag.quantile_upper_ns(0.99)
+              << " p99.9<=" << lag.quantile_upper_ns(0.999) << " max=" << lag.max_ns()
+              << " mean=" << lag.mean_ns() << " back_pressure_retries=" << retries << std::endl;
+    return 0;
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
+    if (argc >= 2 && std::string(argv[1]) == "replay") {
+        return run_replay(argc, argv);
+    }
     if (argc < 5) {
-        std::cerr << "Usage: " << argv[0] << " <channel> <stream_id> <count> <sleep_ms>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <channel> <stream_id> <count> <sleep_ms>\n"
+                  << "       " << argv[0] << " replay <capture_file> ... (run with 'replay' for details)"
+                  << std::endl;
         return 1;
     }
 
@@ -61,19 +193,8 @@ int main(int argc, char** argv) {
 
     aeron::Context ctx;
     auto client = aeron::Aeron::connect(ctx);
-    const auto pub_reg_id = client->addPublication(channel, stream_id);
-
-    std::shared_ptr<aeron::Publication> pub;
-    const auto wait_deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
-    while (!pub && std::chrono::steady_clock::now() < wait_deadline) {
-        pub = client->findPublication(pub_reg_id);
-        if (!pub) {
-            std::this_thread::sleep_for(std::chrono::milliseconds{50});
-        }
-    }
-
+    const auto pub = await_publication(*client, channel, stream_id);
     if (!pub) {
-        std::cerr << "Publication not available for registration id " << pub_reg_id << std::endl;
         return 1;
     }
 
@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/event_capture.hpp"
+#include "core/recon_backtest.hpp"
+#include "core/recon_config.hpp"
+
+namespace {
+
+// Parses "a,b,c" into integers; an empty or missing list yields {fallback}.
+template <typename T>
+std::vector<T> parse_list(const char* arg, T fallback) {
+    std::vector<T> out;
+    if (arg) {
+        std::stringstream ss(arg);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) {
+                out.push_back(static_cast<T>(std::stoll(item)));
+            }
+        }
+    }
+    if (out.empty()) {
+        out.push_back(fallback);
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <capture_file> [grace_ms,...] [qty_tol,...] [px_tol_micro,...] [dedup_ms,...]\n"
+                  << "Replays a captured event stream against every combination of the given\n"
+                  << "ReconConfig values, one variant per core. Set BACKTEST_THREADS to cap threads.\n";
+        return 1;
+    }
+
+    std::vector<core::ExecEvent> events;
+    std::string error;
+    if (!core::load_capture(argv[1], events, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    const core::ReconConfig base = core::default_recon_config();
+    const auto grace_ms = parse_list<std::uint64_t>(argc > 2 ? argv[2] : nullptr, base.grace_period_ns / 1'000'000);
+    const auto qty_tol = parse_list<std::int64_t>(argc > 3 ? argv[3] : nullptr, base.qty_tolerance);
+    const auto px_tol = parse_list<std::int64_t>(argc > 4 ? argv[4] : nullptr, base.px_tolerance);
+    const auto dedup_ms = parse_list<std::uint64_t>(argc > 5 ? argv[5] : nullptr,
+                                                    base.divergence_dedup_window_ns / 1'000'000);
+
+    std::vector<core::ReconConfig> variants;
+    for (const std::uint64_t g : grace_ms) {
+        for (const std::int64_t q : qty_tol) {
+            for (const std::int64_t p : px_tol) {
+                for (const std::uint64_t d : dedup_ms) {
+                    core::ReconConfig cfg = base;
+                    cfg.grace_period_ns = g * 1'000'000;
+                    cfg.qty_tolerance = q;
+                    cfg.px_tolerance = p;
+                    cfg.divergence_dedup_window_ns = d * 1'000'000;
+                    variants.push_back(cfg);
+                }
+            }
+        }
+    }
+
+    core::BacktestOptions options{};
+    if (const char* threads_env = std::getenv("BACKTEST_THREADS")) {
+        options.threads = static_cast<std::size_t>(std::strtoull(threads_env, nullptr, 10));
+    }
+
+    std::cout << "Replaying " << events.size() << " events ("
+              << core::count_distinct_orders(events) << " orders) against "
+              << variants.size() << " variants\n";
+
+    const auto results = core::run_backtest(events, variants, options);
+
+    std::cout << std::left
+              << std::setw(9) << "grace_ms" << std::setw(8) << "qty_tol" << std::setw(9) << "px_tol"
+              << std::setw(9) << "dedup_ms" << std::setw(10) << "observed" << std::setw(10) << "confirmed"
+              << std::setw(9) << "fp_avoid" << std::setw(9) << "deduped" << std::setw(11) << "scheduled"
+              << std::setw(9) << "expired" << std::setw(9) << "overflow" << std::setw(9) << "peak_tmr"
+              << "wall_ms\n";
+    for (const core::BacktestResult& r : results) {
+        std::cout << std::setw(9) << r.config.grace_period_ns / 1'000'000
+                  << std::setw(8) << r.config.qty_tolerance
+                  << std::setw(9) << r.config.px_tolerance
+                  << std::setw(9) << r.config.divergence_dedup_window_ns / 1'000'000;
+        if (!r.completed) {
+            std::cout << "failed (could not allocate order store)\n";
+            continue;
+        }
+        std::cout << std::setw(10) << r.counters.mismatch_observed
+                  << std::setw(10) << r.counters.mismatch_confirmed
+                  << std::setw(9) << r.counters.false_positive_avoided
+                  << std::setw(9) << r.counters.divergence_deduped
+                  << std::setw(11) << r.timer_stats.scheduled
+                  << std::setw(9) << r.timer_stats.expired
+                  << std::setw(9) << r.timer_stats.overflow_dropped
+                  << std::setw(9) << r.peak_pending_timers
+                  << std::fixed << std::setprecision(1) << static_cast<double>(r.wall_ns) / 1e6 << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,302 @@
+#include "api/fx_recon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "core/divergence.hpp"
+#include "core/exec_event.hpp"
+#include "core/ingest_annotator.hpp"
+#include "core/order_state_store.hpp"
+#include "core/recon_config.hpp"
+#include "core/reconciler.hpp"
+#include "util/arena.hpp"
+#include "util/rdtsc.hpp"
+#include "util/tsc_calibration.hpp"
+#include "util/wheel_timer.hpp"
+
+// The C constants mirror the core enums one to one, so conversion is a cast
+static_assert(FX_SIDE_PRIMARY == static_cast<int>(core::Source::Primary));
+static_assert(FX_SIDE_DROPCOPY == static_cast<int>(core::Source::DropCopy));
+static_assert(FX_SIDE_PRIME_BROKER == static_cast<int>(core::Source::PrimeBroker));
+static_assert(FX_EXEC_NEW == static_cast<int>(core::ExecType::New));
+static_assert(FX_EXEC_FILL == static_cast<int>(core::ExecType::Fill));
+static_assert(FX_EXEC_UNKNOWN == static_cast<int>(core::ExecType::Unknown));
+static_assert(FX_ORD_NEW == static_cast<int>(core::OrdStatus::New));
+static_assert(FX_ORD_FILLED == static_cast<int>(core::OrdStatus::Filled));
+static_assert(FX_ORD_UNKNOWN == static_cast<int>(core::OrdStatus::Unknown));
+static_assert(FX_ORD_CANCEL_PENDING == static_cast<int>(core::OrdStatus::CancelPending));
+static_assert(FX_DIV_MISSING_FILL == static_cast<int>(core::DivergenceType::MissingFill));
+static_assert(FX_DIV_QUANTITY_MISMATCH == static_cast<int>(core::DivergenceType::QuantityMismatch));
+static_assert(FX_DIV_MISSING_DROPCOPY == static_cast<int>(core::DivergenceType::MissingDropCopy));
+static_assert(core::SOURCE_COUNT == 3, "fx_recon_stats carries three per-side slots");
+static_assert(core::ExecEvent::id_capacity <= 255, "fx_exec id lengths are uint8_t");
+
+namespace {
+
+// Per-side producer state; written by that side's submit thread only
+struct alignas(64) SubmitSide {
+    core::IngestAnnotator annotator{};
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> full{0};
+    std::atomic<std::uint64_t> invalid{0};
+};
+
+inline void bump(std::atomic<std::uint64_t>& c) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+core::ReconConfig to_recon_config(const fx_recon_config& c) noexcept {
+    core::ReconConfig rc = core::default_recon_config();
+    rc.grace_period_ns = c.grace_period_ns;
+    rc.gap_recheck_period_ns = c.gap_recheck_period_ns;
+    rc.divergence_dedup_window_ns = c.divergence_dedup_window_ns;
+    rc.qty_tolerance = c.qty_tolerance;
+    rc.px_tolerance = c.px_tolerance;
+    rc.required_sides = c.required_sides;
+    rc.enable_windowed_recon = c.enable_windowed_recon != 0;
+    return rc;
+}
+
+void to_c(const core::Divergence& d, fx_divergence& out) noexcept {
+    out = fx_divergence{};
+    out.key = d.key;
+    out.type = static_cast<std::uint8_t>(d.type);
+    out.primary_status = static_cast<std::uint8_t>(d.internal_status);
+    out.dropcopy_status = static_cast<std::uint8_t>(d.dropcopy_status);
+    out.prime_broker_status = static_cast<std::uint8_t>(d.prime_broker_status);
+    out.mismatch_mask = d.mismatch_mask;
+    out.primary_cum_qty = d.internal_cum_qty;
+    out.dropcopy_cum_qty = d.dropcopy_cum_qty;
+    out.prime_broker_cum_qty = d.prime_broker_cum_qty;
+    out.primary_avg_px = d.internal_avg_px;
+    out.dropcopy_avg_px = d.dropcopy_avg_px;
+    out.prime_broker_avg_px = d.prime_broker_avg_px;
+    out.primary_ts = d.internal_ts;
+    out.dropcopy_ts = d.dropcopy_ts;
+    out.prime_broker_ts = d.prime_broker_ts;
+    out.detect_tsc = d.detect_tsc;
+}
+
+} // namespace
+
+// Everything recond_main wires up around a Reconciler, minus Aeron: the host's
+// threads are the ingest stage (one per side) and the divergence consumer.
+struct fx_recon {
+    explicit fx_recon(const fx_recon_config& c)
+        : cfg(c),
+          arena(util::Arena::default_capacity_bytes),
+          store(arena, c.order_capacity),
+          wheel(c.enable_windowed_recon ? std::make_unique<util::WheelTimer>(util::rdtsc()) : nullptr),
+          recon(stop_flag, *rings[FX_SIDE_PRIMARY], *rings[FX_SIDE_DROPCOPY], store, counters, *divergences,
+                *gaps, wheel.get(), to_recon_config(c)) {
+        if (c.enable_prime_broker != 0) {
+            recon.attach_prime_broker(*rings[FX_SIDE_PRIME_BROKER]);
+        }
+    }
+
+    fx_recon_config cfg;
+    std::atomic<bool> stop_flag{false};
+    std::unique_ptr<core::ExecRing> rings[core::SOURCE_COUNT]{
+        std::make_unique<core::ExecRing>(), std::make_unique<core::ExecRing>(), std::make_unique<core::ExecRing>()};
+    std::unique_ptr<core::DivergenceRing> divergences{std::make_unique<core::DivergenceRing>()};
+    std::unique_ptr<core::SequenceGapRing> gaps{std::make_unique<core::SequenceGapRing>()};
+    util::Arena arena;
+    core::OrderStateStore store;
+    core::ReconCounters counters{};
+    std::unique_ptr<util::WheelTimer> wheel;
+    core::Reconciler recon;
+    SubmitSide sides[core::SOURCE_COUNT]{};
+    std::thread thread{};
+};
+
+extern "C" {
+
+uint32_t fx_recon_abi_version(void) {
+    return FX_RECON_ABI_VERSION;
+}
+
+void fx_recon_config_init(fx_recon_config* cfg) {
+    if (cfg == nullptr) {
+        return;
+    }
+    const core::ReconConfig rc = core::default_recon_config();
+    *cfg = fx_recon_config{};
+    cfg->struct_size = sizeof(fx_recon_config);
+    cfg->order_capacity = 1u << 20;
+    cfg->enable_prime_broker = 0;
+    cfg->enable_windowed_recon = rc.enable_windowed_recon ? 1 : 0;
+    cfg->required_sides = rc.required_sides;
+    cfg->cpu = -1;
+    cfg->grace_period_ns = rc.grace_period_ns;
+    cfg->gap_recheck_period_ns = rc.gap_recheck_period_ns;
+    cfg->divergence_dedup_window_ns = rc.divergence_dedup_window_ns;
+    cfg->qty_tolerance = rc.qty_tolerance;
+    cfg->px_tolerance = rc.px_tolerance;
+}
+
+fx_recon* fx_recon_create(const fx_recon_config* cfg) {
+    if (cfg == nullptr || cfg->struct_size < sizeof(fx_recon_config) || cfg->order_capacity == 0) {
+        return nullptr;
+    }
+    util::TscCalibration& tsc = util::TscCalibration::instance();
+    if (!tsc.is_calibrated()) {
+        tsc.calibrate_blocking();
+    }
+    try {
+        return new fx_recon(*cfg);
+    } catch (...) {
+        return nullptr;  // Allocation failure or an unusable order_capacity
+    }
+}
+
+void fx_recon_destroy(fx_recon* recon) {
+    if (recon == nullptr) {
+        return;
+    }
+    (void)fx_recon_stop(recon);
+    delete recon;
+}
+
+int fx_recon_start(fx_recon* recon) {
+    if (recon == nullptr) {
+        return FX_RECON_EINVAL;
+    }
+    if (recon->thread.joinable()) {
+        return FX_RECON_ESTATE;
+    }
+    recon->stop_flag.store(false, std::memory_order_release);
+    try {
+        recon->thread = std::thread([recon] { recon->recon.run(); });
+    } catch (...) {
+        return FX_RECON_ESTATE;
+    }
+#if defined(__linux__)
+    const int cpu = recon->cfg.cpu;
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        (void)pthread_setaffinity_np(recon->thread.native_handle(), sizeof(set), &set);  // A failed pin is not fatal
+    }
+#endif
+    return FX_RECON_OK;
+}
+
+int fx_recon_stop(fx_recon* recon) {
+    if (recon == nullptr) {
+        return FX_RECON_EINVAL;
+    }
+    if (!recon->thread.joinable()) {
+        return FX_RECON_ESTATE;
+    }
+    recon->stop_flag.store(true, std::memory_order_release);
+    recon->thread.join();
+    return FX_RECON_OK;
+}
+
+int fx_recon_submit_exec(fx_recon* recon, int side, const fx_exec* exec) {
+    if (recon == nullptr || exec == nullptr || side < 0 || side >= static_cast<int>(core::SOURCE_COUNT) ||
+        (side == FX_SIDE_PRIME_BROKER && recon->cfg.enable_prime_broker == 0)) {
+        return FX_RECON_EINVAL;
+    }
+    SubmitSide& s = recon->sides[side];
+    core::ExecEvent* ev = recon->rings[side]->try_claim();
+    if (ev == nullptr) {
+        bump(s.full);
+        return FX_RECON_EFULL;
+    }
+    // Built in the ring slot itself; every field the reconciler reads is written
+    // here or by the annotator, so the slot's previous contents never leak through
+    ev->source = static_cast<core::Source>(side);
+    ev->exec_type = static_cast<core::ExecType>(exec->exec_type);
+    ev->ord_status = static_cast<core::OrdStatus>(exec->ord_status);
+    ev->seq_num = exec->seq_num;
+    ev->session_id = exec->session_id;
+    ev->price_micro = exec->price_micro;
+    ev->qty = exec->qty;
+    ev->cum_qty = exec->cum_qty;
+    ev->sending_time = exec->sending_time;
+    ev->transact_time = exec->transact_time;
+    ev->ingest_tsc = util::rdtsc();
+    ev->set_exec_id(exec->exec_id, exec->exec_id != nullptr ? exec->exec_id_len : 0);
+    ev->set_order_id(exec->order_id, exec->order_id != nullptr ? exec->order_id_len : 0);
+    ev->set_clord_id(exec->clord_id, exec->clord_id != nullptr ? exec->clord_id_len : 0);
+    if (!s.annotator.annotate(*ev)) {
+        bump(s.invalid);  // Slot stays unpublished and is reused by the next submit
+        return FX_RECON_EINVAL;
+    }
+    recon->rings[side]->publish();
+    bump(s.submitted);
+    return FX_RECON_OK;
+}
+
+size_t fx_recon_poll_divergences(fx_recon* recon, fx_divergence* out, size_t max) {
+    if (recon == nullptr || out == nullptr) {
+        return 0;
+    }
+    // Sequence gaps are not part of the C ABI; keep their ring from filling up
+    core::SequenceGapEvent gap{};
+    while (recon->gaps->try_pop(gap)) {
+    }
+    core::Divergence div{};
+    size_t n = 0;
+    while (n < max && recon->divergences->try_pop(div)) {
+        to_c(div, out[n++]);
+    }
+    return n;
+}
+
+size_t fx_recon_drain_divergences(fx_recon* recon, fx_divergence_fn fn, void* ctx, size_t max) {
+    if (recon == nullptr || fn == nullptr) {
+        return 0;
+    }
+    fx_divergence batch[64];
+    size_t delivered = 0;
+    while (delivered < max) {
+        const size_t n = fx_recon_poll_divergences(recon, batch, std::min(max - delivered, std::size(batch)));
+        for (size_t i = 0; i < n; ++i) {
+            fn(ctx, &batch[i]);
+        }
+        delivered += n;
+        if (n < std::size(batch)) {
+            break;
+        }
+    }
+    return delivered;
+}
+
+int fx_recon_stats_get(const fx_recon* recon, fx_recon_stats* stats) {
+    if (recon == nullptr || stats == nullptr || stats->struct_size == 0) {
+        return FX_RECON_EINVAL;
+    }
+    fx_recon_stats full{};
+    full.struct_size = stats->struct_size;
+    for (std::size_t i = 0; i < core::SOURCE_COUNT; ++i) {
+        const SubmitSide& s = recon->sides[i];
+        full.submitted[i] = s.submitted.load(std::memory_order_relaxed);
+        full.submit_full[i] = s.full.load(std::memory_order_relaxed);
+        full.submit_invalid[i] = s.invalid.load(std::memory_order_relaxed);
+    }
+    const core::ReconStatsSnapshot snap = recon->recon.stats_snapshot();
+    full.events_processed[FX_SIDE_PRIMARY] = snap.counters.internal_events;
+    full.events_processed[FX_SIDE_DROPCOPY] = snap.counters.dropcopy_events;
+    full.events_processed[FX_SIDE_PRIME_BROKER] = snap.counters.prime_broker_events;
+    full.divergences = snap.counters.divergence_total;
+    full.divergence_ring_drops = snap.counters.divergence_ring_drops;
+    full.store_overflow = snap.counters.store_overflow;
+    full.orders_matched = snap.counters.orders_matched;
+    // Older callers get the prefix their struct has room for
+    std::memcpy(stats, &full, std::min<std::size_t>(stats->struct_size, sizeof(full)));
+    return FX_RECON_OK;
+}
+
+} // extern "C"
@@ -0,0 +1,183 @@
+/*
+ * fx_recon.h - C ABI of the embeddable reconciler (libfx_recon).
+ *
+ * Runs the reconciler in-process: the host feeds executions straight into the
+ * reconciler's ingest rings (no Aeron hop, no wire decode) and collects confirmed
+ * divergences by polling or through a callback on its own thread.
+ *
+ * Threading:
+ *   - fx_recon_submit_exec: one producer thread per side (the rings are SPSC).
+ *   - fx_recon_poll_divergences / fx_recon_drain_divergences: one consumer thread.
+ *   - fx_recon_stats_get: any thread.
+ *   - create / start / stop / destroy: the owning thread.
+ *
+ * ABI rules: structs are only ever extended at the end; callers set struct_size
+ * where present (fx_recon_config_init does it). FX_RECON_ABI_VERSION changes only
+ * on an incompatible change.
+ */
+#ifndef FX_RECON_H
+#define FX_RECON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+    #define FX_RECON_API __attribute__((visibility("default")))
+#else
+    #define FX_RECON_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FX_RECON_ABI_VERSION 1u
+
+/* Return codes */
+#define FX_RECON_OK 0
+#define FX_RECON_EINVAL (-1) /* Bad argument, out-of-range enum, or side not enabled */
+#define FX_RECON_EFULL (-2)  /* Ingest ring full; the execution was not taken */
+#define FX_RECON_ESTATE (-3) /* Not allowed in the current state (e.g. already started) */
+
+/* Sides (core::Source) */
+#define FX_SIDE_PRIMARY 0
+#define FX_SIDE_DROPCOPY 1
+#define FX_SIDE_PRIME_BROKER 2
+
+/* fx_exec.exec_type (core::ExecType) */
+#define FX_EXEC_NEW 0
+#define FX_EXEC_PARTIAL_FILL 1
+#define FX_EXEC_FILL 2
+#define FX_EXEC_CANCEL 3
+#define FX_EXEC_REPLACE 4
+#define FX_EXEC_REJECTED 5
+#define FX_EXEC_UNKNOWN 6
+
+/* fx_exec.ord_status (core::OrdStatus) */
+#define FX_ORD_NEW 0
+#define FX_ORD_PARTIALLY_FILLED 1
+#define FX_ORD_FILLED 2
+#define FX_ORD_CANCELED 3
+#define FX_ORD_REPLACED 4
+#define FX_ORD_REJECTED 5
+#define FX_ORD_UNKNOWN 6
+#define FX_ORD_PENDING_NEW 7
+#define FX_ORD_WORKING 8
+#define FX_ORD_CANCEL_PENDING 9
+
+/* fx_divergence.type (core::DivergenceType) */
+#define FX_DIV_MISSING_FILL 0
+#define FX_DIV_PHANTOM_ORDER 1
+#define FX_DIV_STATE_MISMATCH 2
+#define FX_DIV_QUANTITY_MISMATCH 3
+#define FX_DIV_TIMING_ANOMALY 4
+#define FX_DIV_MISSING_DROPCOPY 5
+
+typedef struct fx_recon fx_recon; /* Opaque */
+
+/* One execution report. Ids are read during the call (up to 32 bytes each kept). */
+typedef struct fx_exec {
+    uint64_t seq_num;       /* Session-level sequence number */
+    uint64_t sending_time;
+    uint64_t transact_time;
+    int64_t price_micro;    /* Price in micro-units */
+    int64_t qty;
+    int64_t cum_qty;
+    const char* exec_id;
+    const char* order_id;
+    const char* clord_id;
+    uint8_t exec_id_len;
+    uint8_t order_id_len;
+    uint8_t clord_id_len;
+    uint8_t exec_type;      /* FX_EXEC_* */
+    uint8_t ord_status;     /* FX_ORD_* */
+    uint8_t reserved;
+    uint16_t session_id;
+} fx_exec;
+
+typedef struct fx_divergence {
+    uint64_t key;           /* Order key (hash of the order's ids) */
+    uint8_t type;           /* FX_DIV_* */
+    uint8_t primary_status; /* FX_ORD_* per side */
+    uint8_t dropcopy_status;
+    uint8_t prime_broker_status;
+    uint8_t mismatch_mask;  /* Mismatch bits at detection */
+    uint8_t reserved[3];
+    int64_t primary_cum_qty;
+    int64_t dropcopy_cum_qty;
+    int64_t prime_broker_cum_qty;
+    int64_t primary_avg_px;
+    int64_t dropcopy_avg_px;
+    int64_t prime_broker_avg_px;
+    uint64_t primary_ts;
+    uint64_t dropcopy_ts;
+    uint64_t prime_broker_ts;
+    uint64_t detect_tsc;
+} fx_divergence;
+
+typedef struct fx_recon_config {
+    uint32_t struct_size;            /* sizeof(fx_recon_config) */
+    uint32_t order_capacity;         /* Live orders the store is sized for */
+    uint8_t enable_prime_broker;     /* Accept FX_SIDE_PRIME_BROKER */
+    uint8_t enable_windowed_recon;   /* Grace period before a mismatch is confirmed */
+    uint8_t required_sides;          /* Bit per FX_SIDE_* that must report every order */
+    uint8_t reserved;
+    int32_t cpu;                     /* Pin the reconciler thread; -1 = unpinned */
+    uint64_t grace_period_ns;
+    uint64_t gap_recheck_period_ns;
+    uint64_t divergence_dedup_window_ns;
+    int64_t qty_tolerance;
+    int64_t px_tolerance;
+} fx_recon_config;
+
+typedef struct fx_recon_stats {
+    uint32_t struct_size;            /* sizeof(fx_recon_stats) */
+    uint32_t reserved;
+    uint64_t submitted[3];           /* Per side: executions accepted */
+    uint64_t submit_full[3];         /* Per side: refused, ring full */
+    uint64_t submit_invalid[3];      /* Per side: refused, bad enums */
+    uint64_t events_processed[3];    /* Per side, as of the last published snapshot */
+    uint64_t divergences;
+    uint64_t divergence_ring_drops;
+    uint64_t store_overflow;
+    uint64_t orders_matched;
+} fx_recon_stats;
+
+typedef void (*fx_divergence_fn)(void* ctx, const fx_divergence* div);
+
+FX_RECON_API uint32_t fx_recon_abi_version(void);
+
+/* Production defaults */
+FX_RECON_API void fx_recon_config_init(fx_recon_config* cfg);
+
+/* Allocates every ring, the order store and timers up front. The first call
+ * calibrates the TSC (~100ms). NULL on failure. */
+FX_RECON_API fx_recon* fx_recon_create(const fx_recon_config* cfg);
+/* Stops if running and frees everything. NULL is ignored. */
+FX_RECON_API void fx_recon_destroy(fx_recon* recon);
+
+/* Starts the reconciler thread. */
+FX_RECON_API int fx_recon_start(fx_recon* recon);
+/* Stops and joins the reconciler thread. Executions still queued are dropped. */
+FX_RECON_API int fx_recon_stop(fx_recon* recon);
+
+/* Validates, keys and sequence-checks exec, writing it directly into the side's
+ * ingest ring slot. FX_RECON_EFULL when the reconciler lags; nothing is queued. */
+FX_RECON_API int fx_recon_submit_exec(fx_recon* recon, int side, const fx_exec* exec);
+
+/* Copies up to max confirmed divergences (most severe lane first) into out.
+ * Returns the number copied. */
+FX_RECON_API size_t fx_recon_poll_divergences(fx_recon* recon, fx_divergence* out, size_t max);
+/* Calls fn(ctx, div) on the calling thread for up to max divergences.
+ * Returns the number delivered. */
+FX_RECON_API size_t fx_recon_drain_divergences(fx_recon* recon, fx_divergence_fn fn, void* ctx, size_t max);
+
+/* Fills stats (set stats->struct_size first). Reconciler-side figures are
+ * refreshed every 10ms while running and once more on stop. */
+FX_RECON_API int fx_recon_stats_get(const fx_recon* recon, fx_recon_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FX_RECON_H */
@@ -1,68 +1,340 @@
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <unistd.h>
 
 #include <Aeron.h>
 
+#include "core/flight_recorder.hpp"
 #include "core/reconciler.hpp"
+#include "core/recon_metrics.hpp"
 #include "core/order_state_store.hpp"
 #include "ingest/aeron_subscriber.hpp"
+#include "util/agent_runtime.hpp"
+#include "util/alloc_guard.hpp"
 #include "util/arena.hpp"
 #include "util/async_log.hpp"
+#include "util/cold_start.hpp"
+#include "util/metrics_exporter.hpp"
+#include "util/tsc_calibration.hpp"
+
+namespace {
+
+// "q0,q1,..." -> live-order quota per store partition; empty if unset or malformed
+std::vector<std::size_t> parse_partition_quotas(const char* spec) {
+    std::vector<std::size_t> quotas;
+    while (spec && *spec) {
+        char* end = nullptr;
+        const unsigned long long quota = std::strtoull(spec, &end, 10);
+        if (end == spec || quota == 0 || (*end != ',' && *end != '\0')) {
+            return {};
+        }
+        quotas.push_back(static_cast<std::size_t>(quota));
+        spec = *end == ',' ? end + 1 : end;
+    }
+    return quotas;
+}
+
+// "session:partition,..." -> set_session_partition on every subscriber. Returns false
+// on a malformed entry or a partition outside [0, partition_count).
+bool assign_session_partitions(const char* spec, std::size_t partition_count,
+                               std::span<ingest::AeronSubscriber* const> subscribers) {
+    while (spec && *spec) {
+        char* end = nullptr;
+        const unsigned long session = std::strtoul(spec, &end, 10);
+        if (end == spec || *end != ':' || session > 0xFFFF) {
+            return false;
+        }
+        const char* part_begin = end + 1;
+        const unsigned long partition = std::strtoul(part_begin, &end, 10);
+        if (end == part_begin || partition >= partition_count || (*end != ',' && *end != '\0')) {
+            return false;
+        }
+        for (ingest::AeronSubscriber* sub : subscribers) {
+            if (!sub->annotator().set_session_partition(static_cast<std::uint16_t>(session),
+                                                        static_cast<std::uint8_t>(partition))) {
+                return false;
+            }
+        }
+        spec = *end == ',' ? end + 1 : end;
+    }
+    return true;
+}
+
+// RECOND_READY_FILE: written once the daemon is up (memory resident, TSC calibrated,
+// subscriptions started), for supervisors and health checks to wait on
+void signal_ready(std::uint64_t startup_ns) {
+    const char* path = std::getenv("RECOND_READY_FILE");
+    if (path == nullptr || *path == '\0') {
+        return;
+    }
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr) {
+        LOG_SLOW_WARN("Cannot write ready file %s", path);
+        return;
+    }
+    std::fprintf(f, "pid=%d startup_ms=%.3f\n", static_cast<int>(::getpid()), static_cast<double>(startup_ns) / 1e6);
+    std::fclose(f);
+}
+
+void clear_ready() {
+    const char* path = std::getenv("RECOND_READY_FILE");
+    if (path != nullptr && *path != '\0') {
+        (void)std::remove(path);
+    }
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
     if (argc < 5) {
         std::cerr << "Usage: " << argv[0]
-                  << " <primary_channel> <primary_stream_id> <dropcopy_channel> <dropcopy_stream_id>" << std::endl;
+                  << " <primary_channel> <primary_stream_id> <dropcopy_channel> <dropcopy_stream_id>"
+                  << " [<prime_broker_channel> <prime_broker_stream_id>]" << std::endl;
         return 1;
     }
 
     util::AsyncLogger::Config hot_cfg{};
     hot_cfg.capacity_pow2 = 1u << 15;
     hot_cfg.use_rdtsc = true;
+    // Drained by an agent on the housekeeping runtime rather than its own thread
+    hot_cfg.external_consumer = true;
+    // Hot log to a file (written via io_uring / pwrite pool) instead of stderr
+    if (const char* hot_log_path = std::getenv("RECOND_HOT_LOG")) {
+        hot_cfg.file_path = hot_log_path;
+    }
     if (!init_hot_logger(hot_cfg)) {
         LOG_SLOW_ERROR("Failed to start async logger for fx_exec_recond");
+    } else if (!hot_cfg.file_path.empty()) {
+        LOG_SLOW_INFO("Hot log %s via %s", hot_cfg.file_path.c_str(),
+                      util::file_io_backend_name(util::hot_logger().io_backend()));
     }
 
     const std::string primary_channel = argv[1];
     const std::int32_t primary_stream = static_cast<std::int32_t>(std::stoi(argv[2]));
     const std::string dropcopy_channel = argv[3];
     const std::int32_t dropcopy_stream = static_cast<std::int32_t>(std::stoi(argv[4]));
+    // Optional third side: prime-broker give-up feed
+    const bool with_prime_broker = argc >= 7;
+    const std::string prime_broker_channel = with_prime_broker ? argv[5] : "";
+    const std::int32_t prime_broker_stream = with_prime_broker ? static_cast<std::int32_t>(std::stoi(argv[6])) : 0;
+
+    // Cold start: the TSC is calibrated on its own thread while the large structures
+    // are built and faulted in by startup workers (RECOND_STARTUP_THREADS). Nothing
+    // hot starts until both are done, so the first events hit resident memory and
+    // calibrated clocks.
+    util::StartupPhases startup;
+    util::BackgroundCalibration calibration;
+    std::size_t startup_threads = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 8);
+    if (const char* threads_env = std::getenv("RECOND_STARTUP_THREADS")) {
+        startup_threads = std::max<std::size_t>(std::strtoul(threads_env, nullptr, 10), 1);
+    }
 
-    ingest::Ring primary_ring;
-    ingest::Ring dropcopy_ring;
-    core::DivergenceRing divergence_ring;
-    core::SequenceGapRing seq_gap_ring;
+    // Each ring's constructor writes every slot; build them side by side
+    std::unique_ptr<ingest::Ring> primary_ring_ptr;
+    std::unique_ptr<ingest::Ring> dropcopy_ring_ptr;
+    std::unique_ptr<ingest::Ring> prime_broker_ring_ptr;
+    std::unique_ptr<core::DivergenceRing> divergence_ring_ptr;
+    std::unique_ptr<core::SequenceGapRing> seq_gap_ring_ptr;
+    startup.time("rings", [&] {
+        const std::function<void()> tasks[] = {
+            [&] { primary_ring_ptr = std::make_unique<ingest::Ring>(); },
+            [&] { dropcopy_ring_ptr = std::make_unique<ingest::Ring>(); },
+            [&] { prime_broker_ring_ptr = std::make_unique<ingest::Ring>(); },
+            [&] { divergence_ring_ptr = std::make_unique<core::DivergenceRing>(); },
+            [&] { seq_gap_ring_ptr = std::make_unique<core::SequenceGapRing>(); },
+        };
+        util::run_parallel(tasks, startup_threads);
+    });
+    ingest::Ring& primary_ring = *primary_ring_ptr;
+    ingest::Ring& dropcopy_ring = *dropcopy_ring_ptr;
+    ingest::Ring& prime_broker_ring = *prime_broker_ring_ptr;
+    core::DivergenceRing& divergence_ring = *divergence_ring_ptr;
+    core::SequenceGapRing& seq_gap_ring = *seq_gap_ring_ptr;
 
     ingest::ThreadStats primary_stats;
     ingest::ThreadStats dropcopy_stats;
+    ingest::ThreadStats prime_broker_stats;
     core::ReconCounters counters;
     std::atomic<bool> stop_flag{false};
-    util::Arena arena(util::Arena::default_capacity_bytes);
+    // Not zero-filled: its pages are faulted in by all startup workers instead of
+    // by a serial memset (or, worse, by the reconciler on first use)
+    util::Arena arena(util::Arena::default_capacity_bytes, util::Arena::for_overwrite);
+    std::size_t prefaulted_pages = 0;
+    startup.time("prefault", [&] {
+        const util::MemoryRegion regions[] = {{arena.data(), arena.capacity_bytes()}};
+        prefaulted_pages = util::prefault_parallel(regions, startup_threads);
+    });
     constexpr std::size_t order_capacity_hint = 1u << 16;
-    core::OrderStateStore store(arena, order_capacity_hint);
+    // Optional per-desk partitions: RECOND_PARTITION_QUOTAS="q0,q1,..." live orders each,
+    // sessions mapped with RECOND_SESSION_PARTITIONS="session:partition,..."
+    const std::vector<std::size_t> partition_quotas = parse_partition_quotas(std::getenv("RECOND_PARTITION_QUOTAS"));
+    std::unique_ptr<core::OrderStateStore> store_ptr;
+    startup.time("order_store", [&] {
+        store_ptr = partition_quotas.empty()
+                        ? std::make_unique<core::OrderStateStore>(arena, order_capacity_hint)
+                        : std::make_unique<core::OrderStateStore>(arena,
+                                                                  std::span<const std::size_t>(partition_quotas));
+    });
+    core::OrderStateStore& store = *store_ptr;
 
     aeron::Context context;
-    auto client = aeron::Aeron::connect(context);
+    std::shared_ptr<aeron::Aeron> client;
+    startup.time("aeron_connect", [&] { client = aeron::Aeron::connect(context); });
 
     core::Reconciler recon(stop_flag, primary_ring, dropcopy_ring, store, counters, divergence_ring, seq_gap_ring);
+    if (with_prime_broker) {
+        recon.attach_prime_broker(prime_broker_ring);
+    }
 
     ingest::AeronSubscriber primary_sub(primary_channel, primary_stream, primary_ring, primary_stats,
                                         core::Source::Primary, client, stop_flag);
     ingest::AeronSubscriber dropcopy_sub(dropcopy_channel, dropcopy_stream, dropcopy_ring, dropcopy_stats,
                                          core::Source::DropCopy, client, stop_flag);
+    ingest::AeronSubscriber prime_broker_sub(prime_broker_channel, prime_broker_stream, prime_broker_ring,
+                                             prime_broker_stats, core::Source::PrimeBroker, client, stop_flag);
+
+    ingest::AeronSubscriber* const subscribers[] = {&primary_sub, &dropcopy_sub, &prime_broker_sub};
+    if (!assign_session_partitions(std::getenv("RECOND_SESSION_PARTITIONS"), store.partition_count(), subscribers)) {
+        LOG_SLOW_ERROR("Invalid RECOND_SESSION_PARTITIONS; unlisted sessions stay in partition 0");
+    }
+    LOG_SLOW_INFO("Order store partitions=%zu buckets=%zu", store.partition_count(), store.bucket_count());
+
+    // Always-on flight recorders, one per hot thread, dumped with the unconsumed hot
+    // log records on SIGSEGV/SIGBUS/SIGILL/SIGFPE/SIGABRT or on demand (kill -USR2)
+    constexpr std::size_t flight_records = 1u << 14;
+    core::FlightRecorder recon_flight("recon", flight_records);
+    core::FlightRecorder primary_flight("primary", flight_records);
+    core::FlightRecorder dropcopy_flight("dropcopy", flight_records);
+    core::FlightRecorder prime_broker_flight("prime_broker", flight_records);
+    recon.attach_flight_recorder(recon_flight);
+    primary_sub.attach_flight_recorder(primary_flight);
+    dropcopy_sub.attach_flight_recorder(dropcopy_flight);
+    prime_broker_sub.attach_flight_recorder(prime_broker_flight);
+    core::FlightRecorder* const flight_recorders[] = {&recon_flight, &primary_flight, &dropcopy_flight,
+                                                      &prime_broker_flight};
+    for (core::FlightRecorder* rec : flight_recorders) {
+        (void)core::register_flight_recorder(rec);
+    }
+    const char* flight_dump_env = std::getenv("RECOND_FLIGHT_DUMP");
+    const char* flight_dump_path = flight_dump_env ? flight_dump_env : "fx_exec_recond.flight";
+    if (core::install_flight_dump_handlers(flight_dump_path, &util::hot_logger())) {
+        LOG_SLOW_INFO("Flight recorder dumps to %s (kill -USR2 %d for a live dump)", flight_dump_path,
+                      static_cast<int>(::getpid()));
+    } else {
+        LOG_SLOW_WARN("Flight recorder dump handlers not installed (path %s)", flight_dump_path);
+    }
 
     LOG_SLOW_INFO("Starting fx_exec_recond primary=%s stream=%d dropcopy=%s stream=%d",
                   primary_channel.c_str(), primary_stream, dropcopy_channel.c_str(), dropcopy_stream);
+    if (with_prime_broker) {
+        LOG_SLOW_INFO("Prime-broker feed enabled channel=%s stream=%d", prime_broker_channel.c_str(),
+                      prime_broker_stream);
+    }
+
+    // Hot threads, timers and rate limiters convert between TSC cycles and ns from
+    // here on
+    bool tsc_calibrated = false;
+    startup.time("calibration_wait", [&] { tsc_calibrated = calibration.wait(); });
+    startup.record("tsc_calibration", calibration.elapsed_ns());
+    for (const util::StartupPhases::Phase& phase : startup.phases()) {
+        LOG_SLOW_INFO("Startup phase %s took %.3f ms", phase.name, static_cast<double>(phase.ns) / 1e6);
+    }
+    LOG_SLOW_INFO("Startup memory resident pages=%zu workers=%zu; TSC %llu Hz (%s)", prefaulted_pages,
+                  startup_threads, static_cast<unsigned long long>(util::TscCalibration::instance().tsc_freq_hz()),
+                  tsc_calibrated ? "calibrated" : "default, no invariant TSC");
+
+    // Every slow-path duty runs as an agent on this one housekeeping thread
+    // (optionally pinned with RECOND_HOUSEKEEPING_CPU), next to the hot threads
+    util::AgentRuntime::Config housekeeping_cfg{};
+    if (const char* cpu_env = std::getenv("RECOND_HOUSEKEEPING_CPU")) {
+        housekeeping_cfg.cpu = static_cast<int>(std::strtol(cpu_env, nullptr, 10));
+    }
+    util::AgentRuntime housekeeping(housekeeping_cfg);
 
     std::thread primary_thread([&] { primary_sub.run(); });
     std::thread dropcopy_thread([&] { dropcopy_sub.run(); });
+    std::thread prime_broker_thread;
+    if (with_prime_broker) {
+        prime_broker_thread = std::thread([&] { prime_broker_sub.run(); });
+    }
     std::thread recon_thread([&] { recon.run(); });
+    const std::uint64_t startup_ns = startup.elapsed_ns();
+    LOG_SLOW_INFO("fx_exec_recond ready in %.3f ms; subscriptions started", static_cast<double>(startup_ns) / 1e6);
+    signal_ready(startup_ns);
+
+    // Reports reconciler loop stalls captured by the jitter monitor, off the hot thread
+    core::ReconJitterMonitor& jitter = recon.jitter_monitor();
+    const auto report_incident = [](const core::JitterIncident& inc) {
+        LOG_SLOW_WARN("Reconciler stall iter=%llu cycles=%llu slowest=%s ingest=%llu timers=%llu housekeeping=%llu "
+                      "primary_depth=%u dropcopy_depth=%u prime_broker_depth=%u pending_timers=%u burst=%u",
+                      static_cast<unsigned long long>(inc.iteration),
+                      static_cast<unsigned long long>(inc.total_cycles),
+                      core::recon_stage_name(inc.slowest_stage),
+                      static_cast<unsigned long long>(inc.stage_cycles[0]),
+                      static_cast<unsigned long long>(inc.stage_cycles[1]),
+                      static_cast<unsigned long long>(inc.stage_cycles[2]),
+                      inc.context.primary_depth, inc.context.dropcopy_depth, inc.context.prime_broker_depth,
+                      inc.context.pending_timers, inc.context.burst_events);
+    };
+    const auto jitter_agent = [](core::ReconJitterMonitor& monitor, const auto& report) -> util::Agent {
+        for (;;) {
+            monitor.drain_incidents(report);
+            co_await util::sleep_for(100'000'000);
+        }
+    };
+    (void)housekeeping.spawn(util::log_consumer_agent(util::hot_logger()));
+    (void)housekeeping.spawn(jitter_agent(jitter, report_incident));
+    if (!housekeeping.start()) {
+        LOG_SLOW_ERROR("Failed to start the housekeeping thread; hot log and stall reports are not drained");
+    } else if (housekeeping_cfg.cpu >= 0 && !housekeeping.pinned()) {
+        LOG_SLOW_WARN("Housekeeping thread not pinned to CPU %d", housekeeping_cfg.cpu);
+    }
+
+    // Optional /metrics endpoint on 127.0.0.1:RECOND_METRICS_PORT for Prometheus scrapes.
+    // Reads only snapshots, relaxed atomics and ring depths; never touches the hot threads.
+    std::unique_ptr<util::MetricsExporter> metrics;
+    if (const char* metrics_port_env = std::getenv("RECOND_METRICS_PORT")) {
+        const auto port = static_cast<std::uint16_t>(std::strtoul(metrics_port_env, nullptr, 10));
+        metrics = std::make_unique<util::MetricsExporter>(port, [&](util::MetricsText& out) {
+            core::append_recon_metrics(out, recon.stats_snapshot());
+            const core::IngestMetricsSource sources[] = {
+                {core::Source::Primary, &primary_stats},
+                {core::Source::DropCopy, &dropcopy_stats},
+                {core::Source::PrimeBroker, &prime_broker_stats},
+            };
+            core::append_ingest_metrics(out, std::span(sources, with_prime_broker ? 3 : 2));
+            const core::RingDepth rings[] = {
+                {"primary", primary_ring.size_approx()},
+                {"dropcopy", dropcopy_ring.size_approx()},
+                {"divergence", divergence_ring.size_approx()},
+                {"sequence_gap", seq_gap_ring.size_approx()},
+                {"prime_broker", prime_broker_ring.size_approx()},
+            };
+            core::append_ring_depths(out, std::span(rings, with_prime_broker ? 5 : 4));
+            core::append_divergence_lane_metrics(out, divergence_ring);
+            core::append_jitter_metrics(out, jitter);
+            core::append_logger_metrics(out, util::hot_logger());
+        });
+        std::string error;
+        if (metrics->start(error)) {
+            LOG_SLOW_INFO("Serving metrics on http://127.0.0.1:%u/metrics", static_cast<unsigned>(metrics->port()));
+        } else {
+            LOG_SLOW_WARN("Metrics exporter disabled: %s", error.c_str());
+            metrics.reset();
+        }
+    }
 
     const char* duration_env = std::getenv("RECOND_RUN_MS");
     if (duration_env) {
@@ -74,22 +346,65 @@ int main(int argc, char** argv) {
         LOG_SLOW_INFO("fx_exec_recond running. Press Enter to exit.");
         std::cin.get();
     }
+    clear_ready();
     stop_flag.store(true, std::memory_order_release);
+    if (metrics) {
+        metrics->stop();
+    }
 
     primary_thread.join();
     dropcopy_thread.join();
+    if (prime_broker_thread.joinable()) {
+        prime_broker_thread.join();
+    }
     recon_thread.join();
+    housekeeping.stop();
+    jitter.drain_incidents(report_incident);
 
-    LOG_SLOW_INFO("Primary produced=%zu drops=%zu parse_failures=%zu", primary_stats.produced, primary_stats.drops,
-                  primary_stats.parse_failures);
-    LOG_SLOW_INFO("DropCopy produced=%zu drops=%zu parse_failures=%zu", dropcopy_stats.produced, dropcopy_stats.drops,
-                  dropcopy_stats.parse_failures);
-    LOG_SLOW_INFO("Reconciler processed internal=%llu dropcopy=%llu divergences=%llu ring_drops=%llu",
+    LOG_SLOW_INFO("Primary produced=%zu drops=%zu parse_failures=%zu rejected=%zu", primary_stats.produced.load(),
+                  primary_stats.drops.load(), primary_stats.parse_failures.load(), primary_stats.rejected.load());
+    LOG_SLOW_INFO("DropCopy produced=%zu drops=%zu parse_failures=%zu rejected=%zu", dropcopy_stats.produced.load(),
+                  dropcopy_stats.drops.load(), dropcopy_stats.parse_failures.load(), dropcopy_stats.rejected.load());
+    if (with_prime_broker) {
+        LOG_SLOW_INFO("PrimeBroker produced=%zu drops=%zu parse_failures=%zu rejected=%zu", prime_broker_stats.produced.load(),
+                      prime_broker_stats.drops.load(), prime_broker_stats.parse_failures.load(),
+                      prime_broker_stats.rejected.load());
+    }
+    LOG_SLOW_INFO("Reconciler processed internal=%llu dropcopy=%llu prime_broker=%llu divergences=%llu ring_drops=%llu",
                   static_cast<unsigned long long>(counters.internal_events),
                   static_cast<unsigned long long>(counters.dropcopy_events),
+                  static_cast<unsigned long long>(counters.prime_broker_events),
                   static_cast<unsigned long long>(counters.divergence_total),
                   static_cast<unsigned long long>(counters.divergence_ring_drops));
+    LOG_SLOW_INFO("Divergence lane drops critical=%llu high=%llu low=%llu",
+                  static_cast<unsigned long long>(divergence_ring.drops(core::DivergencePriority::Critical)),
+                  static_cast<unsigned long long>(divergence_ring.drops(core::DivergencePriority::High)),
+                  static_cast<unsigned long long>(divergence_ring.drops(core::DivergencePriority::Low)));
+    LOG_SLOW_INFO("Reconciler loop iterations=%llu p50<=%llu p99<=%llu p99.99<=%llu max=%llu cycles "
+                  "stalls=%llu stall_drops=%llu",
+                  static_cast<unsigned long long>(jitter.iterations()),
+                  static_cast<unsigned long long>(jitter.quantile_upper_cycles(0.50)),
+                  static_cast<unsigned long long>(jitter.quantile_upper_cycles(0.99)),
+                  static_cast<unsigned long long>(jitter.quantile_upper_cycles(0.9999)),
+                  static_cast<unsigned long long>(jitter.max_cycles()),
+                  static_cast<unsigned long long>(jitter.incidents()),
+                  static_cast<unsigned long long>(jitter.incident_drops()));
+    for (std::size_t p = 0; p < store.partition_count(); ++p) {
+        const core::StorePartitionStats part = store.partition_stats(p);
+        LOG_SLOW_INFO("Store partition %zu live=%llu quota=%llu overflow=%llu", p,
+                      static_cast<unsigned long long>(part.live), static_cast<unsigned long long>(part.quota),
+                      static_cast<unsigned long long>(part.overflow));
+    }
+    if (util::AllocGuard::enabled) {
+        LOG_SLOW_INFO("Hot-phase allocations=%llu bytes=%llu",
+                      static_cast<unsigned long long>(util::AllocGuard::total_hot_allocations()),
+                      static_cast<unsigned long long>(util::AllocGuard::total_hot_bytes()));
+    }
 
+    core::uninstall_flight_dump_handlers();
+    for (core::FlightRecorder* rec : flight_recorders) {
+        core::unregister_flight_recorder(rec);
+    }
     util::shutdown_hot_logger();
 
     return 0;
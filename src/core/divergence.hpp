@@ -29,66 +29,84 @@ struct Divergence {
     std::uint64_t dropcopy_ts{0};
     std::uint64_t detect_tsc{0};      // TSC when divergence was detected (FX-7053)
     std::uint8_t mismatch_mask{0};    // MismatchMask bits at detection time (FX-7053)
+
+    // Prime-broker view and per-pair breakdown (three-way recon). pair_mismatch is
+    // indexed like SIDE_PAIRS; all zero when the PB side does not participate.
+    OrdStatus prime_broker_status{OrdStatus::Unknown};
+    std::uint8_t pair_mismatch[SIDE_PAIR_COUNT]{};
+    std::int64_t prime_broker_cum_qty{0};
+    std::int64_t prime_broker_avg_px{0};
+    std::uint64_t prime_broker_ts{0};
 };
 
 inline void fill_divergence_snapshot(const OrderState& state,
                                      DivergenceType type,
                                      Divergence& out) noexcept {
+    constexpr std::size_t P = SideIndex::PRIMARY;
+    constexpr std::size_t D = SideIndex::DROPCOPY;
+    constexpr std::size_t B = SideIndex::PRIME_BROKER;
     out.key = state.key;
     out.type = type;
-    out.internal_status = state.internal_status;
-    out.dropcopy_status = state.dropcopy_status;
-    out.internal_cum_qty = state.internal_cum_qty;
-    out.dropcopy_cum_qty = state.dropcopy_cum_qty;
-    out.internal_avg_px = state.internal_avg_px;
-    out.dropcopy_avg_px = state.dropcopy_avg_px;
-    out.internal_ts = state.last_internal_ts;
-    out.dropcopy_ts = state.last_dropcopy_ts;
+    out.internal_status = state.status[P];
+    out.dropcopy_status = state.status[D];
+    out.internal_cum_qty = state.cum_qty[P];
+    out.dropcopy_cum_qty = state.cum_qty[D];
+    out.internal_avg_px = state.avg_px[P];
+    out.dropcopy_avg_px = state.avg_px[D];
+    out.internal_ts = state.last_ts[P];
+    out.dropcopy_ts = state.last_ts[D];
+    out.prime_broker_status = state.status[B];
+    out.prime_broker_cum_qty = state.cum_qty[B];
+    out.prime_broker_avg_px = state.avg_px[B];
+    out.prime_broker_ts = state.last_ts[B];
 }
 
+// Classifies one external side (drop copy or prime broker) against the internal view.
 // Priority order: PhantomOrder > MissingFill > StateMismatch > QuantityMismatch > TimingAnomaly.
-inline bool classify_divergence(const OrderState& state,
-                                Divergence& out,
-                                std::int64_t qty_tolerance = 0,
-                                std::int64_t px_tolerance = 0,
-                                std::uint64_t timing_slack = 0) noexcept {
+inline bool classify_side_divergence(const OrderState& state,
+                                     std::size_t side,
+                                     Divergence& out,
+                                     std::int64_t qty_tolerance = 0,
+                                     std::int64_t px_tolerance = 0,
+                                     std::uint64_t timing_slack = 0) noexcept {
     using OS = OrdStatus;
+    constexpr std::size_t P = SideIndex::PRIMARY;
 
-    if (!state.seen_dropcopy) {
+    if (!state.seen[side]) {
         return false;
     }
 
-    if (!state.seen_internal) {
+    if (!state.seen[P]) {
         fill_divergence_snapshot(state, DivergenceType::PhantomOrder, out);
         return true;
     }
 
-    const bool dropcopy_is_fill = state.dropcopy_status == OS::Filled ||
-                                  state.dropcopy_status == OS::PartiallyFilled;
-    const bool internal_pre_filled = state.internal_status == OS::New ||
-                                     state.internal_status == OS::PendingNew ||
-                                     state.internal_status == OS::Working;
+    const bool external_is_fill = state.status[side] == OS::Filled ||
+                                  state.status[side] == OS::PartiallyFilled;
+    const bool internal_pre_filled = state.status[P] == OS::New ||
+                                     state.status[P] == OS::PendingNew ||
+                                     state.status[P] == OS::Working;
 
-    if (dropcopy_is_fill && internal_pre_filled) {
+    if (external_is_fill && internal_pre_filled) {
         fill_divergence_snapshot(state, DivergenceType::MissingFill, out);
         return true;
     }
 
-    if (state.dropcopy_status != state.internal_status) {
+    if (state.status[side] != state.status[P]) {
         fill_divergence_snapshot(state, DivergenceType::StateMismatch, out);
         return true;
     }
 
     // Use safe_abs_diff to avoid signed integer overflow and UB from std::llabs(LLONG_MIN)
-    const auto qty_diff = safe_abs_diff(state.dropcopy_cum_qty, state.internal_cum_qty);
-    const auto px_diff = safe_abs_diff(state.dropcopy_avg_px, state.internal_avg_px);
+    const auto qty_diff = safe_abs_diff(state.cum_qty[side], state.cum_qty[P]);
+    const auto px_diff = safe_abs_diff(state.avg_px[side], state.avg_px[P]);
     if (qty_diff > static_cast<std::uint64_t>(qty_tolerance) || 
         px_diff > static_cast<std::uint64_t>(px_tolerance)) {
         fill_divergence_snapshot(state, DivergenceType::QuantityMismatch, out);
         return true;
     }
 
-    if (state.last_dropcopy_ts + timing_slack < state.last_internal_ts) {
+    if (state.last_ts[side] + timing_slack < state.last_ts[P]) {
         fill_divergence_snapshot(state, DivergenceType::TimingAnomaly, out);
         return true;
     }
@@ -96,5 +114,16 @@ inline bool classify_divergence(const OrderState& state,
     return false;
 }
 
+// Legacy (immediate) classification: the drop copy, then the prime broker, each
+// against the internal view. Returns the first divergence found.
+inline bool classify_divergence(const OrderState& state,
+                                Divergence& out,
+                                std::int64_t qty_tolerance = 0,
+                                std::int64_t px_tolerance = 0,
+                                std::uint64_t timing_slack = 0) noexcept {
+    return classify_side_divergence(state, SideIndex::DROPCOPY, out, qty_tolerance, px_tolerance, timing_slack) ||
+           classify_side_divergence(state, SideIndex::PRIME_BROKER, out, qty_tolerance, px_tolerance, timing_slack);
+}
+
 } // namespace core
 
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/divergence.hpp"
+#include "core/recon_state.hpp"
+#include "ingest/spsc_ring.hpp"
+
+namespace core {
+
+// Severity class of a divergence; lower value drains first.
+enum class DivergencePriority : std::uint8_t {
+    Critical = 0,  // Order or fill one side never saw: phantom order, missing fill, missing drop copy
+    High = 1,      // Sides disagree on status or filled quantity
+    Low = 2        // Price / exec-id drift and timing anomalies
+};
+
+inline constexpr std::size_t DIVERGENCE_PRIORITY_COUNT = 3;
+
+[[nodiscard]] constexpr const char* to_string(DivergencePriority p) noexcept {
+    switch (p) {
+        case DivergencePriority::Critical: return "critical";
+        case DivergencePriority::High:     return "high";
+        case DivergencePriority::Low:      return "low";
+        default:                           return "unknown";
+    }
+}
+
+// Lane for a divergence, from its type and the mismatch bits captured at detection.
+// classify_divergence_type folds AVG_PX / EXEC_ID mismatches into StateMismatch, so
+// the bits decide: a StateMismatch with only those bits ranks Low. Legacy (immediate)
+// emissions carry no mask and rank by type alone.
+[[nodiscard]] constexpr DivergencePriority divergence_priority(const Divergence& div) noexcept {
+    switch (div.type) {
+        case DivergenceType::PhantomOrder:
+        case DivergenceType::MissingFill:
+        case DivergenceType::MissingDropCopy:
+            return DivergencePriority::Critical;
+        default:
+            break;
+    }
+    const MismatchMask mask{div.mismatch_mask};
+    if (mask.has(MismatchMask::EXISTENCE)) {
+        return DivergencePriority::Critical;
+    }
+    if (mask.has(MismatchMask::STATUS) || mask.has(MismatchMask::CUM_QTY)) {
+        return DivergencePriority::High;
+    }
+    if (mask.any()) {
+        return DivergencePriority::Low;  // Only price / exec-id / leaves bits differ
+    }
+    // Legacy path: no mask, rank by type
+    return div.type == DivergenceType::TimingAnomaly ? DivergencePriority::Low : DivergencePriority::High;
+}
+
+// Divergence output split into one SPSC ring per DivergencePriority, so a flood of
+// low-severity divergences cannot crowd out a phantom-order alert: each lane fills
+// (and drops) on its own, and try_pop drains in strict priority order.
+//
+// Same producer/consumer contract as SpscRing: one reconciler thread pushes, one
+// consumer pops. Drop counters are written by the producer and may be read from any
+// thread. The lanes hold 56K divergences in total.
+class DivergenceLanes {
+public:
+    static constexpr std::size_t CRITICAL_CAPACITY = 1u << 13;
+    static constexpr std::size_t HIGH_CAPACITY = 1u << 14;
+    static constexpr std::size_t LOW_CAPACITY = 1u << 15;
+
+    // Routes div to its lane. Returns false (and counts a drop on that lane) if the
+    // lane is full.
+    bool try_push(const Divergence& div) noexcept {
+        const DivergencePriority p = divergence_priority(div);
+        bool pushed = false;
+        switch (p) {
+            case DivergencePriority::Critical: pushed = critical_.try_push(div); break;
+            case DivergencePriority::High:     pushed = high_.try_push(div); break;
+            case DivergencePriority::Low:      pushed = low_.try_push(div); break;
+        }
+        if (!pushed) {
+            auto& drops = drops_[static_cast<std::size_t>(p)];
+            drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        return pushed;
+    }
+
+    // Pops the oldest divergence of the highest-priority non-empty lane.
+    bool try_pop(Divergence& out) noexcept {
+        return critical_.try_pop(out) || high_.try_pop(out) || low_.try_pop(out);
+    }
+
+    [[nodiscard]] std::size_t size_approx() const noexcept {
+        return critical_.size_approx() + high_.size_approx() + low_.size_approx();
+    }
+
+    [[nodiscard]] std::size_t lane_size_approx(DivergencePriority p) const noexcept {
+        switch (p) {
+            case DivergencePriority::Critical: return critical_.size_approx();
+            case DivergencePriority::High:     return high_.size_approx();
+            case DivergencePriority::Low:      return low_.size_approx();
+        }
+        return 0;
+    }
+
+    [[nodiscard]] static constexpr std::size_t lane_capacity(DivergencePriority p) noexcept {
+        switch (p) {
+            case DivergencePriority::Critical: return CRITICAL_CAPACITY;
+            case DivergencePriority::High:     return HIGH_CAPACITY;
+            case DivergencePriority::Low:      return LOW_CAPACITY;
+        }
+        return 0;
+    }
+
+    // Divergences dropped because lane p was full
+    [[nodiscard]] std::uint64_t drops(DivergencePriority p) const noexcept {
+        return drops_[static_cast<std::size_t>(p)].load(std::memory_order_relaxed);
+    }
+
+private:
+    ingest::SpscRing<Divergence, CRITICAL_CAPACITY> critical_;
+    ingest::SpscRing<Divergence, HIGH_CAPACITY> high_;
+    ingest::SpscRing<Divergence, LOW_CAPACITY> low_;
+    std::atomic<std::uint64_t> drops_[DIVERGENCE_PRIORITY_COUNT]{};
+};
+
+} // namespace core
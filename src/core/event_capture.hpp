@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/exec_event.hpp"
+#include "core/wire_exec_event.hpp"
+#include "util/tsc_calibration.hpp"
+
+namespace core {
+
+// On-disk capture of a merged execution event stream, as seen by the reconciler:
+//
+//   CaptureFileHeader
+//   CaptureRecord[record_count]   (in reconciler arrival order)
+//
+// Timestamps are stored in nanoseconds so a capture can be replayed on a host with
+// a different TSC frequency; load_capture converts them back to TSC cycles.
+// Layout is native-endian and packed, like WireExecEvent.
+#pragma pack(push, 1)
+struct CaptureFileHeader {
+    static constexpr char MAGIC[8] = {'F', 'X', 'R', 'C', 'A', 'P', '1', '\0'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    char magic[8]{};
+    std::uint32_t version{0};
+    std::uint32_t record_size{0};   // sizeof(CaptureRecord) at write time
+    std::uint64_t record_count{0};
+};
+
+struct CaptureRecord {
+    std::uint64_t ingest_ns{0};     // Arrival time at the reconciler
+    std::uint8_t source{0};         // core::Source
+    WireExecEvent wire{};
+};
+#pragma pack(pop)
+
+static_assert(std::is_trivially_copyable_v<CaptureFileHeader>, "CaptureFileHeader must be trivial");
+static_assert(std::is_trivially_copyable_v<CaptureRecord>, "CaptureRecord must be trivial");
+
+[[nodiscard]] inline WireExecEvent to_wire(const ExecEvent& evt) noexcept {
+    WireExecEvent w{};
+    w.exec_type = static_cast<std::uint8_t>(evt.exec_type);
+    w.ord_status = static_cast<std::uint8_t>(evt.ord_status);
+    w.seq_num = evt.seq_num;
+    w.session_id = evt.session_id;
+    w.price_micro = evt.price_micro;
+    w.qty = evt.qty;
+    w.cum_qty = evt.cum_qty;
+    w.sending_time = evt.sending_time;
+    w.transact_time = evt.transact_time;
+
+    const auto copy_id = [](char* dst, std::uint8_t& dst_len, const char* src, std::size_t len) {
+        const std::size_t l = len > WireExecEvent::id_capacity ? WireExecEvent::id_capacity : len;
+        std::memcpy(dst, src, l);
+        dst_len = static_cast<std::uint8_t>(l);
+    };
+    copy_id(w.exec_id, w.exec_id_len, evt.exec_id, evt.exec_id_len);
+    copy_id(w.order_id, w.order_id_len, evt.order_id, evt.order_id_len);
+    copy_id(w.clord_id, w.clord_id_len, evt.clord_id, evt.clord_id_len);
+    return w;
+}
+
+// Writes events (ingest_tsc converted to ns) as a capture file.
+// Returns false and fills error on I/O failure.
+inline bool write_capture(const char* path, std::span<const ExecEvent> events, std::string& error) {
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        error = std::string("cannot open ") + path + " for writing";
+        return false;
+    }
+
+    CaptureFileHeader header{};
+    std::memcpy(header.magic, CaptureFileHeader::MAGIC, sizeof(header.magic));
+    header.version = CaptureFileHeader::VERSION;
+    header.record_size = sizeof(CaptureRecord);
+    header.record_count = events.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+
+    for (std::size_t i = 0; ok && i < events.size(); ++i) {
+        CaptureRecord rec{};
+        rec.ingest_ns = util::tsc_to_ns(events[i].ingest_tsc);
+        rec.source = static_cast<std::uint8_t>(events[i].source);
+        rec.wire = to_wire(events[i]);
+        ok = std::fwrite(&rec, sizeof(rec), 1, f) == 1;
+    }
+
+    if (std::fclose(f) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        error = std::string("short write to ") + path;
+    }
+    return ok;
+}
+
+// Loads the raw records of a capture (timestamps stay in ns), e.g. for replay.
+// Returns false and fills error if the file is missing, truncated or not a capture.
+inline bool load_capture_records(const char* path, std::vector<CaptureRecord>& out, std::string& error) {
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    CaptureFileHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, f) == 1;
+    if (!ok || std::memcmp(header.magic, CaptureFileHeader::MAGIC, sizeof(header.magic)) != 0) {
+        error = std::string(path) + " is not an event capture";
+        ok = false;
+    } else if (header.version != CaptureFileHeader::VERSION || header.record_size != sizeof(CaptureRecord)) {
+        error = std::string(path) + ": unsupported capture version or record size";
+        ok = false;
+    }
+
+    if (ok) {
+        out.clear();
+        out.reserve(static_cast<std::size_t>(header.record_count));
+        CaptureRecord rec{};
+        for (std::uint64_t i = 0; i < header.record_count; ++i) {
+            if (std::fread(&rec, sizeof(rec), 1, f) != 1) {
+                error = std::string(path) + ": truncated after " + std::to_string(i) + " records";
+                ok = false;
+                break;
+            }
+            if (rec.source >= SOURCE_COUNT) {
+                error = std::string(path) + ": bad source in record " + std::to_string(i);
+                ok = false;
+                break;
+            }
+            out.push_back(rec);
+        }
+    }
+
+    std::fclose(f);
+    return ok;
+}
+
+// Loads a whole capture as ExecEvents (ingest_ns converted to TSC cycles).
+// Returns false and fills error if the file is missing, truncated or not a capture.
+inline bool load_capture(const char* path, std::vector<ExecEvent>& out, std::string& error) {
+    std::vector<CaptureRecord> records;
+    if (!load_capture_records(path, records, error)) {
+        return false;
+    }
+    out.clear();
+    out.reserve(records.size());
+    for (const CaptureRecord& rec : records) {
+        out.push_back(from_wire(rec.wire, static_cast<Source>(rec.source), util::ns_to_tsc(rec.ingest_ns)));
+    }
+    return true;
+}
+
+} // namespace core
@@ -10,7 +10,31 @@
 
 namespace core {
 
-enum class Source : uint8_t { Primary = 0, DropCopy = 1 };
+// Feeds reconciled against each other. The value doubles as the index of the
+// source's slot in per-side arrays (OrderState, trackers, rings).
+enum class Source : uint8_t { Primary = 0, DropCopy = 1, PrimeBroker = 2 };
+inline constexpr std::size_t SOURCE_COUNT = 3;
+
+[[nodiscard]] constexpr std::size_t source_index(Source s) noexcept { return static_cast<std::size_t>(s); }
+[[nodiscard]] constexpr std::uint8_t source_bit(Source s) noexcept {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(s));
+}
+
+[[nodiscard]] constexpr const char* source_name(Source s) noexcept {
+    switch (s) {
+    case Source::Primary:
+        return "Primary";
+    case Source::DropCopy:
+        return "DropCopy";
+    case Source::PrimeBroker:
+        return "PrimeBroker";
+    }
+    return "Unknown";
+}
+
+// Sides that must report on every order unless configured otherwise (two-way recon)
+inline constexpr std::uint8_t DEFAULT_REQUIRED_SIDES = source_bit(Source::Primary) | source_bit(Source::DropCopy);
+
 enum class ExecType : uint8_t { New, PartialFill, Fill, Cancel, Replace, Rejected, Unknown };
 enum class OrdStatus : uint8_t {
     New = 0,
@@ -25,6 +49,26 @@ enum class OrdStatus : uint8_t {
     CancelPending = 9
 };
 
+// Range check for the enums a decoder copies straight off the wire
+[[nodiscard]] constexpr bool is_valid_exec_enums(Source src, ExecType type, OrdStatus status) noexcept {
+    return static_cast<std::uint8_t>(src) < SOURCE_COUNT &&
+           static_cast<std::uint8_t>(type) <= static_cast<std::uint8_t>(ExecType::Unknown) &&
+           static_cast<std::uint8_t>(status) <= static_cast<std::uint8_t>(OrdStatus::CancelPending);
+}
+
+// ExecEvent::ingest_flags bits, set by the ingest stage (IngestAnnotator) before the
+// event is pushed to the reconciler. Events without ORDER_KEYED / SEQ_TRACKED (tests,
+// replay, overflowing session tables) are keyed and sequence-tracked by the reconciler.
+namespace IngestFlags {
+    constexpr std::uint8_t ORDER_KEYED      = 1u << 0;  // order_key holds make_order_key(event)
+    constexpr std::uint8_t SEQ_TRACKED      = 1u << 1;  // Sequence checked per (source, session)
+    constexpr std::uint8_t SEQ_GAP          = 1u << 2;  // Jumped past seq_expected
+    constexpr std::uint8_t SEQ_DUPLICATE    = 1u << 3;  // Repeat of the last sequence
+    constexpr std::uint8_t SEQ_OUT_OF_ORDER = 1u << 4;  // Older than seq_expected
+    constexpr std::uint8_t SEQ_GAP_FILL     = 1u << 5;  // Older, inside the open gap (closed it)
+    constexpr std::uint8_t SEQ_ANOMALY = SEQ_GAP | SEQ_DUPLICATE | SEQ_OUT_OF_ORDER | SEQ_GAP_FILL;
+}
+
 struct ExecEvent {
     Source source{};
     ExecType exec_type{ExecType::Unknown};
@@ -38,6 +82,12 @@ struct ExecEvent {
     uint64_t transact_time{0};
     uint64_t ingest_tsc{0};
 
+    // Ingest-stage annotation (IngestFlags); zero when the event was not annotated
+    std::uint64_t order_key{0};
+    std::uint64_t seq_expected{0};  // Session's expected sequence, when a SEQ_ANOMALY bit is set
+    std::uint8_t ingest_flags{0};
+    std::uint8_t partition{0};  // Store partition (desk / account group) of the session
+
     static constexpr std::size_t id_capacity = 32;
     char exec_id[id_capacity]{};
     std::size_t exec_id_len{0};
@@ -0,0 +1,154 @@
+#include "core/flight_recorder.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "util/async_log.hpp"
+#include "util/rdtsc.hpp"
+#include "util/sigsafe_writer.hpp"
+
+namespace core {
+namespace {
+
+std::atomic<FlightRecorder*> g_recorders[MAX_FLIGHT_RECORDERS]{};
+
+// Handler state; written by install/uninstall only, before and after the handlers run
+constexpr int DUMP_SIGNALS[] = {SIGUSR2, SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+char g_dump_path[256]{};
+const util::AsyncLogger* g_dump_logger = nullptr;
+struct sigaction g_previous[std::size(DUMP_SIGNALS)]{};
+bool g_installed = false;
+std::atomic<bool> g_dumping{false};  // A dump is in progress (nested signal skips its own)
+
+void write_record(util::SigsafeWriter& out, const FlightRecord& r) noexcept {
+    out.str("tsc=").u64(r.tsc).ch(' ').str(flight_kind_name(r.kind));
+    switch (r.kind) {
+    case FlightKind::Event:
+    case FlightKind::IngestDrop:
+        out.str(" src=").u64(r.a).str(" exec_type=").u64(r.b).str(" status=").u64(r.c);
+        out.str(" session=").u64(r.d).str(" seq=").u64(r.x).str(" key=").hex(r.y);
+        break;
+    case FlightKind::Transition:
+        out.str(" from=").u64(r.a).str(" to=").u64(r.b).str(" mismatch=").u64(r.c).str(" key=").hex(r.x);
+        break;
+    case FlightKind::TimerFire:
+        out.str(" handle=").u64(r.x).str(" gen=").u64(r.d);
+        break;
+    case FlightKind::RingDepths:
+        out.str(" primary=").u64(r.x >> 32).str(" dropcopy=").u64(r.x & 0xFFFF'FFFFu);
+        out.str(" prime_broker=").u64(r.y >> 32).str(" divergence=").u64(r.y & 0xFFFF'FFFFu);
+        out.str(" pending_timers=").u64(r.d);
+        break;
+    }
+    out.ch('\n');
+}
+
+void on_dump_signal(int sig) {
+    const int saved_errno = errno;
+    if (!g_dumping.exchange(true, std::memory_order_acquire)) {
+        const int fd = ::open(g_dump_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            {
+                util::SigsafeWriter out(fd);
+                out.str("# flight recorder dump signal=").u64(static_cast<std::uint64_t>(sig));
+                out.str(" tsc=").u64(util::rdtsc()).ch('\n');
+            }
+            dump_flight_recorders(fd, g_dump_logger);
+            ::close(fd);
+        }
+        g_dumping.store(false, std::memory_order_release);
+    }
+    if (sig != SIGUSR2) {
+        // Fatal: hand the signal to whatever was installed before us (default: terminate).
+        // It stays blocked until this handler returns, then is delivered again.
+        for (std::size_t i = 0; i < std::size(DUMP_SIGNALS); ++i) {
+            if (DUMP_SIGNALS[i] == sig) {
+                ::sigaction(sig, &g_previous[i], nullptr);
+            }
+        }
+        ::raise(sig);
+    }
+    errno = saved_errno;
+}
+
+} // namespace
+
+bool register_flight_recorder(FlightRecorder* rec) noexcept {
+    for (std::atomic<FlightRecorder*>& slot : g_recorders) {
+        FlightRecorder* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, rec, std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void unregister_flight_recorder(FlightRecorder* rec) noexcept {
+    for (std::atomic<FlightRecorder*>& slot : g_recorders) {
+        FlightRecorder* expected = rec;
+        (void)slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    }
+}
+
+void dump_flight_recorders(int fd, const util::AsyncLogger* logger) noexcept {
+    for (const std::atomic<FlightRecorder*>& slot : g_recorders) {
+        const FlightRecorder* rec = slot.load(std::memory_order_acquire);
+        if (!rec) {
+            continue;
+        }
+        util::SigsafeWriter out(fd);
+        out.str("## recorder=").str(rec->name()).str(" recorded=").u64(rec->recorded());
+        out.str(" capacity=").u64(rec->capacity()).ch('\n');
+        rec->for_each([&out](const FlightRecord& r) { write_record(out, r); });
+    }
+    if (logger) {
+        {
+            util::SigsafeWriter out(fd);
+            out.str("## logger pending records (dropped=").u64(logger->dropped()).str(")\n");
+        }
+        (void)logger->dump_pending(fd);
+    }
+}
+
+bool install_flight_dump_handlers(const char* path, const util::AsyncLogger* logger) noexcept {
+    const std::size_t len = path ? std::strlen(path) : 0;
+    if (len == 0 || len >= sizeof(g_dump_path)) {
+        return false;
+    }
+    uninstall_flight_dump_handlers();
+    std::memcpy(g_dump_path, path, len + 1);
+    g_dump_logger = logger;
+
+    struct sigaction action{};
+    action.sa_handler = on_dump_signal;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i < std::size(DUMP_SIGNALS); ++i) {
+        // SIGUSR2 must not break blocking calls of the thread it lands on
+        action.sa_flags = DUMP_SIGNALS[i] == SIGUSR2 ? SA_RESTART : 0;
+        if (::sigaction(DUMP_SIGNALS[i], &action, &g_previous[i]) != 0) {
+            for (std::size_t j = 0; j < i; ++j) {
+                ::sigaction(DUMP_SIGNALS[j], &g_previous[j], nullptr);
+            }
+            return false;
+        }
+    }
+    g_installed = true;
+    return true;
+}
+
+void uninstall_flight_dump_handlers() noexcept {
+    if (!g_installed) {
+        return;
+    }
+    for (std::size_t i = 0; i < std::size(DUMP_SIGNALS); ++i) {
+        ::sigaction(DUMP_SIGNALS[i], &g_previous[i], nullptr);
+    }
+    g_installed = false;
+}
+
+} // namespace core
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "core/exec_event.hpp"
+
+namespace util {
+class AsyncLogger;
+}
+
+namespace core {
+
+enum class FlightKind : std::uint8_t {
+    Event = 1,       // Event taken by this thread
+    IngestDrop = 2,  // Event refused by a full ingest ring
+    Transition = 3,  // ReconState change of an order
+    TimerFire = 4,   // Grace / gap-recheck deadline popped
+    RingDepths = 5,  // Queue depths, sampled on the housekeeping cadence
+};
+
+[[nodiscard]] constexpr const char* flight_kind_name(FlightKind kind) noexcept {
+    switch (kind) {
+    case FlightKind::Event:
+        return "event";
+    case FlightKind::IngestDrop:
+        return "ingest_drop";
+    case FlightKind::Transition:
+        return "transition";
+    case FlightKind::TimerFire:
+        return "timer_fire";
+    case FlightKind::RingDepths:
+        return "ring_depths";
+    }
+    return "unknown";
+}
+
+// One flight record. Field meaning by kind:
+//   Event, IngestDrop: a=source b=exec_type c=ord_status d=session_id x=seq_num y=order key
+//   Transition:        a=from b=to c=mismatch bits x=order key
+//   TimerFire:         d=generation x=pool handle
+//   RingDepths:        d=pending timers x=primary<<32|dropcopy y=prime_broker<<32|divergence
+struct FlightRecord {
+    std::uint64_t tsc{0};
+    FlightKind kind{};
+    std::uint8_t a{0};
+    std::uint8_t b{0};
+    std::uint8_t c{0};
+    std::uint32_t d{0};
+    std::uint64_t x{0};
+    std::uint64_t y{0};
+};
+
+static_assert(std::is_trivially_copyable_v<FlightRecord>, "FlightRecord must be trivially copyable");
+static_assert(sizeof(FlightRecord) == 32, "FlightRecord should stay at 32 bytes");
+
+// FlightRecorder keeps the last capacity() records of one hot thread in a ring
+// that is always overwritten, never drained: recording is a 32-byte store and a
+// release store of the head, so it stays on in production. The ring is read only
+// by dump_flight_recorders, normally from a crash / SIGUSR2 handler.
+//
+// A dump may race the owning thread: the newest record can be half-written and,
+// with the ring full, the oldest may be overwritten while read. The dump skips
+// the oldest slot and tolerates a torn newest one.
+//
+// Thread safety: single writer (the owning thread); any thread or signal handler
+// may dump.
+//
+// Memory: The ring is allocated and touched at construction. No heap allocations
+// afterwards.
+class FlightRecorder {
+public:
+    static constexpr std::size_t NAME_LEN = 16;
+
+    // capacity is rounded up to a power of two. Throws std::invalid_argument if 0.
+    FlightRecorder(const char* name, std::size_t capacity)
+        : capacity_(capacity == 0 ? 0 : std::bit_ceil(capacity)) {
+        if (capacity_ == 0) {
+            throw std::invalid_argument("FlightRecorder capacity must be > 0");
+        }
+        records_ = std::make_unique<FlightRecord[]>(capacity_);
+        for (std::size_t i = 0; name && name[i] != '\0' && i + 1 < NAME_LEN; ++i) {
+            name_[i] = name[i];
+        }
+    }
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    void record(const FlightRecord& rec) noexcept {
+        const std::uint64_t pos = head_.load(std::memory_order_relaxed);
+        records_[pos & (capacity_ - 1)] = rec;
+        head_.store(pos + 1, std::memory_order_release);
+    }
+
+    void record_event(FlightKind kind, const ExecEvent& ev, std::uint64_t key) noexcept {
+        FlightRecord rec{};
+        rec.tsc = ev.ingest_tsc;
+        rec.kind = kind;
+        rec.a = static_cast<std::uint8_t>(ev.source);
+        rec.b = static_cast<std::uint8_t>(ev.exec_type);
+        rec.c = static_cast<std::uint8_t>(ev.ord_status);
+        rec.d = ev.session_id;
+        rec.x = ev.seq_num;
+        rec.y = key;
+        record(rec);
+    }
+
+    // Records ever written (the ring holds the last capacity() of them)
+    [[nodiscard]] std::uint64_t recorded() const noexcept { return head_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] const char* name() const noexcept { return name_; }
+
+    // Calls fn(const FlightRecord&) for the retained records, oldest first
+    // (skipping the slot the writer overwrites next). Async-signal-safe if fn is.
+    template <typename F>
+    void for_each(F&& fn) const noexcept {
+        const std::uint64_t head = recorded();
+        const std::uint64_t begin = head >= capacity_ ? head - capacity_ + 1 : 0;
+        for (std::uint64_t pos = begin; pos < head; ++pos) {
+            fn(records_[pos & (capacity_ - 1)]);
+        }
+    }
+
+private:
+    std::size_t capacity_;
+    std::unique_ptr<FlightRecord[]> records_;
+    std::atomic<std::uint64_t> head_{0};
+    char name_[NAME_LEN]{};
+};
+
+// Recorders dumped on a crash: a fixed table, so the handler walks it without
+// locks. Returns false if the table (MAX_FLIGHT_RECORDERS) is full. Recorders must
+// be unregistered before they are destroyed.
+inline constexpr std::size_t MAX_FLIGHT_RECORDERS = 16;
+bool register_flight_recorder(FlightRecorder* rec) noexcept;
+void unregister_flight_recorder(FlightRecorder* rec) noexcept;
+
+// Writes every registered recorder, then the hot logger records not yet consumed
+// (if logger is non-null), to fd as text. Async-signal-safe.
+void dump_flight_recorders(int fd, const util::AsyncLogger* logger) noexcept;
+
+// Installs handlers that dump to path (truncated on each dump): SIGUSR2 dumps and
+// continues; SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT dump, restore the previous
+// handler and re-raise. Returns false if path is too long or sigaction fails.
+bool install_flight_dump_handlers(const char* path, const util::AsyncLogger* logger) noexcept;
+// Restores the handlers replaced by install_flight_dump_handlers
+void uninstall_flight_dump_handlers() noexcept;
+
+} // namespace core
@@ -19,11 +19,14 @@ namespace core {
 
 // Helper to get the flag bit for a given source (reduces code duplication)
 [[nodiscard]] constexpr std::uint8_t get_gap_flag_for_source(Source source) noexcept {
-    return (source == Source::Primary)
-        ? GapUncertaintyFlags::PRIMARY
-        : GapUncertaintyFlags::DROPCOPY;
+    return source_bit(source);
 }
 
+static_assert(get_gap_flag_for_source(Source::Primary) == GapUncertaintyFlags::PRIMARY &&
+                  get_gap_flag_for_source(Source::DropCopy) == GapUncertaintyFlags::DROPCOPY &&
+                  get_gap_flag_for_source(Source::PrimeBroker) == GapUncertaintyFlags::PRIME_BROKER,
+              "Gap flag bits must follow source order");
+
 // Mark order as affected by a gap on the given source.
 // Increments the tracker's orders_in_gap_count if newly marked.
 // No-op if tracker's gap is not open.
@@ -32,7 +35,7 @@ namespace core {
 // Only takes effect when tracker.gap_open == true.
 // 
 // @param os The order state to mark
-// @param source The source (Primary or DropCopy) that has the gap
+// @param source The source (Primary, DropCopy or PrimeBroker) that has the gap
 // @param tracker The sequence tracker for the source (must have gap_open == true for effect)
 inline void mark_gap_uncertainty(
     OrderState& os,
@@ -71,7 +74,7 @@ inline void mark_gap_uncertainty(
 // edge cases like clearing flags after close_gap() has reset the counter.
 //
 // @param os The order state to clear
-// @param source The source (Primary or DropCopy) to clear
+// @param source The source (Primary, DropCopy or PrimeBroker) to clear
 // @param tracker Optional tracker to decrement count. If nullptr, only clears the flag.
 // @return true if the flag was previously set and cleared, false if it was already clear
 [[nodiscard]] inline bool clear_gap_uncertainty(
@@ -104,7 +107,7 @@ inline void mark_gap_uncertainty(
 // Always decrements the tracker's count if the flag was set.
 //
 // @param os The order state to clear
-// @param source The source (Primary or DropCopy) to clear
+// @param source The source (Primary, DropCopy or PrimeBroker) to clear
 // @param tracker The tracker to decrement count
 // @return true if the flag was previously set and cleared, false if it was already clear
 [[nodiscard]] inline bool clear_gap_uncertainty(
@@ -128,7 +131,7 @@ inline void mark_gap_uncertainty(
 // This is an O(1) check suitable for hot-path use.
 //
 // @param os The order state to check
-// @param source The source (Primary or DropCopy) to check
+// @param source The source (Primary, DropCopy or PrimeBroker) to check
 // @param tracker The sequence tracker for the source
 // @return true if this order should have divergence suppressed due to an open gap
 [[nodiscard]] inline bool is_suppressed_by_gap(
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/exec_event.hpp"
+#include "core/order_state.hpp"
+#include "core/sequence_tracker.hpp"
+
+namespace core {
+
+// Ingest-stage pre-processing for one source, run on its subscriber thread before
+// the event is pushed to the reconciler ring: rejects events whose enums are out of
+// range, computes the order key and checks the sequence number per session,
+// recording the outcome in ExecEvent::ingest_flags / seq_expected. The reconciler
+// then only folds the flags into its gap state instead of re-deriving them. It also
+// tags the event with its session's store partition (set_session_partition; 0 if
+// unassigned).
+//
+// Sessions are tracked in a small fixed table; events of sessions beyond
+// MAX_SESSIONS are keyed but left without SEQ_TRACKED (the reconciler tracks them).
+//
+// Thread safety: None. One annotator per ingest thread.
+class IngestAnnotator {
+public:
+    static constexpr std::size_t MAX_SESSIONS = 64;
+
+    // Charges orders of session_id to store partition. Returns false if the session
+    // table is full.
+    bool set_session_partition(std::uint16_t session_id, std::uint8_t partition) noexcept {
+        const std::size_t slot = slot_for(session_id);
+        if (slot == MAX_SESSIONS) {
+            return false;
+        }
+        partitions_[slot] = partition;
+        return true;
+    }
+
+    // Returns false (event untouched past validation) if the event must be dropped.
+    [[nodiscard]] bool annotate(ExecEvent& ev) noexcept {
+        if (!is_valid_exec_enums(ev.source, ev.exec_type, ev.ord_status)) {
+            ++rejected_;
+            return false;
+        }
+        ev.order_key = make_order_key(ev);
+        ev.ingest_flags = IngestFlags::ORDER_KEYED;
+        ev.seq_expected = 0;
+        ev.partition = 0;
+
+        const std::size_t slot = slot_for(ev.session_id);
+        if (slot == MAX_SESSIONS) {
+            return true;
+        }
+        ev.partition = partitions_[slot];
+        ev.ingest_flags |= IngestFlags::SEQ_TRACKED;
+        SequenceGapEvent gap{};
+        if (track_sequence(trackers_[slot], ev.source, ev.session_id, ev.seq_num, ev.ingest_tsc, &gap)) {
+            ev.seq_expected = gap.expected_seq;
+            ev.ingest_flags |= gap_kind_flag(gap.kind);
+        }
+        return true;
+    }
+
+    // Events dropped by annotate()
+    [[nodiscard]] std::uint64_t rejected() const noexcept { return rejected_; }
+    [[nodiscard]] std::size_t session_count() const noexcept { return session_count_; }
+
+    [[nodiscard]] static constexpr std::uint8_t gap_kind_flag(GapKind kind) noexcept {
+        switch (kind) {
+            case GapKind::Gap:        return IngestFlags::SEQ_GAP;
+            case GapKind::Duplicate:  return IngestFlags::SEQ_DUPLICATE;
+            case GapKind::OutOfOrder: return IngestFlags::SEQ_OUT_OF_ORDER;
+            case GapKind::GapFill:    return IngestFlags::SEQ_GAP_FILL;
+        }
+        return 0;
+    }
+
+private:
+    // Table slot of session_id, adding it if new; MAX_SESSIONS if the table is full
+    std::size_t slot_for(std::uint16_t session_id) noexcept {
+        // Sessions per source are few; a linear scan over a hot line beats hashing
+        for (std::size_t i = 0; i < session_count_; ++i) {
+            if (session_ids_[i] == session_id) {
+                return i;
+            }
+        }
+        if (session_count_ == MAX_SESSIONS) {
+            return MAX_SESSIONS;
+        }
+        session_ids_[session_count_] = session_id;
+        return session_count_++;
+    }
+
+    std::uint16_t session_ids_[MAX_SESSIONS]{};
+    std::uint8_t partitions_[MAX_SESSIONS]{};
+    std::size_t session_count_{0};
+    SequenceTracker trackers_[MAX_SESSIONS]{};
+    std::uint64_t rejected_{0};
+};
+
+// Reconciler side: the SequenceGapEvent for an annotated event, or false if its
+// sequence was in order. Only meaningful with IngestFlags::SEQ_TRACKED set.
+[[nodiscard]] inline bool annotated_gap_event(const ExecEvent& ev, std::uint64_t now_ts,
+                                              SequenceGapEvent& out) noexcept {
+    const std::uint8_t f = ev.ingest_flags;
+    if ((f & IngestFlags::SEQ_ANOMALY) == 0) {
+        return false;
+    }
+    out.source = ev.source;
+    out.session_id = ev.session_id;
+    out.expected_seq = ev.seq_expected;
+    out.seen_seq = ev.seq_num;
+    out.detect_ts = now_ts;
+    out.gap_closed_by_fill = (f & IngestFlags::SEQ_GAP_FILL) != 0;
+    if ((f & IngestFlags::SEQ_GAP) != 0) {
+        out.kind = GapKind::Gap;
+    } else if ((f & IngestFlags::SEQ_DUPLICATE) != 0) {
+        out.kind = GapKind::Duplicate;
+    } else if (out.gap_closed_by_fill) {
+        out.kind = GapKind::GapFill;
+    } else {
+        out.kind = GapKind::OutOfOrder;
+    }
+    return true;
+}
+
+// Folds an annotated event into the reconciler's per-source gap state: the same
+// transitions track_sequence makes, driven by the ingest verdict instead of a
+// sequence comparison. A gap opens (new epoch) or extends on SEQ_GAP and closes on
+// SEQ_GAP_FILL; in-order events and gaps advance the expected sequence.
+inline void apply_annotated_sequence(SequenceTracker& trk, const ExecEvent& ev,
+                                     std::uint64_t now_ts) noexcept {
+    const std::uint8_t f = ev.ingest_flags;
+    const std::uint64_t seq = ev.seq_num;
+    if (!trk.initialized) {
+        (void)init_sequence_tracker(trk, seq);
+    }
+    if ((f & IngestFlags::SEQ_GAP) != 0) {
+        if (!trk.gap_open) {
+            trk.gap_open = true;
+            trk.gap_start_seq = ev.seq_expected;
+            trk.gap_opened_tsc = now_ts;
+            trk.orders_in_gap_count = 0;
+            ++trk.gap_epoch;
+            if (trk.gap_epoch == 0) {
+                trk.gap_epoch = 1;  // 0 is the "not flagged" sentinel
+            }
+        }
+        trk.gap_last_missing_seq = seq - 1;
+        trk.gap_end_seq = seq;
+        trk.gap_detected_tsc = now_ts;
+    } else if ((f & IngestFlags::SEQ_GAP_FILL) != 0) {
+        (void)close_gap(trk);
+        return;
+    } else if ((f & IngestFlags::SEQ_ANOMALY) != 0) {
+        return;  // Duplicate / out of order: nothing advances
+    }
+    trk.last_seen_seq = seq;
+    trk.expected_seq = seq + 1;
+}
+
+} // namespace core
@@ -0,0 +1,306 @@
+#include "core/order_soa_mirror.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if FX_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+struct Columns {
+    const std::int64_t* cum_qty;
+    const std::int64_t* avg_px;
+    const std::uint64_t* exec_id_hash;
+    const std::uint8_t* status;
+    const std::uint8_t* seen;
+    std::size_t stride;  // slot_count
+};
+
+// Same decision table as compute_pairwise_mismatch, folded into one mask
+std::uint8_t mismatch_bits_at(const Columns& c, std::size_t slot, std::uint64_t qty_tol, std::uint64_t px_tol,
+                              std::uint8_t required_sides) noexcept {
+    const std::uint8_t seen_bits = c.seen[slot];
+    const auto participating = static_cast<std::uint8_t>(seen_bits | required_sides);
+    std::uint8_t out = 0;
+    for (const SidePair& pair : SIDE_PAIRS) {
+        const auto pair_bits = static_cast<std::uint8_t>((1u << pair.a) | (1u << pair.b));
+        if ((participating & pair_bits) != pair_bits) {
+            continue;
+        }
+        const std::uint8_t pair_seen = seen_bits & pair_bits;
+        if (pair_seen != pair_bits) {
+            out = static_cast<std::uint8_t>(out | (pair_seen != 0 ? MismatchMask::EXISTENCE : 0));
+            continue;
+        }
+        const std::size_t a = pair.a * c.stride + slot;
+        const std::size_t b = pair.b * c.stride + slot;
+        if (c.status[a] != c.status[b]) {
+            out = static_cast<std::uint8_t>(out | MismatchMask::STATUS);
+        }
+        if (safe_abs_diff(c.cum_qty[a], c.cum_qty[b]) > qty_tol) {
+            out = static_cast<std::uint8_t>(out | MismatchMask::CUM_QTY);
+        }
+        if (safe_abs_diff(c.avg_px[a], c.avg_px[b]) > px_tol) {
+            out = static_cast<std::uint8_t>(out | MismatchMask::AVG_PX);
+        }
+        if (c.exec_id_hash[a] != c.exec_id_hash[b]) {
+            out = static_cast<std::uint8_t>(out | MismatchMask::EXEC_ID);
+        }
+    }
+    return out;
+}
+
+void evaluate_scalar(const Columns& c, std::size_t first, std::size_t count, std::uint64_t qty_tol,
+                     std::uint64_t px_tol, std::uint8_t required_sides, MismatchMask* out) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i].v = mismatch_bits_at(c, first + i, qty_tol, px_tol, required_sides);
+    }
+}
+
+#if FX_X86_DISPATCH
+
+// LANE_SPREAD[m] has byte i set to 1 iff bit i of m is set, so a lane mask times a
+// MismatchMask flag gives that flag in each matching output byte
+constexpr std::array<std::uint64_t, 256> make_lane_spread() noexcept {
+    std::array<std::uint64_t, 256> t{};
+    for (std::size_t m = 0; m < t.size(); ++m) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            if ((m >> i) & 1u) {
+                t[m] |= std::uint64_t{1} << (8 * i);
+            }
+        }
+    }
+    return t;
+}
+
+constexpr std::array<std::uint64_t, 256> LANE_SPREAD = make_lane_spread();
+
+constexpr std::size_t AVX2_LANES = 4;
+
+FX_TARGET_AVX2 inline __m256i load_u8x4(const std::uint8_t* p) noexcept {
+    std::int32_t bytes = 0;
+    std::memcpy(&bytes, p, sizeof(bytes));
+    return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+}
+
+FX_TARGET_AVX2 inline __m256i load_64x4(const void* p) noexcept { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+
+FX_TARGET_AVX2 inline unsigned lane_mask(__m256i v) noexcept {
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+}
+
+// safe_abs_diff(a, b) > tol, per lane; tol_biased has the sign bit flipped so the
+// signed compare orders the lanes as unsigned
+FX_TARGET_AVX2 inline __m256i abs_diff_gt(__m256i a, __m256i b, __m256i tol_biased, __m256i sign) noexcept {
+    const __m256i lt = _mm256_cmpgt_epi64(b, a);
+    const __m256i diff = _mm256_sub_epi64(_mm256_xor_si256(_mm256_sub_epi64(a, b), lt), lt);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(diff, sign), tol_biased);
+}
+
+// Evaluates slots [slot, slot + 4) and returns their masks, one per byte
+FX_TARGET_AVX2 std::uint32_t evaluate_block_avx2(const Columns& c, std::size_t slot, __m256i qty_tol, __m256i px_tol,
+                             __m256i required, __m256i sign) noexcept {
+    const __m256i seen = load_u8x4(c.seen + slot);
+    const __m256i participating = _mm256_or_si256(seen, required);
+    std::uint64_t out = 0;
+    for (const SidePair& pair : SIDE_PAIRS) {
+        const __m256i pair_bits = _mm256_set1_epi64x(static_cast<long long>((1u << pair.a) | (1u << pair.b)));
+        const __m256i part = _mm256_cmpeq_epi64(_mm256_and_si256(participating, pair_bits), pair_bits);
+        const __m256i pair_seen = _mm256_and_si256(seen, pair_bits);
+        const __m256i both = _mm256_cmpeq_epi64(pair_seen, pair_bits);
+        const __m256i none = _mm256_cmpeq_epi64(pair_seen, _mm256_setzero_si256());
+        const __m256i existence = _mm256_andnot_si256(_mm256_or_si256(both, none), part);
+
+        const std::size_t a = pair.a * c.stride + slot;
+        const std::size_t b = pair.b * c.stride + slot;
+        const __m256i status = _mm256_andnot_si256(
+            _mm256_cmpeq_epi64(load_u8x4(c.status + a), load_u8x4(c.status + b)), both);
+        const __m256i cum_qty = _mm256_and_si256(
+            abs_diff_gt(load_64x4(c.cum_qty + a), load_64x4(c.cum_qty + b), qty_tol, sign), both);
+        const __m256i avg_px = _mm256_and_si256(
+            abs_diff_gt(load_64x4(c.avg_px + a), load_64x4(c.avg_px + b), px_tol, sign), both);
+        const __m256i exec_id = _mm256_andnot_si256(
+            _mm256_cmpeq_epi64(load_64x4(c.exec_id_hash + a), load_64x4(c.exec_id_hash + b)), both);
+
+        out |= LANE_SPREAD[lane_mask(existence)] * MismatchMask::EXISTENCE |
+               LANE_SPREAD[lane_mask(status)] * MismatchMask::STATUS |
+               LANE_SPREAD[lane_mask(cum_qty)] * MismatchMask::CUM_QTY |
+               LANE_SPREAD[lane_mask(avg_px)] * MismatchMask::AVG_PX |
+               LANE_SPREAD[lane_mask(exec_id)] * MismatchMask::EXEC_ID;
+    }
+    return static_cast<std::uint32_t>(out);
+}
+
+FX_TARGET_AVX2 void evaluate_avx2(const Columns& c, std::size_t first, std::size_t count, std::uint64_t qty_tol,
+                                   std::uint64_t px_tol, std::uint8_t required_sides, MismatchMask* out) noexcept {
+    const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<long long>::min());
+    const __m256i qty = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(qty_tol)), sign);
+    const __m256i px = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(px_tol)), sign);
+    const __m256i required = _mm256_set1_epi64x(required_sides);
+    std::size_t i = 0;
+    for (; i + AVX2_LANES <= count; i += AVX2_LANES) {
+        const std::uint32_t masks = evaluate_block_avx2(c, first + i, qty, px, required, sign);
+        std::memcpy(static_cast<void*>(out + i), &masks, sizeof(masks));
+    }
+    evaluate_scalar(c, first + i, count - i, qty_tol, px_tol, required_sides, out + i);
+}
+
+constexpr std::size_t AVX512_LANES = 8;
+
+// Zero-masked form: the unmasked one trips -Wmaybe-uninitialized in some GCC headers
+FX_TARGET_AVX512 inline __m512i load_u8x8(const std::uint8_t* p) noexcept {
+    return _mm512_maskz_cvtepu8_epi64(0xFF, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+}
+
+FX_TARGET_AVX512 inline __m512i load_64x8(const void* p) noexcept { return _mm512_loadu_si512(p); }
+
+// safe_abs_diff(a, b) > tol, per lane
+FX_TARGET_AVX512 inline __mmask8 abs_diff_gt(__m512i a, __m512i b, __m512i tol) noexcept {
+    const __mmask8 lt = _mm512_cmplt_epi64_mask(a, b);
+    const __m512i diff = _mm512_mask_sub_epi64(_mm512_sub_epi64(a, b), lt, b, a);
+    return _mm512_cmpgt_epu64_mask(diff, tol);
+}
+
+// Evaluates slots [slot, slot + 8) and returns their masks, one per byte
+FX_TARGET_AVX512 std::uint64_t evaluate_block_avx512(const Columns& c, std::size_t slot, __m512i qty_tol, __m512i px_tol,
+                             __m512i required) noexcept {
+    const __m512i seen = load_u8x8(c.seen + slot);
+    const __m512i participating = _mm512_or_si512(seen, required);
+    std::uint64_t out = 0;
+    for (const SidePair& pair : SIDE_PAIRS) {
+        const __m512i pair_bits = _mm512_set1_epi64(static_cast<long long>((1u << pair.a) | (1u << pair.b)));
+        const __mmask8 part = _mm512_cmpeq_epi64_mask(_mm512_and_si512(participating, pair_bits), pair_bits);
+        const __m512i pair_seen = _mm512_and_si512(seen, pair_bits);
+        const __mmask8 both = _mm512_cmpeq_epi64_mask(pair_seen, pair_bits);
+        const __mmask8 none = _mm512_cmpeq_epi64_mask(pair_seen, _mm512_setzero_si512());
+        const auto existence = static_cast<__mmask8>(part & ~both & ~none);
+
+        const std::size_t a = pair.a * c.stride + slot;
+        const std::size_t b = pair.b * c.stride + slot;
+        const __mmask8 status = _mm512_mask_cmpneq_epi64_mask(both, load_u8x8(c.status + a), load_u8x8(c.status + b));
+        const auto cum_qty = static_cast<__mmask8>(
+            both & abs_diff_gt(load_64x8(c.cum_qty + a), load_64x8(c.cum_qty + b), qty_tol));
+        const auto avg_px = static_cast<__mmask8>(
+            both & abs_diff_gt(load_64x8(c.avg_px + a), load_64x8(c.avg_px + b), px_tol));
+        const __mmask8 exec_id = _mm512_mask_cmpneq_epi64_mask(both, load_64x8(c.exec_id_hash + a),
+                                                               load_64x8(c.exec_id_hash + b));
+
+        out |= LANE_SPREAD[existence] * MismatchMask::EXISTENCE | LANE_SPREAD[status] * MismatchMask::STATUS |
+               LANE_SPREAD[cum_qty] * MismatchMask::CUM_QTY | LANE_SPREAD[avg_px] * MismatchMask::AVG_PX |
+               LANE_SPREAD[exec_id] * MismatchMask::EXEC_ID;
+    }
+    return out;
+}
+
+FX_TARGET_AVX512 void evaluate_avx512(const Columns& c, std::size_t first, std::size_t count, std::uint64_t qty_tol,
+                                       std::uint64_t px_tol, std::uint8_t required_sides, MismatchMask* out) noexcept {
+    const __m512i qty = _mm512_set1_epi64(static_cast<long long>(qty_tol));
+    const __m512i px = _mm512_set1_epi64(static_cast<long long>(px_tol));
+    const __m512i required = _mm512_set1_epi64(required_sides);
+    std::size_t i = 0;
+    for (; i + AVX512_LANES <= count; i += AVX512_LANES) {
+        const std::uint64_t masks = evaluate_block_avx512(c, first + i, qty, px, required);
+        std::memcpy(static_cast<void*>(out + i), &masks, sizeof(masks));
+    }
+    evaluate_scalar(c, first + i, count - i, qty_tol, px_tol, required_sides, out + i);
+}
+
+#endif
+
+using EvaluateFn = void (*)(const Columns&, std::size_t, std::size_t, std::uint64_t, std::uint64_t, std::uint8_t,
+                            MismatchMask*) noexcept;
+
+constexpr util::IsaKernels<EvaluateFn> EVALUATE{
+    evaluate_scalar,
+#if FX_X86_DISPATCH
+    evaluate_avx2,
+    evaluate_avx512,
+#endif
+};
+
+const EvaluateFn bound_evaluate = EVALUATE.bind();
+
+} // namespace
+
+OrderSoaMirror::OrderSoaMirror(std::size_t slot_count) : slot_count_(slot_count) {
+    if (slot_count == 0) {
+        throw std::invalid_argument("OrderSoaMirror slot_count must be > 0");
+    }
+    cum_qty_ = std::make_unique<std::int64_t[]>(SOURCE_COUNT * slot_count);
+    avg_px_ = std::make_unique<std::int64_t[]>(SOURCE_COUNT * slot_count);
+    exec_id_hash_ = std::make_unique<std::uint64_t[]>(SOURCE_COUNT * slot_count);
+    status_ = std::make_unique<std::uint8_t[]>(SOURCE_COUNT * slot_count);
+    seen_ = std::make_unique<std::uint8_t[]>(slot_count);
+}
+
+void OrderSoaMirror::capture(std::size_t slot, const OrderState& os) noexcept {
+    for (std::size_t side = 0; side < SOURCE_COUNT; ++side) {
+        const std::size_t i = side * slot_count_ + slot;
+        cum_qty_[i] = os.cum_qty[side];
+        avg_px_[i] = os.avg_px[side];
+        exec_id_hash_[i] = os.exec_id_hash[side];
+        status_[i] = static_cast<std::uint8_t>(os.status[side]);
+    }
+    seen_[slot] = seen_sides(os);
+}
+
+void OrderSoaMirror::clear(std::size_t slot) noexcept {
+    // Only seen_ decides whether the columns are read; zero them anyway so a
+    // cleared slot is indistinguishable from a fresh one
+    for (std::size_t side = 0; side < SOURCE_COUNT; ++side) {
+        const std::size_t i = side * slot_count_ + slot;
+        cum_qty_[i] = 0;
+        avg_px_[i] = 0;
+        exec_id_hash_[i] = 0;
+        status_[i] = 0;
+    }
+    seen_[slot] = 0;
+}
+
+void OrderSoaMirror::move(std::size_t from, std::size_t to) noexcept {
+    for (std::size_t side = 0; side < SOURCE_COUNT; ++side) {
+        const std::size_t f = side * slot_count_ + from;
+        const std::size_t t = side * slot_count_ + to;
+        cum_qty_[t] = cum_qty_[f];
+        avg_px_[t] = avg_px_[f];
+        exec_id_hash_[t] = exec_id_hash_[f];
+        status_[t] = status_[f];
+    }
+    seen_[to] = seen_[from];
+}
+
+void OrderSoaMirror::clear_all() noexcept {
+    const std::size_t cells = SOURCE_COUNT * slot_count_;
+    std::fill_n(cum_qty_.get(), cells, 0);
+    std::fill_n(avg_px_.get(), cells, 0);
+    std::fill_n(exec_id_hash_.get(), cells, 0);
+    std::fill_n(status_.get(), cells, 0);
+    std::fill_n(seen_.get(), slot_count_, 0);
+}
+
+void OrderSoaMirror::evaluate(std::size_t first, std::size_t count,
+                              std::int64_t qty_tolerance, std::int64_t px_tolerance,
+                              std::uint8_t required_sides, MismatchMask* out) const noexcept {
+    const Columns c{cum_qty_.get(), avg_px_.get(), exec_id_hash_.get(), status_.get(), seen_.get(), slot_count_};
+    bound_evaluate(c, first, count, static_cast<std::uint64_t>(qty_tolerance),
+                   static_cast<std::uint64_t>(px_tolerance), required_sides, out);
+}
+
+void OrderSoaMirror::evaluate_isa(util::Isa isa, std::size_t first, std::size_t count,
+                                  std::int64_t qty_tolerance, std::int64_t px_tolerance,
+                                  std::uint8_t required_sides, MismatchMask* out) const noexcept {
+    const Columns c{cum_qty_.get(), avg_px_.get(), exec_id_hash_.get(), status_.get(), seen_.get(), slot_count_};
+    EVALUATE.for_isa(isa)(c, first, count, static_cast<std::uint64_t>(qty_tolerance),
+                          static_cast<std::uint64_t>(px_tolerance), required_sides, out);
+}
+
+const char* OrderSoaMirror::kernel_name() noexcept { return util::isa_name(util::dispatch_isa()); }
+
+} // namespace core
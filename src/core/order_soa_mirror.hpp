@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core/order_state.hpp"
+#include "core/recon_state.hpp"
+#include "util/cpu_features.hpp"
+
+namespace core {
+
+// OrderSoaMirror is a structure-of-arrays copy of the OrderState fields that
+// compute_mismatch reads (per-side status, cum qty, avg px, exec id fingerprint and
+// the seen bits), indexed by OrderStateStore bucket slot.
+//
+// Bulk passes (audit sweeps, gap-close re-evaluation, rollover) evaluate mismatch
+// masks straight from these arrays instead of chasing one OrderState pointer per
+// order. evaluate() runs the kernel bound for this CPU at startup (AVX-512: 8 slots
+// per step, AVX2: 4, otherwise scalar); the result for every slot equals
+// compute_mismatch on the mirrored record. An empty slot (nothing seen) always
+// evaluates to no mismatch.
+//
+// The store keeps slots aligned with its buckets once attached (see
+// OrderStateStore::attach_mirror); callers refresh a slot after mutating a record.
+// Single-writer, like the store; no allocations after construction.
+class OrderSoaMirror {
+public:
+    // Slots handed to one evaluate() call by for_each_mismatch
+    static constexpr std::size_t SCAN_CHUNK = 256;
+
+    // Throws std::invalid_argument if slot_count is 0.
+    explicit OrderSoaMirror(std::size_t slot_count);
+
+    OrderSoaMirror(const OrderSoaMirror&) = delete;
+    OrderSoaMirror& operator=(const OrderSoaMirror&) = delete;
+
+    [[nodiscard]] std::size_t slot_count() const noexcept { return slot_count_; }
+
+    // Copies the mismatch inputs of os into slot
+    void capture(std::size_t slot, const OrderState& os) noexcept;
+    void clear(std::size_t slot) noexcept;
+    // Moves slot from into slot to (backward-shift deletion); from is left as is
+    void move(std::size_t from, std::size_t to) noexcept;
+    void clear_all() noexcept;
+
+    // Writes compute_mismatch(...) of slots [first, first + count) to out[0..count).
+    // The range must lie within slot_count().
+    void evaluate(std::size_t first, std::size_t count,
+                  std::int64_t qty_tolerance, std::int64_t px_tolerance,
+                  std::uint8_t required_sides, MismatchMask* out) const noexcept;
+
+    // evaluate() through the kernel for isa (or the next lower level built); the
+    // caller checks util::isa_supported(isa). For equivalence tests and tools.
+    void evaluate_isa(util::Isa isa, std::size_t first, std::size_t count,
+                      std::int64_t qty_tolerance, std::int64_t px_tolerance,
+                      std::uint8_t required_sides, MismatchMask* out) const noexcept;
+
+    // Calls fn(slot, MismatchMask) for every mismatched slot in [first, first + count).
+    // Returns the number of mismatched slots.
+    template <typename Fn>
+    std::size_t for_each_mismatch(std::size_t first, std::size_t count,
+                                  std::int64_t qty_tolerance, std::int64_t px_tolerance,
+                                  std::uint8_t required_sides, Fn&& fn) const noexcept {
+        MismatchMask masks[SCAN_CHUNK];
+        std::size_t found = 0;
+        while (count != 0) {
+            const std::size_t n = count < SCAN_CHUNK ? count : SCAN_CHUNK;
+            evaluate(first, n, qty_tolerance, px_tolerance, required_sides, masks);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (masks[i].any()) {
+                    fn(first + i, masks[i]);
+                    ++found;
+                }
+            }
+            first += n;
+            count -= n;
+        }
+        return found;
+    }
+
+    // Level of the bound kernel: "avx512", "avx2" or "scalar"
+    [[nodiscard]] static const char* kernel_name() noexcept;
+
+private:
+    std::size_t slot_count_{0};
+    // Per-side columns, side-major: column[side * slot_count_ + slot]
+    std::unique_ptr<std::int64_t[]> cum_qty_;
+    std::unique_ptr<std::int64_t[]> avg_px_;
+    std::unique_ptr<std::uint64_t[]> exec_id_hash_;
+    std::unique_ptr<std::uint8_t[]> status_;
+    // seen_sides() bitmask per slot
+    std::unique_ptr<std::uint8_t[]> seen_;
+};
+
+} // namespace core
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -38,36 +40,42 @@ inline OrderKey make_order_key(const ExecEvent& evt) noexcept {
     return hash;
 }
 
+// Key of an event: the ingest stage's precomputed one when present
+[[nodiscard]] inline OrderKey event_order_key(const ExecEvent& evt) noexcept {
+    return (evt.ingest_flags & IngestFlags::ORDER_KEYED) != 0 ? evt.order_key : make_order_key(evt);
+}
+
+// Slot of each source in the per-side OrderState arrays (== source_index(Source)).
+namespace SideIndex {
+    constexpr std::size_t PRIMARY      = 0;
+    constexpr std::size_t DROPCOPY     = 1;
+    constexpr std::size_t PRIME_BROKER = 2;
+}
+
 struct OrderState {
     OrderKey key{0};
 
-    // Internal (primary) view.
-    OrdStatus internal_status{OrdStatus::Unknown};
-    std::int64_t internal_cum_qty{0};
-    std::int64_t internal_avg_px{0};
-    std::uint64_t last_internal_ts{0};
-    char last_internal_exec_id[ExecEvent::id_capacity]{};
-    std::uint8_t last_internal_exec_id_len{0};
-
-    // Drop-copy view.
-    OrdStatus dropcopy_status{OrdStatus::Unknown};
-    std::int64_t dropcopy_cum_qty{0};
-    std::int64_t dropcopy_avg_px{0};
-    std::uint64_t last_dropcopy_ts{0};
-    char last_dropcopy_exec_id[ExecEvent::id_capacity]{};
-    std::uint8_t last_dropcopy_exec_id_len{0};
+    // ===== Per-side views (SoA within the record, index = source_index(Source)) =====
+    // Primary is our OMS, DropCopy the venue drop copy, PrimeBroker the PB give-up
+    // feed. Each field is one small array so mismatch checks walk the sides in a
+    // single pass; exec ids are kept as 64-bit fingerprints (0 = none) to keep the
+    // record within four cache lines.
+    std::int64_t cum_qty[SOURCE_COUNT]{};
+    std::int64_t avg_px[SOURCE_COUNT]{};
+    std::uint64_t last_ts[SOURCE_COUNT]{};
+    std::uint64_t exec_id_hash[SOURCE_COUNT]{};
+    std::uint64_t last_seen_tsc[SOURCE_COUNT]{};  // Reconciler TSC of the side's last event
+    OrdStatus status[SOURCE_COUNT]{OrdStatus::Unknown, OrdStatus::Unknown, OrdStatus::Unknown};
+    static_assert(SOURCE_COUNT == 3, "status initializer must list every source");
+    bool seen[SOURCE_COUNT]{};
 
     // Bookkeeping.
-    bool seen_internal{false};
-    bool seen_dropcopy{false};
     bool has_divergence{false};
     bool has_gap{false};
     std::uint32_t divergence_count{0};
 
     // ===== Reconciliation overlay (FX-7051) =====
     // Tracks reconciliation lifecycle separately from FIX execution state.
-    std::uint64_t primary_last_seen_tsc{0};
-    std::uint64_t dropcopy_last_seen_tsc{0};
     std::uint64_t mismatch_first_seen_tsc{0};
     std::uint64_t recon_deadline_tsc{0};
 
@@ -82,7 +90,8 @@ struct OrderState {
     // Bitmask indicating which session gaps affect this order's reconciliation
     // Bit 0: Primary session gap uncertainty
     // Bit 1: DropCopy session gap uncertainty
-    // Bits 2-7: Reserved for additional sessions
+    // Bit 2: PrimeBroker session gap uncertainty
+    // Bits 3-7: Reserved for additional sessions
     std::uint8_t gap_uncertainty_flags{0};
 
     // ===== Divergence emission tracking (FX-7053) =====
@@ -91,22 +100,42 @@ struct OrderState {
     std::uint64_t last_divergence_emit_tsc{0};  // When last divergence was emitted (0 = never)
     MismatchMask last_emitted_mismatch{};       // What mismatch bits were last emitted
     std::uint32_t divergence_emit_count{0};     // Total divergences emitted for this order (lifetime)
+
+    // ===== Per-session order lists (maintained by OrderStateStore) =====
+    // Intrusive doubly linked lists, one per source (index = Source value), so a
+    // session-level event can visit exactly the orders seen on that session.
+    // session_link holds SessionOrderIndex slot + 1 (0 = not linked).
+    OrderState* session_next[SOURCE_COUNT]{};
+    OrderState* session_prev[SOURCE_COUNT]{};
+    std::uint16_t session_link[SOURCE_COUNT]{};
+    std::uint8_t session_flags{0};  // SessionFlags bits
+    std::uint8_t partition{0};      // OrderStateStore partition (desk) the record is charged to
+
+    // Handle of this record in the OrderStateStore slot pool (0 = not store-owned).
+    // Grace timers carry it instead of the key.
+    std::uint32_t pool_handle{0};
 };
 
-inline OrderState* create_order_state(util::Arena& arena, OrderKey key) noexcept {
-    void* mem = arena.allocate(sizeof(OrderState), alignof(OrderState));
-    if (!mem) {
-        return nullptr;
-    }
+// Initializes raw OrderState-sized storage (fresh arena memory or a recycled record).
+inline OrderState* init_order_state(void* mem, OrderKey key) noexcept {
     std::memset(mem, 0, sizeof(OrderState));
     auto* state = static_cast<OrderState*>(mem);
     state->key = key;
-    state->internal_status = OrdStatus::Unknown;
-    state->dropcopy_status = OrdStatus::Unknown;
+    for (OrdStatus& status : state->status) {
+        status = OrdStatus::Unknown;
+    }
     state->recon_state = ReconState::Unknown;
     return state;
 }
 
+inline OrderState* create_order_state(util::Arena& arena, OrderKey key) noexcept {
+    void* mem = arena.allocate(sizeof(OrderState), alignof(OrderState));
+    if (!mem) {
+        return nullptr;
+    }
+    return init_order_state(mem, key);
+}
+
 inline std::uint64_t select_event_timestamp(const ExecEvent& ev) noexcept {
     return ev.transact_time != 0 ? ev.transact_time : ev.sending_time;
 }
@@ -115,156 +144,186 @@ inline std::uint8_t bounded_exec_id_length(std::size_t len) noexcept {
     return static_cast<std::uint8_t>(len > ExecEvent::id_capacity ? ExecEvent::id_capacity : len);
 }
 
-// Applies an internal (primary session) ExecEvent to the OrderState.
+// 64-bit fingerprint of an ExecID (FNV-1a). 0 is reserved for "no exec id", so two
+// sides compare equal exactly when both are empty or both carry the same bytes
+// (up to a 2^-64 collision).
+[[nodiscard]] inline std::uint64_t exec_id_fingerprint(const char* data, std::size_t len) noexcept {
+    if (len == 0) {
+        return 0;
+    }
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<std::uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+[[nodiscard]] inline bool has_seen(const OrderState& os, Source side) noexcept {
+    return os.seen[source_index(side)];
+}
+
+// Bitmask (source_bit) of the sides that have reported on the order
+[[nodiscard]] inline std::uint8_t seen_sides(const OrderState& os) noexcept {
+    std::uint8_t bits = 0;
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        bits = static_cast<std::uint8_t>(bits | (os.seen[i] ? 1u << i : 0u));
+    }
+    return bits;
+}
+
+// Applies an ExecEvent to the given side's view of the OrderState.
 // Returns true if applied successfully, false if the transition was invalid.
-inline bool apply_internal_exec(OrderState& state, const ExecEvent& ev) noexcept {
+inline bool apply_side_exec(OrderState& state, Source side, const ExecEvent& ev) noexcept {
 #ifndef NDEBUG
-    assert(make_order_key(ev) == state.key);
+    assert(event_order_key(ev) == state.key);
 #endif
+    const std::size_t i = source_index(side);
     const OrdStatus next = ev.ord_status;
-    if (!apply_status_transition(state.internal_status, next)) {
+    if (!apply_status_transition(state.status[i], next)) {
         state.has_divergence = true;
         ++state.divergence_count;
         return false;
     }
 
-    state.internal_cum_qty = ev.cum_qty;
-    state.internal_avg_px = ev.price_micro;
-    state.last_internal_ts = select_event_timestamp(ev);
-    const auto len = bounded_exec_id_length(ev.exec_id_len);
-    if (len > 0) {
-        std::memcpy(state.last_internal_exec_id, ev.exec_id, len);
-    }
-    state.last_internal_exec_id_len = len;
-    state.seen_internal = true;
+    state.cum_qty[i] = ev.cum_qty;
+    state.avg_px[i] = ev.price_micro;
+    state.last_ts[i] = select_event_timestamp(ev);
+    state.exec_id_hash[i] = exec_id_fingerprint(ev.exec_id, bounded_exec_id_length(ev.exec_id_len));
+    state.seen[i] = true;
     return true;
 }
 
+// Applies an ExecEvent to the view of the side that sent it (ev.source).
+inline bool apply_exec(OrderState& state, const ExecEvent& ev) noexcept {
+    return apply_side_exec(state, ev.source, ev);
+}
+
+// Applies an internal (primary session) ExecEvent to the OrderState.
+inline bool apply_internal_exec(OrderState& state, const ExecEvent& ev) noexcept {
+    return apply_side_exec(state, Source::Primary, ev);
+}
+
 // Applies a drop-copy ExecEvent to the OrderState.
 inline bool apply_dropcopy_exec(OrderState& state, const ExecEvent& ev) noexcept {
-#ifndef NDEBUG
-    assert(make_order_key(ev) == state.key);
-#endif
-    const OrdStatus next = ev.ord_status;
-    if (!apply_status_transition(state.dropcopy_status, next)) {
-        state.has_divergence = true;
-        ++state.divergence_count;
-        return false;
-    }
+    return apply_side_exec(state, Source::DropCopy, ev);
+}
+
+// ===== Pairwise mismatch =====
 
-    state.dropcopy_cum_qty = ev.cum_qty;
-    state.dropcopy_avg_px = ev.price_micro;
-    state.last_dropcopy_ts = select_event_timestamp(ev);
-    const auto len = bounded_exec_id_length(ev.exec_id_len);
-    if (len > 0) {
-        std::memcpy(state.last_dropcopy_exec_id, ev.exec_id, len);
+// Unordered side pairs in fixed order: (0,1), (0,2), ..., (1,2), ...
+inline constexpr std::size_t SIDE_PAIR_COUNT = SOURCE_COUNT * (SOURCE_COUNT - 1) / 2;
+
+struct SidePair {
+    std::uint8_t a{0};
+    std::uint8_t b{0};
+};
+
+[[nodiscard]] constexpr std::array<SidePair, SIDE_PAIR_COUNT> make_side_pairs() noexcept {
+    std::array<SidePair, SIDE_PAIR_COUNT> pairs{};
+    std::size_t p = 0;
+    for (std::size_t a = 0; a < SOURCE_COUNT; ++a) {
+        for (std::size_t b = a + 1; b < SOURCE_COUNT; ++b) {
+            pairs[p++] = SidePair{static_cast<std::uint8_t>(a), static_cast<std::uint8_t>(b)};
+        }
     }
-    state.last_dropcopy_exec_id_len = len;
-    state.seen_dropcopy = true;
-    return true;
+    return pairs;
 }
 
-// Pure, noexcept mismatch computation for hot path.
-// No tolerance parameters in this version (tolerance/config comes in FX-7053/FX-7200).
-[[nodiscard]] inline MismatchMask compute_mismatch(const OrderState& os) noexcept {
-    MismatchMask m{};
+inline constexpr std::array<SidePair, SIDE_PAIR_COUNT> SIDE_PAIRS = make_side_pairs();
 
-    // Existence mismatch: if one side seen but not the other
-    if (os.seen_internal != os.seen_dropcopy) {
-        m.set(MismatchMask::EXISTENCE);
-        return m;  // Early return on existence mismatch
-    }
+[[nodiscard]] constexpr std::size_t side_pair_index(Source x, Source y) noexcept {
+    const std::size_t a = source_index(x) < source_index(y) ? source_index(x) : source_index(y);
+    const std::size_t b = source_index(x) < source_index(y) ? source_index(y) : source_index(x);
+    // Pairs starting at a are preceded by (SOURCE_COUNT-1) + ... + (SOURCE_COUNT-a) others
+    return a * (2 * SOURCE_COUNT - a - 1) / 2 + (b - a - 1);
+}
 
-    // If neither side seen, return empty mask
-    if (!os.seen_internal && !os.seen_dropcopy) {
-        return m;
-    }
+static_assert(SIDE_PAIRS[side_pair_index(Source::DropCopy, Source::PrimeBroker)].a == SideIndex::DROPCOPY &&
+                  SIDE_PAIRS[side_pair_index(Source::PrimeBroker, Source::DropCopy)].b == SideIndex::PRIME_BROKER,
+              "side_pair_index must agree with SIDE_PAIRS");
 
-    // Both sides seen: compare fields
+// One MismatchMask per side pair; combined() is what the recon state machine acts on.
+struct PairwiseMismatch {
+    std::array<MismatchMask, SIDE_PAIR_COUNT> pair{};
 
-    // Status mismatch
-    if (os.internal_status != os.dropcopy_status) {
-        m.set(MismatchMask::STATUS);
-    }
+    [[nodiscard]] MismatchMask between(Source x, Source y) const noexcept { return pair[side_pair_index(x, y)]; }
 
-    // CumQty mismatch
-    if (os.internal_cum_qty != os.dropcopy_cum_qty) {
-        m.set(MismatchMask::CUM_QTY);
+    [[nodiscard]] MismatchMask combined() const noexcept {
+        MismatchMask m{};
+        for (const MismatchMask& p : pair) {
+            m.set(p.bits());
+        }
+        return m;
     }
+};
 
-    // LEAVES_QTY: Not computed in v1 because total order qty (order_qty) is not tracked
-    // in OrderState. Future implementation will either compute leaves_qty
-    // as (order_qty - cum_qty) or compare directly-reported leaves_qty values
-    // from both feeds once order_qty tracking is added.
+// Compares every pair of participating sides in one pass over the per-side arrays.
+// A side participates if it is in required_sides (source_bit mask) or has reported
+// on the order. For each participating pair:
+//   - exactly one side seen: EXISTENCE only
+//   - neither side seen:     nothing (no information yet)
+//   - both seen:             STATUS / CUM_QTY / AVG_PX / EXEC_ID, with tolerances
+// LEAVES_QTY is not computed: total order qty is not tracked in OrderState.
+[[nodiscard]] inline PairwiseMismatch compute_pairwise_mismatch(
+    const OrderState& os,
+    std::int64_t qty_tolerance,
+    std::int64_t px_tolerance,
+    std::uint8_t required_sides = DEFAULT_REQUIRED_SIDES
+) noexcept {
+    PairwiseMismatch out{};
+    const std::uint8_t seen_bits = seen_sides(os);
+    const std::uint8_t participating = static_cast<std::uint8_t>(seen_bits | required_sides);
+
+    for (std::size_t p = 0; p < SIDE_PAIR_COUNT; ++p) {
+        const std::size_t a = SIDE_PAIRS[p].a;
+        const std::size_t b = SIDE_PAIRS[p].b;
+        const auto pair_bits = static_cast<std::uint8_t>((1u << a) | (1u << b));
+        if ((participating & pair_bits) != pair_bits) {
+            continue;
+        }
 
-    // AvgPx mismatch
-    if (os.internal_avg_px != os.dropcopy_avg_px) {
-        m.set(MismatchMask::AVG_PX);
-    }
+        MismatchMask& m = out.pair[p];
+        const std::uint8_t pair_seen = seen_bits & pair_bits;
+        if (pair_seen != pair_bits) {
+            if (pair_seen != 0) {
+                m.set(MismatchMask::EXISTENCE);
+            }
+            continue;
+        }
 
-    // ExecID mismatch: compare lengths first, then content if both are populated
-    if (os.last_internal_exec_id_len != os.last_dropcopy_exec_id_len) {
-        m.set(MismatchMask::EXEC_ID);
-    } else if (os.last_internal_exec_id_len > 0 && os.last_dropcopy_exec_id_len > 0) {
-        if (std::memcmp(os.last_internal_exec_id, os.last_dropcopy_exec_id, 
-                        os.last_internal_exec_id_len) != 0) {
+        if (os.status[a] != os.status[b]) {
+            m.set(MismatchMask::STATUS);
+        }
+        // safe_abs_diff avoids signed overflow/UB
+        if (safe_abs_diff(os.cum_qty[a], os.cum_qty[b]) > static_cast<std::uint64_t>(qty_tolerance)) {
+            m.set(MismatchMask::CUM_QTY);
+        }
+        if (safe_abs_diff(os.avg_px[a], os.avg_px[b]) > static_cast<std::uint64_t>(px_tolerance)) {
+            m.set(MismatchMask::AVG_PX);
+        }
+        if (os.exec_id_hash[a] != os.exec_id_hash[b]) {
             m.set(MismatchMask::EXEC_ID);
         }
     }
-
-    return m;
+    return out;
 }
 
 // Mismatch computation with tolerance parameters (FX-7053 Part 3).
 // Tolerances allow for minor differences without triggering mismatches.
+// Returns the union of all pairwise masks.
 [[nodiscard]] inline MismatchMask compute_mismatch(
     const OrderState& os,
     std::int64_t qty_tolerance,
-    std::int64_t px_tolerance
+    std::int64_t px_tolerance,
+    std::uint8_t required_sides = DEFAULT_REQUIRED_SIDES
 ) noexcept {
-    MismatchMask m{};
-
-    // Existence mismatch: if one side seen but not the other
-    if (os.seen_internal != os.seen_dropcopy) {
-        m.set(MismatchMask::EXISTENCE);
-        return m;  // Early return on existence mismatch
-    }
-
-    // If neither side seen, return empty mask
-    if (!os.seen_internal && !os.seen_dropcopy) {
-        return m;
-    }
-
-    // Both sides seen: compare fields
-
-    // Status mismatch (no tolerance for status)
-    if (os.internal_status != os.dropcopy_status) {
-        m.set(MismatchMask::STATUS);
-    }
-
-    // CumQty mismatch with tolerance (use safe_abs_diff to avoid overflow/UB)
-    const auto qty_diff = safe_abs_diff(os.internal_cum_qty, os.dropcopy_cum_qty);
-    if (qty_diff > static_cast<std::uint64_t>(qty_tolerance)) {
-        m.set(MismatchMask::CUM_QTY);
-    }
-
-    // AvgPx mismatch with tolerance (use safe_abs_diff to avoid overflow/UB)
-    const auto px_diff = safe_abs_diff(os.internal_avg_px, os.dropcopy_avg_px);
-    if (px_diff > static_cast<std::uint64_t>(px_tolerance)) {
-        m.set(MismatchMask::AVG_PX);
-    }
-
-    // ExecID mismatch: compare lengths first, then content if both are populated
-    if (os.last_internal_exec_id_len != os.last_dropcopy_exec_id_len) {
-        m.set(MismatchMask::EXEC_ID);
-    } else if (os.last_internal_exec_id_len > 0 && os.last_dropcopy_exec_id_len > 0) {
-        if (std::memcmp(os.last_internal_exec_id, os.last_dropcopy_exec_id, 
-                        os.last_internal_exec_id_len) != 0) {
-            m.set(MismatchMask::EXEC_ID);
-        }
-    }
+    return compute_pairwise_mismatch(os, qty_tolerance, px_tolerance, required_sides).combined();
+}
 
-    return m;
+// Pure, noexcept mismatch computation for hot path (exact match, default sides).
+[[nodiscard]] inline MismatchMask compute_mismatch(const OrderState& os) noexcept {
+    return compute_mismatch(os, 0, 0);
 }
 
 // Check if a divergence should be emitted or deduplicated.
@@ -317,7 +376,24 @@ namespace GapUncertaintyFlags {
     constexpr std::uint8_t NONE     = 0u;
     constexpr std::uint8_t PRIMARY  = 1u << 0;  // Bit 0
     constexpr std::uint8_t DROPCOPY = 1u << 1;  // Bit 1
-    // Bits 2-7 reserved for future multi-session support
+    constexpr std::uint8_t PRIME_BROKER = 1u << 2;  // Bit 2
+    // Bits 3-7 reserved for future multi-session support
+}
+
+// ===== Session flag bits (OrderState::session_flags) =====
+namespace SessionFlags {
+    constexpr std::uint8_t NONE                = 0u;
+    constexpr std::uint8_t PRIMARY_DOWN        = 1u << 0;  // Order's primary session logged out
+    constexpr std::uint8_t DROPCOPY_DOWN       = 1u << 1;  // Order's drop-copy session logged out
+    constexpr std::uint8_t PRIME_BROKER_DOWN   = 1u << 2;  // Order's PB give-up session logged out
+    constexpr std::uint8_t MASS_CANCEL_PENDING = 1u << 3;  // Awaiting the other sides' cancel after a mass cancel
+    constexpr std::uint8_t STREAM_PARKED       = 1u << 4;  // Grace deferred while a whole source stream is down
+    constexpr std::uint8_t DOWN_MASK           = PRIMARY_DOWN | DROPCOPY_DOWN | PRIME_BROKER_DOWN;
+
+    // Down bits are source_bit(source)
+    [[nodiscard]] constexpr std::uint8_t down_bit(Source source) noexcept {
+        return source_bit(source);
+    }
 }
 
 // ===== FX-7054: Gap uncertainty query functions =====
@@ -331,10 +407,8 @@ namespace GapUncertaintyFlags {
 
 // Check if order has gap uncertainty for specific source
 [[nodiscard]] inline bool has_gap_uncertainty_for(const OrderState& os, Source source) noexcept {
-    const std::uint8_t flag = (source == Source::Primary)
-        ? GapUncertaintyFlags::PRIMARY
-        : GapUncertaintyFlags::DROPCOPY;
-    return (os.gap_uncertainty_flags & flag) != 0;
+    // Gap flag bits are source_bit(source)
+    return (os.gap_uncertainty_flags & source_bit(source)) != 0;
 }
 
 // Clear all gap uncertainty (e.g., when order is confirmed matched)
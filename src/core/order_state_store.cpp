@@ -3,11 +3,14 @@
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <string>
 
 namespace core {
 
 namespace {
 constexpr std::size_t default_probe_limit = 64;
+// Multiply-shift slot selection takes 32 bits of key and bucket count
+constexpr std::size_t max_tombstone_buckets = std::size_t{1} << 32;
 }
 
 std::size_t OrderStateStore::next_power_of_two(std::size_t v) {
@@ -27,8 +30,7 @@ std::size_t OrderStateStore::next_power_of_two(std::size_t v) {
     return n;
 }
 
-OrderStateStore::OrderStateStore(util::Arena& arena, std::size_t capacity_hint)
-    : arena_(arena) {
+std::size_t OrderStateStore::bucket_count_for(std::size_t capacity_hint) {
     if (capacity_hint == 0) {
         throw std::invalid_argument("OrderStateStore capacity_hint must be > 0");
     }
@@ -36,22 +38,70 @@ OrderStateStore::OrderStateStore(util::Arena& arena, std::size_t capacity_hint)
     const std::size_t desired = capacity_hint > (std::numeric_limits<std::size_t>::max() / 2)
                                     ? std::numeric_limits<std::size_t>::max()
                                     : capacity_hint * 2;
-    bucket_count_ = next_power_of_two(desired);
-    if (bucket_count_ < 2) {
+    const std::size_t buckets = next_power_of_two(desired);
+    if (buckets < 2) {
         throw std::runtime_error("OrderStateStore bucket_count underflow");
     }
+    return buckets;
+}
 
+OrderStateStore::OrderStateStore(util::Arena& arena, std::size_t capacity_hint,
+                                 std::size_t tombstone_capacity_hint)
+    : bucket_count_(bucket_count_for(capacity_hint)),
+      pool_(arena, bucket_count_) {
     keys_ = std::make_unique<OrderKey[]>(bucket_count_);
-    values_ = std::make_unique<OrderState*[]>(bucket_count_);
+    values_ = std::make_unique<util::PoolHandle[]>(bucket_count_);
     max_probe_ = std::min<std::size_t>(bucket_count_, default_probe_limit);
 
+    // Tombstones are only ever inserted, so size for ~80% load and skip power-of-two
+    // rounding (slots are picked by multiply-shift) to keep the per-order footprint
+    // at roughly one 16-byte slot.
+    const std::size_t tomb_hint = tombstone_capacity_hint != 0 ? tombstone_capacity_hint : capacity_hint;
+    if (tomb_hint > max_tombstone_buckets - max_tombstone_buckets / 5) {
+        throw std::runtime_error("OrderStateStore tombstone capacity overflow");
+    }
+    tombstone_bucket_count_ = std::max<std::size_t>(tomb_hint + tomb_hint / 4, 2);
+    tombstones_ = std::make_unique<OrderTombstone[]>(tombstone_bucket_count_);
+    tombstone_max_probe_ = std::min<std::size_t>(tombstone_bucket_count_, default_probe_limit);
+
+    partitions_[0].quota = pool_.capacity();
     reset_epoch();
 }
 
+std::size_t OrderStateStore::quota_sum(std::span<const std::size_t> partition_quotas) {
+    if (partition_quotas.empty() || partition_quotas.size() > MAX_STORE_PARTITIONS) {
+        throw std::invalid_argument("OrderStateStore needs 1.." + std::to_string(MAX_STORE_PARTITIONS) +
+                                    " partition quotas");
+    }
+    std::size_t sum = 0;
+    for (const std::size_t quota : partition_quotas) {
+        if (quota == 0) {
+            throw std::invalid_argument("OrderStateStore partition quota must be > 0");
+        }
+        if (quota > std::numeric_limits<std::size_t>::max() - sum) {
+            throw std::runtime_error("OrderStateStore partition quotas overflow");
+        }
+        sum += quota;
+    }
+    return sum;
+}
+
+OrderStateStore::OrderStateStore(util::Arena& arena, std::span<const std::size_t> partition_quotas,
+                                 std::size_t tombstone_capacity_hint)
+    : OrderStateStore(arena, quota_sum(partition_quotas), tombstone_capacity_hint) {
+    partition_count_ = partition_quotas.size();
+    for (std::size_t p = 0; p < partition_count_; ++p) {
+        partitions_[p].quota = partition_quotas[p];
+    }
+}
+
 OrderState* OrderStateStore::upsert(const ExecEvent& ev) noexcept {
-    const OrderKey key = make_order_key(ev);
+    const OrderKey key = event_order_key(ev);
+    const std::uint8_t partition = partition_of(ev);
+    StorePartitionStats& part = partitions_[partition];
     if (key == empty_key_) {
         ++overflow_count_;
+        ++part.overflow;
         return nullptr;
     }
 
@@ -61,23 +111,35 @@ OrderState* OrderStateStore::upsert(const ExecEvent& ev) noexcept {
     for (std::size_t probe = 0; probe < max_probe_; ++probe) {
         const OrderKey bucket_key = keys_[idx];
         if (bucket_key == empty_key_) {
-            OrderState* st = create_order_state(arena_, key);
+            if (tombstone_count_ != 0 && find_tombstone(key)) {
+                return nullptr;  // Finished and compacted; never re-create state
+            }
+            OrderState* st = part.live < part.quota ? allocate_state(key) : nullptr;
             if (!st) {
                 ++overflow_count_;
+                ++part.overflow;
                 return nullptr;
             }
+            st->partition = partition;
+            ++part.live;
             keys_[idx] = key;
-            values_[idx] = st;
+            values_[idx] = st->pool_handle;
             ++size_;
+            (void)sessions_.link(*st, ev.source, ev.session_id);
             return st;
         }
         if (bucket_key == key) {
-            return values_[idx];
+            OrderState* st = pool_.at(values_[idx]);
+            (void)sessions_.link(*st, ev.source, ev.session_id);
+            return st;
         }
         idx = (idx + 1) & mask();
     }
 
-    ++overflow_count_;
+    if (tombstone_count_ == 0 || !find_tombstone(key)) {
+        ++overflow_count_;
+        ++part.overflow;
+    }
     return nullptr;
 }
 
@@ -95,7 +157,7 @@ OrderState* OrderStateStore::find(OrderKey key) noexcept {
             return nullptr;
         }
         if (bucket_key == key) {
-            return values_[idx];
+            return pool_.at(values_[idx]);
         }
         idx = (idx + 1) & mask();
     }
@@ -103,11 +165,176 @@ OrderState* OrderStateStore::find(OrderKey key) noexcept {
 }
 
 void OrderStateStore::reset_epoch() noexcept {
-    arena_.reset();
+    pool_.reset();
     std::fill_n(keys_.get(), bucket_count_, empty_key_);
-    std::fill_n(values_.get(), bucket_count_, nullptr);
+    std::fill_n(values_.get(), bucket_count_, util::NULL_POOL_HANDLE);
     size_ = 0;
     overflow_count_ = 0;
+    for (StorePartitionStats& part : partitions_) {
+        part.live = 0;
+        part.overflow = 0;
+    }
+
+    OrderTombstone empty{};
+    empty.key = empty_key_;
+    std::fill_n(tombstones_.get(), tombstone_bucket_count_, empty);
+    tombstone_count_ = 0;
+    tombstone_overflow_count_ = 0;
+    compacted_count_ = 0;
+    sweep_cursor_ = 0;
+    sessions_.clear();
+    if (mirror_) {
+        mirror_->clear_all();
+    }
+}
+
+// ===== Tombstone compaction =====
+
+OrderState* OrderStateStore::allocate_state(OrderKey key) noexcept {
+    const util::PoolHandle handle = pool_.allocate();
+    if (handle == util::NULL_POOL_HANDLE) {
+        return nullptr;
+    }
+    OrderState* st = init_order_state(pool_.at(handle), key);
+    st->pool_handle = handle;
+    return st;
+}
+
+void OrderStateStore::release_state(const OrderState& st) noexcept {
+    pool_.release(st.pool_handle);
+}
+
+const OrderTombstone* OrderStateStore::find_tombstone(OrderKey key) const noexcept {
+    if (key == empty_key_) {
+        return nullptr;
+    }
+
+    std::size_t idx = tombstone_slot(key);
+    for (std::size_t probe = 0; probe < tombstone_max_probe_; ++probe) {
+        const OrderTombstone& t = tombstones_[idx];
+        if (t.key == empty_key_) {
+            return nullptr;
+        }
+        if (t.key == key) {
+            return &t;
+        }
+        idx = (idx + 1 == tombstone_bucket_count_) ? 0 : idx + 1;
+    }
+    return nullptr;
+}
+
+bool OrderStateStore::insert_tombstone(const OrderTombstone& tomb) noexcept {
+    std::size_t idx = tombstone_slot(tomb.key);
+    for (std::size_t probe = 0; probe < tombstone_max_probe_; ++probe) {
+        OrderTombstone& t = tombstones_[idx];
+        if (t.key == empty_key_) {
+            t = tomb;
+            ++tombstone_count_;
+            return true;
+        }
+        if (t.key == tomb.key) {
+            t = tomb;
+            return true;
+        }
+        idx = (idx + 1 == tombstone_bucket_count_) ? 0 : idx + 1;
+    }
+    return false;
+}
+
+bool OrderStateStore::compact(OrderKey key) noexcept {
+    if (key == empty_key_) {
+        return false;
+    }
+
+    std::size_t idx = hash(key) & mask();
+    for (std::size_t probe = 0; probe < max_probe_; ++probe) {
+        const OrderKey bucket_key = keys_[idx];
+        if (bucket_key == empty_key_) {
+            return false;
+        }
+        if (bucket_key == key) {
+            return compact_at(idx);
+        }
+        idx = (idx + 1) & mask();
+    }
+    return false;
+}
+
+bool OrderStateStore::compact_at(std::size_t idx) noexcept {
+    OrderState* st = pool_.at(values_[idx]);
+    if (!insert_tombstone(make_tombstone(*st))) {
+        ++tombstone_overflow_count_;
+        return false;
+    }
+    erase_at(idx);
+    --partitions_[st->partition].live;
+    sessions_.unlink_all(*st);
+    release_state(*st);
+    ++compacted_count_;
+    return true;
+}
+
+// Backward-shift deletion for linear probing: pull later entries of the cluster
+// into the hole unless that would move them before their home bucket. Entries only
+// ever move closer to home, so the max_probe_ bound still holds.
+void OrderStateStore::erase_at(std::size_t idx) noexcept {
+    std::size_t hole = idx;
+    std::size_t next = (hole + 1) & mask();
+    for (std::size_t step = 1; step < bucket_count_ && keys_[next] != empty_key_; ++step) {
+        const std::size_t home = hash(keys_[next]) & mask();
+        // Distance from home to next vs from home to hole (cyclic)
+        const std::size_t dist_next = (next - home) & mask();
+        const std::size_t dist_hole = (hole - home) & mask();
+        if (dist_hole < dist_next) {
+            keys_[hole] = keys_[next];
+            values_[hole] = values_[next];
+            if (mirror_) {
+                mirror_->move(next, hole);
+            }
+            hole = next;
+        }
+        next = (next + 1) & mask();
+    }
+    keys_[hole] = empty_key_;
+    values_[hole] = util::NULL_POOL_HANDLE;
+    if (mirror_) {
+        mirror_->clear(hole);
+    }
+    --size_;
+}
+
+// ===== SoA mirror =====
+
+bool OrderStateStore::attach_mirror(OrderSoaMirror* mirror) noexcept {
+    if (mirror && mirror->slot_count() < bucket_count_) {
+        return false;
+    }
+    mirror_ = mirror;
+    if (!mirror_) {
+        return true;
+    }
+    mirror_->clear_all();
+    for (std::size_t idx = 0; idx < bucket_count_; ++idx) {
+        if (keys_[idx] != empty_key_) {
+            mirror_->capture(idx, *pool_.at(values_[idx]));
+        }
+    }
+    return true;
+}
+
+void OrderStateStore::refresh_mirror_slot(const OrderState& os) noexcept {
+    std::size_t idx = hash(os.key) & mask();
+    for (std::size_t probe = 0; probe < max_probe_; ++probe) {
+        const OrderKey bucket_key = keys_[idx];
+        if (bucket_key == empty_key_) {
+            return;
+        }
+        if (bucket_key == os.key) {
+            mirror_->capture(idx, os);
+            return;
+        }
+        idx = (idx + 1) & mask();
+    }
 }
 
 } // namespace core
@@ -1,26 +1,69 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <span>
 
+#include "core/order_soa_mirror.hpp"
 #include "core/order_state.hpp"
+#include "core/order_tombstone.hpp"
+#include "core/session_index.hpp"
 #include "core/exec_event.hpp"
 #include "util/arena.hpp"
+#include "util/pool.hpp"
 
 namespace core {
 
+inline constexpr std::size_t MAX_STORE_PARTITIONS = 16;
+
+// Accounting of one OrderStateStore partition
+struct StorePartitionStats {
+    std::uint64_t quota{0};     // Live orders the partition may hold
+    std::uint64_t live{0};
+    std::uint64_t overflow{0};  // Inserts refused: quota reached, store full or probe limit hit
+};
+
 // OrderStateStore is a single-writer, open-addressed hash table keyed by OrderKey.
 // The reconciler thread is the only writer; future readers will be read-only.
-// Buckets are allocated once in the constructor (heap), while OrderState
-// instances are allocated from the provided Arena. The hot path (upsert/find)
-// performs no allocations and is noexcept.
+// Buckets are allocated once in the constructor (heap). OrderState records live in
+// a cache-line-slotted util::Pool carved from the provided Arena at construction
+// (one slot per bucket, or as many as the arena holds); buckets store 32-bit pool
+// handles rather than pointers. The store owns the arena from then on. The hot path
+// (upsert/find) performs no allocations and is noexcept.
+//
+// Finished orders can be compacted (compact / compact_sweep): the full record is
+// replaced by a 16-byte OrderTombstone in a dense, open-addressed side table and the
+// record's slot goes back to the pool, which upsert draws from before fresh slots.
+// upsert never re-creates state for a tombstoned key; it returns nullptr and the
+// caller can tell this apart from overflow via find_tombstone.
+//
+// upsert also links each order into the per-session list of the event's
+// (source, session_id) so session-level events can reach their orders directly.
+//
+// Orders are charged to a partition (a desk or account group; ExecEvent::partition,
+// assigned at ingest) with its own quota of live orders and overflow counter, so one
+// runaway flow exhausts only its own quota: the pool holds every quota at once and
+// the buckets are sized for twice their sum, which keeps probes short whatever mix
+// is live. The plain constructor makes a single partition limited only by the pool.
+//
+// An attached OrderSoaMirror is kept slot-aligned with the buckets: erase shifts
+// move mirror slots along with the entries and reset_epoch clears it. Record
+// contents are not tracked; the writer calls refresh_mirror after mutating one.
 class OrderStateStore {
 public:
     // May throw std::invalid_argument on an unusable capacity_hint or std::runtime_error
     // if the bucket sizing overflows at construction time.
-    OrderStateStore(util::Arena& arena, std::size_t capacity_hint);
+    // tombstone_capacity_hint sizes the tombstone table (0 = same as capacity_hint).
+    OrderStateStore(util::Arena& arena, std::size_t capacity_hint,
+                    std::size_t tombstone_capacity_hint = 0);
+    // One partition per quota (live orders), capacity_hint = their sum. Throws
+    // std::invalid_argument if there are no quotas, more than MAX_STORE_PARTITIONS or
+    // a zero quota.
+    OrderStateStore(util::Arena& arena, std::span<const std::size_t> partition_quotas,
+                    std::size_t tombstone_capacity_hint = 0);
 
     OrderStateStore(const OrderStateStore&) = delete;
     OrderStateStore& operator=(const OrderStateStore&) = delete;
@@ -31,27 +74,127 @@ public:
     OrderState* find(OrderKey key) noexcept;
     void reset_epoch() noexcept;
 
+    // ===== Tombstone compaction =====
+
+    // Compacts a live order into a tombstone. Returns false if the key is not live
+    // or the tombstone table is full (the full record is then kept).
+    bool compact(OrderKey key) noexcept;
+
+    // Visits up to max_buckets index buckets, resuming where the previous sweep
+    // stopped, and compacts every order for which should_compact(OrderState&)
+    // returns true. Returns the number of orders compacted.
+    template <typename Pred>
+    std::size_t compact_sweep(std::size_t max_buckets, Pred&& should_compact) noexcept {
+        std::size_t compacted = 0;
+        const std::size_t limit = std::min(max_buckets, bucket_count_);
+        for (std::size_t n = 0; n < limit; ++n) {
+            const std::size_t idx = sweep_cursor_;
+            if (keys_[idx] != empty_key_ && should_compact(*pool_.at(values_[idx])) && compact_at(idx)) {
+                // Deletion may have shifted a later entry into idx; look at it next.
+                ++compacted;
+                continue;
+            }
+            sweep_cursor_ = (idx + 1) & mask();
+        }
+        return compacted;
+    }
+
+    const OrderTombstone* find_tombstone(OrderKey key) const noexcept;
+
+    // ===== SoA mirror =====
+
+    // Attaches (or with nullptr detaches) a mirror and fills it from the live orders.
+    // Returns false if the mirror has fewer slots than bucket_count().
+    bool attach_mirror(OrderSoaMirror* mirror) noexcept;
+    OrderSoaMirror* mirror() const noexcept { return mirror_; }
+
+    // Re-captures os into its mirror slot; no-op without a mirror
+    void refresh_mirror(const OrderState& os) noexcept {
+        if (mirror_) {
+            refresh_mirror_slot(os);
+        }
+    }
+
+    // Record in bucket slot (nullptr if empty); pairs mirror slots with their orders
+    OrderState* slot_state(std::size_t slot) const noexcept {
+        return values_[slot] != util::NULL_POOL_HANDLE ? pool_.at(values_[slot]) : nullptr;
+    }
+
+    // Record named by a pool handle (OrderState::pool_handle); nullptr once the
+    // record was compacted or the epoch reset, even if its slot was reused.
+    OrderState* resolve(util::PoolHandle handle) const noexcept { return pool_.get(handle); }
+
+    // Per-session order lists (see SessionOrderIndex)
+    SessionOrderIndex& sessions() noexcept { return sessions_; }
+    const SessionOrderIndex& sessions() const noexcept { return sessions_; }
+
+    // ===== Partitions =====
+
+    std::size_t partition_count() const noexcept { return partition_count_; }
+    const StorePartitionStats& partition_stats(std::size_t partition) const noexcept {
+        return partitions_[partition];
+    }
+    // Partition an event is charged to; out-of-range tags fall back to partition 0
+    std::uint8_t partition_of(const ExecEvent& ev) const noexcept {
+        return ev.partition < partition_count_ ? ev.partition : std::uint8_t{0};
+    }
+
     std::size_t bucket_count() const noexcept { return bucket_count_; }
     std::size_t size() const noexcept { return size_; }
     std::size_t overflow_count() const noexcept { return overflow_count_; }
 
+    std::size_t tombstone_bucket_count() const noexcept { return tombstone_bucket_count_; }
+    std::size_t tombstone_count() const noexcept { return tombstone_count_; }
+    std::size_t tombstone_overflow_count() const noexcept { return tombstone_overflow_count_; }
+    std::size_t compacted_count() const noexcept { return compacted_count_; }
+    std::size_t free_pool_size() const noexcept { return pool_.free_count(); }
+    // Records the pool can hold at once
+    std::size_t pool_capacity() const noexcept { return pool_.capacity(); }
+
 private:
     // Sentinel key marking an empty bucket. make_order_key is allowed to produce 0,
     // so we pick the maximal value to avoid collisions with real keys.
     static constexpr OrderKey empty_key_ = std::numeric_limits<OrderKey>::max();
 
     static std::size_t next_power_of_two(std::size_t v);
+    static std::size_t bucket_count_for(std::size_t capacity_hint);
+    static std::size_t quota_sum(std::span<const std::size_t> partition_quotas);
 
     std::size_t mask() const noexcept { return bucket_count_ - 1; }
+    // Maps the key's high 32 bits onto [0, tombstone_bucket_count_) without a division
+    std::size_t tombstone_slot(OrderKey key) const noexcept {
+        return static_cast<std::size_t>(((key >> 32) * static_cast<std::uint64_t>(tombstone_bucket_count_)) >> 32);
+    }
     std::size_t hash(OrderKey key) const noexcept { return key; }
 
-    util::Arena& arena_;
+    OrderState* allocate_state(OrderKey key) noexcept;
+    void release_state(const OrderState& st) noexcept;
+    bool insert_tombstone(const OrderTombstone& tomb) noexcept;
+    bool compact_at(std::size_t idx) noexcept;
+    void erase_at(std::size_t idx) noexcept;
+    void refresh_mirror_slot(const OrderState& os) noexcept;
+
     std::unique_ptr<OrderKey[]> keys_;
-    std::unique_ptr<OrderState*[]> values_;
+    std::unique_ptr<util::PoolHandle[]> values_;
     std::size_t bucket_count_{0};
     std::size_t size_{0};
     std::size_t overflow_count_{0};
     std::size_t max_probe_{0};
+
+    util::Pool<OrderState> pool_;
+    StorePartitionStats partitions_[MAX_STORE_PARTITIONS]{};
+    std::size_t partition_count_{1};
+
+    std::unique_ptr<OrderTombstone[]> tombstones_;
+    std::size_t tombstone_bucket_count_{0};
+    std::size_t tombstone_count_{0};
+    std::size_t tombstone_overflow_count_{0};
+    std::size_t tombstone_max_probe_{0};
+    std::size_t compacted_count_{0};
+    std::size_t sweep_cursor_{0};
+
+    SessionOrderIndex sessions_;
+    OrderSoaMirror* mirror_{nullptr};
 };
 
 } // namespace core
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/exec_event.hpp"
+#include "core/order_state.hpp"
+
+namespace core {
+
+// Compact record kept for an order after it has been finished and compacted out of
+// the OrderStateStore (terminal on both sides, Matched, quiet for the configured
+// period). It holds just enough to recognise a late or duplicate execution for the
+// order without re-creating full state: the key, the agreed final status and a
+// fingerprint of the agreed cumulative quantity.
+//
+// A finished order costs sizeof(OrderState) plus two index buckets (~248 bytes) at
+// full size, and one 16-byte tombstone slot once compacted.
+struct OrderTombstone {
+    OrderKey key{0};
+    std::uint32_t cum_qty_hash{0};
+    OrdStatus final_status{OrdStatus::Unknown};
+    std::uint8_t flags{0};
+    std::uint16_t reserved{0};
+
+    // flags
+    static constexpr std::uint8_t HAD_DIVERGENCE = 1u << 0;  // Order emitted a divergence at some point
+};
+
+static_assert(sizeof(OrderTombstone) == 16, "OrderTombstone must stay 16 bytes");
+static_assert(std::is_trivially_copyable_v<OrderTombstone>, "OrderTombstone must be trivially copyable");
+
+// 32-bit fingerprint of a cumulative quantity (fold + Fibonacci multiply)
+[[nodiscard]] inline constexpr std::uint32_t cum_qty_fingerprint(std::int64_t cum_qty) noexcept {
+    const auto v = static_cast<std::uint64_t>(cum_qty);
+    return static_cast<std::uint32_t>(v ^ (v >> 32)) * 0x9E3779B1u;
+}
+
+[[nodiscard]] inline OrderTombstone make_tombstone(const OrderState& os) noexcept {
+    OrderTombstone t{};
+    t.key = os.key;
+    t.cum_qty_hash = cum_qty_fingerprint(os.cum_qty[SideIndex::PRIMARY]);
+    t.final_status = os.status[SideIndex::PRIMARY];
+    if (os.divergence_emit_count != 0 || os.has_divergence) {
+        t.flags |= OrderTombstone::HAD_DIVERGENCE;
+    }
+    return t;
+}
+
+// An order may be compacted once the sides agree it is finished (Matched, primary
+// and drop copy seen, every seen side terminal) and no side has reported anything
+// for quiet_tsc cycles.
+[[nodiscard]] inline bool is_compactable(const OrderState& os, std::uint64_t now_tsc,
+                                         std::uint64_t quiet_tsc) noexcept {
+    if (os.recon_state != ReconState::Matched || !os.seen[SideIndex::PRIMARY] || !os.seen[SideIndex::DROPCOPY]) {
+        return false;
+    }
+    std::uint64_t last_seen = 0;
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        if (!os.seen[i]) {
+            continue;
+        }
+        if (!is_terminal_status(os.status[i])) {
+            return false;
+        }
+        last_seen = os.last_seen_tsc[i] > last_seen ? os.last_seen_tsc[i] : last_seen;
+    }
+    return now_tsc >= last_seen && (now_tsc - last_seen) >= quiet_tsc;
+}
+
+// True if the event only repeats what the tombstone already records (same final
+// status and cumulative quantity), i.e. a benign duplicate or late echo.
+[[nodiscard]] inline bool tombstone_matches(const OrderTombstone& t, const ExecEvent& ev) noexcept {
+    return ev.ord_status == t.final_status && cum_qty_fingerprint(ev.cum_qty) == t.cum_qty_hash;
+}
+
+} // namespace core
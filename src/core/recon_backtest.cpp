@@ -0,0 +1,147 @@
+#include "core/recon_backtest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+
+#include "core/order_state_store.hpp"
+#include "util/arena.hpp"
+#include "util/tsc_calibration.hpp"
+
+namespace core {
+
+namespace {
+
+// Simulated housekeeping cadence, matching Reconciler::run
+constexpr std::uint64_t HOUSEKEEPING_INTERVAL_NS = 10'000'000ULL;  // 10ms
+
+// Per-order arena footprint plus slack for the store's recycled records
+std::size_t arena_bytes_for(std::size_t orders) noexcept {
+    return orders * sizeof(OrderState) + orders * sizeof(OrderState) / 4 + (1u << 20);
+}
+
+} // namespace
+
+std::size_t count_distinct_orders(std::span<const ExecEvent> events) {
+    std::unordered_set<OrderKey> keys;
+    keys.reserve(events.size());
+    for (const ExecEvent& ev : events) {
+        keys.insert(make_order_key(ev));
+    }
+    return keys.size();
+}
+
+BacktestResult run_backtest_variant(std::span<const ExecEvent> events,
+                                    const ReconConfig& config,
+                                    const BacktestOptions& options) {
+    BacktestResult result{};
+    result.config = config;
+
+    const std::size_t orders = std::max<std::size_t>(
+        options.order_capacity_hint != 0 ? options.order_capacity_hint : count_distinct_orders(events), 1);
+    const std::size_t arena_bytes = options.arena_bytes != 0 ? options.arena_bytes : arena_bytes_for(orders);
+    const std::uint64_t start_tsc = events.empty() ? 0 : events.front().ingest_tsc;
+
+    // Rings are required by the Reconciler but unused in replay, except the
+    // output rings which are drained after every event
+    auto primary = std::make_unique<ExecRing>();
+    auto dropcopy = std::make_unique<ExecRing>();
+    auto divergence = std::make_unique<DivergenceRing>();
+    auto seq_gap = std::make_unique<SequenceGapRing>();
+    auto wheel = std::make_unique<util::WheelTimer>(start_tsc);
+    util::Arena arena{arena_bytes};
+    OrderStateStore store(arena, orders);
+    std::atomic<bool> stop{false};
+    auto recon = std::make_unique<Reconciler>(stop, *primary, *dropcopy, store, result.counters,
+                                              *divergence, *seq_gap, wheel.get(), config);
+
+    const std::uint64_t housekeeping_tsc = util::ns_to_tsc(HOUSEKEEPING_INTERVAL_NS);
+    std::uint64_t last_housekeeping_tsc = start_tsc;
+    Divergence div{};
+    SequenceGapEvent gap{};
+
+    const auto started = std::chrono::steady_clock::now();
+    for (const ExecEvent& ev : events) {
+        recon->replay_event(ev);
+        while (divergence->try_pop(div)) {
+            ++result.divergences_emitted;
+        }
+        while (seq_gap->try_pop(gap)) {
+        }
+
+        if (ev.ingest_tsc - last_housekeeping_tsc > housekeeping_tsc) {
+            result.peak_pending_timers = std::max(result.peak_pending_timers, recon->pending_timers());
+            recon->check_session_deadlines(ev.ingest_tsc);
+            if (config.enable_compaction) {
+                (void)recon->compact_quiet_orders(ev.ingest_tsc);
+            }
+            last_housekeeping_tsc = ev.ingest_tsc;
+        }
+    }
+
+    // Let every grace window opened by the stream run out
+    if (!events.empty()) {
+        result.peak_pending_timers = std::max(result.peak_pending_timers, recon->pending_timers());
+        recon->advance_to(events.back().ingest_tsc + util::ns_to_tsc(config.grace_period_ns) +
+                          wheel->tick_tsc());
+        while (divergence->try_pop(div)) {
+            ++result.divergences_emitted;
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    result.events = events.size();
+    result.timer_stats = recon->timer_stats();
+    result.wall_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    result.completed = true;
+    return result;
+}
+
+std::vector<BacktestResult> run_backtest(std::span<const ExecEvent> events,
+                                         std::span<const ReconConfig> variants,
+                                         const BacktestOptions& options) {
+    std::vector<BacktestResult> results(variants.size());
+    if (variants.empty()) {
+        return results;
+    }
+
+    // Size every variant's store once, from the shared stream
+    BacktestOptions shared = options;
+    if (shared.order_capacity_hint == 0) {
+        shared.order_capacity_hint = count_distinct_orders(events);
+    }
+
+    std::size_t threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp<std::size_t>(threads, 1, variants.size());
+
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < variants.size();
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                results[i] = run_backtest_variant(events, variants[i], shared);
+            } catch (const std::exception&) {
+                // Arena/store setup failed (e.g. out of memory); report as not completed
+                results[i] = BacktestResult{};
+                results[i].config = variants[i];
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    return results;
+}
+
+} // namespace core
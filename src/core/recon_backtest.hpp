@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/exec_event.hpp"
+#include "core/recon_config.hpp"
+#include "core/reconciler.hpp"
+#include "util/wheel_timer.hpp"
+
+namespace core {
+
+// What-if backtesting of ReconConfig variants over one captured event stream.
+//
+// The stream is loaded once and shared read-only. Each variant gets its own
+// Reconciler, OrderStateStore, Arena and WheelTimer and is replayed under
+// simulated time (the events' ingest_tsc), so variants are independent and
+// deterministic and run_backtest can spread them across all cores.
+
+struct BacktestOptions {
+    std::size_t threads{0};              // Worker threads; 0 = hardware concurrency
+    std::size_t order_capacity_hint{0};  // Store sizing; 0 = distinct orders in the stream
+    std::size_t arena_bytes{0};          // Per-variant arena; 0 = sized from the capacity hint
+};
+
+struct BacktestResult {
+    ReconConfig config{};
+    bool completed{false};                 // False if the variant could not be set up
+    std::uint64_t events{0};
+    ReconCounters counters{};              // Confirmed divergences, false positives avoided, ...
+    util::WheelTimer::Stats timer_stats{}; // Timer load: scheduled / expired / overflow
+    std::size_t peak_pending_timers{0};    // Max pending timers (wheel + FIFOs), sampled every simulated 10ms
+    std::uint64_t divergences_emitted{0};  // Records that reached the divergence ring
+    std::uint64_t wall_ns{0};              // Replay wall time for this variant
+};
+
+// Number of distinct orders (by OrderKey) in the stream.
+[[nodiscard]] std::size_t count_distinct_orders(std::span<const ExecEvent> events);
+
+// Replays events against a single variant on the calling thread.
+[[nodiscard]] BacktestResult run_backtest_variant(std::span<const ExecEvent> events,
+                                                  const ReconConfig& config,
+                                                  const BacktestOptions& options = {});
+
+// Replays events against every variant, in parallel. Results are in variant order
+// and identical to running each variant alone.
+[[nodiscard]] std::vector<BacktestResult> run_backtest(std::span<const ExecEvent> events,
+                                                       std::span<const ReconConfig> variants,
+                                                       const BacktestOptions& options = {});
+
+} // namespace core
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "core/exec_event.hpp"
+
 namespace core {
 
 // Configuration for two-stage reconciliation behavior.
@@ -15,6 +17,12 @@ struct ReconConfig {
     // Gap recheck period: when suppressed by gap, how long to wait before rechecking
     std::uint64_t gap_recheck_period_ns{100'000'000};  // 100ms default
 
+    // Both timer kinds have a constant duration, so each gets a FIFO deadline queue
+    // (util::DeadlineFifo) of this many entries, rounded up to a power of two;
+    // entries it refuses (full, clock skew) go to the WheelTimer
+    std::uint32_t grace_timer_capacity{1u << 18};
+    std::uint32_t gap_recheck_timer_capacity{1u << 14};
+
     // Gap close timeout: after this duration, consider gap closed even if missing messages
     // never arrived. This prevents indefinite suppression when messages are truly lost.
     // Should be longer than gap_recheck_period_ns to allow multiple rechecks.
@@ -28,6 +36,12 @@ struct ReconConfig {
     std::int64_t px_tolerance{0};     // Price tolerance in micro-units (0 = exact match)
     std::uint64_t timing_slack_ns{0}; // Timing tolerance (0 = exact match)
 
+    // Sides (source_bit mask) that must report on every order. A side outside the
+    // mask is still compared pairwise once it reports on an order, but its absence
+    // is not an EXISTENCE mismatch. Add source_bit(Source::PrimeBroker) for strict
+    // three-way recon where every order is given up to the PB.
+    std::uint8_t required_sides{DEFAULT_REQUIRED_SIDES};
+
     // Feature flags
     bool enable_windowed_recon{true};   // Enable two-stage pipeline (can disable for A/B testing)
     bool enable_gap_suppression{true};  // Suppress divergences during sequence gaps
@@ -35,6 +49,24 @@ struct ReconConfig {
     // FX-7054: Gap timeout - close gap after this duration if not recovered
     // This prevents indefinite suppression if messages are truly lost
     std::uint64_t gap_timeout_ns{30'000'000'000ULL};  // 30 seconds default
+
+    // Tombstone compaction: finished orders (Matched, terminal on both sides) quiet
+    // for this long are compacted to 16-byte tombstones by a bounded background sweep
+    bool enable_compaction{true};
+    std::uint64_t compaction_quiet_period_ns{10'000'000'000ULL};  // 10 seconds default
+    std::uint32_t compaction_sweep_budget{256};  // Store buckets visited per sweep step
+
+    // Stream liveness: a source silent (no exec event or heartbeat) for this long is
+    // declared down and the reconciler enters degraded mode, parking new grace entries
+    // that involve it instead of scheduling timers; parked orders are re-evaluated in
+    // bulk once it is active again. Keep it below grace_period_ns so a stalled feed is
+    // caught before its orders' timers fire, and above the feed's heartbeat interval.
+    // 0 = disabled.
+    std::uint64_t stream_liveness_timeout_ns{0};
+
+    // Jitter monitor: loop iterations at or above this cost are captured as incidents
+    // (stage breakdown, ring depths, pending timers). 0 = histogram/max only.
+    std::uint64_t jitter_threshold_ns{50'000};  // 50us default
 };
 
 static_assert(std::is_trivially_copyable_v<ReconConfig>, "ReconConfig must be trivially copyable");
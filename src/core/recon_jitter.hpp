@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ingest/spsc_ring.hpp"
+
+namespace core {
+
+// Stages of one Reconciler::run iteration, in loop order.
+enum class ReconStage : std::uint8_t {
+    Ingest = 0,        // Ring pops + process_event
+    TimerPoll = 1,     // Reconciler::poll_timers (grace / gap-recheck deadline callbacks)
+    Housekeeping = 2,  // check_gap_timeouts + tombstone compaction
+};
+
+inline constexpr std::size_t RECON_STAGE_COUNT = 3;
+
+[[nodiscard]] constexpr const char* recon_stage_name(ReconStage s) noexcept {
+    switch (s) {
+    case ReconStage::Ingest:
+        return "ingest";
+    case ReconStage::TimerPoll:
+        return "timer_poll";
+    case ReconStage::Housekeeping:
+        return "housekeeping";
+    }
+    return "unknown";
+}
+
+// Loop state the reconciler hands over when an iteration is captured.
+struct JitterContext {
+    std::uint32_t primary_depth{0};   // Primary ring depth at capture
+    std::uint32_t dropcopy_depth{0};  // DropCopy ring depth at capture
+    std::uint32_t prime_broker_depth{0};  // PrimeBroker ring depth (0 if not attached)
+    std::uint32_t pending_timers{0};  // Entries left in the timer wheel
+    std::uint32_t burst_events{0};    // Events consumed since the loop was last idle
+};
+
+// One slow iteration, as captured on the reconciler thread.
+struct JitterIncident {
+    std::uint64_t iteration{0};     // Iteration index (monotonic per monitor)
+    std::uint64_t start_tsc{0};     // TSC at iteration start
+    std::uint64_t total_cycles{0};  // Whole-iteration cost
+    std::array<std::uint64_t, RECON_STAGE_COUNT> stage_cycles{};
+    ReconStage slowest_stage{ReconStage::Ingest};
+    JitterContext context{};
+};
+
+static_assert(std::is_trivially_copyable_v<JitterIncident>, "JitterIncident must be trivially copyable");
+
+// Preallocated incident buffer; the reconciler produces, a reporter thread consumes.
+using JitterIncidentRing = ingest::SpscRing<JitterIncident, 256>;
+
+// ReconJitterMonitor measures the cycle cost of every reconciler loop iteration.
+//
+// The reconciler thread brackets each iteration with begin_iteration/end_iteration
+// and marks stage boundaries with end_stage. Every iteration lands in a log2
+// histogram and updates the running max. Iterations at or above the threshold are
+// captured with per-stage costs and loop context into an SPSC incident ring that
+// a reporter thread drains (drain_incidents); when the reporter lags, incidents
+// are dropped and counted rather than blocking the hot loop.
+//
+// Thread safety: single writer (reconciler thread). Histogram, max and counters are
+// relaxed atomics written with plain load+store, so any thread may read them.
+// drain_incidents must only be called from one consumer thread.
+//
+// Memory: all storage is inline; no allocations.
+class ReconJitterMonitor {
+public:
+    // Bucket b counts iterations whose cost has bit_width b, i.e. [2^(b-1), 2^b)
+    // cycles; the last bucket also absorbs everything larger.
+    static constexpr std::size_t HISTOGRAM_BUCKETS = 40;
+
+    explicit ReconJitterMonitor(std::uint64_t threshold_tsc = 0) noexcept
+        : threshold_tsc_(threshold_tsc) {}
+
+    ReconJitterMonitor(const ReconJitterMonitor&) = delete;
+    ReconJitterMonitor& operator=(const ReconJitterMonitor&) = delete;
+
+    // 0 disables incident capture (histogram and max are still kept)
+    void set_threshold_tsc(std::uint64_t threshold_tsc) noexcept { threshold_tsc_ = threshold_tsc; }
+    [[nodiscard]] std::uint64_t threshold_tsc() const noexcept { return threshold_tsc_; }
+
+    // ===== Reconciler thread =====
+
+    void begin_iteration(std::uint64_t tsc) noexcept {
+        iteration_start_tsc_ = tsc;
+        stage_start_tsc_ = tsc;
+        stage_cycles_ = {};
+    }
+
+    // Attributes the cycles since the previous boundary to stage
+    void end_stage(ReconStage stage, std::uint64_t tsc) noexcept {
+        stage_cycles_[static_cast<std::size_t>(stage)] += tsc - stage_start_tsc_;
+        stage_start_tsc_ = tsc;
+    }
+
+    // Records the iteration. Returns true if it met the threshold; the caller then
+    // calls capture_incident with the loop context.
+    [[nodiscard]] bool end_iteration(std::uint64_t tsc) noexcept {
+        last_cycles_ = tsc - iteration_start_tsc_;
+        bump(iterations_);
+        bump(histogram_[bucket_for(last_cycles_)]);
+        if (last_cycles_ > max_cycles_.load(std::memory_order_relaxed)) {
+            max_cycles_.store(last_cycles_, std::memory_order_relaxed);
+        }
+        return threshold_tsc_ != 0 && last_cycles_ >= threshold_tsc_;
+    }
+
+    // Captures the iteration just ended into the incident ring.
+    void capture_incident(const JitterContext& ctx) noexcept {
+        JitterIncident inc{};
+        inc.iteration = iterations_.load(std::memory_order_relaxed) - 1;
+        inc.start_tsc = iteration_start_tsc_;
+        inc.total_cycles = last_cycles_;
+        inc.stage_cycles = stage_cycles_;
+        std::size_t slowest = 0;
+        for (std::size_t i = 1; i < RECON_STAGE_COUNT; ++i) {
+            if (stage_cycles_[i] > stage_cycles_[slowest]) {
+                slowest = i;
+            }
+        }
+        inc.slowest_stage = static_cast<ReconStage>(slowest);
+        inc.context = ctx;
+
+        bump(incidents_);
+        if (!incident_ring_.try_push(inc)) {
+            bump(incident_drops_);
+        }
+    }
+
+    // ===== Reporter thread =====
+
+    // Pops every pending incident and hands it to fn(const JitterIncident&).
+    template <typename F>
+    std::size_t drain_incidents(F&& fn) {
+        std::size_t drained = 0;
+        JitterIncident inc{};
+        while (incident_ring_.try_pop(inc)) {
+            fn(inc);
+            ++drained;
+        }
+        return drained;
+    }
+
+    [[nodiscard]] std::uint64_t iterations() const noexcept { return iterations_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t max_cycles() const noexcept { return max_cycles_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t incidents() const noexcept { return incidents_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t incident_drops() const noexcept {
+        return incident_drops_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t histogram_count(std::size_t bucket) const noexcept {
+        return bucket < HISTOGRAM_BUCKETS ? histogram_[bucket].load(std::memory_order_relaxed) : 0;
+    }
+
+    // Upper bound (in cycles) of the histogram bucket holding quantile q (0..1).
+    [[nodiscard]] std::uint64_t quantile_upper_cycles(double q) const noexcept {
+        const std::uint64_t total = iterations();
+        if (total == 0) {
+            return 0;
+        }
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            seen += histogram_count(b);
+            if (seen > rank || seen == total) {
+                return b == 0 ? 0 : (std::uint64_t{1} << b) - 1;
+            }
+        }
+        return max_cycles();
+    }
+
+    [[nodiscard]] static constexpr std::size_t bucket_for(std::uint64_t cycles) noexcept {
+        const auto width = static_cast<std::size_t>(std::bit_width(cycles));
+        return width < HISTOGRAM_BUCKETS ? width : HISTOGRAM_BUCKETS - 1;
+    }
+
+private:
+    // Single writer: plain load+store avoids a locked RMW on the hot path
+    static void bump(std::atomic<std::uint64_t>& c) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t threshold_tsc_{0};
+
+    // Current iteration (reconciler thread only)
+    std::uint64_t iteration_start_tsc_{0};
+    std::uint64_t stage_start_tsc_{0};
+    std::uint64_t last_cycles_{0};
+    std::array<std::uint64_t, RECON_STAGE_COUNT> stage_cycles_{};
+
+    std::atomic<std::uint64_t> iterations_{0};
+    std::atomic<std::uint64_t> max_cycles_{0};
+    std::atomic<std::uint64_t> incidents_{0};
+    std::atomic<std::uint64_t> incident_drops_{0};
+    std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram_{};
+
+    JitterIncidentRing incident_ring_;
+};
+
+} // namespace core
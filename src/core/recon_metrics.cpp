@@ -0,0 +1,227 @@
+#include "core/recon_metrics.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+#include "util/tsc_calibration.hpp"
+
+namespace core {
+
+namespace {
+
+struct CounterField {
+    const char* name;
+    std::uint64_t ReconCounters::*field;
+    const char* help;
+};
+
+// One entry per ReconCounters field (checked below by size)
+constexpr CounterField RECON_COUNTER_FIELDS[] = {
+    {"fx_recon_internal_events", &ReconCounters::internal_events, "Primary execution events processed"},
+    {"fx_recon_dropcopy_events", &ReconCounters::dropcopy_events, "Drop-copy execution events processed"},
+    {"fx_recon_prime_broker_events", &ReconCounters::prime_broker_events, "Prime-broker execution events processed"},
+    {"fx_recon_divergence", &ReconCounters::divergence_total, "Divergences emitted"},
+    {"fx_recon_divergence_missing_fill", &ReconCounters::divergence_missing_fill, "Missing-fill divergences"},
+    {"fx_recon_divergence_phantom", &ReconCounters::divergence_phantom, "Phantom-order divergences"},
+    {"fx_recon_divergence_state_mismatch", &ReconCounters::divergence_state_mismatch, "State-mismatch divergences"},
+    {"fx_recon_divergence_quantity_mismatch", &ReconCounters::divergence_quantity_mismatch,
+     "Quantity-mismatch divergences"},
+    {"fx_recon_divergence_timing_anomaly", &ReconCounters::divergence_timing_anomaly, "Timing-anomaly divergences"},
+    {"fx_recon_divergence_ring_drops", &ReconCounters::divergence_ring_drops, "Divergences dropped on a full ring"},
+    {"fx_recon_store_overflow", &ReconCounters::store_overflow, "Events dropped because the order store was full"},
+    {"fx_recon_invalid_events", &ReconCounters::invalid_events, "Events dropped for out-of-range enum values"},
+    {"fx_recon_primary_seq_gaps", &ReconCounters::primary_seq_gaps, "Primary sequence gaps"},
+    {"fx_recon_primary_seq_duplicates", &ReconCounters::primary_seq_duplicates, "Primary duplicate sequence numbers"},
+    {"fx_recon_primary_seq_out_of_order", &ReconCounters::primary_seq_out_of_order,
+     "Primary out-of-order sequence numbers"},
+    {"fx_recon_dropcopy_seq_gaps", &ReconCounters::dropcopy_seq_gaps, "Drop-copy sequence gaps"},
+    {"fx_recon_dropcopy_seq_duplicates", &ReconCounters::dropcopy_seq_duplicates,
+     "Drop-copy duplicate sequence numbers"},
+    {"fx_recon_dropcopy_seq_out_of_order", &ReconCounters::dropcopy_seq_out_of_order,
+     "Drop-copy out-of-order sequence numbers"},
+    {"fx_recon_prime_broker_seq_gaps", &ReconCounters::prime_broker_seq_gaps, "Prime-broker sequence gaps"},
+    {"fx_recon_prime_broker_seq_duplicates", &ReconCounters::prime_broker_seq_duplicates,
+     "Prime-broker duplicate sequence numbers"},
+    {"fx_recon_prime_broker_seq_out_of_order", &ReconCounters::prime_broker_seq_out_of_order,
+     "Prime-broker out-of-order sequence numbers"},
+    {"fx_recon_sequence_gap_ring_drops", &ReconCounters::sequence_gap_ring_drops,
+     "Sequence gap events dropped on a full ring"},
+    {"fx_recon_mismatch_observed", &ReconCounters::mismatch_observed, "Mismatches that entered the grace period"},
+    {"fx_recon_mismatch_confirmed", &ReconCounters::mismatch_confirmed, "Mismatches confirmed after grace"},
+    {"fx_recon_false_positive_avoided", &ReconCounters::false_positive_avoided,
+     "Mismatches resolved within the grace period"},
+    {"fx_recon_orders_matched", &ReconCounters::orders_matched, "Orders reconciled with all sides agreeing"},
+    {"fx_recon_divergence_deduped", &ReconCounters::divergence_deduped,
+     "Divergences suppressed by the dedup window"},
+    {"fx_recon_stale_timers_skipped", &ReconCounters::stale_timers_skipped, "Stale grace timers skipped"},
+    {"fx_recon_gap_suppressions", &ReconCounters::gap_suppressions, "Confirmations deferred by open sequence gaps"},
+    {"fx_recon_gaps_closed", &ReconCounters::gaps_closed, "Sequence gaps closed"},
+    {"fx_recon_gap_timeouts", &ReconCounters::gap_timeouts, "Sequence gaps closed by gap_timeout_ns"},
+    {"fx_recon_timer_overflow", &ReconCounters::timer_overflow, "Grace timers lost to wheel bucket overflow"},
+    {"fx_recon_divergence_resolved", &ReconCounters::divergence_resolved, "Confirmed divergences later resolved"},
+    {"fx_recon_gaps_closed_by_timeout", &ReconCounters::gaps_closed_by_timeout,
+     "Sequence gaps closed by gap_close_timeout_ns"},
+    {"fx_recon_gaps_closed_by_fill", &ReconCounters::gaps_closed_by_fill,
+     "Sequence gaps closed by out-of-order fill"},
+    {"fx_recon_orders_compacted", &ReconCounters::orders_compacted, "Finished orders compacted to tombstones"},
+    {"fx_recon_tombstone_duplicates", &ReconCounters::tombstone_duplicates,
+     "Late events repeating a tombstone's final state"},
+    {"fx_recon_tombstone_late_mismatch", &ReconCounters::tombstone_late_mismatch,
+     "Late events disagreeing with a tombstone's final state"},
+    {"fx_recon_session_logouts", &ReconCounters::session_logouts, "Session logouts"},
+    {"fx_recon_session_logons", &ReconCounters::session_logons, "Session logons"},
+    {"fx_recon_session_resets", &ReconCounters::session_resets, "Session sequence resets"},
+    {"fx_recon_session_mass_cancels", &ReconCounters::session_mass_cancels, "Session mass cancels"},
+    {"fx_recon_session_orders_suspended", &ReconCounters::session_orders_suspended, "Orders parked by a logout"},
+    {"fx_recon_session_orders_resumed", &ReconCounters::session_orders_resumed,
+     "Parked orders re-evaluated on logon or reset"},
+    {"fx_recon_session_orders_mass_canceled", &ReconCounters::session_orders_mass_canceled,
+     "Orders canceled by a mass cancel"},
+    {"fx_recon_session_suppressions", &ReconCounters::session_suppressions,
+     "Grace entries redirected because a session was down"},
+    {"fx_recon_stream_downs", &ReconCounters::stream_downs, "Sources declared down by the liveness monitor"},
+    {"fx_recon_stream_ups", &ReconCounters::stream_ups, "Down sources active again"},
+    {"fx_recon_stream_orders_parked", &ReconCounters::stream_orders_parked,
+     "Grace entries parked while a source stream was down"},
+    {"fx_recon_stream_orders_resumed", &ReconCounters::stream_orders_resumed,
+     "Parked orders re-evaluated once their streams were up"},
+    {"fx_recon_transitions_published", &ReconCounters::transitions_published,
+     "ReconState transitions published on the CDC ring"},
+    {"fx_recon_transition_ring_drops", &ReconCounters::transition_ring_drops,
+     "ReconState transitions dropped on a full CDC ring"},
+};
+
+static_assert(sizeof(RECON_COUNTER_FIELDS) / sizeof(RECON_COUNTER_FIELDS[0]) ==
+                  sizeof(ReconCounters) / sizeof(std::uint64_t),
+              "Add new ReconCounters fields to RECON_COUNTER_FIELDS");
+
+// Prometheus label values are conventionally lower snake case
+constexpr const char* source_label(Source s) noexcept {
+    switch (s) {
+    case Source::Primary:
+        return "primary";
+    case Source::DropCopy:
+        return "dropcopy";
+    case Source::PrimeBroker:
+        return "prime_broker";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+void append_recon_metrics(util::MetricsText& out, const ReconStatsSnapshot& snap) {
+    for (const CounterField& f : RECON_COUNTER_FIELDS) {
+        out.counter(f.name, f.help, snap.counters.*f.field);
+    }
+
+    out.counter("fx_recon_timer_scheduled", "Grace timers scheduled", snap.timer.scheduled);
+    out.counter("fx_recon_timer_expired", "Grace timers expired", snap.timer.expired);
+    out.counter("fx_recon_timer_rescheduled", "Far-future timers carried to a later wheel lap",
+                snap.timer.rescheduled);
+    out.counter("fx_recon_timer_overflow_dropped", "Timers dropped on a full wheel bucket",
+                snap.timer.overflow_dropped);
+    out.gauge("fx_recon_timer_pending", "Timers pending in the wheel and deadline FIFOs",
+              static_cast<double>(snap.pending_timers));
+    out.counter("fx_recon_timer_fifo_refused", "Timers a deadline FIFO refused (full or out of order) and left to the wheel",
+                snap.grace_fifo.refused, "queue=\"grace\"");
+    out.counter("fx_recon_timer_fifo_refused", "Timers a deadline FIFO refused (full or out of order) and left to the wheel",
+                snap.gap_recheck_fifo.refused, "queue=\"gap_recheck\"");
+
+    char labels[32];
+    for (std::uint32_t p = 0; p < snap.store_partition_count; ++p) {
+        std::snprintf(labels, sizeof(labels), "partition=\"%u\"", p);
+        out.gauge("fx_recon_store_partition_live", "Live orders in a store partition",
+                  static_cast<double>(snap.store_partitions[p].live), labels);
+    }
+    for (std::uint32_t p = 0; p < snap.store_partition_count; ++p) {
+        std::snprintf(labels, sizeof(labels), "partition=\"%u\"", p);
+        out.gauge("fx_recon_store_partition_quota", "Live-order quota of a store partition",
+                  static_cast<double>(snap.store_partitions[p].quota), labels);
+    }
+    for (std::uint32_t p = 0; p < snap.store_partition_count; ++p) {
+        std::snprintf(labels, sizeof(labels), "partition=\"%u\"", p);
+        out.counter("fx_recon_store_partition_overflow", "Orders refused by a store partition",
+                    snap.store_partitions[p].overflow, labels);
+    }
+    const std::uint64_t now = util::rdtsc();
+    const std::uint64_t age_tsc = snap.published_tsc != 0 && now > snap.published_tsc ? now - snap.published_tsc : 0;
+    out.gauge("fx_recon_stats_age_seconds", "Age of the reconciler statistics snapshot",
+              static_cast<double>(util::tsc_to_ns(age_tsc)) / 1e9);
+}
+
+void append_ingest_metrics(util::MetricsText& out, std::span<const IngestMetricsSource> sources) {
+    static constexpr struct {
+        const char* name;
+        std::atomic<std::size_t> ingest::ThreadStats::*field;
+        const char* help;
+    } FIELDS[] = {
+        {"fx_recon_ingest_produced", &ingest::ThreadStats::produced, "Events pushed to the reconciler ring"},
+        {"fx_recon_ingest_parse_failures", &ingest::ThreadStats::parse_failures, "Messages that failed to decode"},
+        {"fx_recon_ingest_drops", &ingest::ThreadStats::drops, "Events dropped on a full reconciler ring"},
+        {"fx_recon_ingest_rejected", &ingest::ThreadStats::rejected, "Events with out-of-range enums dropped at ingest"},
+    };
+
+    char labels[48];
+    for (const auto& f : FIELDS) {
+        for (const IngestMetricsSource& src : sources) {
+            std::snprintf(labels, sizeof(labels), "source=\"%s\"", source_label(src.source));
+            out.counter(f.name, f.help, (src.stats->*f.field).load(std::memory_order_relaxed), labels);
+        }
+    }
+}
+
+void append_jitter_metrics(util::MetricsText& out, const ReconJitterMonitor& jitter) {
+    static constexpr struct {
+        double q;
+        const char* label;
+    } QUANTILES[] = {{0.5, "quantile=\"0.5\""},
+                     {0.99, "quantile=\"0.99\""},
+                     {0.999, "quantile=\"0.999\""},
+                     {0.9999, "quantile=\"0.9999\""}};
+
+    // Histogram buckets are powers of two in cycles; each quantile is a bucket upper bound
+    for (const auto& q : QUANTILES) {
+        out.gauge("fx_recon_loop_latency_ns", "Reconciler loop iteration cost (histogram bucket upper bound)",
+                  static_cast<double>(util::tsc_to_ns(jitter.quantile_upper_cycles(q.q))), q.label);
+    }
+    out.gauge("fx_recon_loop_latency_max_ns", "Slowest reconciler loop iteration",
+              static_cast<double>(util::tsc_to_ns(jitter.max_cycles())));
+    out.counter("fx_recon_loop_iterations", "Reconciler loop iterations", jitter.iterations());
+    out.counter("fx_recon_loop_stalls", "Loop iterations at or above the jitter threshold", jitter.incidents());
+    out.counter("fx_recon_loop_stall_drops", "Stall incidents dropped on a full incident ring",
+                jitter.incident_drops());
+}
+
+void append_logger_metrics(util::MetricsText& out, const util::AsyncLogger& logger) {
+    out.counter("fx_recon_log_written", "Hot log records written", logger.written());
+    out.counter("fx_recon_log_dropped", "Hot log records dropped on a full log ring", logger.dropped());
+    out.counter("fx_recon_log_io_errors", "Hot log file writes that failed", logger.io_errors());
+}
+
+void append_ring_depths(util::MetricsText& out, std::span<const RingDepth> rings) {
+    char labels[64];
+    for (const RingDepth& ring : rings) {
+        std::snprintf(labels, sizeof(labels), "ring=\"%s\"", ring.name);
+        out.gauge("fx_recon_ring_depth", "Entries waiting in an SPSC ring", static_cast<double>(ring.depth), labels);
+    }
+}
+
+void append_divergence_lane_metrics(util::MetricsText& out, const DivergenceLanes& lanes) {
+    constexpr DivergencePriority LANES[] = {DivergencePriority::Critical, DivergencePriority::High,
+                                            DivergencePriority::Low};
+    char labels[64];
+    for (const DivergencePriority lane : LANES) {
+        std::snprintf(labels, sizeof(labels), "lane=\"%s\"", to_string(lane));
+        out.gauge("fx_recon_divergence_lane_depth", "Divergences waiting in a priority lane",
+                  static_cast<double>(lanes.lane_size_approx(lane)), labels);
+    }
+    for (const DivergencePriority lane : LANES) {
+        std::snprintf(labels, sizeof(labels), "lane=\"%s\"", to_string(lane));
+        out.counter("fx_recon_divergence_lane_drops", "Divergences dropped on a full priority lane",
+                    lanes.drops(lane), labels);
+    }
+}
+
+} // namespace core
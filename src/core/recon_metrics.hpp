@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "core/reconciler.hpp"
+#include "ingest/thread_stats.hpp"
+#include "util/async_log.hpp"
+#include "util/metrics_exporter.hpp"
+
+namespace core {
+
+// Renderers for the daemon's /metrics page. Each reads only data that is safe to
+// access from the exporter thread while the daemon runs:
+//   - ReconStatsSnapshot (seqlock copy published by the reconciler)
+//   - ingest::ThreadStats, ReconJitterMonitor, AsyncLogger (single-writer relaxed atomics)
+//   - SPSC ring depths (size_approx)
+// All metric names are prefixed fx_recon_. Functions taking spans emit one sample per
+// element, so each metric family stays contiguous as the exposition format requires.
+
+// Every ReconCounters field as fx_recon_<field>_total, plus timer-wheel statistics.
+void append_recon_metrics(util::MetricsText& out, const ReconStatsSnapshot& snap);
+
+struct IngestMetricsSource {
+    Source source;
+    const ingest::ThreadStats* stats;
+};
+
+// Ingest thread counters, one sample per source (labelled source="<name>").
+void append_ingest_metrics(util::MetricsText& out, std::span<const IngestMetricsSource> sources);
+
+// Loop latency histogram quantiles (p50/p99/p99.9/p99.99/max, in ns) and stall counts.
+void append_jitter_metrics(util::MetricsText& out, const ReconJitterMonitor& jitter);
+
+// Hot logger records written and dropped.
+void append_logger_metrics(util::MetricsText& out, const util::AsyncLogger& logger);
+
+struct RingDepth {
+    const char* name;
+    std::size_t depth;  // size_approx() at render time
+};
+
+// Queue depth of each SPSC ring (labelled ring="<name>").
+void append_ring_depths(util::MetricsText& out, std::span<const RingDepth> rings);
+
+// Depth and drops of each divergence priority lane (labelled lane="<priority>").
+void append_divergence_lane_metrics(util::MetricsText& out, const DivergenceLanes& lanes);
+
+} // namespace core
@@ -4,6 +4,7 @@
 
 #include "core/order_state.hpp"
 #include "core/recon_state.hpp"
+#include "util/deadline_fifo.hpp"
 #include "util/wheel_timer.hpp"
 
 namespace core {
@@ -13,7 +14,7 @@ namespace core {
 //
 // Pattern overview:
 // - Each OrderState has a timer_generation counter
-// - When scheduling, we store (key, current_generation) in the wheel
+// - When scheduling, we store (pool_handle, current_generation) in the wheel
 // - To "cancel", we just increment timer_generation (O(1), no wheel lookup)
 // - On expiry callback, we compare scheduled generation vs current generation
 // - If mismatch, the timer was cancelled - skip processing
@@ -37,7 +38,22 @@ namespace core {
     os.recon_deadline_tsc = deadline_tsc;
 
     // Schedule with current generation
-    return wheel.schedule(os.key, os.timer_generation, deadline_tsc);
+    return wheel.schedule(os.pool_handle, os.timer_generation, deadline_tsc);
+}
+
+// Schedule on a fixed-duration FIFO, falling back to the wheel for entries the FIFO
+// refuses (full, or a deadline earlier than its newest entry).
+// Returns true if either accepted it.
+[[nodiscard]] inline bool schedule_recon_deadline(
+    util::DeadlineFifo& fifo,
+    util::WheelTimer& wheel,
+    OrderState& os,
+    std::uint64_t deadline_tsc
+) noexcept {
+    ++os.timer_generation;
+    os.recon_deadline_tsc = deadline_tsc;
+    return fifo.push(os.pool_handle, os.timer_generation, deadline_tsc) ||
+           wheel.schedule(os.pool_handle, os.timer_generation, deadline_tsc);
 }
 
 // "Cancel" a timer by incrementing the generation.
@@ -80,7 +96,7 @@ inline void cancel_recon_deadline(OrderState& os) noexcept {
 //         OrderState* os = store_.upsert(ev);
 //         apply_exec(*os, ev);
 //
-//         if (os->seen_internal && os->seen_dropcopy) {
+//         if (Reconciler::both_sides_seen(*os)) {
 //             MismatchMask mismatch = compute_mismatch(*os);
 //
 //             if (mismatch.any() && os->recon_state != ReconState::InGrace) {
@@ -109,16 +125,16 @@ inline void cancel_recon_deadline(OrderState& os) noexcept {
 //
 //             // Poll timer wheel for expired deadlines
 //             uint64_t now = rdtsc_ns();
-//             timer_wheel_.poll_expired(now, [this](OrderKey key, uint32_t gen) {
-//                 on_deadline_expired(key, gen);
+//             timer_wheel_.poll_expired(now, [this](uint32_t ref, uint32_t gen) {
+//                 on_deadline_expired(ref, gen);
 //             });
 //         }
 //     }
 //
 // SCENARIO 3: Handling timer expiry
 //
-//     void Reconciler::on_deadline_expired(OrderKey key, uint32_t scheduled_gen) {
-//         OrderState* os = store_.find(key);
+//     void Reconciler::on_deadline_expired(uint32_t ref, uint32_t scheduled_gen) {
+//         OrderState* os = store_.resolve(ref);  // One indexed load, no hash probe
 //         if (!os) return;  // Order was recycled
 //
 //         if (!is_timer_valid(*os, scheduled_gen)) {
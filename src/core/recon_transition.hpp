@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "core/order_state.hpp"
+#include "core/recon_state.hpp"
+#include "ingest/spsc_ring.hpp"
+
+namespace core {
+
+// One ReconState change of one order, as published on the change-data-capture
+// (CDC) stream. Fixed size so the reconciler writes it with a single ring push.
+struct ReconTransition {
+    OrderKey key{0};
+    std::uint64_t tsc{0};     // Reconciler time of the change (event or deadline TSC)
+    std::uint64_t seq{0};     // Per-reconciler transition number, starts at 1, no gaps
+                              // on the producer side; a gap seen by the consumer is a ring drop
+    ReconState from{ReconState::Unknown};
+    ReconState to{ReconState::Unknown};
+    std::uint8_t mismatch{0};  // MismatchMask bits after the change
+    std::uint8_t reserved[5]{};
+};
+
+static_assert(sizeof(ReconTransition) == 32, "ReconTransition must stay 32 bytes");
+static_assert(std::is_trivially_copyable_v<ReconTransition>, "ReconTransition must be trivially copyable");
+
+using ReconTransitionRing = ingest::SpscRing<ReconTransition, 1u << 16>;
+
+// Consumer side of the CDC stream. Pops transitions in batches of up to
+// BATCH_SIZE into an inline buffer and hands each batch to a sink, so a
+// publisher (Aeron, Kafka bridge, file) pays its per-message cost once per
+// batch. Tracks the transition sequence to count records the reconciler had
+// to drop while the consumer lagged.
+//
+// Single consumer thread only. No allocations.
+class ReconTransitionPublisher {
+public:
+    static constexpr std::size_t BATCH_SIZE = 256;
+
+    explicit ReconTransitionPublisher(ReconTransitionRing& ring) noexcept : ring_(ring) {}
+
+    // Drains the ring, calling sink(std::span<const ReconTransition>) once per
+    // batch. Returns the number of transitions published.
+    template <typename Sink>
+    std::size_t publish(Sink&& sink) {
+        std::size_t published = 0;
+        for (;;) {
+            std::size_t n = 0;
+            while (n < BATCH_SIZE && ring_.try_pop(batch_[n])) {
+                note_sequence(batch_[n].seq);
+                ++n;
+            }
+            if (n == 0) {
+                return published;
+            }
+            sink(std::span<const ReconTransition>(batch_.data(), n));
+            published += n;
+            ++batches_;
+            if (n < BATCH_SIZE) {
+                return published;
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t batches() const noexcept { return batches_; }
+    // Transitions missing from the stream (dropped on a full ring)
+    [[nodiscard]] std::uint64_t missed() const noexcept { return missed_; }
+    [[nodiscard]] std::uint64_t last_seq() const noexcept { return last_seq_; }
+
+private:
+    void note_sequence(std::uint64_t seq) noexcept {
+        if (seq > last_seq_ + 1) {
+            missed_ += seq - last_seq_ - 1;
+        }
+        last_seq_ = seq;
+    }
+
+    ReconTransitionRing& ring_;
+    std::array<ReconTransition, BATCH_SIZE> batch_{};
+    std::uint64_t last_seq_{0};
+    std::uint64_t batches_{0};
+    std::uint64_t missed_{0};
+};
+
+} // namespace core
@@ -1,10 +1,13 @@
 #include "core/reconciler.hpp"
 
+#include <algorithm>
 #include <thread>
 
 #include "core/order_state.hpp"
 #include "core/order_lifecycle.hpp"
 #include "core/gap_uncertainty.hpp"
+#include "core/ingest_annotator.hpp"
+#include "util/alloc_guard.hpp"
 #include "util/async_log.hpp"
 #include "util/rdtsc.hpp"
 #include "util/tsc_calibration.hpp"
@@ -24,6 +27,13 @@
 
 namespace core {
 
+namespace {
+// Overload warnings (ring drops, store overflow) fire once per event while the
+// condition lasts; the rest are counted into the next line that gets through.
+constexpr std::uint32_t OVERLOAD_LOG_PER_SEC = 10;
+constexpr std::uint32_t OVERLOAD_LOG_BURST = 20;
+} // namespace
+
 Reconciler::Reconciler(std::atomic<bool>& stop_flag,
                        ingest::SpscRing<core::ExecEvent, 1u << 16>& primary,
                        ingest::SpscRing<core::ExecEvent, 1u << 16>& dropcopy,
@@ -48,7 +58,7 @@ Reconciler::Reconciler(std::atomic<bool>& stop_flag,
                        DivergenceRing& divergence_ring,
                        SequenceGapRing& seq_gap_ring,
                        util::WheelTimer* timer_wheel,
-                       const ReconConfig& config) noexcept
+                       const ReconConfig& config)
     : stop_flag_(stop_flag),
       primary_(primary),
       dropcopy_(dropcopy),
@@ -57,7 +67,9 @@ Reconciler::Reconciler(std::atomic<bool>& stop_flag,
       divergence_ring_(divergence_ring),
       seq_gap_ring_(seq_gap_ring),
       timer_wheel_(timer_wheel),
-      config_(config) {}
+      config_(config),
+      grace_timers_(timer_wheel ? config.grace_timer_capacity : 1),
+      gap_recheck_timers_(timer_wheel ? config.gap_recheck_timer_capacity : 1) {}
 
 void Reconciler::increment_divergence_counter(DivergenceType type) noexcept {
     switch (type) {
@@ -83,17 +95,28 @@ void Reconciler::increment_divergence_counter(DivergenceType type) noexcept {
 }
 
 void Reconciler::process_event(const ExecEvent& ev) noexcept {
-    // === Sequence tracking (unchanged) ===
+    // === Sequence tracking ===
+    // Subscriber threads validate, key and sequence-check events (IngestAnnotator);
+    // unannotated events (tests, replay) get the same treatment here.
     SequenceGapEvent gap_ev{};
-    SequenceGapEvent* gap_ptr = &gap_ev;
     const std::uint64_t now_tsc = ev.ingest_tsc;  // Use event timestamp for determinism
-
+    if (flight_) {
+        flight_->record_event(FlightKind::Event, ev, ev.order_key);
+    }
     bool has_gap = false;
-    if (ev.source == Source::Primary) {
-        has_gap = track_sequence(primary_seq_tracker_, ev.source, ev.session_id, ev.seq_num, now_tsc, gap_ptr);
-    } else if (ev.source == Source::DropCopy) {
-        has_gap = track_sequence(dropcopy_seq_tracker_, ev.source, ev.session_id, ev.seq_num, now_tsc, gap_ptr);
+    if ((ev.ingest_flags & IngestFlags::SEQ_TRACKED) != 0) {
+        apply_annotated_sequence(tracker_for(ev.source), ev, now_tsc);
+        has_gap = annotated_gap_event(ev, now_tsc, gap_ev);
+    } else {
+        if ((ev.ingest_flags & IngestFlags::ORDER_KEYED) == 0 &&
+            !is_valid_exec_enums(ev.source, ev.exec_type, ev.ord_status)) {
+            ++counters_.invalid_events;
+            return;
+        }
+        has_gap = track_sequence(tracker_for(ev.source), ev.source, ev.session_id, ev.seq_num,
+                                 now_tsc, &gap_ev);
     }
+    liveness_.on_activity(ev.source, now_tsc);
 
     if (has_gap) {
         switch (gap_ev.source) {
@@ -121,60 +144,83 @@ void Reconciler::process_event(const ExecEvent& ev) noexcept {
                 ++counters_.dropcopy_seq_out_of_order;
             }
             break;
+        case Source::PrimeBroker:
+            if (gap_ev.kind == GapKind::Gap) {
+                ++counters_.prime_broker_seq_gaps;
+            } else if (gap_ev.kind == GapKind::Duplicate) {
+                ++counters_.prime_broker_seq_duplicates;
+            } else if (gap_ev.kind == GapKind::GapFill) {
+                ++counters_.prime_broker_seq_out_of_order;
+                ++counters_.gaps_closed_by_fill;
+            } else {
+                ++counters_.prime_broker_seq_out_of_order;
+            }
+            break;
         }
 
         // Note: gaps_closed_by_fill is incremented in the switch above when kind == GapFill
 
         if (!seq_gap_ring_.try_push(gap_ev)) {
             ++counters_.sequence_gap_ring_drops;
-            LOG_HOT_LVL(::util::LogLevel::Warn, "RECON",
-                        "seq_gap_ring_drop src=%u session=%u expected=%llu seen=%llu kind=%u",
-                        static_cast<unsigned>(gap_ev.source), gap_ev.session_id,
-                        static_cast<unsigned long long>(gap_ev.expected_seq),
-                        static_cast<unsigned long long>(gap_ev.seen_seq),
-                        static_cast<unsigned>(gap_ev.kind));
+            LOG_HOT_RATE_LIMITED(::util::LogLevel::Warn, "RECON", OVERLOAD_LOG_PER_SEC, OVERLOAD_LOG_BURST,
+                                 "seq_gap_ring_drop src=%u session=%u expected=%llu seen=%llu kind=%u",
+                                 static_cast<unsigned>(gap_ev.source), gap_ev.session_id,
+                                 static_cast<unsigned long long>(gap_ev.expected_seq),
+                                 static_cast<unsigned long long>(gap_ev.seen_seq),
+                                 static_cast<unsigned>(gap_ev.kind));
         }
     }
 
     // === Get/create order state ===
     OrderState* st = store_.upsert(ev);
     if (!st) {
+        // Finished orders are compacted to tombstones; late events must not re-create them
+        if (const OrderTombstone* tomb = store_.find_tombstone(event_order_key(ev))) {
+            on_tombstoned_event(*tomb, ev);
+            return;
+        }
         ++counters_.store_overflow;
-        LOG_HOT_LVL(::util::LogLevel::Warn, "RECON",
-                    "store_overflow src=%u session=%u seq=%llu",
-                    static_cast<unsigned>(ev.source), ev.session_id,
-                    static_cast<unsigned long long>(ev.seq_num));
+        LOG_HOT_RATE_LIMITED(::util::LogLevel::Warn, "RECON", OVERLOAD_LOG_PER_SEC, OVERLOAD_LOG_BURST,
+                             "store_overflow src=%u session=%u seq=%llu",
+                             static_cast<unsigned>(ev.source), ev.session_id,
+                             static_cast<unsigned long long>(ev.seq_num));
         return;
     }
+    if (const std::uint16_t link = st->session_link[source_index(ev.source)]; link != 0) {
+        store_.sessions().session_at(link - 1u).last_activity_tsc = now_tsc;
+    }
 
     // FX-7054: Mark orders affected by open gaps using per-session epoch tracking
     // Note: mark_gap_uncertainty() internally increments orders_in_gap_count
     // IMPORTANT: Mark order if ANY gap is open (not just the event's source), because
-    // reconciliation between Primary and DropCopy can be affected by gaps on either side.
-    if (primary_seq_tracker_.gap_open) {
-        mark_gap_uncertainty(*st, Source::Primary, primary_seq_tracker_);
-    }
-    if (dropcopy_seq_tracker_.gap_open) {
-        mark_gap_uncertainty(*st, Source::DropCopy, dropcopy_seq_tracker_);
+    // reconciliation between the sides can be affected by a gap on any of them.
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        if (seq_trackers_[i].gap_open) {
+            mark_gap_uncertainty(*st, static_cast<Source>(i), seq_trackers_[i]);
+        }
     }
 
-    // === Update appropriate view ===
-    bool ok = false;
-    if (ev.source == Source::Primary) {
+    // === Update the event's side ===
+    switch (ev.source) {
+    case Source::Primary:
         ++counters_.internal_events;
-        ok = apply_internal_exec(*st, ev);
-        st->primary_last_seen_tsc = now_tsc;
-    } else {
+        break;
+    case Source::DropCopy:
         ++counters_.dropcopy_events;
-        ok = apply_dropcopy_exec(*st, ev);
-        st->dropcopy_last_seen_tsc = now_tsc;
+        break;
+    case Source::PrimeBroker:
+        ++counters_.prime_broker_events;
+        break;
     }
+    const bool ok = apply_exec(*st, ev);
+    st->last_seen_tsc[source_index(ev.source)] = now_tsc;
+    store_.refresh_mirror(*st);
 
     // Handle invalid state transitions (emit immediately - this is an error)
     if (!ok) {
         MismatchMask error_mismatch{};
         error_mismatch.set(MismatchMask::STATUS);
-        st->recon_state = ReconState::DivergedConfirmed;
+        set_recon_state(*st, ReconState::DivergedConfirmed, now_tsc);
         emit_confirmed_divergence(*st, error_mismatch, now_tsc);
         ++counters_.mismatch_confirmed;
         return;
@@ -183,8 +229,7 @@ void Reconciler::process_event(const ExecEvent& ev) noexcept {
     // === Two-stage reconciliation ===
     if (config_.enable_windowed_recon && timer_wheel_) {
         // Compute current mismatch BEFORE state transition
-        const MismatchMask new_mismatch = compute_mismatch(*st, config_.qty_tolerance,
-                                                            config_.px_tolerance);
+        const MismatchMask new_mismatch = current_mismatch_of(*st);
         st->current_mismatch = new_mismatch;  // Set BEFORE transition
 
         // Handle state transition based on mismatch
@@ -195,10 +240,10 @@ void Reconciler::process_event(const ExecEvent& ev) noexcept {
         if (classify_divergence(*st, div, qty_tolerance_, px_tolerance_, timing_slack_)) {
             if (!divergence_ring_.try_push(div)) {
                 ++counters_.divergence_ring_drops;
-                LOG_HOT_LVL(::util::LogLevel::Warn, "RECON",
-                            "divergence_ring_drop type=%u key=%llu",
-                            static_cast<unsigned>(div.type),
-                            static_cast<unsigned long long>(div.key));
+                LOG_HOT_RATE_LIMITED(::util::LogLevel::Warn, "RECON", OVERLOAD_LOG_PER_SEC, OVERLOAD_LOG_BURST,
+                                     "divergence_ring_drop type=%u key=%llu",
+                                     static_cast<unsigned>(div.type),
+                                     static_cast<unsigned long long>(div.key));
                 return;
             }
             ++counters_.divergence_total;
@@ -210,6 +255,7 @@ void Reconciler::process_event(const ExecEvent& ev) noexcept {
 void Reconciler::run() {
     ExecEvent primary_evt{};
     ExecEvent dropcopy_evt{};
+    ExecEvent prime_broker_evt{};
     std::uint32_t backoff = 0;
     last_poll_tsc_ = util::rdtsc();
     
@@ -218,29 +264,53 @@ void Reconciler::run() {
     std::uint64_t last_gap_check_tsc = util::rdtsc();
     const std::uint64_t gap_check_interval_tsc = util::ns_to_tsc(GAP_CHECK_INTERVAL_NS);
 
+    // Housekeeping cadence: session events, mass-cancel deadlines and bounded
+    // tombstone compaction sweeps
+    static constexpr std::uint64_t HOUSEKEEPING_INTERVAL_NS = 10'000'000ULL;  // 10ms
+    std::uint64_t last_housekeeping_tsc = last_gap_check_tsc;
+    const std::uint64_t housekeeping_interval_tsc = util::ns_to_tsc(HOUSEKEEPING_INTERVAL_NS);
+    SessionEvent session_evt{};
+
+    // Events consumed since the loop was last idle (jitter incident context)
+    std::uint32_t burst_events = 0;
+
+    // Everything below runs on the hot thread; no heap allocation allowed
+    util::ScopedHotPhase hot_phase;
+
     while (!stop_flag_.load(std::memory_order_acquire)) {
         bool consumed = false;
+        jitter_.begin_iteration(util::rdtsc());
 
         // Hot path: drain event queues
         if (primary_.try_pop(primary_evt)) {
             process_event(primary_evt);
             last_poll_tsc_ = primary_evt.ingest_tsc;
             consumed = true;
+            ++burst_events;
         }
         if (dropcopy_.try_pop(dropcopy_evt)) {
             process_event(dropcopy_evt);
             last_poll_tsc_ = std::max(last_poll_tsc_, dropcopy_evt.ingest_tsc);
             consumed = true;
+            ++burst_events;
+        }
+        if (prime_broker_ && prime_broker_->try_pop(prime_broker_evt)) {
+            process_event(prime_broker_evt);
+            last_poll_tsc_ = std::max(last_poll_tsc_, prime_broker_evt.ingest_tsc);
+            consumed = true;
+            ++burst_events;
         }
 
         // Warm path: poll timer wheel for expired deadlines
         // Always use fresh rdtsc() to avoid missing timer deadlines
         // (using stale last_poll_tsc_ could cause timers to be skipped)
+        // Skip the poll entirely while nothing can be due (next_deadline_tsc is a
+        // tick-granular lower bound maintained by the wheel's occupancy bitmap)
         const std::uint64_t now = util::rdtsc();
-        if (timer_wheel_) {
-            timer_wheel_->poll_expired(now, [this](OrderKey key, std::uint32_t gen) {
-                on_grace_deadline_expired(key, gen);
-            });
+        jitter_.end_stage(ReconStage::Ingest, now);
+        if (now >= next_timer_deadline_tsc()) {
+            poll_timers(now);
+            jitter_.end_stage(ReconStage::TimerPoll, util::rdtsc());
         }
         
         // FX-7054: Periodic gap timeout check (not in hot path - once per second)
@@ -249,8 +319,47 @@ void Reconciler::run() {
             last_gap_check_tsc = now;
         }
 
+        if (now - last_housekeeping_tsc > housekeeping_interval_tsc) {
+            for (SessionEventRing& ring : session_events_) {
+                while (ring.try_pop(session_evt)) {
+                    on_session_event(session_evt);
+                }
+            }
+            check_session_deadlines(now);
+            check_stream_liveness(now);
+            if (config_.enable_compaction) {
+                (void)compact_quiet_orders(now);
+            }
+            publish_stats_snapshot(now);
+            if (flight_) {
+                FlightRecord rec{};
+                rec.tsc = now;
+                rec.kind = FlightKind::RingDepths;
+                rec.d = static_cast<std::uint32_t>(pending_timers());
+                rec.x = (static_cast<std::uint64_t>(primary_.size_approx()) << 32) | dropcopy_.size_approx();
+                rec.y = (static_cast<std::uint64_t>(prime_broker_ ? prime_broker_->size_approx() : 0) << 32) |
+                        divergence_ring_.size_approx();
+                flight_->record(rec);
+            }
+            last_housekeeping_tsc = now;
+        }
+
+        // Iteration cost excludes the idle backoff below
+        const std::uint64_t iteration_end = util::rdtsc();
+        jitter_.end_stage(ReconStage::Housekeeping, iteration_end);
+        if (jitter_.end_iteration(iteration_end)) {
+            JitterContext ctx{};
+            ctx.primary_depth = static_cast<std::uint32_t>(primary_.size_approx());
+            ctx.dropcopy_depth = static_cast<std::uint32_t>(dropcopy_.size_approx());
+            ctx.prime_broker_depth = prime_broker_ ? static_cast<std::uint32_t>(prime_broker_->size_approx()) : 0;
+            ctx.pending_timers = static_cast<std::uint32_t>(pending_timers());
+            ctx.burst_events = burst_events;
+            jitter_.capture_incident(ctx);
+        }
+
         // Backoff when idle - exponential backoff reduces CPU burn
         if (!consumed) {
+            burst_events = 0;
             if (backoff == 0) {
                 backoff = 1;
             } else if (backoff < 256) {
@@ -265,6 +374,83 @@ void Reconciler::run() {
             backoff = 0;
         }
     }
+
+    // Final numbers for readers that outlive the loop
+    publish_stats_snapshot(util::rdtsc());
+}
+
+void Reconciler::publish_stats_snapshot(std::uint64_t now_tsc) noexcept {
+    ReconStatsSnapshot snap{};
+    snap.counters = counters_;
+    snap.timer = timer_stats();
+    snap.grace_fifo = grace_timers_.stats();
+    snap.gap_recheck_fifo = gap_recheck_timers_.stats();
+    snap.pending_timers = pending_timers();
+    snap.store_partition_count = static_cast<std::uint32_t>(store_.partition_count());
+    for (std::size_t p = 0; p < store_.partition_count(); ++p) {
+        snap.store_partitions[p] = store_.partition_stats(p);
+    }
+    snap.published_tsc = now_tsc;
+    stats_snapshot_.store(snap);
+}
+
+// ===== Simulated time =====
+
+void Reconciler::replay_event(const ExecEvent& ev) noexcept {
+    advance_to(ev.ingest_tsc);
+    process_event(ev);
+}
+
+void Reconciler::advance_to(std::uint64_t now_tsc) noexcept {
+    last_poll_tsc_ = std::max(last_poll_tsc_, now_tsc);
+    // Before the wheel, so a source that went silent parks its orders before their timers fire
+    check_stream_liveness(now_tsc);
+    if (now_tsc >= next_timer_deadline_tsc()) {
+        poll_timers(now_tsc);
+    }
+}
+
+// ===== Timers =====
+
+void Reconciler::poll_timers(std::uint64_t now_tsc) noexcept {
+    const auto fire = [this, now_tsc](std::uint32_t ref, std::uint32_t gen) {
+        if (flight_) {
+            FlightRecord rec{};
+            rec.tsc = now_tsc;
+            rec.kind = FlightKind::TimerFire;
+            rec.d = gen;
+            rec.x = ref;
+            flight_->record(rec);
+        }
+        on_timer_expired(ref, gen);
+    };
+    // Grace first: an expiry that reschedules as a recheck lands in the recheck FIFO
+    (void)grace_timers_.poll_expired(now_tsc, fire);
+    (void)gap_recheck_timers_.poll_expired(now_tsc, fire);
+    if (timer_wheel_ && now_tsc >= timer_wheel_->next_deadline_tsc()) {
+        timer_wheel_->poll_expired(now_tsc, fire);
+    }
+}
+
+std::uint64_t Reconciler::next_timer_deadline_tsc() const noexcept {
+    std::uint64_t next = std::min(grace_timers_.next_deadline_tsc(), gap_recheck_timers_.next_deadline_tsc());
+    if (timer_wheel_) {
+        next = std::min(next, timer_wheel_->next_deadline_tsc());
+    }
+    return next;
+}
+
+util::WheelTimer::Stats Reconciler::timer_stats() const noexcept {
+    util::WheelTimer::Stats stats = timer_wheel_ ? timer_wheel_->stats() : util::WheelTimer::Stats{};
+    for (const util::DeadlineFifo* fifo : {&grace_timers_, &gap_recheck_timers_}) {
+        stats.scheduled += fifo->stats().scheduled;
+        stats.expired += fifo->stats().expired;
+    }
+    return stats;
+}
+
+std::size_t Reconciler::pending_timers() const noexcept {
+    return (timer_wheel_ ? timer_wheel_->total_pending() : 0) + grace_timers_.size() + gap_recheck_timers_.size();
 }
 
 // ===== Two-stage pipeline helper implementations (FX-7053) =====
@@ -282,12 +468,10 @@ bool Reconciler::is_gap_suppressed(const OrderState& os) noexcept {
     //
     // This is more precise than the original FX-7054 Part 1 approach (max epoch across sources)
     // because it tracks which specific source(s) caused the gap uncertainty.
-    if (is_suppressed_by_gap(os, Source::Primary, primary_seq_tracker_)) {
-        return true;
-    }
-    
-    if (is_suppressed_by_gap(os, Source::DropCopy, dropcopy_seq_tracker_)) {
-        return true;
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        if (is_suppressed_by_gap(os, static_cast<Source>(i), seq_trackers_[i])) {
+            return true;
+        }
     }
 
     // Inline gap timeout check (from master branch's FX-7054 Part 1):
@@ -296,20 +480,11 @@ bool Reconciler::is_gap_suppressed(const OrderState& os) noexcept {
     const std::uint64_t now = last_poll_tsc_;
     const std::uint64_t timeout_tsc = util::ns_to_tsc(config_.gap_close_timeout_ns);
 
-    if (primary_seq_tracker_.gap_open) {
-        if (primary_seq_tracker_.gap_detected_tsc > 0 &&
-            now > primary_seq_tracker_.gap_detected_tsc &&
-            (now - primary_seq_tracker_.gap_detected_tsc) >= timeout_tsc) {
-            close_gap(primary_seq_tracker_);
-            ++counters_.gaps_closed_by_timeout;
-        }
-    }
-
-    if (dropcopy_seq_tracker_.gap_open) {
-        if (dropcopy_seq_tracker_.gap_detected_tsc > 0 &&
-            now > dropcopy_seq_tracker_.gap_detected_tsc &&
-            (now - dropcopy_seq_tracker_.gap_detected_tsc) >= timeout_tsc) {
-            close_gap(dropcopy_seq_tracker_);
+    for (SequenceTracker& tracker : seq_trackers_) {
+        if (tracker.gap_open && tracker.gap_detected_tsc > 0 &&
+            now > tracker.gap_detected_tsc &&
+            (now - tracker.gap_detected_tsc) >= timeout_tsc) {
+            close_gap(tracker);
             ++counters_.gaps_closed_by_timeout;
         }
     }
@@ -319,20 +494,41 @@ bool Reconciler::is_gap_suppressed(const OrderState& os) noexcept {
 
 void Reconciler::enter_grace_period(OrderState& os, MismatchMask mismatch,
                                     std::uint64_t now_tsc) noexcept {
-    os.recon_state = ReconState::InGrace;
+    // A logged-out session cannot deliver the missing updates: park the order
+    // without a timer; the session's logon/reset re-evaluates it in bulk
+    if ((os.session_flags & SessionFlags::DOWN_MASK) != 0) {
+        cancel_recon_deadline(os);
+        os.current_mismatch = mismatch;
+        set_recon_state(os, ReconState::SuppressedByGap, now_tsc);
+        ++counters_.session_suppressions;
+        return;
+    }
+
+    // Degraded mode: a silent source cannot deliver its side either. Park the same
+    // way; check_stream_liveness re-evaluates the order once the source is back
+    if (involves_down_stream(os)) {
+        cancel_recon_deadline(os);
+        os.current_mismatch = mismatch;
+        os.session_flags |= SessionFlags::STREAM_PARKED;
+        set_recon_state(os, ReconState::SuppressedByGap, now_tsc);
+        ++counters_.stream_orders_parked;
+        return;
+    }
+
     os.current_mismatch = mismatch;
+    set_recon_state(os, ReconState::InGrace, now_tsc);
     os.mismatch_first_seen_tsc = now_tsc;
     // Convert nanoseconds config to TSC cycles before adding to TSC timestamp
     os.recon_deadline_tsc = now_tsc + util::ns_to_tsc(config_.grace_period_ns);
 
     // Schedule timer (requires non-null timer_wheel_)
     if (timer_wheel_) {
-        const bool scheduled = schedule_recon_deadline(*timer_wheel_, os, os.recon_deadline_tsc);
+        const bool scheduled = schedule_recon_deadline(grace_timers_, *timer_wheel_, os, os.recon_deadline_tsc);
         if (!scheduled) {
             // Timer wheel bucket overflow - fallback to immediate emission
             // This is degraded mode, should be monitored
             ++counters_.timer_overflow;
-            os.recon_state = ReconState::DivergedConfirmed;
+            set_recon_state(os, ReconState::DivergedConfirmed, now_tsc);
             emit_confirmed_divergence(os, mismatch, now_tsc);
             ++counters_.mismatch_confirmed;
             return;
@@ -342,64 +538,71 @@ void Reconciler::enter_grace_period(OrderState& os, MismatchMask mismatch,
     ++counters_.mismatch_observed;
 }
 
-void Reconciler::exit_grace_period(OrderState& os, std::uint64_t /*now_tsc*/) noexcept {
+void Reconciler::exit_grace_period(OrderState& os, std::uint64_t now_tsc) noexcept {
     // Cancel timer by incrementing generation
     cancel_recon_deadline(os);
 
-    os.recon_state = ReconState::Matched;
     os.current_mismatch = MismatchMask{};
+    set_recon_state(os, ReconState::Matched, now_tsc);
     
     // FX-7054: Clear gap uncertainty when order matches
-    // Return values intentionally ignored - we don't need to track if flags were previously set
-    if (has_gap_uncertainty_for(os, Source::Primary)) {
-        (void)clear_gap_uncertainty(os, Source::Primary, primary_seq_tracker_);
-    }
-    if (has_gap_uncertainty_for(os, Source::DropCopy)) {
-        (void)clear_gap_uncertainty(os, Source::DropCopy, dropcopy_seq_tracker_);
-    }
+    clear_all_gap_flags(os);
 
     ++counters_.false_positive_avoided;
     ++counters_.orders_matched;
 }
 
+void Reconciler::on_timer_expired(std::uint32_t pool_handle, std::uint32_t scheduled_gen) noexcept {
+    OrderState* os = store_.resolve(pool_handle);
+    if (!os) {
+        return;  // Order was compacted (or the epoch reset); its slot may hold another order
+    }
+    expire_grace_deadline(*os, scheduled_gen);
+}
+
 void Reconciler::on_grace_deadline_expired(OrderKey key, std::uint32_t scheduled_gen) noexcept {
     OrderState* os = store_.find(key);
     if (!os) {
         return;  // Order was recycled
     }
+    expire_grace_deadline(*os, scheduled_gen);
+}
 
-    if (!is_timer_valid(*os, scheduled_gen)) {
+void Reconciler::expire_grace_deadline(OrderState& os, std::uint32_t scheduled_gen) noexcept {
+    if (!is_timer_valid(os, scheduled_gen)) {
         ++counters_.stale_timers_skipped;
         return;
     }
 
     // Additional safety check: only process if order is in a state expecting timer callback.
     // This protects against edge cases where state changed without timer cancellation.
-    if (os->recon_state != ReconState::InGrace && os->recon_state != ReconState::SuppressedByGap) {
+    if (os.recon_state != ReconState::InGrace && os.recon_state != ReconState::SuppressedByGap) {
         ++counters_.stale_timers_skipped;
         return;
     }
 
     // Re-check mismatch at expiration time (use same tolerances as main reconciliation path)
-    const MismatchMask mismatch = compute_mismatch(*os, config_.qty_tolerance, config_.px_tolerance);
+    const MismatchMask mismatch = current_mismatch_of(os);
     const std::uint64_t now = last_poll_tsc_;  // Use last known time
+    os.current_mismatch = mismatch;
 
     if (mismatch.none()) {
         // Mismatch resolved - false positive avoided
-        os->recon_state = ReconState::Matched;
+        set_recon_state(os, ReconState::Matched, now);
         ++counters_.false_positive_avoided;
         ++counters_.orders_matched;
-    } else if (is_gap_suppressed(*os)) {
+    } else if (is_gap_suppressed(os)) {
         // Gap still open - suppress and reschedule
-        os->recon_state = ReconState::SuppressedByGap;
+        set_recon_state(os, ReconState::SuppressedByGap, now);
         if (timer_wheel_) {
             // Convert nanoseconds config to TSC cycles before adding to TSC timestamp
-            const bool rescheduled = refresh_recon_deadline(*timer_wheel_, *os, now + util::ns_to_tsc(config_.gap_recheck_period_ns));
+            const bool rescheduled = schedule_recon_deadline(gap_recheck_timers_, *timer_wheel_, os,
+                                                             now + util::ns_to_tsc(config_.gap_recheck_period_ns));
             if (!rescheduled) {
                 // Timer overflow during gap recheck - emit divergence
                 ++counters_.timer_overflow;
-                os->recon_state = ReconState::DivergedConfirmed;
-                emit_confirmed_divergence(*os, mismatch, now);
+                set_recon_state(os, ReconState::DivergedConfirmed, now);
+                emit_confirmed_divergence(os, mismatch, now);
                 ++counters_.mismatch_confirmed;
                 return;
             }
@@ -407,8 +610,8 @@ void Reconciler::on_grace_deadline_expired(OrderKey key, std::uint32_t scheduled
         ++counters_.gap_suppressions;
     } else {
         // Confirmed divergence
-        os->recon_state = ReconState::DivergedConfirmed;
-        emit_confirmed_divergence(*os, mismatch, now);
+        set_recon_state(os, ReconState::DivergedConfirmed, now);
+        emit_confirmed_divergence(os, mismatch, now);
         ++counters_.mismatch_confirmed;
     }
 }
@@ -423,18 +626,13 @@ void Reconciler::emit_confirmed_divergence(OrderState& os, MismatchMask mismatch
 
     // Build and emit divergence event
     Divergence div{};
-    div.key = os.key;
-    div.type = classify_divergence_type(os, mismatch);
-    div.internal_status = os.internal_status;
-    div.dropcopy_status = os.dropcopy_status;
-    div.internal_cum_qty = os.internal_cum_qty;
-    div.dropcopy_cum_qty = os.dropcopy_cum_qty;
-    div.internal_avg_px = os.internal_avg_px;
-    div.dropcopy_avg_px = os.dropcopy_avg_px;
-    div.internal_ts = os.last_internal_ts;
-    div.dropcopy_ts = os.last_dropcopy_ts;
+    fill_divergence_snapshot(os, classify_divergence_type(os, mismatch), div);
     div.detect_tsc = now_tsc;
     div.mismatch_mask = mismatch.bits();
+    const PairwiseMismatch pairs = pairwise_mismatch(os);
+    for (std::size_t p = 0; p < SIDE_PAIR_COUNT; ++p) {
+        div.pair_mismatch[p] = pairs.pair[p].bits();
+    }
 
     if (!divergence_ring_.try_push(div)) {
         ++counters_.divergence_ring_drops;
@@ -445,12 +643,31 @@ void Reconciler::emit_confirmed_divergence(OrderState& os, MismatchMask mismatch
     record_divergence_emission(os, mismatch, now_tsc);
     
     // FX-7054: Clear gap uncertainty after confirmed divergence
-    // Return values intentionally ignored - we don't need to track if flags were previously set
-    if (has_gap_uncertainty_for(os, Source::Primary)) {
-        (void)clear_gap_uncertainty(os, Source::Primary, primary_seq_tracker_);
+    clear_all_gap_flags(os);
+}
+
+void Reconciler::publish_transition(const OrderState& os, ReconState from, std::uint64_t now_tsc) noexcept {
+    ReconTransition tr{};
+    tr.key = os.key;
+    tr.tsc = now_tsc;
+    tr.seq = ++transition_seq_;
+    tr.from = from;
+    tr.to = os.recon_state;
+    tr.mismatch = os.current_mismatch.bits();
+    if (!transition_ring_->try_push(tr)) {
+        ++counters_.transition_ring_drops;
+        return;
     }
-    if (has_gap_uncertainty_for(os, Source::DropCopy)) {
-        (void)clear_gap_uncertainty(os, Source::DropCopy, dropcopy_seq_tracker_);
+    ++counters_.transitions_published;
+}
+
+void Reconciler::clear_all_gap_flags(OrderState& os) noexcept {
+    // Return values intentionally ignored - we don't need to track if flags were previously set
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        const Source source = static_cast<Source>(i);
+        if (has_gap_uncertainty_for(os, source)) {
+            (void)clear_gap_uncertainty(os, source, seq_trackers_[i]);
+        }
     }
 }
 
@@ -462,42 +679,30 @@ void Reconciler::handle_recon_state_transition(
     switch (os.recon_state) {
         case ReconState::Unknown:
             // First event - determine initial state and schedule timer if needed
-            if (os.seen_internal && !os.seen_dropcopy) {
-                // Internal seen first; either await dropcopy or enter grace on mismatch
-                if (new_mismatch.any()) {
-                    // Schedule grace timer for EXISTENCE mismatch (per FX-7053 spec)
-                    // This ensures we emit divergence if dropcopy never arrives
-                    enter_grace_period(os, new_mismatch, now_tsc);
-                } else {
-                    os.recon_state = ReconState::AwaitingDropCopy;
-                }
-            } else if (os.seen_dropcopy && !os.seen_internal) {
-                // Dropcopy seen first; either await primary or enter grace on mismatch
-                if (new_mismatch.any()) {
-                    // Schedule grace timer for EXISTENCE mismatch (per FX-7053 spec)
-                    // This ensures we emit divergence if primary never arrives
-                    enter_grace_period(os, new_mismatch, now_tsc);
-                } else {
-                    os.recon_state = ReconState::AwaitingPrimary;
-                }
-            } else if (both_sides_seen(os)) {
-                // Both sides seen on first event (unusual but handle it)
-                if (new_mismatch.any()) {
-                    enter_grace_period(os, new_mismatch, now_tsc);
-                } else {
-                    os.recon_state = ReconState::Matched;
-                    ++counters_.orders_matched;
-                }
+            if (seen_sides(os) == 0) {
+                break;
+            }
+            if (new_mismatch.any()) {
+                // Schedule grace timer for EXISTENCE mismatch (per FX-7053 spec)
+                // This ensures we emit divergence if a required side never arrives
+                enter_grace_period(os, new_mismatch, now_tsc);
+            } else if ((seen_sides(os) & config_.required_sides) == config_.required_sides) {
+                // Every required side seen and agreeing (unusual on a first event)
+                set_recon_state(os, ReconState::Matched, now_tsc);
+                ++counters_.orders_matched;
+            } else {
+                set_recon_state(os, os.seen[SideIndex::PRIMARY] ? ReconState::AwaitingDropCopy
+                                                             : ReconState::AwaitingPrimary, now_tsc);
             }
             break;
 
         case ReconState::AwaitingPrimary:
-            if (os.seen_internal) {
+            if (os.seen[SideIndex::PRIMARY]) {
                 // Primary arrived - now we can compare
                 if (new_mismatch.any()) {
                     enter_grace_period(os, new_mismatch, now_tsc);
                 } else {
-                    os.recon_state = ReconState::Matched;
+                    set_recon_state(os, ReconState::Matched, now_tsc);
                     ++counters_.orders_matched;
                 }
             } else if (new_mismatch.any()) {
@@ -510,12 +715,12 @@ void Reconciler::handle_recon_state_transition(
             break;
 
         case ReconState::AwaitingDropCopy:
-            if (os.seen_dropcopy) {
+            if (os.seen[SideIndex::DROPCOPY]) {
                 // DropCopy arrived - now we can compare
                 if (new_mismatch.any()) {
                     enter_grace_period(os, new_mismatch, now_tsc);
                 } else {
-                    os.recon_state = ReconState::Matched;
+                    set_recon_state(os, ReconState::Matched, now_tsc);
                     ++counters_.orders_matched;
                 }
             } else if (new_mismatch.any()) {
@@ -550,18 +755,20 @@ void Reconciler::handle_recon_state_transition(
         case ReconState::DivergedConfirmed:
             if (new_mismatch.none()) {
                 // Divergence resolved - return to matched
-                os.recon_state = ReconState::Matched;
+                set_recon_state(os, ReconState::Matched, now_tsc);
                 ++counters_.divergence_resolved;
             }
             break;
 
         case ReconState::SuppressedByGap:
-            if (!is_gap_suppressed(os)) {
+            if ((os.session_flags & SessionFlags::DOWN_MASK) == 0 && !is_gap_suppressed(os)) {
+                // Re-parked below if a source it depends on is still down
+                os.session_flags &= static_cast<std::uint8_t>(~SessionFlags::STREAM_PARKED);
                 // Gap closed - re-evaluate
                 if (new_mismatch.any()) {
                     enter_grace_period(os, new_mismatch, now_tsc);
                 } else {
-                    os.recon_state = ReconState::Matched;
+                    set_recon_state(os, ReconState::Matched, now_tsc);
                     ++counters_.orders_matched;
                 }
             }
@@ -569,12 +776,290 @@ void Reconciler::handle_recon_state_transition(
     }
 }
 
+// ===== Tombstone compaction =====
+
+std::size_t Reconciler::compact_quiet_orders(std::uint64_t now_tsc) noexcept {
+    const std::uint64_t quiet_tsc = util::ns_to_tsc(config_.compaction_quiet_period_ns);
+    const std::size_t compacted = store_.compact_sweep(
+        config_.compaction_sweep_budget, [&](OrderState& os) noexcept {
+            if (!is_compactable(os, now_tsc, quiet_tsc)) {
+                return false;
+            }
+            // Keep orders_in_gap_count honest before the record goes away
+            clear_all_gap_flags(os);
+            return true;
+        });
+    counters_.orders_compacted += compacted;
+    return compacted;
+}
+
+void Reconciler::on_tombstoned_event(const OrderTombstone& tomb, const ExecEvent& ev) noexcept {
+    if (tombstone_matches(tomb, ev)) {
+        ++counters_.tombstone_duplicates;
+        return;
+    }
+
+    ++counters_.tombstone_late_mismatch;
+    LOG_HOT_RATE_LIMITED(::util::LogLevel::Warn, "RECON", OVERLOAD_LOG_PER_SEC, OVERLOAD_LOG_BURST,
+                         "late_exec_after_compaction src=%u key=%llu status=%u final_status=%u cum_qty=%lld",
+                         static_cast<unsigned>(ev.source), static_cast<unsigned long long>(tomb.key),
+                         static_cast<unsigned>(ev.ord_status), static_cast<unsigned>(tomb.final_status),
+                         static_cast<long long>(ev.cum_qty));
+}
+
+// ===== Session-level events =====
+
+void Reconciler::on_session_event(const SessionEvent& sev) noexcept {
+    liveness_.on_activity(sev.source, sev.tsc);
+    SessionOrderIndex& sessions = store_.sessions();
+    SessionOrderIndex::Session* session = sessions.find_or_add(sev.source, sev.session_id);
+    if (!session) {
+        if (sev.kind == SessionEventKind::Heartbeat) {
+            return;
+        }
+        LOG_HOT_RATE_LIMITED(::util::LogLevel::Warn, "RECON", OVERLOAD_LOG_PER_SEC, OVERLOAD_LOG_BURST,
+                             "session_event_untracked src=%u session=%u kind=%u",
+                             static_cast<unsigned>(sev.source), sev.session_id, static_cast<unsigned>(sev.kind));
+        return;
+    }
+
+    session->last_activity_tsc = std::max(session->last_activity_tsc, sev.tsc);
+    if (sev.kind == SessionEventKind::Heartbeat) {
+        return;  // Liveness only; not logged
+    }
+
+    std::size_t affected = 0;
+    switch (sev.kind) {
+    case SessionEventKind::Heartbeat:
+        break;
+    case SessionEventKind::Logout:
+        ++counters_.session_logouts;
+        session->down = true;
+        affected = suspend_session_orders(*session, sev.tsc);
+        break;
+    case SessionEventKind::SessionReset:
+        ++counters_.session_resets;
+        // Sequence numbers restart: drop the old gap and re-initialise on the next event
+        close_session_gap(sev.source);
+        tracker_for(sev.source).initialized = false;
+        session->down = false;
+        affected = resume_session_orders(*session, sev.tsc);
+        break;
+    case SessionEventKind::Logon:
+        ++counters_.session_logons;
+        session->down = false;
+        affected = resume_session_orders(*session, sev.tsc);
+        break;
+    case SessionEventKind::MassCancel:
+        ++counters_.session_mass_cancels;
+        affected = mass_cancel_session_orders(*session, sev.tsc);
+        if (affected != 0) {
+            session->mass_cancel_deadline_tsc = sev.tsc + util::ns_to_tsc(config_.grace_period_ns);
+        }
+        break;
+    }
+
+    LOG_HOT_LVL(::util::LogLevel::Info, "RECON",
+                "session_event src=%u session=%u kind=%u orders=%u affected=%llu",
+                static_cast<unsigned>(sev.source), sev.session_id, static_cast<unsigned>(sev.kind),
+                static_cast<unsigned>(session->order_count), static_cast<unsigned long long>(affected));
+}
+
+std::size_t Reconciler::suspend_session_orders(const SessionOrderIndex::Session& session,
+                                               std::uint64_t now_tsc) noexcept {
+    const std::uint8_t down = SessionFlags::down_bit(session.source);
+    std::size_t suspended = 0;
+    store_.sessions().for_each_order(session, [&](OrderState& os) noexcept {
+        os.session_flags |= down;
+        if (os.recon_state == ReconState::InGrace || os.recon_state == ReconState::SuppressedByGap) {
+            // Lazy cancel: the wheel entry goes stale, nothing is rescheduled
+            cancel_recon_deadline(os);
+            set_recon_state(os, ReconState::SuppressedByGap, now_tsc);
+            ++suspended;
+        }
+    });
+    counters_.session_orders_suspended += suspended;
+    return suspended;
+}
+
+std::size_t Reconciler::resume_session_orders(const SessionOrderIndex::Session& session,
+                                              std::uint64_t now_tsc) noexcept {
+    const std::uint8_t down = SessionFlags::down_bit(session.source);
+    std::size_t resumed = 0;
+    store_.sessions().for_each_order(session, [&](OrderState& os) noexcept {
+        if ((os.session_flags & down) == 0) {
+            return;
+        }
+        os.session_flags &= static_cast<std::uint8_t>(~down);
+        if ((os.session_flags & SessionFlags::DOWN_MASK) != 0 ||
+            os.recon_state != ReconState::SuppressedByGap || is_gap_suppressed(os)) {
+            return;  // Still parked for another reason
+        }
+        const MismatchMask mismatch = current_mismatch_of(os);
+        os.current_mismatch = mismatch;
+        if (mismatch.none()) {
+            set_recon_state(os, ReconState::Matched, now_tsc);
+            ++counters_.orders_matched;
+        } else {
+            // Fresh grace window for the reconnected session to replay
+            enter_grace_period(os, mismatch, now_tsc);
+        }
+        ++resumed;
+    });
+    counters_.session_orders_resumed += resumed;
+    return resumed;
+}
+
+std::size_t Reconciler::mass_cancel_session_orders(const SessionOrderIndex::Session& session,
+                                                   std::uint64_t now_tsc) noexcept {
+    const Source source = session.source;
+    std::size_t canceled = 0;
+    store_.sessions().for_each_order(session, [&](OrderState& os) noexcept {
+        const std::size_t side = source_index(source);
+        OrdStatus& status = os.status[side];
+        if (!os.seen[side] || is_terminal_status(status)) {
+            return;
+        }
+
+        // The session reported the cancel for all of its open orders at once; it is
+        // authoritative, so open states go straight to Canceled (a later per-order
+        // Canceled report is an idempotent repeat)
+        status = OrdStatus::Canceled;
+        store_.refresh_mirror(os);
+        cancel_recon_deadline(os);
+
+        const MismatchMask mismatch = current_mismatch_of(os);
+        os.current_mismatch = mismatch;
+        if (mismatch.none()) {
+            if (os.recon_state != ReconState::Matched) {
+                set_recon_state(os, ReconState::Matched, now_tsc);
+                ++counters_.orders_matched;
+            }
+        } else {
+            // Expect the other sides' cancel; one session-level deadline covers all
+            set_recon_state(os, source == Source::Primary ? ReconState::AwaitingDropCopy
+                                                       : ReconState::AwaitingPrimary, now_tsc);
+            os.session_flags |= SessionFlags::MASS_CANCEL_PENDING;
+        }
+        ++canceled;
+    });
+    counters_.session_orders_mass_canceled += canceled;
+    return canceled;
+}
+
+void Reconciler::check_session_deadlines(std::uint64_t now_tsc) noexcept {
+    SessionOrderIndex& sessions = store_.sessions();
+    for (std::size_t i = 0; i < sessions.session_count(); ++i) {
+        SessionOrderIndex::Session& session = sessions.session_at(i);
+        if (session.mass_cancel_deadline_tsc == 0 || now_tsc < session.mass_cancel_deadline_tsc) {
+            continue;
+        }
+        session.mass_cancel_deadline_tsc = 0;
+
+        sessions.for_each_order(session, [&](OrderState& os) noexcept {
+            if ((os.session_flags & SessionFlags::MASS_CANCEL_PENDING) == 0) {
+                return;
+            }
+            os.session_flags &= static_cast<std::uint8_t>(~SessionFlags::MASS_CANCEL_PENDING);
+            if (os.recon_state != ReconState::AwaitingPrimary &&
+                os.recon_state != ReconState::AwaitingDropCopy) {
+                return;  // Resolved (or re-entered the normal pipeline) in the meantime
+            }
+            const MismatchMask mismatch = current_mismatch_of(os);
+            if (mismatch.none()) {
+                set_recon_state(os, ReconState::Matched, now_tsc);
+                ++counters_.orders_matched;
+                return;
+            }
+            set_recon_state(os, ReconState::DivergedConfirmed, now_tsc);
+            emit_confirmed_divergence(os, mismatch, now_tsc);
+            ++counters_.mismatch_confirmed;
+        });
+    }
+}
+
+// ===== Stream liveness (degraded mode) =====
+
+void Reconciler::check_stream_liveness(std::uint64_t now_tsc) noexcept {
+    if (config_.stream_liveness_timeout_ns == 0) {
+        return;
+    }
+    const std::uint8_t was_down = liveness_.down_mask();
+    const std::uint8_t down = liveness_.evaluate(now_tsc, util::ns_to_tsc(config_.stream_liveness_timeout_ns),
+                                                 config_.required_sides);
+    if (down == was_down) {
+        return;
+    }
+
+    const auto went_down = static_cast<std::uint8_t>(down & ~was_down);
+    const auto came_up = static_cast<std::uint8_t>(was_down & ~down);
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        const Source source = static_cast<Source>(i);
+        if ((went_down & source_bit(source)) != 0) {
+            ++counters_.stream_downs;
+            LOG_HOT_LVL(::util::LogLevel::Warn, "RECON", "stream_down src=%u silent_since_tsc=%llu",
+                        static_cast<unsigned>(source),
+                        static_cast<unsigned long long>(liveness_.last_activity_tsc(source)));
+        } else if ((came_up & source_bit(source)) != 0) {
+            ++counters_.stream_ups;
+            LOG_HOT_LVL(::util::LogLevel::Info, "RECON", "stream_up src=%u", static_cast<unsigned>(source));
+        }
+    }
+
+    if (went_down != 0) {
+        (void)park_down_stream_orders(now_tsc);
+    }
+    if (came_up != 0) {
+        (void)resume_stream_parked_orders(now_tsc);
+    }
+}
+
+std::size_t Reconciler::park_down_stream_orders(std::uint64_t now_tsc) noexcept {
+    std::size_t parked = 0;
+    for_each_session_order([&](OrderState& os) noexcept {
+        if (os.recon_state != ReconState::InGrace || !involves_down_stream(os)) {
+            return;
+        }
+        // Lazy cancel: the wheel entry goes stale
+        cancel_recon_deadline(os);
+        os.session_flags |= SessionFlags::STREAM_PARKED;
+        set_recon_state(os, ReconState::SuppressedByGap, now_tsc);
+        ++parked;
+    });
+    counters_.stream_orders_parked += parked;
+    return parked;
+}
+
+std::size_t Reconciler::resume_stream_parked_orders(std::uint64_t now_tsc) noexcept {
+    std::size_t resumed = 0;
+    for_each_session_order([&](OrderState& os) noexcept {
+        if ((os.session_flags & SessionFlags::STREAM_PARKED) == 0 || involves_down_stream(os)) {
+            return;
+        }
+        os.session_flags &= static_cast<std::uint8_t>(~SessionFlags::STREAM_PARKED);
+        if ((os.session_flags & SessionFlags::DOWN_MASK) != 0 ||
+            os.recon_state != ReconState::SuppressedByGap || is_gap_suppressed(os)) {
+            return;  // Resolved meanwhile, or still parked for another reason
+        }
+        const MismatchMask mismatch = current_mismatch_of(os);
+        os.current_mismatch = mismatch;
+        if (mismatch.none()) {
+            set_recon_state(os, ReconState::Matched, now_tsc);
+            ++counters_.orders_matched;
+        } else {
+            // Fresh grace window for the recovered stream to catch up
+            enter_grace_period(os, mismatch, now_tsc);
+        }
+        ++resumed;
+    });
+    counters_.stream_orders_resumed += resumed;
+    return resumed;
+}
+
 // ===== FX-7054: Gap management implementations =====
 
 void Reconciler::close_session_gap(Source source) noexcept {
-    SequenceTracker& tracker = (source == Source::Primary)
-        ? primary_seq_tracker_
-        : dropcopy_seq_tracker_;
+    SequenceTracker& tracker = tracker_for(source);
     
     if (!tracker.gap_open) {
         return;  // Gap already closed
@@ -610,35 +1095,24 @@ void Reconciler::close_session_gap(Source source) noexcept {
 void Reconciler::check_gap_timeouts(std::uint64_t now_tsc) noexcept {
     const std::uint64_t gap_timeout_tsc = util::ns_to_tsc(config_.gap_timeout_ns);
     
-    // Check Primary gap timeout
     // Note: gap_opened_tsc is always set when gap_open becomes true (see track_sequence),
     // but we check > 0 as a defensive measure against uninitialized state
-    if (primary_seq_tracker_.gap_open &&
-        primary_seq_tracker_.gap_opened_tsc != 0 &&
-        (now_tsc - primary_seq_tracker_.gap_opened_tsc) > gap_timeout_tsc) {
-        
-        LOG_HOT_LVL(::util::LogLevel::Warn, "RECON",
-                    "gap_timeout src=Primary epoch=%u missing=[%llu,%llu]",
-                    static_cast<unsigned>(primary_seq_tracker_.gap_epoch),
-                    static_cast<unsigned long long>(primary_seq_tracker_.gap_start_seq),
-                    static_cast<unsigned long long>(primary_seq_tracker_.gap_last_missing_seq));
-        
-        close_session_gap(Source::Primary);
-        ++counters_.gap_timeouts;
-    }
-    
-    // Check DropCopy gap timeout
-    if (dropcopy_seq_tracker_.gap_open &&
-        dropcopy_seq_tracker_.gap_opened_tsc != 0 &&
-        (now_tsc - dropcopy_seq_tracker_.gap_opened_tsc) > gap_timeout_tsc) {
-        
+    for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+        const SequenceTracker& tracker = seq_trackers_[i];
+        if (!tracker.gap_open || tracker.gap_opened_tsc == 0 ||
+            (now_tsc - tracker.gap_opened_tsc) <= gap_timeout_tsc) {
+            continue;
+        }
+
+        const Source source = static_cast<Source>(i);
         LOG_HOT_LVL(::util::LogLevel::Warn, "RECON",
-                    "gap_timeout src=DropCopy epoch=%u missing=[%llu,%llu]",
-                    static_cast<unsigned>(dropcopy_seq_tracker_.gap_epoch),
-                    static_cast<unsigned long long>(dropcopy_seq_tracker_.gap_start_seq),
-                    static_cast<unsigned long long>(dropcopy_seq_tracker_.gap_last_missing_seq));
+                    "gap_timeout src=%s epoch=%u missing=[%llu,%llu]",
+                    source_name(source),
+                    static_cast<unsigned>(tracker.gap_epoch),
+                    static_cast<unsigned long long>(tracker.gap_start_seq),
+                    static_cast<unsigned long long>(tracker.gap_last_missing_seq));
         
-        close_session_gap(Source::DropCopy);
+        close_session_gap(source);
         ++counters_.gap_timeouts;
     }
 }
@@ -2,25 +2,36 @@
 
 #include <atomic>
 #include <thread>
+#include <type_traits>
 #include <cstdint>
 
+#include "core/flight_recorder.hpp"
 #include "core/order_state_store.hpp"
 #include "core/recon_config.hpp"
+#include "core/recon_jitter.hpp"
+#include "core/recon_transition.hpp"
 #include "core/recon_timer.hpp"
 #include "ingest/spsc_ring.hpp"
 #include "core/exec_event.hpp"
 #include "core/divergence.hpp"
+#include "core/divergence_lanes.hpp"
 #include "core/sequence_tracker.hpp"
+#include "core/session_index.hpp"
+#include "core/stream_liveness.hpp"
+#include "util/deadline_fifo.hpp"
+#include "util/seqlock.hpp"
 #include "util/wheel_timer.hpp"
 
 namespace core {
 
-using DivergenceRing = ingest::SpscRing<Divergence, 1u << 16>;
+// Divergence output: one ring per DivergencePriority, drained most severe first
+using DivergenceRing = DivergenceLanes;
 using SequenceGapRing = ingest::SpscRing<SequenceGapEvent, 1u << 16>;
 
 struct ReconCounters {
     std::uint64_t internal_events{0};
     std::uint64_t dropcopy_events{0};
+    std::uint64_t prime_broker_events{0};
 
     std::uint64_t divergence_total{0};
     std::uint64_t divergence_missing_fill{0};
@@ -31,6 +42,7 @@ struct ReconCounters {
 
     std::uint64_t divergence_ring_drops{0};
     std::uint64_t store_overflow{0};
+    std::uint64_t invalid_events{0};  // Unannotated events with out-of-range enums (ingest drops its own)
 
     std::uint64_t primary_seq_gaps{0};
     std::uint64_t primary_seq_duplicates{0};
@@ -38,6 +50,9 @@ struct ReconCounters {
     std::uint64_t dropcopy_seq_gaps{0};
     std::uint64_t dropcopy_seq_duplicates{0};
     std::uint64_t dropcopy_seq_out_of_order{0};
+    std::uint64_t prime_broker_seq_gaps{0};
+    std::uint64_t prime_broker_seq_duplicates{0};
+    std::uint64_t prime_broker_seq_out_of_order{0};
     std::uint64_t sequence_gap_ring_drops{0};
 
     // ===== Two-stage reconciliation counters (FX-7053) =====
@@ -54,6 +69,47 @@ struct ReconCounters {
     std::uint64_t divergence_resolved{0};     // Confirmed divergences that later resolved
     std::uint64_t gaps_closed_by_timeout{0};  // Sequence gaps closed due to timeout
     std::uint64_t gaps_closed_by_fill{0};     // Sequence gaps closed by out-of-order message fill
+
+    // ===== Tombstone compaction counters =====
+    std::uint64_t orders_compacted{0};        // Finished orders compacted to tombstones
+    std::uint64_t tombstone_duplicates{0};    // Late events repeating a tombstone's final state
+    std::uint64_t tombstone_late_mismatch{0}; // Late events disagreeing with a tombstone's final state
+
+    // ===== Session-level event counters =====
+    std::uint64_t session_logouts{0};
+    std::uint64_t session_logons{0};
+    std::uint64_t session_resets{0};
+    std::uint64_t session_mass_cancels{0};
+    std::uint64_t session_orders_suspended{0};    // Orders parked by a logout (timers cancelled)
+    std::uint64_t session_orders_resumed{0};      // Parked orders re-evaluated on logon/reset
+    std::uint64_t session_orders_mass_canceled{0};  // Orders moved to expected-cancel by a mass cancel
+    std::uint64_t session_suppressions{0};        // Grace entries redirected because a session was down
+
+    // ===== Stream liveness (degraded mode) =====
+    std::uint64_t stream_downs{0};                // Sources declared down after stream_liveness_timeout_ns
+    std::uint64_t stream_ups{0};                  // Down sources active again
+    std::uint64_t stream_orders_parked{0};        // Grace entries parked while a source was down
+    std::uint64_t stream_orders_resumed{0};       // Parked orders re-evaluated once their sources were up
+
+    // ===== CDC transition stream counters =====
+    std::uint64_t transitions_published{0};       // ReconState changes pushed to the transition ring
+    std::uint64_t transition_ring_drops{0};       // ReconState changes lost because the consumer lagged
+};
+
+static_assert(std::is_trivially_copyable_v<ReconCounters>, "ReconCounters must be trivially copyable");
+
+// Point-in-time copy of the reconciler's statistics for other threads (metrics
+// exporter). The counters themselves are plain fields owned by the reconciler
+// thread; this copy is what may be read concurrently.
+struct ReconStatsSnapshot {
+    ReconCounters counters{};
+    util::WheelTimer::Stats timer{};   // Wheel and deadline FIFOs combined
+    util::DeadlineFifo::Stats grace_fifo{};
+    util::DeadlineFifo::Stats gap_recheck_fifo{};
+    std::uint64_t pending_timers{0};
+    StorePartitionStats store_partitions[MAX_STORE_PARTITIONS]{};
+    std::uint32_t store_partition_count{0};
+    std::uint64_t published_tsc{0};  // Reconciler time of the copy (0 = never published)
 };
 
 // Default deduplication window: don't re-emit identical divergence within this period.
@@ -67,7 +123,8 @@ static constexpr std::uint64_t DEFAULT_DIVERGENCE_DEDUP_WINDOW_NS = 1'000'000'00
     MismatchMask mismatch
 ) noexcept {
     if (mismatch.has(MismatchMask::EXISTENCE)) {
-        if (os.seen_internal && !os.seen_dropcopy) {
+        // Internal seen: some external side (drop copy or PB) never reported
+        if (os.seen[SideIndex::PRIMARY]) {
             return DivergenceType::MissingDropCopy;
         } else {
             return DivergenceType::PhantomOrder;
@@ -88,6 +145,8 @@ static constexpr std::uint64_t DEFAULT_DIVERGENCE_DEDUP_WINDOW_NS = 1'000'000'00
     return DivergenceType::StateMismatch;
 }
 
+using ExecRing = ingest::SpscRing<core::ExecEvent, 1u << 16>;
+
 class Reconciler {
 public:
     // Existing constructor (backward compatibility)
@@ -108,16 +167,60 @@ public:
                DivergenceRing& divergence_ring,
                SequenceGapRing& seq_gap_ring,
                util::WheelTimer* timer_wheel,  // nullptr = disable windowed recon
-               const ReconConfig& config = default_recon_config()) noexcept;
+               const ReconConfig& config = default_recon_config());
+
+    // Adds the prime-broker give-up feed as a third side. Its events share the
+    // order store (one lookup per event) and are compared pairwise against the
+    // other sides; set ReconConfig::required_sides to make PB reports mandatory.
+    // Must be called before run().
+    void attach_prime_broker(ExecRing& prime_broker) noexcept { prime_broker_ = &prime_broker; }
+
+    // Enables the change-data-capture stream: every ReconState change is pushed
+    // to ring as a ReconTransition (dropped and counted if the ring is full).
+    // Drain it with a ReconTransitionPublisher. Must be called before run().
+    void attach_transition_ring(ReconTransitionRing& ring) noexcept { transition_ring_ = &ring; }
+
+    // Records events taken, ReconState changes, timer fires and (on the housekeeping
+    // cadence) queue depths into recorder for crash dumps. Must be called before run().
+    void attach_flight_recorder(FlightRecorder& recorder) noexcept { flight_ = &recorder; }
 
     void run();
     void process_event_for_test(const ExecEvent& ev) noexcept { process_event(ev); }
 
+    // ===== Simulated time (backtest / replay) =====
+    // Drive the reconciler from a recorded stream instead of run(): the clock is
+    // the events' ingest_tsc, so results are deterministic and independent of
+    // wall time. Events must be fed in ingest_tsc order.
+
+    // Fires grace deadlines due by ev.ingest_tsc, then processes ev.
+    void replay_event(const ExecEvent& ev) noexcept;
+
+    // Fires every grace deadline due by now_tsc (simulated clock).
+    void advance_to(std::uint64_t now_tsc) noexcept;
+
+    // ===== Timers =====
+    // Grace and gap-recheck deadlines go to per-kind FIFOs (constant durations, so
+    // already sorted) and spill to the WheelTimer when a FIFO refuses them.
+
+    // Fires every timer due by now_tsc: FIFO fronts, then the wheel
+    void poll_timers(std::uint64_t now_tsc) noexcept;
+    // Earliest TSC at which poll_timers() can fire anything (WheelTimer::NO_DEADLINE if none)
+    [[nodiscard]] std::uint64_t next_timer_deadline_tsc() const noexcept;
+    // Wheel and FIFO statistics combined (rescheduled / overflow_dropped are the wheel's)
+    [[nodiscard]] util::WheelTimer::Stats timer_stats() const noexcept;
+    // Entries pending across the wheel and the FIFOs, stale ones included
+    [[nodiscard]] std::size_t pending_timers() const noexcept;
+
     // ===== Two-stage pipeline helpers (FX-7053) =====
 
     // Check if both primary and dropcopy have been seen for an order
     [[nodiscard]] static bool both_sides_seen(const OrderState& os) noexcept {
-        return os.seen_internal && os.seen_dropcopy;
+        return os.seen[SideIndex::PRIMARY] && os.seen[SideIndex::DROPCOPY];
+    }
+
+    // Mismatch of every side pair under the configured tolerances and required sides
+    [[nodiscard]] PairwiseMismatch pairwise_mismatch(const OrderState& os) const noexcept {
+        return compute_pairwise_mismatch(os, config_.qty_tolerance, config_.px_tolerance, config_.required_sides);
     }
 
     // Check if divergence should be suppressed due to sequence gap
@@ -130,7 +233,10 @@ public:
     // Exit grace period (mismatch resolved before deadline)
     void exit_grace_period(OrderState& os, std::uint64_t now_tsc) noexcept;
 
-    // Handle timer expiration callback from wheel
+    // Handle timer expiration callback from wheel: the wheel reports the order's
+    // pool handle, which resolves without a hash lookup (nullptr once recycled)
+    void on_timer_expired(std::uint32_t pool_handle, std::uint32_t scheduled_gen) noexcept;
+    // Same, by key (tools and tests that track orders by key)
     void on_grace_deadline_expired(OrderKey key, std::uint32_t scheduled_gen) noexcept;
 
     // Emit confirmed divergence (with deduplication check)
@@ -153,32 +259,144 @@ public:
     // FX-7054: Administrative gap closure (for testing and manual intervention)
     void close_session_gap(Source source) noexcept;
 
+    // ===== Session-level events =====
+
+    // Applies a session event to every order on the session in one pass
+    // (O(orders in session), no per-order timers). Reconciler thread only.
+    void on_session_event(const SessionEvent& sev) noexcept;
+
+    // Input ring for session events detected by the given source's ingest thread;
+    // drained by run() on the housekeeping cadence.
+    [[nodiscard]] SessionEventRing& session_event_ring(Source source) noexcept {
+        return session_events_[source_index(source)];
+    }
+
+    // Resolves mass cancels whose expected-cancel window has elapsed. Called
+    // periodically from run().
+    void check_session_deadlines(std::uint64_t now_tsc) noexcept;
+
+    // ===== Stream liveness (degraded mode) =====
+
+    // Re-evaluates the liveness of every required source at now_tsc (no-op unless
+    // ReconConfig::stream_liveness_timeout_ns is set). A source going down parks the
+    // in-grace orders it is involved in and cancels their timers; while it is down,
+    // new grace entries involving it are parked the same way. When it is active
+    // again, every parked order is re-evaluated in one pass over the session lists.
+    // Called from run() on the housekeeping cadence and from advance_to().
+    void check_stream_liveness(std::uint64_t now_tsc) noexcept;
+
+    [[nodiscard]] const StreamLiveness& stream_liveness() const noexcept { return liveness_; }
+    // True while any required source is down
+    [[nodiscard]] bool degraded() const noexcept { return liveness_.down_mask() != 0; }
+
+    // Loop stall/jitter statistics and incident buffer. Statistics may be read from
+    // any thread; incidents are drained by a single reporter thread.
+    [[nodiscard]] ReconJitterMonitor& jitter_monitor() noexcept { return jitter_; }
+
+    // Copies counters and timer statistics into the snapshot read by stats_snapshot().
+    // Reconciler thread only; run() calls it on the housekeeping cadence and on exit.
+    void publish_stats_snapshot(std::uint64_t now_tsc) noexcept;
+
+    // Latest published statistics. Safe from any thread; never blocks the reconciler.
+    [[nodiscard]] ReconStatsSnapshot stats_snapshot() const noexcept { return stats_snapshot_.load(); }
+
+    // Compact finished orders that have been quiet for compaction_quiet_period_ns.
+    // Runs one bounded sweep step (compaction_sweep_budget buckets); returns the
+    // number of orders compacted. Called periodically from run().
+    std::size_t compact_quiet_orders(std::uint64_t now_tsc) noexcept;
+
 private:
     void process_event(const ExecEvent& ev) noexcept;
     void increment_divergence_counter(DivergenceType type) noexcept;
+    void on_tombstoned_event(const OrderTombstone& tomb, const ExecEvent& ev) noexcept;
+    void expire_grace_deadline(OrderState& os, std::uint32_t scheduled_gen) noexcept;
+    std::size_t suspend_session_orders(const SessionOrderIndex::Session& session, std::uint64_t now_tsc) noexcept;
+    std::size_t resume_session_orders(const SessionOrderIndex::Session& session, std::uint64_t now_tsc) noexcept;
+    std::size_t mass_cancel_session_orders(const SessionOrderIndex::Session& session, std::uint64_t now_tsc) noexcept;
+    std::size_t park_down_stream_orders(std::uint64_t now_tsc) noexcept;
+    std::size_t resume_stream_parked_orders(std::uint64_t now_tsc) noexcept;
+
+    // Down sources the order depends on: the sides it was seen on plus the required ones
+    [[nodiscard]] bool involves_down_stream(const OrderState& os) const noexcept {
+        return (liveness_.down_mask() & (seen_sides(os) | config_.required_sides)) != 0;
+    }
+
+    // Calls fn once per order linked to any session (an order on several sessions is
+    // visited once per session; fn must be idempotent)
+    template <typename F>
+    void for_each_session_order(F&& fn) {
+        SessionOrderIndex& sessions = store_.sessions();
+        for (std::size_t i = 0; i < sessions.session_count(); ++i) {
+            sessions.for_each_order(sessions.session_at(i), fn);
+        }
+    }
+
+    // Every ReconState write goes through here so the CDC stream sees all changes
+    void set_recon_state(OrderState& os, ReconState to, std::uint64_t now_tsc) noexcept {
+        const ReconState from = os.recon_state;
+        os.recon_state = to;
+        if (from == to) {
+            return;
+        }
+        if (flight_) {
+            FlightRecord rec{};
+            rec.tsc = now_tsc;
+            rec.kind = FlightKind::Transition;
+            rec.a = static_cast<std::uint8_t>(from);
+            rec.b = static_cast<std::uint8_t>(to);
+            rec.c = os.current_mismatch.bits();
+            rec.x = os.key;
+            flight_->record(rec);
+        }
+        if (transition_ring_) {
+            publish_transition(os, from, now_tsc);
+        }
+    }
+    void publish_transition(const OrderState& os, ReconState from, std::uint64_t now_tsc) noexcept;
     
     // FX-7054: Gap management
     void check_gap_timeouts(std::uint64_t now_tsc) noexcept;
 
+    [[nodiscard]] MismatchMask current_mismatch_of(const OrderState& os) const noexcept {
+        return compute_mismatch(os, config_.qty_tolerance, config_.px_tolerance, config_.required_sides);
+    }
+    [[nodiscard]] SequenceTracker& tracker_for(Source source) noexcept { return seq_trackers_[source_index(source)]; }
+    void clear_all_gap_flags(OrderState& os) noexcept;
+
     static constexpr std::int64_t qty_tolerance_ = 0;
     static constexpr std::int64_t px_tolerance_ = 0;
     static constexpr std::uint64_t timing_slack_ = 0;
 
     std::atomic<bool>& stop_flag_;
-    ingest::SpscRing<core::ExecEvent, 1u << 16>& primary_;
-    ingest::SpscRing<core::ExecEvent, 1u << 16>& dropcopy_;
+    ExecRing& primary_;
+    ExecRing& dropcopy_;
+    ExecRing* prime_broker_{nullptr};  // Optional third side
     OrderStateStore& store_;
     ReconCounters& counters_;
     DivergenceRing& divergence_ring_;
     SequenceGapRing& seq_gap_ring_;
 
-    SequenceTracker primary_seq_tracker_{};
-    SequenceTracker dropcopy_seq_tracker_{};
+    // Per-source sequence trackers (index = source_index)
+    SequenceTracker seq_trackers_[SOURCE_COUNT]{};
 
     // ===== New members (FX-7053) =====
     util::WheelTimer* timer_wheel_{nullptr};  // Optional, nullptr if windowed recon disabled
     ReconConfig config_{};
+    util::DeadlineFifo grace_timers_{1};        // Sized from config_ when windowed
+    util::DeadlineFifo gap_recheck_timers_{1};
     std::uint64_t last_poll_tsc_{0};  // Last poll timestamp for deadline processing
+
+    ReconJitterMonitor jitter_{util::ns_to_tsc(config_.jitter_threshold_ns)};
+
+    SessionEventRing session_events_[SOURCE_COUNT];
+    StreamLiveness liveness_;
+
+    ReconTransitionRing* transition_ring_{nullptr};  // Optional CDC output
+    std::uint64_t transition_seq_{0};
+
+    FlightRecorder* flight_{nullptr};  // Optional crash-dump trace
+
+    util::SeqlockSnapshot<ReconStatsSnapshot> stats_snapshot_;
 };
 
 } // namespace core
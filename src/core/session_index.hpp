@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/exec_event.hpp"
+#include "core/order_state.hpp"
+#include "ingest/spsc_ring.hpp"
+
+namespace core {
+
+// Session-level events that affect every order seen on a session at once.
+enum class SessionEventKind : std::uint8_t {
+    Logout = 0,        // Session disconnected; its orders stop receiving updates
+    Logon = 1,         // Session (re)connected; suspended orders are re-evaluated
+    SessionReset = 2,  // Sequence reset / new session; like Logon plus tracker reset
+    MassCancel = 3,    // Venue cancelled every open order on the session
+    Heartbeat = 4      // Session alive with no executions (FIX 35=0 / transport keepalive)
+};
+
+struct SessionEvent {
+    Source source{};
+    std::uint16_t session_id{0};
+    SessionEventKind kind{SessionEventKind::Logout};
+    std::uint64_t tsc{0};  // When the session event was observed
+};
+
+static_assert(std::is_trivially_copyable_v<SessionEvent>, "SessionEvent must be trivially copyable");
+
+// One ring per ingest thread (producer) into the reconciler (consumer).
+using SessionEventRing = ingest::SpscRing<SessionEvent, 64>;
+
+// SessionOrderIndex keeps, per (source, session_id), an intrusive list of the orders
+// seen on that session. Links live in OrderState (session_next/prev/link), so
+// linking and unlinking are O(1) and a session-wide pass is O(orders in session).
+//
+// The session table is a small fixed array; when it is full, further sessions are
+// not tracked (untracked_links counts the orders affected).
+//
+// Thread safety: None. Single-writer only (reconciler thread).
+// Memory: All storage is inline. No heap allocations.
+class SessionOrderIndex {
+public:
+    static constexpr std::size_t MAX_SESSIONS = 64;
+
+    struct Session {
+        Source source{};
+        std::uint16_t session_id{0};
+        bool down{false};                          // Logged out, not yet back
+        std::uint32_t order_count{0};
+        OrderState* head{nullptr};
+        std::uint64_t mass_cancel_deadline_tsc{0};  // 0 = no mass cancel pending
+        std::uint64_t last_activity_tsc{0};         // Last exec event or heartbeat (0 = none)
+    };
+
+    // Links os into the (source, session_id) list, moving it off any other session
+    // of the same source. Orders joining a down session inherit its down flag.
+    // Returns false if the session table is full.
+    bool link(OrderState& os, Source source, std::uint16_t session_id) noexcept {
+        const std::size_t side = side_index(source);
+        const std::uint16_t link = os.session_link[side];
+        if (link != 0 && sessions_[link - 1].session_id == session_id) {
+            return true;  // Fast path: already on this session
+        }
+
+        Session* session = find_or_add(source, session_id);
+        if (!session) {
+            ++untracked_links_;
+            return false;
+        }
+        if (link != 0) {
+            unlink(os, source);
+        }
+
+        os.session_prev[side] = nullptr;
+        os.session_next[side] = session->head;
+        if (session->head) {
+            session->head->session_prev[side] = &os;
+        }
+        session->head = &os;
+        ++session->order_count;
+        os.session_link[side] = static_cast<std::uint16_t>(slot_of(*session) + 1);
+        if (session->down) {
+            os.session_flags |= SessionFlags::down_bit(source);
+        }
+        return true;
+    }
+
+    void unlink(OrderState& os, Source source) noexcept {
+        const std::size_t side = side_index(source);
+        const std::uint16_t link = os.session_link[side];
+        if (link == 0) {
+            return;
+        }
+        Session& session = sessions_[link - 1];
+        if (os.session_prev[side]) {
+            os.session_prev[side]->session_next[side] = os.session_next[side];
+        } else {
+            session.head = os.session_next[side];
+        }
+        if (os.session_next[side]) {
+            os.session_next[side]->session_prev[side] = os.session_prev[side];
+        }
+        --session.order_count;
+        os.session_next[side] = nullptr;
+        os.session_prev[side] = nullptr;
+        os.session_link[side] = 0;
+    }
+
+    void unlink_all(OrderState& os) noexcept {
+        for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+            unlink(os, static_cast<Source>(i));
+        }
+    }
+
+    [[nodiscard]] Session* find(Source source, std::uint16_t session_id) noexcept {
+        for (std::size_t i = 0; i < used_; ++i) {
+            Session& s = sessions_[i];
+            if (s.source == source && s.session_id == session_id) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns nullptr only when the table is full.
+    [[nodiscard]] Session* find_or_add(Source source, std::uint16_t session_id) noexcept {
+        if (Session* s = find(source, session_id)) {
+            return s;
+        }
+        if (used_ == MAX_SESSIONS) {
+            return nullptr;
+        }
+        Session& s = sessions_[used_++];
+        s = Session{};
+        s.source = source;
+        s.session_id = session_id;
+        return &s;
+    }
+
+    // Session the order is linked to for source, or nullptr.
+    [[nodiscard]] const Session* session_of(const OrderState& os, Source source) const noexcept {
+        const std::uint16_t link = os.session_link[side_index(source)];
+        return link != 0 ? &sessions_[link - 1] : nullptr;
+    }
+
+    // Calls fn(OrderState&) for every order on the session. fn must not link or
+    // unlink orders on this session.
+    template <typename F>
+    std::size_t for_each_order(const Session& session, F&& fn) {
+        const std::size_t side = side_index(session.source);
+        std::size_t visited = 0;
+        for (OrderState* os = session.head; os; os = os->session_next[side]) {
+            fn(*os);
+            ++visited;
+        }
+        return visited;
+    }
+
+    // Sessions in use are slots [0, session_count())
+    [[nodiscard]] std::size_t session_count() const noexcept { return used_; }
+    [[nodiscard]] Session& session_at(std::size_t slot) noexcept { return sessions_[slot]; }
+    [[nodiscard]] std::size_t untracked_links() const noexcept { return untracked_links_; }
+
+    void clear() noexcept {
+        sessions_ = {};
+        used_ = 0;
+        untracked_links_ = 0;
+    }
+
+private:
+    [[nodiscard]] static constexpr std::size_t side_index(Source source) noexcept {
+        return source_index(source);
+    }
+    [[nodiscard]] std::size_t slot_of(const Session& s) const noexcept {
+        return static_cast<std::size_t>(&s - sessions_.data());
+    }
+
+    std::array<Session, MAX_SESSIONS> sessions_{};
+    std::size_t used_{0};
+    std::size_t untracked_links_{0};
+};
+
+} // namespace core
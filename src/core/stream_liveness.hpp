@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/exec_event.hpp"
+
+namespace core {
+
+// Per-source stream liveness for degraded-mode reconciliation. Activity is any
+// execution event or heartbeat from the source; a source is down once it has been
+// silent for the timeout and up again as soon as it is active within it.
+//
+// A source is monitored only after its first activity, so a feed that was never
+// attached (or has not started yet) is not reported down.
+//
+// Thread safety: None. Single-writer only (reconciler thread).
+class StreamLiveness {
+public:
+    // Hot path: one compare and store
+    void on_activity(Source source, std::uint64_t tsc) noexcept {
+        std::uint64_t& last = last_activity_tsc_[source_index(source)];
+        if (tsc > last) {
+            last = tsc;
+        }
+    }
+
+    // Recomputes the down set at now_tsc. Only sources in monitored (source_bit mask)
+    // can be down. Returns the new down mask.
+    std::uint8_t evaluate(std::uint64_t now_tsc, std::uint64_t timeout_tsc, std::uint8_t monitored) noexcept {
+        std::uint8_t down = 0;
+        for (std::size_t i = 0; i < SOURCE_COUNT; ++i) {
+            const std::uint64_t last = last_activity_tsc_[i];
+            const std::uint8_t bit = source_bit(static_cast<Source>(i));
+            if ((monitored & bit) != 0 && last != 0 && now_tsc > last && now_tsc - last >= timeout_tsc) {
+                down = static_cast<std::uint8_t>(down | bit);
+            }
+        }
+        down_mask_ = down;
+        return down;
+    }
+
+    [[nodiscard]] std::uint64_t last_activity_tsc(Source source) const noexcept {
+        return last_activity_tsc_[source_index(source)];
+    }
+    // source_bit of every source currently down
+    [[nodiscard]] std::uint8_t down_mask() const noexcept { return down_mask_; }
+    [[nodiscard]] bool is_down(Source source) const noexcept { return (down_mask_ & source_bit(source)) != 0; }
+
+private:
+    std::uint64_t last_activity_tsc_[SOURCE_COUNT]{};  // 0 = never active
+    std::uint8_t down_mask_{0};
+};
+
+} // namespace core
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "core/divergence.hpp"
+#include "core/exec_event.hpp"
+#include "core/sequence_tracker.hpp"
+
+namespace core {
+
+// Flyweight codecs for messages on the bus, laid out the way SBE lays out a
+// fixed-length block:
+//
+//   MessageHeader (8 bytes): block_length u16 | template_id u16 | schema_id u16 | version u16
+//   Body (block_length bytes): fixed fields at naturally aligned offsets
+//
+// Every integer is little-endian on the wire regardless of host. Decoders read
+// fields straight from the receive buffer (no intermediate struct). A decoder
+// accepts any version of its schema whose block is at least as long as the
+// block it knows: newer senders append fields at the end of the block, older
+// receivers skip them.
+//
+// The offsets below are the schema; bump WIRE_SCHEMA_VERSION when appending
+// fields and never move or resize an existing one.
+
+inline constexpr std::uint16_t WIRE_SCHEMA_ID = 0x4658;  // "FX"
+inline constexpr std::uint16_t WIRE_SCHEMA_VERSION = 1;
+
+namespace wire_detail {
+
+template <typename T>
+[[nodiscard]] inline T load_le(const std::uint8_t* p) noexcept {
+    static_assert(std::is_integral_v<T>);
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+        v = std::byteswap(v);
+    }
+    return v;
+}
+
+template <typename T>
+inline void store_le(std::uint8_t* p, T v) noexcept {
+    static_assert(std::is_integral_v<T>);
+    if constexpr (std::endian::native == std::endian::big) {
+        v = std::byteswap(v);
+    }
+    std::memcpy(p, &v, sizeof(T));
+}
+
+} // namespace wire_detail
+
+// ===== Message header =====
+
+class MessageHeaderFlyweight {
+public:
+    static constexpr std::size_t ENCODED_LENGTH = 8;
+
+    explicit MessageHeaderFlyweight(const std::uint8_t* buf) noexcept : buf_(buf) {}
+
+    [[nodiscard]] std::uint16_t block_length() const noexcept { return wire_detail::load_le<std::uint16_t>(buf_ + 0); }
+    [[nodiscard]] std::uint16_t template_id() const noexcept { return wire_detail::load_le<std::uint16_t>(buf_ + 2); }
+    [[nodiscard]] std::uint16_t schema_id() const noexcept { return wire_detail::load_le<std::uint16_t>(buf_ + 4); }
+    [[nodiscard]] std::uint16_t version() const noexcept { return wire_detail::load_le<std::uint16_t>(buf_ + 6); }
+
+    static void encode(std::uint8_t* buf, std::uint16_t block_length, std::uint16_t template_id) noexcept {
+        wire_detail::store_le<std::uint16_t>(buf + 0, block_length);
+        wire_detail::store_le<std::uint16_t>(buf + 2, template_id);
+        wire_detail::store_le<std::uint16_t>(buf + 4, WIRE_SCHEMA_ID);
+        wire_detail::store_le<std::uint16_t>(buf + 6, WIRE_SCHEMA_VERSION);
+    }
+
+private:
+    const std::uint8_t* buf_;
+};
+
+// Returns the body of a message with the given template, or nullptr if buf is not
+// such a message of this schema (short buffer, other schema/template, truncated block).
+[[nodiscard]] inline const std::uint8_t* wire_message_body(const std::uint8_t* buf, std::size_t length,
+                                                           std::uint16_t template_id,
+                                                           std::uint16_t min_block_length) noexcept {
+    if (length < MessageHeaderFlyweight::ENCODED_LENGTH) {
+        return nullptr;
+    }
+    const MessageHeaderFlyweight hdr(buf);
+    const std::size_t block = hdr.block_length();
+    const bool ok = hdr.schema_id() == WIRE_SCHEMA_ID && hdr.template_id() == template_id &&
+                    hdr.version() >= 1 && block >= min_block_length &&
+                    length >= MessageHeaderFlyweight::ENCODED_LENGTH + block;
+    return ok ? buf + MessageHeaderFlyweight::ENCODED_LENGTH : nullptr;
+}
+
+// ===== ExecEvent (template 1) =====
+//
+//   0 seq_num u64        48 session_id u16      56 exec_id char[32]
+//   8 price_micro i64    50 exec_type u8        88 order_id char[32]
+//  16 qty i64            51 ord_status u8      120 clord_id char[32]
+//  24 cum_qty i64        52 exec_id_len u8
+//  32 sending_time u64   53 order_id_len u8
+//  40 transact_time u64  54 clord_id_len u8  (55 padding)
+class ExecEventDecoder {
+public:
+    static constexpr std::uint16_t TEMPLATE_ID = 1;
+    static constexpr std::uint16_t BLOCK_LENGTH = 152;
+    static constexpr std::size_t ID_CAPACITY = 32;
+
+    explicit ExecEventDecoder(const std::uint8_t* body) noexcept : body_(body) {}
+
+    [[nodiscard]] std::uint64_t seq_num() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 0); }
+    [[nodiscard]] std::int64_t price_micro() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 8); }
+    [[nodiscard]] std::int64_t qty() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 16); }
+    [[nodiscard]] std::int64_t cum_qty() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 24); }
+    [[nodiscard]] std::uint64_t sending_time() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 32); }
+    [[nodiscard]] std::uint64_t transact_time() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 40); }
+    [[nodiscard]] std::uint16_t session_id() const noexcept { return wire_detail::load_le<std::uint16_t>(body_ + 48); }
+    [[nodiscard]] std::uint8_t exec_type() const noexcept { return body_[50]; }
+    [[nodiscard]] std::uint8_t ord_status() const noexcept { return body_[51]; }
+    // Id lengths are clamped to ID_CAPACITY, so a corrupt length never reads past the block
+    [[nodiscard]] std::string_view exec_id() const noexcept { return id(52, 56); }
+    [[nodiscard]] std::string_view order_id() const noexcept { return id(53, 88); }
+    [[nodiscard]] std::string_view clord_id() const noexcept { return id(54, 120); }
+
+private:
+    [[nodiscard]] std::string_view id(std::size_t len_offset, std::size_t data_offset) const noexcept {
+        const std::size_t len = std::min<std::size_t>(body_[len_offset], ID_CAPACITY);
+        return {reinterpret_cast<const char*>(body_ + data_offset), len};
+    }
+
+    const std::uint8_t* body_;
+};
+
+class ExecEventEncoder {
+public:
+    static constexpr std::size_t MESSAGE_LENGTH = MessageHeaderFlyweight::ENCODED_LENGTH + ExecEventDecoder::BLOCK_LENGTH;
+
+    // Writes header and block into buf (MESSAGE_LENGTH bytes). Ids longer than the
+    // wire capacity are truncated; ingest-side fields (source, ingest_tsc) are not sent.
+    static void encode(std::uint8_t* buf, const ExecEvent& ev) noexcept {
+        static_assert(ExecEvent::id_capacity == ExecEventDecoder::ID_CAPACITY,
+                      "ExecEvent ids must fit the wire id fields");
+        MessageHeaderFlyweight::encode(buf, ExecEventDecoder::BLOCK_LENGTH, ExecEventDecoder::TEMPLATE_ID);
+        std::uint8_t* body = buf + MessageHeaderFlyweight::ENCODED_LENGTH;
+        std::memset(body, 0, ExecEventDecoder::BLOCK_LENGTH);
+        wire_detail::store_le<std::uint64_t>(body + 0, ev.seq_num);
+        wire_detail::store_le<std::int64_t>(body + 8, ev.price_micro);
+        wire_detail::store_le<std::int64_t>(body + 16, ev.qty);
+        wire_detail::store_le<std::int64_t>(body + 24, ev.cum_qty);
+        wire_detail::store_le<std::uint64_t>(body + 32, ev.sending_time);
+        wire_detail::store_le<std::uint64_t>(body + 40, ev.transact_time);
+        wire_detail::store_le<std::uint16_t>(body + 48, ev.session_id);
+        body[50] = static_cast<std::uint8_t>(ev.exec_type);
+        body[51] = static_cast<std::uint8_t>(ev.ord_status);
+        put_id(body, 52, 56, ev.exec_id, ev.exec_id_len);
+        put_id(body, 53, 88, ev.order_id, ev.order_id_len);
+        put_id(body, 54, 120, ev.clord_id, ev.clord_id_len);
+    }
+
+private:
+    static void put_id(std::uint8_t* body, std::size_t len_offset, std::size_t data_offset, const char* id,
+                       std::size_t len) noexcept {
+        const std::size_t l = std::min(len, ExecEventDecoder::ID_CAPACITY);
+        body[len_offset] = static_cast<std::uint8_t>(l);
+        std::memcpy(body + data_offset, id, l);
+    }
+};
+
+// Decodes an ExecEvent message into out. Returns false (out untouched) if buf does
+// not hold one; field copies themselves are unconditional.
+[[nodiscard]] inline bool decode_exec_event(const std::uint8_t* buf, std::size_t length, Source src,
+                                            std::uint64_t ingest_tsc, ExecEvent& out) noexcept {
+    const std::uint8_t* body =
+        wire_message_body(buf, length, ExecEventDecoder::TEMPLATE_ID, ExecEventDecoder::BLOCK_LENGTH);
+    if (!body) {
+        return false;
+    }
+    const ExecEventDecoder d(body);
+    out.source = src;
+    out.exec_type = static_cast<ExecType>(d.exec_type());
+    out.ord_status = static_cast<OrdStatus>(d.ord_status());
+    out.seq_num = d.seq_num();
+    out.session_id = d.session_id();
+    out.price_micro = d.price_micro();
+    out.qty = d.qty();
+    out.cum_qty = d.cum_qty();
+    out.sending_time = d.sending_time();
+    out.transact_time = d.transact_time();
+    out.ingest_tsc = ingest_tsc;
+    // Whole id fields are copied; only the first *_len bytes are meaningful
+    std::memcpy(out.exec_id, body + 56, ExecEventDecoder::ID_CAPACITY);
+    std::memcpy(out.order_id, body + 88, ExecEventDecoder::ID_CAPACITY);
+    std::memcpy(out.clord_id, body + 120, ExecEventDecoder::ID_CAPACITY);
+    out.exec_id_len = d.exec_id().size();
+    out.order_id_len = d.order_id().size();
+    out.clord_id_len = d.clord_id().size();
+    return true;
+}
+
+// ===== Divergence (template 2) =====
+//
+//   0 key u64                 48 dropcopy_ts u64        88 type u8
+//   8 internal_cum_qty i64    56 detect_tsc u64         89 internal_status u8
+//  16 dropcopy_cum_qty i64    64 prime_broker_cum_qty   90 dropcopy_status u8
+//  24 internal_avg_px i64     72 prime_broker_avg_px    91 prime_broker_status u8
+//  32 dropcopy_avg_px i64     80 prime_broker_ts u64    92 mismatch_mask u8
+//  40 internal_ts u64                                   93 pair_mismatch u8[3]
+class DivergenceDecoder {
+public:
+    static constexpr std::uint16_t TEMPLATE_ID = 2;
+    static constexpr std::uint16_t BLOCK_LENGTH = 96;
+
+    explicit DivergenceDecoder(const std::uint8_t* body) noexcept : body_(body) {}
+
+    [[nodiscard]] OrderKey key() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 0); }
+    [[nodiscard]] std::int64_t internal_cum_qty() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 8); }
+    [[nodiscard]] std::int64_t dropcopy_cum_qty() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 16); }
+    [[nodiscard]] std::int64_t internal_avg_px() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 24); }
+    [[nodiscard]] std::int64_t dropcopy_avg_px() const noexcept { return wire_detail::load_le<std::int64_t>(body_ + 32); }
+    [[nodiscard]] std::uint64_t internal_ts() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 40); }
+    [[nodiscard]] std::uint64_t dropcopy_ts() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 48); }
+    [[nodiscard]] std::uint64_t detect_tsc() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 56); }
+    [[nodiscard]] std::int64_t prime_broker_cum_qty() const noexcept {
+        return wire_detail::load_le<std::int64_t>(body_ + 64);
+    }
+    [[nodiscard]] std::int64_t prime_broker_avg_px() const noexcept {
+        return wire_detail::load_le<std::int64_t>(body_ + 72);
+    }
+    [[nodiscard]] std::uint64_t prime_broker_ts() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 80); }
+    [[nodiscard]] DivergenceType type() const noexcept { return static_cast<DivergenceType>(body_[88]); }
+    [[nodiscard]] OrdStatus internal_status() const noexcept { return static_cast<OrdStatus>(body_[89]); }
+    [[nodiscard]] OrdStatus dropcopy_status() const noexcept { return static_cast<OrdStatus>(body_[90]); }
+    [[nodiscard]] OrdStatus prime_broker_status() const noexcept { return static_cast<OrdStatus>(body_[91]); }
+    [[nodiscard]] std::uint8_t mismatch_mask() const noexcept { return body_[92]; }
+    [[nodiscard]] std::uint8_t pair_mismatch(std::size_t pair) const noexcept { return body_[93 + pair]; }
+
+private:
+    const std::uint8_t* body_;
+};
+
+static_assert(SIDE_PAIR_COUNT == 3, "Divergence wire block reserves three pair_mismatch bytes");
+
+class DivergenceEncoder {
+public:
+    static constexpr std::size_t MESSAGE_LENGTH =
+        MessageHeaderFlyweight::ENCODED_LENGTH + DivergenceDecoder::BLOCK_LENGTH;
+
+    static void encode(std::uint8_t* buf, const Divergence& div) noexcept {
+        MessageHeaderFlyweight::encode(buf, DivergenceDecoder::BLOCK_LENGTH, DivergenceDecoder::TEMPLATE_ID);
+        std::uint8_t* body = buf + MessageHeaderFlyweight::ENCODED_LENGTH;
+        wire_detail::store_le<std::uint64_t>(body + 0, div.key);
+        wire_detail::store_le<std::int64_t>(body + 8, div.internal_cum_qty);
+        wire_detail::store_le<std::int64_t>(body + 16, div.dropcopy_cum_qty);
+        wire_detail::store_le<std::int64_t>(body + 24, div.internal_avg_px);
+        wire_detail::store_le<std::int64_t>(body + 32, div.dropcopy_avg_px);
+        wire_detail::store_le<std::uint64_t>(body + 40, div.internal_ts);
+        wire_detail::store_le<std::uint64_t>(body + 48, div.dropcopy_ts);
+        wire_detail::store_le<std::uint64_t>(body + 56, div.detect_tsc);
+        wire_detail::store_le<std::int64_t>(body + 64, div.prime_broker_cum_qty);
+        wire_detail::store_le<std::int64_t>(body + 72, div.prime_broker_avg_px);
+        wire_detail::store_le<std::uint64_t>(body + 80, div.prime_broker_ts);
+        body[88] = static_cast<std::uint8_t>(div.type);
+        body[89] = static_cast<std::uint8_t>(div.internal_status);
+        body[90] = static_cast<std::uint8_t>(div.dropcopy_status);
+        body[91] = static_cast<std::uint8_t>(div.prime_broker_status);
+        body[92] = div.mismatch_mask;
+        std::memcpy(body + 93, div.pair_mismatch, SIDE_PAIR_COUNT);
+    }
+};
+
+[[nodiscard]] inline bool decode_divergence(const std::uint8_t* buf, std::size_t length, Divergence& out) noexcept {
+    const std::uint8_t* body =
+        wire_message_body(buf, length, DivergenceDecoder::TEMPLATE_ID, DivergenceDecoder::BLOCK_LENGTH);
+    if (!body) {
+        return false;
+    }
+    const DivergenceDecoder d(body);
+    out.key = d.key();
+    out.type = d.type();
+    out.internal_status = d.internal_status();
+    out.dropcopy_status = d.dropcopy_status();
+    out.internal_cum_qty = d.internal_cum_qty();
+    out.dropcopy_cum_qty = d.dropcopy_cum_qty();
+    out.internal_avg_px = d.internal_avg_px();
+    out.dropcopy_avg_px = d.dropcopy_avg_px();
+    out.internal_ts = d.internal_ts();
+    out.dropcopy_ts = d.dropcopy_ts();
+    out.detect_tsc = d.detect_tsc();
+    out.mismatch_mask = d.mismatch_mask();
+    out.prime_broker_status = d.prime_broker_status();
+    std::memcpy(out.pair_mismatch, body + 93, SIDE_PAIR_COUNT);
+    out.prime_broker_cum_qty = d.prime_broker_cum_qty();
+    out.prime_broker_avg_px = d.prime_broker_avg_px();
+    out.prime_broker_ts = d.prime_broker_ts();
+    return true;
+}
+
+// ===== SequenceGapEvent (template 3) =====
+//
+//   0 expected_seq u64   24 session_id u16   27 kind u8
+//   8 seen_seq u64       26 source u8        28 gap_closed_by_fill u8  (29..31 padding)
+//  16 detect_ts u64
+class SequenceGapDecoder {
+public:
+    static constexpr std::uint16_t TEMPLATE_ID = 3;
+    static constexpr std::uint16_t BLOCK_LENGTH = 32;
+
+    explicit SequenceGapDecoder(const std::uint8_t* body) noexcept : body_(body) {}
+
+    [[nodiscard]] std::uint64_t expected_seq() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 0); }
+    [[nodiscard]] std::uint64_t seen_seq() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 8); }
+    [[nodiscard]] std::uint64_t detect_ts() const noexcept { return wire_detail::load_le<std::uint64_t>(body_ + 16); }
+    [[nodiscard]] std::uint16_t session_id() const noexcept { return wire_detail::load_le<std::uint16_t>(body_ + 24); }
+    [[nodiscard]] Source source() const noexcept { return static_cast<Source>(body_[26]); }
+    [[nodiscard]] GapKind kind() const noexcept { return static_cast<GapKind>(body_[27]); }
+    [[nodiscard]] bool gap_closed_by_fill() const noexcept { return body_[28] != 0; }
+
+private:
+    const std::uint8_t* body_;
+};
+
+class SequenceGapEncoder {
+public:
+    static constexpr std::size_t MESSAGE_LENGTH =
+        MessageHeaderFlyweight::ENCODED_LENGTH + SequenceGapDecoder::BLOCK_LENGTH;
+
+    static void encode(std::uint8_t* buf, const SequenceGapEvent& gap) noexcept {
+        MessageHeaderFlyweight::encode(buf, SequenceGapDecoder::BLOCK_LENGTH, SequenceGapDecoder::TEMPLATE_ID);
+        std::uint8_t* body = buf + MessageHeaderFlyweight::ENCODED_LENGTH;
+        std::memset(body, 0, SequenceGapDecoder::BLOCK_LENGTH);
+        wire_detail::store_le<std::uint64_t>(body + 0, gap.expected_seq);
+        wire_detail::store_le<std::uint64_t>(body + 8, gap.seen_seq);
+        wire_detail::store_le<std::uint64_t>(body + 16, gap.detect_ts);
+        wire_detail::store_le<std::uint16_t>(body + 24, gap.session_id);
+        body[26] = static_cast<std::uint8_t>(gap.source);
+        body[27] = static_cast<std::uint8_t>(gap.kind);
+        body[28] = gap.gap_closed_by_fill ? 1 : 0;
+    }
+};
+
+[[nodiscard]] inline bool decode_sequence_gap(const std::uint8_t* buf, std::size_t length,
+                                              SequenceGapEvent& out) noexcept {
+    const std::uint8_t* body =
+        wire_message_body(buf, length, SequenceGapDecoder::TEMPLATE_ID, SequenceGapDecoder::BLOCK_LENGTH);
+    if (!body) {
+        return false;
+    }
+    const SequenceGapDecoder d(body);
+    out.source = d.source();
+    out.session_id = d.session_id();
+    out.expected_seq = d.expected_seq();
+    out.seen_seq = d.seen_seq();
+    out.kind = d.kind();
+    out.detect_ts = d.detect_ts();
+    out.gap_closed_by_fill = d.gap_closed_by_fill();
+    return true;
+}
+
+} // namespace core
@@ -6,9 +6,9 @@
 
 namespace core {
 
-// WireExecEvent represents the normalized, fixed-layout execution event published on the bus.
-// In production this would correspond to an SBE/flat schema; here it is a simple packed POD
-// with no heap-owned fields.
+// WireExecEvent is the packed, native-endian record layout of an execution event. It is
+// the record format of capture files (event_capture.hpp); the bus carries the aligned,
+// little-endian ExecEvent message from wire_codec.hpp instead.
 #pragma pack(push, 1)
 struct WireExecEvent {
     static constexpr std::size_t id_capacity = 32;
@@ -2,6 +2,8 @@
 
 #include <thread>
 
+#include "core/wire_codec.hpp"
+#include "util/alloc_guard.hpp"
 #include "util/rdtsc.hpp"
 
 namespace ingest {
@@ -54,24 +56,38 @@ void AeronSubscriber::run() {
         return;
     }
 
-    auto handler = [&](const concurrent::AtomicBuffer& buffer,
-                       aeron::util::index_t offset,
-                       aeron::util::index_t length,
-                       const concurrent::logbuffer::Header&) {
-        if (length != static_cast<aeron::util::index_t>(sizeof(core::WireExecEvent))) {
-            ++stats_.parse_failures;
+    auto on_fragment = [&](const concurrent::AtomicBuffer& buffer,
+                           aeron::util::index_t offset,
+                           aeron::util::index_t length,
+                           const concurrent::logbuffer::Header&) {
+        core::ExecEvent evt{};
+        if (length < 0 || !core::decode_exec_event(buffer.buffer() + offset, static_cast<std::size_t>(length),
+                                                   source_, ::util::rdtsc(), evt)) {
+            ThreadStats::bump(stats_.parse_failures);
+            return;
+        }
+        if (!annotator_.annotate(evt)) {
+            ThreadStats::bump(stats_.rejected);
             return;
         }
 
-        const auto* wire = reinterpret_cast<const core::WireExecEvent*>(buffer.buffer() + offset);
-        const core::ExecEvent evt = core::from_wire(*wire, source_, ::util::rdtsc());
-        if (!ring_.try_push(evt)) {
-            ++stats_.drops;
+        const bool pushed = ring_.try_push(evt);
+        if (!pushed) {
+            ThreadStats::bump(stats_.drops);
         } else {
-            ++stats_.produced;
+            ThreadStats::bump(stats_.produced);
+        }
+        if (flight_) {
+            flight_->record_event(pushed ? core::FlightKind::Event : core::FlightKind::IngestDrop, evt, evt.order_key);
         }
     };
 
+    // Bind the type-erased handler once; converting the lambda on every poll() call
+    // would construct a fresh std::function per poll.
+    const FragmentHandler handler{on_fragment};
+
+    ::util::ScopedHotPhase hot_phase;
+
     int idle_count = 0;
     while (!stop_flag_.load(std::memory_order_acquire)) {
         const int fragments = subscription->poll(handler, fragment_limit);
@@ -8,18 +8,15 @@
 #include <aeron/Aeron.h>
 
 #include "core/exec_event.hpp"
+#include "core/flight_recorder.hpp"
+#include "core/ingest_annotator.hpp"
 #include "core/wire_exec_event.hpp"
 #include "ingest/aeron_client_view.hpp"
 #include "ingest/spsc_ring.hpp"
+#include "ingest/thread_stats.hpp"
 
 namespace ingest {
 
-struct ThreadStats {
-    std::size_t produced{0};
-    std::size_t parse_failures{0};
-    std::size_t drops{0};
-};
-
 using Ring = ingest::SpscRing<core::ExecEvent, 1u << 16>;
 
 class AeronSubscriber {
@@ -42,6 +39,11 @@ public:
 
     void run();
 
+    // Configure before run(): owned by the subscriber thread afterwards
+    core::IngestAnnotator& annotator() noexcept { return annotator_; }
+    // Records every event pushed (or dropped on a full ring) for crash dumps
+    void attach_flight_recorder(core::FlightRecorder& recorder) noexcept { flight_ = &recorder; }
+
 private:
     std::string channel_;
     std::int32_t stream_id_;
@@ -50,6 +52,9 @@ private:
     core::Source source_;
     std::shared_ptr<AeronClientView> client_;
     std::atomic<bool>& stop_flag_;
+    // Validation, order key and per-session sequence checks, off the reconciler thread
+    core::IngestAnnotator annotator_{};
+    core::FlightRecorder* flight_{nullptr};
 };
 
 } // namespace ingest
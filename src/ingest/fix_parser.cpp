@@ -3,12 +3,19 @@
 #include <charconv>
 #include <cstring>
 
+#include "ingest/fix_scan.hpp"
 #include "util/rdtsc.hpp"
 
 namespace ingest {
 namespace {
 
 constexpr char soh = '\x01';
+constexpr std::size_t max_indexed_fields = 64;
+
+inline const char* find_byte(const char* begin, const char* end, char c) noexcept {
+    while (begin < end && *begin != c) ++begin;
+    return begin;
+}
 
 inline bool parse_int64(const char* begin, const char* end, int64_t& out) noexcept {
     auto res = std::from_chars(begin, end, out);
@@ -66,17 +73,33 @@ ParseResult parse_exec_report(const char* data, std::size_t len, core::ExecEvent
     const char* ptr = data;
     const char* end = data + len;
 
+    // Field boundaries come from one vector pass over the message; a message with
+    // more fields than fit here finishes with a byte-wise scan
+    std::uint32_t soh_pos[max_indexed_fields];
+    const std::size_t soh_count = scan_soh(data, len, soh_pos, max_indexed_fields);
+    std::size_t next_soh = 0;
+
     while (ptr < end) {
         const char* tag_start = ptr;
-        while (ptr < end && *ptr != '=') ++ptr;
-        if (ptr >= end) break;
+        const char* field_end = end;
+        if (next_soh < soh_count) {
+            field_end = data + soh_pos[next_soh++];
+        } else if (soh_count == max_indexed_fields) {
+            field_end = find_byte(ptr, end, soh);
+        }
+
+        const char* eq = find_byte(tag_start, field_end, '=');
+        if (eq == field_end) {
+            // A tag running into the next field is malformed; trailing bytes without
+            // any further '=' are ignored
+            if (find_byte(field_end, end, '=') != end) return ParseResult::Invalid;
+            break;
+        }
         int64_t tag = 0;
-        if (!parse_int64(tag_start, ptr, tag)) return ParseResult::Invalid;
-        ++ptr; // skip '='
-        const char* val_start = ptr;
-        while (ptr < end && *ptr != soh) ++ptr;
-        const char* val_end = ptr;
-        if (ptr < end) ++ptr; // skip separator
+        if (!parse_int64(tag_start, eq, tag)) return ParseResult::Invalid;
+        const char* val_start = eq + 1;
+        const char* val_end = field_end;
+        ptr = field_end < end ? field_end + 1 : end; // skip separator
 
         switch (tag) {
         case 35: { // MsgType
@@ -137,6 +160,14 @@ ParseResult parse_exec_report(const char* data, std::size_t len, core::ExecEvent
             has_time = true;
             break;
         }
+        case 10: { // CheckSum: byte sum of everything before the tag, modulo 256
+            uint64_t checksum = 0;
+            if (!parse_uint64(val_start, val_end, checksum)) return ParseResult::Invalid;
+            if (checksum != fix_checksum(data, static_cast<std::size_t>(tag_start - data))) {
+                return ParseResult::Invalid;
+            }
+            break;
+        }
         case 60: { // TransactTime
             uint64_t ts = 0;
             if (!parse_uint64(val_start, val_end, ts)) return ParseResult::Invalid;
@@ -0,0 +1,145 @@
+#include "ingest/fix_scan.hpp"
+
+#if FX_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace ingest {
+
+namespace {
+
+constexpr char soh = '\x01';
+
+// Scalar tail shared by every level: scans data[from, len) and appends to positions[n..)
+std::size_t scan_soh_from(const char* data, std::size_t from, std::size_t len, std::uint32_t* positions,
+                          std::size_t n, std::size_t max_positions) noexcept {
+    for (std::size_t i = from; i < len && n < max_positions; ++i) {
+        if (data[i] == soh) {
+            positions[n++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return n;
+}
+
+std::size_t scan_soh_scalar(const char* data, std::size_t len, std::uint32_t* positions,
+                            std::size_t max_positions) noexcept {
+    return scan_soh_from(data, 0, len, positions, 0, max_positions);
+}
+
+std::uint32_t byte_sum(const char* data, std::size_t from, std::size_t len) noexcept {
+    std::uint32_t sum = 0;
+    for (std::size_t i = from; i < len; ++i) {
+        sum += static_cast<unsigned char>(data[i]);
+    }
+    return sum;
+}
+
+std::uint8_t fix_checksum_scalar(const char* data, std::size_t len) noexcept {
+    return static_cast<std::uint8_t>(byte_sum(data, 0, len));
+}
+
+#if FX_X86_DISPATCH
+
+FX_TARGET_AVX2 std::size_t scan_soh_avx2(const char* data, std::size_t len, std::uint32_t* positions,
+                                         std::size_t max_positions) noexcept {
+    const __m256i needle = _mm256_set1_epi8(soh);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto m = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        while (m != 0) {
+            if (n == max_positions) {
+                return n;
+            }
+            positions[n++] = static_cast<std::uint32_t>(i + _tzcnt_u32(m));
+            m = _blsr_u32(m);
+        }
+    }
+    return scan_soh_from(data, i, len, positions, n, max_positions);
+}
+
+FX_TARGET_AVX512 std::size_t scan_soh_avx512(const char* data, std::size_t len, std::uint32_t* positions,
+                                             std::size_t max_positions) noexcept {
+    const __m512i needle = _mm512_set1_epi8(soh);
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < len; i += 64) {
+        // Masked load for the tail: masked-out bytes are never touched
+        const __mmask64 live = len - i >= 64 ? ~__mmask64{0} : _bzhi_u64(~std::uint64_t{0}, static_cast<unsigned>(len - i));
+        const __m512i v = _mm512_maskz_loadu_epi8(live, data + i);
+        std::uint64_t m = _mm512_mask_cmpeq_epi8_mask(live, v, needle);
+        while (m != 0) {
+            if (n == max_positions) {
+                return n;
+            }
+            positions[n++] = static_cast<std::uint32_t>(i + _tzcnt_u64(m));
+            m = _blsr_u64(m);
+        }
+    }
+    return n;
+}
+
+FX_TARGET_AVX2 std::uint8_t fix_checksum_avx2(const char* data, std::size_t len) noexcept {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+    }
+    const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    const auto sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(half)) +
+                     static_cast<std::uint64_t>(_mm_extract_epi64(half, 1));
+    return static_cast<std::uint8_t>(sum + byte_sum(data, i, len));
+}
+
+FX_TARGET_AVX512 std::uint8_t fix_checksum_avx512(const char* data, std::size_t len) noexcept {
+    __m512i acc = _mm512_setzero_si512();
+    for (std::size_t i = 0; i < len; i += 64) {
+        const __mmask64 live = len - i >= 64 ? ~__mmask64{0} : _bzhi_u64(~std::uint64_t{0}, static_cast<unsigned>(len - i));
+        const __m512i v = _mm512_maskz_loadu_epi8(live, data + i);
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(v, _mm512_setzero_si512()));
+    }
+    // Spill instead of _mm512_reduce_add_epi64, which trips -Wuninitialized in GCC 12 headers
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    std::uint64_t sum = 0;
+    for (const std::uint64_t lane : lanes) {
+        sum += lane;
+    }
+    return static_cast<std::uint8_t>(sum);
+}
+
+#endif
+
+constexpr util::IsaKernels<ScanSohFn> SCAN_SOH{
+    scan_soh_scalar,
+#if FX_X86_DISPATCH
+    scan_soh_avx2,
+    scan_soh_avx512,
+#endif
+};
+
+constexpr util::IsaKernels<FixChecksumFn> FIX_CHECKSUM{
+    fix_checksum_scalar,
+#if FX_X86_DISPATCH
+    fix_checksum_avx2,
+    fix_checksum_avx512,
+#endif
+};
+
+// Bound once during static initialisation; calls below are a plain indirect call
+const ScanSohFn bound_scan_soh = SCAN_SOH.bind();
+const FixChecksumFn bound_fix_checksum = FIX_CHECKSUM.bind();
+
+} // namespace
+
+const util::IsaKernels<ScanSohFn>& scan_soh_kernels() noexcept { return SCAN_SOH; }
+const util::IsaKernels<FixChecksumFn>& fix_checksum_kernels() noexcept { return FIX_CHECKSUM; }
+
+std::size_t scan_soh(const char* data, std::size_t len, std::uint32_t* positions, std::size_t max_positions) noexcept {
+    return bound_scan_soh(data, len, positions, max_positions);
+}
+
+std::uint8_t fix_checksum(const char* data, std::size_t len) noexcept { return bound_fix_checksum(data, len); }
+
+} // namespace ingest
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "util/cpu_features.hpp"
+
+namespace ingest {
+
+// Byte-level FIX kernels, dispatched at startup to the best ISA level (see
+// util::dispatch_isa). Every level returns exactly what the scalar reference does.
+
+// Writes the offset of each SOH in data[0, len) to positions, in order, stopping
+// after max_positions. Returns the number written; a result of max_positions means
+// the scan may have stopped early.
+using ScanSohFn = std::size_t (*)(const char* data, std::size_t len, std::uint32_t* positions,
+                                  std::size_t max_positions) noexcept;
+
+// FIX CheckSum(10): sum of all bytes modulo 256.
+using FixChecksumFn = std::uint8_t (*)(const char* data, std::size_t len) noexcept;
+
+[[nodiscard]] const util::IsaKernels<ScanSohFn>& scan_soh_kernels() noexcept;
+[[nodiscard]] const util::IsaKernels<FixChecksumFn>& fix_checksum_kernels() noexcept;
+
+std::size_t scan_soh(const char* data, std::size_t len, std::uint32_t* positions, std::size_t max_positions) noexcept;
+[[nodiscard]] std::uint8_t fix_checksum(const char* data, std::size_t len) noexcept;
+
+} // namespace ingest
@@ -28,6 +28,22 @@ public:
         return true;
     }
 
+    // Two-phase push for producers that build the element in place: try_claim()
+    // returns the next free slot (nullptr if full) without making it visible;
+    // publish() hands it to the consumer. A claimed slot may be abandoned by not
+    // publishing it. Producer thread only.
+    [[nodiscard]] T* try_claim() noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (increment(head) == tail_.load(std::memory_order_acquire)) {
+            return nullptr; // full
+        }
+        return &buffer_[head];
+    }
+
+    void publish() noexcept {
+        head_.store(increment(head_.load(std::memory_order_relaxed)), std::memory_order_release);
+    }
+
     bool try_pop(T& out) noexcept {
         const auto tail = tail_.load(std::memory_order_relaxed);
         if (tail == head_.load(std::memory_order_acquire)) {
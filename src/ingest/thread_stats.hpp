@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace ingest {
+
+// Per-ingest-thread counters. Written only by the owning ingest thread (plain
+// load+store, no locked RMW on the hot path); readable from any thread, e.g. by
+// the metrics exporter while the daemon runs.
+struct ThreadStats {
+    std::atomic<std::size_t> produced{0};
+    std::atomic<std::size_t> parse_failures{0};
+    std::atomic<std::size_t> drops{0};
+    std::atomic<std::size_t> rejected{0};  // Failed IngestAnnotator validation
+
+    // Single-writer increment
+    static void bump(std::atomic<std::size_t>& c) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+} // namespace ingest
@@ -0,0 +1,119 @@
+#include "util/agent_runtime.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "util/async_file.hpp"
+#include "util/rdtsc.hpp"
+
+namespace util {
+
+AgentRuntime::~AgentRuntime() {
+    stop();
+    for (std::size_t i = 0; i < count_; ++i) {
+        agents_[i].destroy();
+    }
+}
+
+bool AgentRuntime::spawn(Agent agent) noexcept {
+    if (count_ == MAX_AGENTS || !agent.handle_) {
+        return false;
+    }
+    Agent::Handle h = std::exchange(agent.handle_, {});
+    h.promise().runtime = this;
+    h.promise().wake_tsc = 0;
+    agents_[count_++] = h;
+    return true;
+}
+
+std::size_t AgentRuntime::run_once(std::uint64_t now_tsc) noexcept {
+    now_tsc_ = now_tsc;
+    next_wake_tsc_ = NO_DEADLINE;
+    std::size_t resumed = 0;
+    // Agents spawned during the pass wait for the next one
+    std::size_t end = count_;
+    for (std::size_t i = 0; i < end;) {
+        const Agent::Handle h = agents_[i];
+        Agent::promise_type& p = h.promise();
+        const bool ready = p.ready && p.ready(p.ready_ctx);
+        if (ready || p.wake_tsc <= now_tsc) {
+            p.timed_out = !ready;
+            p.ready = nullptr;
+            p.ready_ctx = nullptr;
+            p.wake_tsc = NO_DEADLINE;
+            h.resume();
+            ++resumed;
+            if (h.done()) {
+                h.destroy();
+                // Keep spawn order: agents run in a stable sequence every pass
+                std::move(agents_ + i + 1, agents_ + count_, agents_ + i);
+                --count_;
+                --end;
+                continue;
+            }
+        }
+        next_wake_tsc_ = std::min(next_wake_tsc_, p.wake_tsc);
+        ++i;
+    }
+    for (std::size_t i = end; i < count_; ++i) {
+        next_wake_tsc_ = std::min(next_wake_tsc_, agents_[i].promise().wake_tsc);
+    }
+    resumes_ += resumed;
+    return resumed;
+}
+
+void AgentRuntime::run(const std::atomic<bool>& stop) noexcept {
+    while (count_ != 0 && !stop.load(std::memory_order_acquire)) {
+        const std::uint64_t now = rdtsc();
+        if (run_once(now) != 0) {
+            continue;
+        }
+        std::uint64_t sleep_ns = config_.idle_sleep_ns;
+        if (next_wake_tsc_ != NO_DEADLINE) {
+            sleep_ns = next_wake_tsc_ > now ? std::min(sleep_ns, tsc_to_ns(next_wake_tsc_ - now)) : 0;
+        }
+        if (sleep_ns > 0) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+        }
+    }
+}
+
+bool AgentRuntime::start() noexcept {
+    if (thread_.joinable()) {
+        return true;
+    }
+    stop_.store(false, std::memory_order_release);
+    try {
+        thread_ = std::thread([this] { run(stop_); });
+    } catch (...) {
+        return false;
+    }
+#if defined(__linux__)
+    if (config_.cpu >= 0 && config_.cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config_.cpu, &set);
+        pinned_.store(pthread_setaffinity_np(thread_.native_handle(), sizeof(set), &set) == 0,
+                      std::memory_order_release);
+    }
+#endif
+    return true;
+}
+
+void AgentRuntime::stop() noexcept {
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool reap_io_completion(AsyncFileWriter& writer) noexcept {
+    return writer.in_flight() == 0 || writer.reap(false) != 0;
+}
+
+} // namespace util
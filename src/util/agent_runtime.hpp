@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include "util/tsc_calibration.hpp"
+
+namespace util {
+
+class AgentRuntime;
+class AsyncFileWriter;
+
+// Agent is the coroutine type of a slow-path duty (log draining, reporting,
+// snapshotting, ...) run by an AgentRuntime. It starts suspended; spawn() hands it
+// to the runtime, which resumes it whenever what it co_awaits is satisfied.
+// Exceptions escaping an agent terminate the process.
+class Agent {
+public:
+    struct promise_type {
+        // What the suspended agent waits for: resume once wake_tsc is reached or
+        // ready(ready_ctx) returns true, whichever comes first
+        std::uint64_t wake_tsc{0};
+        bool (*ready)(void*){nullptr};
+        void* ready_ctx{nullptr};
+        bool timed_out{false};  // Last wait ended on wake_tsc rather than ready
+        AgentRuntime* runtime{nullptr};
+
+        Agent get_return_object() noexcept { return Agent{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Agent(Agent&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Agent& operator=(Agent&&) = delete;
+    ~Agent() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+private:
+    friend class AgentRuntime;
+    explicit Agent(Handle handle) noexcept : handle_(handle) {}
+
+    Handle handle_;
+};
+
+// AgentRuntime multiplexes agents on one thread: each pass resumes, in spawn order,
+// every agent whose wait is over, then the thread sleeps until the next timer (at
+// most idle_sleep_ns, which bounds the latency of polled conditions) if no agent
+// ran. Adding a duty adds an agent, not a thread.
+//
+// Waits are polled: a condition is re-checked once per pass, so it must be cheap
+// and non-blocking (a ring depth, an atomic, a non-blocking reap).
+//
+// Thread safety: spawn() before start(), or from an agent on the runtime thread.
+// run_once()/run() on one thread only.
+//
+// Memory: Agent frames are heap-allocated when the coroutine is created; the
+// runtime itself keeps a fixed table of MAX_AGENTS and does not allocate.
+class AgentRuntime {
+public:
+    static constexpr std::size_t MAX_AGENTS = 32;
+    static constexpr std::uint64_t NO_DEADLINE = std::numeric_limits<std::uint64_t>::max();
+
+    struct Config {
+        std::uint64_t idle_sleep_ns{100'000};
+        int cpu{-1};  // Pin the runtime thread to this CPU; -1 leaves it unpinned
+    };
+
+    AgentRuntime() noexcept : AgentRuntime(Config{}) {}
+    explicit AgentRuntime(const Config& cfg) noexcept : config_(cfg) {}
+    ~AgentRuntime();
+
+    AgentRuntime(const AgentRuntime&) = delete;
+    AgentRuntime& operator=(const AgentRuntime&) = delete;
+
+    // Takes ownership of agent; it first runs on the next pass. Returns false (agent
+    // destroyed) if MAX_AGENTS are already running.
+    bool spawn(Agent agent) noexcept;
+
+    // One pass at now_tsc. Agents that finish are destroyed. Returns the number resumed.
+    std::size_t run_once(std::uint64_t now_tsc) noexcept;
+    // Passes on the calling thread until stop is set or no agent is left
+    void run(const std::atomic<bool>& stop) noexcept;
+
+    // run() on a new thread, pinned to Config::cpu if set. Returns false if the
+    // thread could not be created.
+    bool start() noexcept;
+    // Stops and joins the start() thread. Agents still suspended stay owned (and
+    // are destroyed with the runtime).
+    void stop() noexcept;
+    // True once the start() thread is pinned to Config::cpu (a failed pin is not fatal)
+    [[nodiscard]] bool pinned() const noexcept { return pinned_.load(std::memory_order_acquire); }
+
+    [[nodiscard]] std::size_t agent_count() const noexcept { return count_; }
+    // Time of the pass in progress (or the last one), in TSC cycles
+    [[nodiscard]] std::uint64_t now_tsc() const noexcept { return now_tsc_; }
+    // Earliest timer among suspended agents after the last pass, or NO_DEADLINE
+    [[nodiscard]] std::uint64_t next_wake_tsc() const noexcept { return next_wake_tsc_; }
+    [[nodiscard]] std::uint64_t resumes() const noexcept { return resumes_; }
+
+private:
+    Config config_;
+    Agent::Handle agents_[MAX_AGENTS]{};
+    std::size_t count_{0};
+    std::uint64_t now_tsc_{0};
+    std::uint64_t next_wake_tsc_{NO_DEADLINE};
+    std::uint64_t resumes_{0};
+
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> pinned_{false};
+    std::thread thread_{};
+};
+
+// ===== Awaitables (only usable inside an Agent) =====
+
+// Resumes on the next pass, after every other runnable agent had its turn
+struct YieldAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Agent::Handle h) const noexcept { h.promise().wake_tsc = 0; }
+    void await_resume() const noexcept {}
+};
+
+[[nodiscard]] inline YieldAwaiter yield_now() noexcept { return {}; }
+
+// Resumes on the first pass at least ns after the current one
+struct SleepAwaiter {
+    std::uint64_t ns;
+
+    bool await_ready() const noexcept { return ns == 0; }
+    void await_suspend(Agent::Handle h) const noexcept {
+        Agent::promise_type& p = h.promise();
+        p.wake_tsc = p.runtime->now_tsc() + ns_to_tsc(ns);
+    }
+    void await_resume() const noexcept {}
+};
+
+[[nodiscard]] inline SleepAwaiter sleep_for(std::uint64_t ns) noexcept { return {ns}; }
+
+// Resumes once pred() holds (checked once per pass) or, with a timeout, after
+// timeout_ns. co_await yields pred()'s value at resumption: false means timed out.
+template <typename Pred>
+struct UntilAwaiter {
+    Pred pred;
+    std::uint64_t timeout_ns;
+
+    bool await_ready() { return pred(); }
+    void await_suspend(Agent::Handle h) noexcept {
+        Agent::promise_type& p = h.promise();
+        p.wake_tsc = timeout_ns == AgentRuntime::NO_DEADLINE ? AgentRuntime::NO_DEADLINE
+                                                             : p.runtime->now_tsc() + ns_to_tsc(timeout_ns);
+        p.ready = [](void* self) { return static_cast<UntilAwaiter*>(self)->pred(); };
+        p.ready_ctx = this;
+        handle_ = h;
+    }
+    bool await_resume() const noexcept { return !handle_ || !handle_.promise().timed_out; }
+
+    Agent::Handle handle_{};
+};
+
+template <typename Pred>
+[[nodiscard]] UntilAwaiter<Pred> until(Pred pred, std::uint64_t timeout_ns = AgentRuntime::NO_DEADLINE) {
+    return {std::move(pred), timeout_ns};
+}
+
+// Resumes once ring has an element to pop (any ring with size_approx())
+template <typename Ring>
+[[nodiscard]] auto readable(const Ring& ring, std::uint64_t timeout_ns = AgentRuntime::NO_DEADLINE) {
+    return until([&ring] { return ring.size_approx() != 0; }, timeout_ns);
+}
+
+// Resumes once writer has no write in flight, or one of them completed (its buffer
+// is back in the free list). Completions are reaped without blocking.
+[[nodiscard]] bool reap_io_completion(AsyncFileWriter& writer) noexcept;
+
+[[nodiscard]] inline auto io_complete(AsyncFileWriter& writer, std::uint64_t timeout_ns = AgentRuntime::NO_DEADLINE) {
+    return until([&writer] { return reap_io_completion(writer); }, timeout_ns);
+}
+
+} // namespace util
@@ -0,0 +1,127 @@
+#include "util/alloc_guard.hpp"
+
+#if defined(FX_ALLOC_GUARD)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace util {
+namespace {
+
+// Constant-initialized so the interposer can touch them before any static
+// constructor runs and without allocating TLS lazily.
+constinit thread_local std::uint32_t tls_hot_depth = 0;
+constinit thread_local std::uint64_t tls_hot_allocations = 0;
+
+std::atomic<std::uint64_t> g_hot_allocations{0};
+std::atomic<std::uint64_t> g_hot_bytes{0};
+
+inline void record_allocation(std::size_t size) noexcept {
+    if (tls_hot_depth == 0) {
+        return;
+    }
+    ++tls_hot_allocations;
+    g_hot_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_hot_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void AllocGuard::enter_hot_phase() noexcept { ++tls_hot_depth; }
+
+void AllocGuard::exit_hot_phase() noexcept {
+    if (tls_hot_depth > 0) {
+        --tls_hot_depth;
+    }
+}
+
+bool AllocGuard::in_hot_phase() noexcept { return tls_hot_depth != 0; }
+
+std::uint64_t AllocGuard::thread_hot_allocations() noexcept { return tls_hot_allocations; }
+
+std::uint64_t AllocGuard::total_hot_allocations() noexcept {
+    return g_hot_allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocGuard::total_hot_bytes() noexcept {
+    return g_hot_bytes.load(std::memory_order_relaxed);
+}
+
+void AllocGuard::reset_counters() noexcept {
+    tls_hot_allocations = 0;
+    g_hot_allocations.store(0, std::memory_order_relaxed);
+    g_hot_bytes.store(0, std::memory_order_relaxed);
+}
+
+} // namespace util
+
+#if defined(__GLIBC__)
+
+// glibc: interpose the malloc family. libstdc++'s operator new forwards to malloc
+// (and aligned new to aligned_alloc), so this covers both C and C++ allocations.
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(std::size_t size) {
+    util::record_allocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) {
+    util::record_allocation(n * size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size) {
+    util::record_allocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+    util::record_allocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) {
+    util::record_allocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+#else
+
+// Other C libraries: replace the global operator new family only.
+void* operator new(std::size_t size) {
+    util::record_allocation(size);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    util::record_allocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif // __GLIBC__
+
+#endif // FX_ALLOC_GUARD
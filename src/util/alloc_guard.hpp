@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// AllocGuard verifies the "no heap allocation after startup" rule on hot threads.
+//
+// Build with -DFX_ALLOC_GUARD=ON (CMake option, sets the FX_ALLOC_GUARD define) to
+// link a malloc/operator new interposer (alloc_guard.cpp). Each thread marks the
+// start of its hot phase (subscriber poll loop, reconciler loop, benchmark loop);
+// every allocation made by that thread while the phase is active is counted per
+// thread and in process-wide totals. Tests and benchmarks read the counters and
+// fail when a hot path allocated.
+//
+// Without FX_ALLOC_GUARD every call below is an inline no-op and no allocator is
+// interposed, so production builds pay nothing.
+//
+// Thread safety: phase markers and thread counters are thread-local; totals are
+// relaxed atomics, safe to read from any thread.
+struct AllocGuard {
+#if defined(FX_ALLOC_GUARD)
+    static constexpr bool enabled = true;
+
+    static void enter_hot_phase() noexcept;
+    static void exit_hot_phase() noexcept;
+    [[nodiscard]] static bool in_hot_phase() noexcept;
+
+    // Allocations made by the calling thread while in a hot phase
+    [[nodiscard]] static std::uint64_t thread_hot_allocations() noexcept;
+    // Allocations made by all threads while in a hot phase
+    [[nodiscard]] static std::uint64_t total_hot_allocations() noexcept;
+    [[nodiscard]] static std::uint64_t total_hot_bytes() noexcept;
+
+    // Clears the calling thread's counter and the process-wide totals
+    static void reset_counters() noexcept;
+#else
+    static constexpr bool enabled = false;
+
+    static void enter_hot_phase() noexcept {}
+    static void exit_hot_phase() noexcept {}
+    [[nodiscard]] static bool in_hot_phase() noexcept { return false; }
+
+    [[nodiscard]] static std::uint64_t thread_hot_allocations() noexcept { return 0; }
+    [[nodiscard]] static std::uint64_t total_hot_allocations() noexcept { return 0; }
+    [[nodiscard]] static std::uint64_t total_hot_bytes() noexcept { return 0; }
+
+    static void reset_counters() noexcept {}
+#endif
+};
+
+// RAII marker for a hot phase. Phases nest; allocations are counted while at
+// least one phase is active on the thread.
+class ScopedHotPhase {
+public:
+    ScopedHotPhase() noexcept { AllocGuard::enter_hot_phase(); }
+    ~ScopedHotPhase() { AllocGuard::exit_hot_phase(); }
+
+    ScopedHotPhase(const ScopedHotPhase&) = delete;
+    ScopedHotPhase& operator=(const ScopedHotPhase&) = delete;
+};
+
+} // namespace util
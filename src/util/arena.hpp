@@ -16,10 +16,21 @@ class Arena {
 public:
     static constexpr std::size_t default_capacity_bytes = 512ULL * 1024ULL * 1024ULL;
 
+    // Tag for the constructor that skips zero-filling the backing store
+    struct ForOverwrite {};
+    static constexpr ForOverwrite for_overwrite{};
+
     explicit Arena(std::size_t capacity_bytes = default_capacity_bytes)
         : capacity_bytes_{capacity_bytes},
           buffer_{capacity_bytes ? std::make_unique<std::byte[]>(capacity_bytes) : nullptr} {}
 
+    // Leaves the backing store uninitialized, so no page is touched until used or
+    // pre-faulted (see util::prefault_parallel). Callers get raw memory, as every
+    // arena user initializes what it allocates anyway.
+    Arena(std::size_t capacity_bytes, ForOverwrite)
+        : capacity_bytes_{capacity_bytes},
+          buffer_{capacity_bytes ? std::make_unique_for_overwrite<std::byte[]>(capacity_bytes) : nullptr} {}
+
     Arena(const Arena&) = delete;
     Arena& operator=(const Arena&) = delete;
     Arena(Arena&&) = default;
@@ -48,8 +59,22 @@ public:
         return ptr;
     }
 
+    // Largest size allocate(size, alignment) would currently satisfy
+    [[nodiscard]] std::size_t available(std::size_t alignment) const noexcept {
+        if (alignment == 0 || !buffer_) {
+            return 0;
+        }
+        const auto base = reinterpret_cast<std::uintptr_t>(buffer_.get());
+        const std::size_t aligned_offset = align_up(base + offset_, alignment) - base;
+        return aligned_offset > capacity_bytes_ ? 0 : capacity_bytes_ - aligned_offset;
+    }
+
     void reset() noexcept { offset_ = 0; }
 
+    // Backing store, for pre-faulting or locking it
+    [[nodiscard]] std::byte* data() noexcept { return buffer_.get(); }
+    [[nodiscard]] std::size_t capacity_bytes() const noexcept { return capacity_bytes_; }
+
 private:
     static constexpr std::uintptr_t align_up(std::uintptr_t value, std::size_t alignment) noexcept {
         const std::uintptr_t remainder = value % static_cast<std::uintptr_t>(alignment);
@@ -0,0 +1,473 @@
+#include "util/async_file.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#if FX_HAVE_IO_URING
+    #include <atomic>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace util {
+
+// ===== io_uring backend =====
+
+struct AsyncFileWriter::IoUring {
+#if FX_HAVE_IO_URING && defined(__NR_io_uring_setup)
+    ~IoUring() {
+        if (sqes_ != MAP_FAILED) {
+            ::munmap(sqes_, sqes_bytes_);
+        }
+        if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+            ::munmap(cq_ptr_, cq_bytes_);
+        }
+        if (sq_ptr_ != MAP_FAILED) {
+            ::munmap(sq_ptr_, sq_bytes_);
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+    }
+
+    // False if the kernel lacks io_uring or refuses it (seccomp, sysctl)
+    bool setup(unsigned entries) noexcept {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) {
+            return false;
+        }
+        sq_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_bytes_ = cq_bytes_ > sq_bytes_ ? cq_bytes_ : sq_bytes_;
+        }
+        sq_ptr_ = ::mmap(nullptr, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                         IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) {
+            return false;
+        }
+        cq_ptr_ = single_mmap ? sq_ptr_
+                              : ::mmap(nullptr, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            return false;
+        }
+        sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = ::mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                       IORING_OFF_SQES);
+        if (sqes_ == MAP_FAILED) {
+            return false;
+        }
+        auto* sq = static_cast<char*>(sq_ptr_);
+        auto* cq = static_cast<char*>(cq_ptr_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    // Fills the next SQE; visible to the kernel at the next enter()
+    void push_write(int fd, const char* data, std::size_t len, std::uint64_t offset, std::uint64_t user) noexcept {
+        const unsigned tail = *sq_tail_ + pending_;
+        const unsigned idx = tail & sq_mask_;
+        io_uring_sqe& sqe = static_cast<io_uring_sqe*>(sqes_)[idx];
+        sqe = io_uring_sqe{};
+        sqe.opcode = IORING_OP_WRITE;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(data);
+        sqe.len = static_cast<unsigned>(len);
+        sqe.off = offset;
+        sqe.user_data = user;
+        sq_array_[idx] = idx;
+        ++pending_;
+    }
+
+    // Publishes the pending SQEs and submits them, optionally waiting for one
+    // completion. Returns 0 or -errno; on error nothing stays pending.
+    int submit(bool wait) noexcept {
+        std::atomic_ref<unsigned>(*sq_tail_).store(*sq_tail_ + pending_, std::memory_order_release);
+        unsigned to_submit = pending_;
+        pending_ = 0;
+        for (;;) {
+            const long ret = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, wait ? 1u : 0u,
+                                       wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (ret >= 0) {
+                to_submit -= static_cast<unsigned>(ret);
+                if (to_submit == 0) {
+                    return 0;
+                }
+                continue;  // Partial submit: resubmit the rest
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            const int err = errno;
+            // The kernel only consumes SQEs inside enter(); withdraw the rest
+            std::atomic_ref<unsigned>(*sq_tail_).store(*sq_tail_ - to_submit, std::memory_order_release);
+            pending_ = 0;
+            return -err;
+        }
+    }
+
+    // Calls fn(user_data, res) for every completion posted so far
+    template <typename Fn>
+    std::size_t drain_cq(Fn&& fn) noexcept {
+        unsigned head = *cq_head_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        std::size_t n = 0;
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            fn(cqe.user_data, cqe.res);
+            ++head;
+            ++n;
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+        return n;
+    }
+
+    [[nodiscard]] bool cq_empty() const noexcept {
+        return *cq_head_ == std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+    }
+
+private:
+    int ring_fd_{-1};
+    void* sq_ptr_{MAP_FAILED};
+    std::size_t sq_bytes_{0};
+    void* cq_ptr_{MAP_FAILED};
+    std::size_t cq_bytes_{0};
+    void* sqes_{MAP_FAILED};
+    std::size_t sqes_bytes_{0};
+    unsigned* sq_tail_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned* sq_array_{nullptr};
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    unsigned cq_mask_{0};
+    io_uring_cqe* cqes_{nullptr};
+    unsigned pending_{0};
+#else
+    bool setup(unsigned) noexcept { return false; }
+    void push_write(int, const char*, std::size_t, std::uint64_t, std::uint64_t) noexcept {}
+    int submit(bool) noexcept { return -ENOSYS; }
+    template <typename Fn>
+    std::size_t drain_cq(Fn&&) noexcept { return 0; }
+    [[nodiscard]] bool cq_empty() const noexcept { return true; }
+#endif
+};
+
+// ===== pwrite thread-pool backend =====
+
+struct AsyncFileWriter::ThreadPool {
+    struct Request {
+        std::uint32_t index;
+        int fd;
+        const char* data;
+        std::size_t len;
+        std::uint64_t offset;
+    };
+    struct Done {
+        std::uint32_t index;
+        long result;
+    };
+
+    explicit ThreadPool(std::size_t capacity)
+        : requests(std::make_unique<Request[]>(capacity)),
+          done(std::make_unique<Done[]>(capacity)),
+          taken(std::make_unique<Done[]>(capacity)),
+          capacity(capacity) {}
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            stopping = true;
+        }
+        work_cv.notify_all();
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    void run() noexcept {
+        for (;;) {
+            Request req;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                work_cv.wait(lock, [this] { return stopping || req_count != 0; });
+                if (req_count == 0) {
+                    return;  // Stopping and drained
+                }
+                req = requests[req_head];
+                req_head = (req_head + 1) % capacity;
+                --req_count;
+            }
+            long result = 0;
+            while (static_cast<std::size_t>(result) < req.len) {
+                const ssize_t n = ::pwrite(req.fd, req.data + result, req.len - static_cast<std::size_t>(result),
+                                           static_cast<off_t>(req.offset + static_cast<std::uint64_t>(result)));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    result = n < 0 ? -errno : -EIO;
+                    break;
+                }
+                result += n;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                done[done_count++] = Done{req.index, result};
+            }
+            done_cv.notify_one();
+        }
+    }
+
+    std::mutex mu;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::unique_ptr<Request[]> requests;  // FIFO ring
+    std::size_t req_head{0};
+    std::size_t req_count{0};
+    std::unique_ptr<Done[]> done;
+    std::size_t done_count{0};
+    std::unique_ptr<Done[]> taken;  // Owner-side copy of done, processed unlocked
+    std::size_t capacity;
+    bool stopping{false};
+    std::vector<std::thread> workers;
+};
+
+// ===== AsyncFileWriter =====
+
+AsyncFileWriter::AsyncFileWriter() noexcept = default;
+
+AsyncFileWriter::~AsyncFileWriter() { close(); }
+
+bool AsyncFileWriter::open(const std::string& path, const Config& cfg) noexcept {
+    close();
+    if (cfg.buffer_count == 0 || cfg.buffer_count > 4096 || cfg.buffer_bytes == 0 ||
+        (cfg.backend == FileIoBackend::ThreadPool && cfg.pool_threads == 0)) {
+        return false;
+    }
+    const std::size_t buffer_bytes = (cfg.buffer_bytes + BUFFER_ALIGN - 1) / BUFFER_ALIGN * BUFFER_ALIGN;
+
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (cfg.truncate ? O_TRUNC : 0);
+    fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    const off_t end = cfg.truncate ? 0 : ::lseek(fd_, 0, SEEK_END);
+    offset_ = end > 0 ? static_cast<std::uint64_t>(end) : 0;
+#ifdef O_DIRECT
+    if (cfg.direct) {
+        // Filesystems without O_DIRECT (tmpfs) keep every write in the page cache
+        direct_fd_ = ::open(path.c_str(), O_WRONLY | O_CLOEXEC | O_DIRECT);
+    }
+#endif
+
+    try {
+        auto* slab = static_cast<char*>(
+            ::operator new(buffer_bytes * cfg.buffer_count, std::align_val_t{BUFFER_ALIGN}));
+        slab_ = std::unique_ptr<char, void (*)(char*)>(
+            slab, [](char* p) { ::operator delete(p, std::align_val_t{BUFFER_ALIGN}); });
+        buffers_ = std::make_unique<Buffer[]>(cfg.buffer_count);
+        writes_ = std::make_unique<Write[]>(cfg.buffer_count);
+        free_ = std::make_unique<std::uint32_t[]>(cfg.buffer_count);
+        queued_ = std::make_unique<std::uint32_t[]>(cfg.buffer_count);
+    } catch (...) {
+        close();
+        return false;
+    }
+    buffer_count_ = cfg.buffer_count;
+    for (std::size_t i = 0; i < buffer_count_; ++i) {
+        buffers_[i] = Buffer{slab_.get() + i * buffer_bytes, buffer_bytes, 0};
+        free_[i] = static_cast<std::uint32_t>(buffer_count_ - 1 - i);  // Buffer 0 on top
+    }
+    free_count_ = buffer_count_;
+
+    backend_ = cfg.backend;
+    if (backend_ != FileIoBackend::ThreadPool) {
+        auto uring = std::make_unique<IoUring>();
+        if (uring->setup(static_cast<unsigned>(buffer_count_))) {
+            uring_ = std::move(uring);
+            backend_ = FileIoBackend::IoUring;
+        } else if (backend_ == FileIoBackend::IoUring) {
+            close();
+            return false;
+        }
+    }
+    if (!uring_) {
+        backend_ = FileIoBackend::ThreadPool;
+        try {
+            pool_ = std::make_unique<ThreadPool>(buffer_count_);
+            const std::size_t threads = cfg.pool_threads == 0 ? 1 : cfg.pool_threads;
+            for (std::size_t i = 0; i < threads; ++i) {
+                pool_->workers.emplace_back([p = pool_.get()] { p->run(); });
+            }
+        } catch (...) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void AsyncFileWriter::close() noexcept {
+    if (fd_ >= 0 && buffers_) {
+        drain();
+    }
+    pool_.reset();
+    uring_.reset();
+    if (direct_fd_ >= 0) {
+        ::close(direct_fd_);
+        direct_fd_ = -1;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    buffers_.reset();
+    writes_.reset();
+    free_.reset();
+    queued_.reset();
+    slab_.reset();
+    buffer_count_ = 0;
+    free_count_ = 0;
+    queued_count_ = 0;
+    in_flight_ = 0;
+}
+
+AsyncFileWriter::Buffer* AsyncFileWriter::acquire() noexcept {
+    if (free_count_ == 0) {
+        return nullptr;
+    }
+    Buffer& buf = buffers_[free_[--free_count_]];
+    buf.size = 0;
+    return &buf;
+}
+
+void AsyncFileWriter::submit(Buffer* buf) noexcept {
+    const auto index = static_cast<std::uint32_t>(buf - buffers_.get());
+    if (buf->size == 0) {
+        recycle(index);
+        return;
+    }
+    writes_[index] = Write{offset_, 0};
+    offset_ += buf->size;
+    ++in_flight_;
+    queue(index);
+}
+
+void AsyncFileWriter::queue(std::uint32_t index) noexcept { queued_[queued_count_++] = index; }
+
+int AsyncFileWriter::fd_for(std::uint64_t offset, std::size_t len) const noexcept {
+    const bool aligned = offset % BUFFER_ALIGN == 0 && len % BUFFER_ALIGN == 0;
+    return direct_fd_ >= 0 && aligned ? direct_fd_ : fd_;
+}
+
+void AsyncFileWriter::flush() noexcept {
+    if (queued_count_ == 0) {
+        return;
+    }
+    ++stats_.batches;
+    if (uring_) {
+        for (std::size_t i = 0; i < queued_count_; ++i) {
+            const std::uint32_t index = queued_[i];
+            const Write& w = writes_[index];
+            const std::size_t len = buffers_[index].size - w.done;
+            const std::uint64_t off = w.offset + w.done;
+            uring_->push_write(fd_for(off, len), buffers_[index].data + w.done, len, off, index);
+        }
+        const int err = uring_->submit(false);
+        if (err < 0) {
+            for (std::size_t i = 0; i < queued_count_; ++i) {
+                complete(queued_[i], err);
+            }
+        }
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(pool_->mu);
+            for (std::size_t i = 0; i < queued_count_; ++i) {
+                const std::uint32_t index = queued_[i];
+                const Write& w = writes_[index];
+                const std::size_t len = buffers_[index].size - w.done;
+                const std::uint64_t off = w.offset + w.done;
+                const std::size_t slot = (pool_->req_head + pool_->req_count) % pool_->capacity;
+                pool_->requests[slot] = ThreadPool::Request{index, fd_for(off, len), buffers_[index].data + w.done,
+                                                            len, off};
+                ++pool_->req_count;
+            }
+        }
+        pool_->work_cv.notify_all();
+    }
+    queued_count_ = 0;
+}
+
+std::size_t AsyncFileWriter::reap(bool wait) noexcept {
+    flush();
+    const std::size_t before = in_flight_;
+    if (uring_) {
+        if (wait && in_flight_ != 0 && uring_->cq_empty()) {
+            ++stats_.buffer_waits;
+            (void)uring_->submit(true);
+        }
+        uring_->drain_cq([this](std::uint64_t user, int res) { complete(static_cast<std::uint32_t>(user), res); });
+    } else {
+        std::size_t n = 0;
+        {
+            std::unique_lock<std::mutex> lock(pool_->mu);
+            if (wait && in_flight_ != 0 && pool_->done_count == 0) {
+                ++stats_.buffer_waits;
+                pool_->done_cv.wait(lock, [this] { return pool_->done_count != 0; });
+            }
+            n = pool_->done_count;
+            for (std::size_t i = 0; i < n; ++i) {
+                pool_->taken[i] = pool_->done[i];
+            }
+            pool_->done_count = 0;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            complete(pool_->taken[i].index, pool_->taken[i].result);
+        }
+    }
+    flush();  // Short-write remainders
+    return before - in_flight_;
+}
+
+void AsyncFileWriter::drain() noexcept {
+    while (in_flight_ != 0) {
+        (void)reap(true);
+    }
+}
+
+void AsyncFileWriter::complete(std::uint32_t index, long result) noexcept {
+    Write& w = writes_[index];
+    const Buffer& buf = buffers_[index];
+    if (result <= 0) {
+        ++stats_.errors;
+    } else if (w.done + static_cast<std::size_t>(result) < buf.size) {
+        w.done += static_cast<std::size_t>(result);
+        queue(index);  // Short write: the rest goes out with the next batch
+        return;
+    } else {
+        ++stats_.writes;
+        stats_.bytes += buf.size;
+    }
+    --in_flight_;
+    recycle(index);
+}
+
+void AsyncFileWriter::recycle(std::uint32_t index) noexcept { free_[free_count_++] = index; }
+
+} // namespace util
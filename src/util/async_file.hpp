@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// io_uring is driven through the raw syscalls (no liburing dependency); the
+// kernel UAPI header is all that is needed at build time.
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define FX_HAVE_IO_URING 1
+#else
+    #define FX_HAVE_IO_URING 0
+#endif
+
+namespace util {
+
+enum class FileIoBackend : std::uint8_t {
+    Auto,        // io_uring if the kernel allows it, else ThreadPool
+    IoUring,     // io_uring only; open() fails without it
+    ThreadPool,  // pwrite on worker threads
+};
+
+[[nodiscard]] constexpr const char* file_io_backend_name(FileIoBackend backend) noexcept {
+    switch (backend) {
+    case FileIoBackend::Auto:
+        return "auto";
+    case FileIoBackend::IoUring:
+        return "io_uring";
+    case FileIoBackend::ThreadPool:
+        return "thread_pool";
+    }
+    return "unknown";
+}
+
+struct FileIoStats {
+    std::uint64_t writes{0};        // Buffers written
+    std::uint64_t bytes{0};
+    std::uint64_t batches{0};       // Kernel / worker hand-offs (several writes each)
+    std::uint64_t errors{0};        // Writes that failed; their bytes are lost
+    std::uint64_t buffer_waits{0};  // reap(true) calls that had to block
+};
+
+// AsyncFileWriter appends to one file without the owning thread blocking in
+// write(2). Data goes through a fixed set of preallocated, BUFFER_ALIGN-aligned
+// buffers: acquire() a free one, fill it, submit() it; submissions are queued and
+// handed to the kernel in one batch by flush(), and a buffer returns to the free
+// list when its write completes (reap()). Each buffer is written at an explicit
+// offset, so completions may arrive in any order.
+//
+// Backends: io_uring (one io_uring_enter per batch, completions polled from the CQ
+// ring), or a small pwrite thread pool where io_uring is missing or blocked. With
+// Config::direct, writes that are whole multiples of BUFFER_ALIGN at aligned
+// offsets go through an O_DIRECT descriptor; the unaligned tail of a partial flush
+// uses the page cache.
+//
+// Only acquire() may find every buffer in flight; the caller then decides whether
+// to wait (reap(true)) or drop.
+//
+// Thread safety: None. One owning thread (e.g. the logger consumer).
+class AsyncFileWriter {
+public:
+    static constexpr std::size_t BUFFER_ALIGN = 4096;
+
+    struct Config {
+        std::size_t buffer_bytes{1u << 16};  // Rounded up to BUFFER_ALIGN
+        std::size_t buffer_count{8};
+        FileIoBackend backend{FileIoBackend::Auto};
+        std::size_t pool_threads{1};         // ThreadPool backend only
+        bool direct{false};
+        bool truncate{true};                 // Else append after the existing contents
+    };
+
+    struct Buffer {
+        char* data{nullptr};
+        std::size_t capacity{0};
+        std::size_t size{0};  // Bytes filled by the caller
+
+        [[nodiscard]] std::size_t room() const noexcept { return capacity - size; }
+    };
+
+    AsyncFileWriter() noexcept;
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    // Opens path and preallocates the buffers. Returns false on any failure (bad
+    // config, open error, IoUring requested but unavailable).
+    bool open(const std::string& path, const Config& cfg) noexcept;
+    // Drains writes in flight and closes the file.
+    void close() noexcept;
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+    // A free, empty buffer, or nullptr if every buffer is queued or in flight
+    [[nodiscard]] Buffer* acquire() noexcept;
+    // Queues buf for writing at the end of the file; empty buffers are recycled at
+    // once. The caller must not touch buf afterwards.
+    void submit(Buffer* buf) noexcept;
+    // Hands every queued write to the backend in one batch
+    void flush() noexcept;
+    // Recycles buffers whose writes completed. With wait, blocks until at least one
+    // completes (if any is in flight). Returns the number of writes finished.
+    std::size_t reap(bool wait) noexcept;
+    // Flushes and waits for every write in flight
+    void drain() noexcept;
+
+    [[nodiscard]] FileIoBackend backend() const noexcept { return backend_; }
+    [[nodiscard]] const FileIoStats& stats() const noexcept { return stats_; }
+    [[nodiscard]] std::size_t in_flight() const noexcept { return in_flight_; }
+    [[nodiscard]] std::size_t buffer_count() const noexcept { return buffer_count_; }
+    // Bytes submitted so far (file size once drained)
+    [[nodiscard]] std::uint64_t offset() const noexcept { return offset_; }
+
+private:
+    struct Write {
+        std::uint64_t offset{0};
+        std::size_t done{0};  // Bytes already written (short-write resume)
+    };
+    struct IoUring;
+    struct ThreadPool;
+
+    int fd_for(std::uint64_t offset, std::size_t len) const noexcept;
+    void queue(std::uint32_t index) noexcept;
+    void complete(std::uint32_t index, long result) noexcept;
+    void recycle(std::uint32_t index) noexcept;
+
+    int fd_{-1};
+    int direct_fd_{-1};
+    FileIoBackend backend_{FileIoBackend::Auto};
+    std::size_t buffer_count_{0};
+    std::uint64_t offset_{0};
+
+    std::unique_ptr<char, void (*)(char*)> slab_{nullptr, nullptr};
+    std::unique_ptr<Buffer[]> buffers_{};
+    std::unique_ptr<Write[]> writes_{};
+    std::unique_ptr<std::uint32_t[]> free_{};     // Stack of free buffer indices
+    std::size_t free_count_{0};
+    std::unique_ptr<std::uint32_t[]> queued_{};   // Submitted, not yet flushed
+    std::size_t queued_count_{0};
+    std::size_t in_flight_{0};                    // Queued + handed to the backend
+
+    std::unique_ptr<IoUring> uring_{};
+    std::unique_ptr<ThreadPool> pool_{};
+    FileIoStats stats_{};
+};
+
+} // namespace util
@@ -5,6 +5,7 @@
 #include <cstring>
 
 #include "util/rdtsc.hpp"
+#include "util/sigsafe_writer.hpp"
 
 namespace util {
 namespace {
@@ -44,25 +45,31 @@ bool AsyncLogger::start(const Config& cfg) noexcept {
     slots_ = std::move(new_slots);
 
     if (!cfg.file_path.empty()) {
-        sink_ = std::fopen(cfg.file_path.c_str(), "w");
-        if (!sink_) {
+        AsyncFileWriter::Config io{};
+        io.buffer_bytes = cfg.io_buffer_bytes;
+        io.buffer_count = cfg.io_buffers;
+        io.backend = cfg.io_backend;
+        io.direct = cfg.io_direct;
+        if (!file_.open(cfg.file_path, io)) {
             return false;
         }
-        owns_file_ = true;
+        sink_ = nullptr;
+        io_backend_.store(file_.backend(), std::memory_order_relaxed);
     } else {
         sink_ = stderr;
-        owns_file_ = false;
     }
 
+    since_flush_ = 0;
     stop_.store(false, std::memory_order_release);
+    if (cfg.external_consumer) {
+        return true;
+    }
     try {
         consumer_ = std::thread([this] { consumer_loop(); });
     } catch (...) {
         stop_.store(true, std::memory_order_release);
-        if (owns_file_ && sink_) {
-            std::fclose(sink_);
-        }
-        owns_file_ = false;
+        file_.close();
+        io_backend_.store(FileIoBackend::Auto, std::memory_order_relaxed);
         sink_ = stderr;
         return false;
     }
@@ -75,12 +82,15 @@ void AsyncLogger::stop() noexcept {
     }
     if (consumer_.joinable()) {
         consumer_.join();
+    } else if (config_.external_consumer) {
+        // The agent is no longer polled; write out what it left behind
+        while (poll_consumer(capacity_) != 0) {
+        }
+        finish_consumer();
     }
-    if (owns_file_ && sink_) {
-        std::fclose(sink_);
-    }
+    file_.close();
+    io_backend_.store(FileIoBackend::Auto, std::memory_order_relaxed);
     sink_ = stderr;
-    owns_file_ = false;
 }
 
 std::uint64_t AsyncLogger::now_ticks() const noexcept {
@@ -136,7 +146,7 @@ bool AsyncLogger::try_log(LogLevel lvl, const char* category, const char* msg, s
 }
 
 bool AsyncLogger::try_logf(LogLevel lvl, const char* category, const char* fmt, ...) noexcept {
-    char buffer[192];
+    char buffer[sizeof(LogRecord::message)];
     va_list args;
     va_start(args, fmt);
     const int written = std::vsnprintf(buffer, sizeof(buffer), fmt, args);
@@ -145,6 +155,56 @@ bool AsyncLogger::try_logf(LogLevel lvl, const char* category, const char* fmt,
     return try_log(lvl, category, buffer, len);
 }
 
+bool AsyncLogger::try_logf_suppressed(LogLevel lvl, const char* category, std::uint64_t suppressed,
+                                      const char* fmt, ...) noexcept {
+    char suffix[40];
+    int n = suppressed == 0 ? 0
+                            : std::snprintf(suffix, sizeof(suffix), " ...and %llu more",
+                                            static_cast<unsigned long long>(suppressed));
+    const std::size_t suffix_len = n < 0 ? 0u : static_cast<std::size_t>(n);
+
+    // One spare byte for vsnprintf's terminator, which the suffix then overwrites
+    char buffer[sizeof(LogRecord::message) + 1];
+    const std::size_t room = sizeof(LogRecord::message) - suffix_len;
+    va_list args;
+    va_start(args, fmt);
+    n = std::vsnprintf(buffer, room + 1, fmt, args);
+    va_end(args);
+    std::size_t len = n < 0 ? 0u : std::min<std::size_t>(static_cast<std::size_t>(n), room);
+    std::memcpy(buffer + len, suffix, suffix_len);
+    len += suffix_len;
+    return try_log(lvl, category, buffer, len);
+}
+
+std::size_t AsyncLogger::dump_pending(int fd) const noexcept {
+    if (!slots_) {
+        return 0;
+    }
+    // Walks the last capacity positions before head_ rather than reading the
+    // consumer's tail_: a slot at pos is published and unconsumed exactly while its
+    // sequence is pos + 1.
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    const std::uint64_t begin = head > capacity_ ? head - capacity_ : 0;
+    SigsafeWriter out(fd);
+    std::size_t dumped = 0;
+    for (std::uint64_t pos = begin; pos < head; ++pos) {
+        const Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            continue;
+        }
+        const LogRecord& rec = slot.record;
+        out.ch('[').u64(rec.timestamp).str("][").str(level_name(rec.level)).str("][");
+        out.str(rec.category, strnlen(rec.category, sizeof(rec.category))).str("] ");
+        out.str(rec.message, std::min<std::size_t>(rec.message_len, sizeof(rec.message)));
+        if (rec.arg0 || rec.arg1) {
+            out.str(" | a0=").u64(rec.arg0).str(" a1=").u64(rec.arg1);
+        }
+        out.ch('\n');
+        ++dumped;
+    }
+    return dumped;
+}
+
 bool AsyncLogger::try_pop(LogRecord& out) noexcept {
     Slot& slot = slots_[tail_ & mask_];
     const std::uint64_t seq = slot.sequence.load(std::memory_order_acquire);
@@ -158,45 +218,123 @@ bool AsyncLogger::try_pop(LogRecord& out) noexcept {
     return false;
 }
 
+std::size_t AsyncLogger::format_record(const LogRecord& rec, char* out, std::size_t cap) noexcept {
+    int n = std::snprintf(out, cap, "[%llu][%s][%u][%.*s] ", static_cast<unsigned long long>(rec.timestamp),
+                          level_name(rec.level), static_cast<unsigned>(rec.thread_id_hash),
+                          static_cast<int>(sizeof(rec.category)), rec.category);
+    std::size_t len = n < 0 ? 0 : std::min<std::size_t>(static_cast<std::size_t>(n), cap - 1);
+    const std::size_t msg = std::min<std::size_t>(rec.message_len, cap - 1 - len);
+    std::memcpy(out + len, rec.message, msg);
+    len += msg;
+    if (rec.arg0 || rec.arg1) {
+        n = std::snprintf(out + len, cap - len, " | a0=%llu a1=%llu", static_cast<unsigned long long>(rec.arg0),
+                          static_cast<unsigned long long>(rec.arg1));
+        len += n < 0 ? 0 : std::min<std::size_t>(static_cast<std::size_t>(n), cap - 1 - len);
+    }
+    out[len++] = '\n';
+    return len;
+}
+
 void AsyncLogger::write_record(const LogRecord& rec) noexcept {
-    if (!sink_) return;
-    std::fprintf(sink_, "[%llu][%s][%u][%s] ", static_cast<unsigned long long>(rec.timestamp),
-                 level_name(rec.level), static_cast<unsigned>(rec.thread_id_hash), rec.category);
-    if (rec.message_len > 0) {
-        std::fwrite(rec.message, 1, rec.message_len, sink_);
+    // Header + message + args, with room to spare
+    char line[sizeof(rec.message) + 160];
+    const std::size_t len = format_record(rec, line, sizeof(line));
+    if (file_.is_open()) {
+        append_to_file(line, len);
+    } else if (sink_) {
+        std::fwrite(line, 1, len, sink_);
     }
-    if (rec.arg0 || rec.arg1) {
-        std::fprintf(sink_, " | a0=%llu a1=%llu", static_cast<unsigned long long>(rec.arg0),
-                     static_cast<unsigned long long>(rec.arg1));
+}
+
+void AsyncLogger::append_to_file(const char* line, std::size_t len) noexcept {
+    if (file_buf_ && file_buf_->room() < len) {
+        file_.submit(file_buf_);
+        file_.flush();
+        file_buf_ = nullptr;
+    }
+    while (!file_buf_) {
+        (void)file_.reap(false);
+        file_buf_ = file_.acquire();
+        if (!file_buf_) {
+            (void)file_.reap(true);  // Every buffer in flight: only this thread waits
+        }
+    }
+    std::memcpy(file_buf_->data + file_buf_->size, line, len);
+    file_buf_->size += len;
+}
+
+void AsyncLogger::flush_sink() noexcept {
+    if (!file_.is_open()) {
+        if (sink_) {
+            std::fflush(sink_);
+        }
+        return;
+    }
+    if (file_buf_) {
+        file_.submit(file_buf_);
+        file_buf_ = nullptr;
+    }
+    file_.flush();
+    (void)file_.reap(false);
+    io_errors_.store(file_.stats().errors, std::memory_order_relaxed);
+}
+
+std::size_t AsyncLogger::poll_consumer(std::size_t max_records) noexcept {
+    std::size_t consumed = 0;
+    LogRecord rec{};
+    while (consumed < max_records && try_pop(rec)) {
+        write_record(rec);
+        written_.fetch_add(1, std::memory_order_relaxed);
+        ++consumed;
+        ++since_flush_;
+        if ((config_.flush_on_warn && rec.level >= LogLevel::Warn) ||
+            (config_.flush_every > 0 && since_flush_ >= config_.flush_every)) {
+            flush_sink();
+            since_flush_ = 0;
+        }
+    }
+    if (consumed == 0) {
+        if (since_flush_ != 0) {
+            flush_sink();  // Idle: write out the partial buffer
+        } else if (file_.in_flight() != 0) {
+            (void)file_.reap(false);
+        }
+        since_flush_ = 0;
     }
-    std::fputc('\n', sink_);
+    return consumed;
 }
 
 void AsyncLogger::consumer_loop() noexcept {
-    std::size_t since_flush = 0;
-    while (!stop_.load(std::memory_order_acquire) || tail_ != head_.load(std::memory_order_acquire)) {
-        LogRecord rec{};
-        bool had = try_pop(rec);
-        if (had) {
-            write_record(rec);
-            written_.fetch_add(1, std::memory_order_relaxed);
-            ++since_flush;
-            if ((config_.flush_on_warn && rec.level >= LogLevel::Warn) ||
-                (config_.flush_every > 0 && since_flush >= config_.flush_every)) {
-                std::fflush(sink_);
-                since_flush = 0;
-            }
+    while (!stop_.load(std::memory_order_acquire) || has_pending()) {
+        if (poll_consumer(capacity_) != 0) {
+            continue;
+        }
+        if (config_.consumer_sleep_ns > 0) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(config_.consumer_sleep_ns));
         } else {
-            since_flush = 0;
-            if (config_.consumer_sleep_ns > 0) {
-                std::this_thread::sleep_for(std::chrono::nanoseconds(config_.consumer_sleep_ns));
-            } else {
-                std::this_thread::yield();
-            }
+            std::this_thread::yield();
         }
     }
-    if (sink_) {
-        std::fflush(sink_);
+    finish_consumer();
+}
+
+void AsyncLogger::finish_consumer() noexcept {
+    flush_sink();
+    file_.drain();
+    io_errors_.store(file_.stats().errors, std::memory_order_relaxed);
+}
+
+Agent log_consumer_agent(AsyncLogger& logger) {
+    // Bounded batches keep the other agents on the thread responsive under a flood
+    constexpr std::size_t BATCH = 256;
+    const std::uint64_t idle_ns = logger.config().consumer_sleep_ns;
+    while (logger.running()) {
+        if (logger.poll_consumer(BATCH) == BATCH) {
+            co_await yield_now();
+        } else {
+            // Idle: wake on the next record, or after idle_ns to reap finished writes
+            (void)co_await until([&logger] { return logger.has_pending() || !logger.running(); }, idle_ns);
+        }
     }
 }
 
@@ -9,7 +9,11 @@
 #include <string>
 #include <thread>
 
+#include "util/agent_runtime.hpp"
+#include "util/async_file.hpp"
 #include "util/log.hpp"
+#include "util/rdtsc.hpp"
+#include "util/tsc_calibration.hpp"
 
 namespace util {
 
@@ -24,6 +28,11 @@ struct LogRecord {
     std::uint64_t arg1{0};
 };
 
+// AsyncLogger is a bounded MPMC ring of fixed-size records drained by one consumer
+// thread. Producers never block: a full ring drops the record. A file sink is
+// written through AsyncFileWriter (io_uring or a pwrite pool), so the consumer
+// formats into preallocated buffers and only waits when every buffer is in flight;
+// stderr stays on stdio.
 class AsyncLogger {
 public:
     struct Config {
@@ -32,7 +41,15 @@ public:
         bool flush_on_warn{true};
         std::size_t flush_every{256};
         std::string file_path{}; // optional target; stderr when empty
+        // File sink I/O: buffers of io_buffer_bytes, written asynchronously
+        std::size_t io_buffer_bytes{1u << 16};
+        std::size_t io_buffers{8};
+        FileIoBackend io_backend{FileIoBackend::Auto};
+        bool io_direct{false};
         std::uint64_t consumer_sleep_ns{50'000};
+        // No consumer thread: the owner drains with poll_consumer(), typically via a
+        // log_consumer_agent on an AgentRuntime
+        bool external_consumer{false};
     };
 
     AsyncLogger() = default;
@@ -48,9 +65,31 @@ public:
                  std::uint64_t arg0 = 0, std::uint64_t arg1 = 0) noexcept;
 
     bool try_logf(LogLevel lvl, const char* category, const char* fmt, ...) noexcept;
+    // As try_logf; a non-zero suppressed count is appended as " ...and N more",
+    // truncating the formatted text if needed so the suffix always fits.
+    bool try_logf_suppressed(LogLevel lvl, const char* category, std::uint64_t suppressed,
+                             const char* fmt, ...) noexcept;
+
+    // External consumer only (consumer thread): writes up to max_records records;
+    // when the ring is empty, writes out the partial buffer and reaps finished I/O.
+    // Returns the records written.
+    std::size_t poll_consumer(std::size_t max_records) noexcept;
+    // Consumer thread: records waiting in the ring
+    [[nodiscard]] bool has_pending() const noexcept { return tail_ != head_.load(std::memory_order_acquire); }
+    [[nodiscard]] bool running() const noexcept { return !stop_.load(std::memory_order_acquire); }
+    [[nodiscard]] const Config& config() const noexcept { return config_; }
 
     std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
     std::uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed); }
+    // File sink writes that failed (their records are lost)
+    std::uint64_t io_errors() const noexcept { return io_errors_.load(std::memory_order_relaxed); }
+    // Backend of the file sink; Auto while stopped or writing to stderr
+    FileIoBackend io_backend() const noexcept { return io_backend_.load(std::memory_order_relaxed); }
+
+    // Writes the records still waiting in the ring (accepted, not yet consumed) to
+    // fd, oldest first, using write(2) only: async-signal-safe, for crash dumps.
+    // Slots a producer is still filling are skipped. Returns the records written.
+    std::size_t dump_pending(int fd) const noexcept;
 
 private:
     struct Slot {
@@ -60,7 +99,11 @@ private:
 
     bool try_pop(LogRecord& out) noexcept;
     void consumer_loop() noexcept;
+    void finish_consumer() noexcept;
     void write_record(const LogRecord& rec) noexcept;
+    void append_to_file(const char* line, std::size_t len) noexcept;
+    void flush_sink() noexcept;
+    static std::size_t format_record(const LogRecord& rec, char* out, std::size_t cap) noexcept;
     std::uint64_t now_ticks() const noexcept;
     bool is_power_of_two(std::size_t v) const noexcept { return v != 0 && (v & (v - 1)) == 0; }
 
@@ -74,13 +117,73 @@ private:
     std::thread consumer_{};
     Config config_{};
 
-    FILE* sink_{stderr};
-    bool owns_file_{false};
+    FILE* sink_{stderr};             // stderr sink only
+    AsyncFileWriter file_{};         // File sink; owned by the consumer thread
+    AsyncFileWriter::Buffer* file_buf_{nullptr};
+    std::size_t since_flush_{0};     // Consumer: records written since the last flush
 
     std::atomic<std::uint64_t> dropped_{0};
     std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> io_errors_{0};
+    std::atomic<FileIoBackend> io_backend_{FileIoBackend::Auto};
+};
+
+// LogRateLimiter throttles one log call site: a token bucket of `burst` lines
+// refilled at `per_sec` lines per second, kept as a single theoretical arrival time
+// (GCRA) so the check is one TSC compare. Calls past the budget only bump a
+// counter; the next call allowed through takes the count so its line can say how
+// many were suppressed. Intended as a function-local static (LOG_HOT_RATE_LIMITED).
+//
+// Thread safety: allow() may be called from any thread; a lost race counts as
+// suppressed rather than retrying.
+class LogRateLimiter {
+public:
+    constexpr LogRateLimiter(std::uint32_t per_sec, std::uint32_t burst) noexcept
+        : per_sec_(per_sec == 0 ? 1 : per_sec), burst_(burst == 0 ? 1 : burst) {}
+
+    LogRateLimiter(const LogRateLimiter&) = delete;
+    LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+
+    // True if a line may be emitted at now_tsc; suppressed then receives (and
+    // resets) the number of calls refused since the last allowed one.
+    [[nodiscard]] bool allow(std::uint64_t now_tsc, std::uint64_t& suppressed) noexcept {
+        std::uint64_t interval = interval_tsc_.load(std::memory_order_relaxed);
+        if (interval == 0) [[unlikely]] {
+            interval = std::max<std::uint64_t>(ns_to_tsc(TscCalibration::NS_PER_SEC / per_sec_), 1);
+            interval_tsc_.store(interval, std::memory_order_relaxed);
+        }
+        const std::uint64_t tolerance = interval * (burst_ - 1);
+        std::uint64_t tat = tat_tsc_.load(std::memory_order_relaxed);
+        if (tat > now_tsc + tolerance) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const std::uint64_t next = std::max(tat, now_tsc) + interval;
+        if (!tat_tsc_.compare_exchange_strong(tat, next, std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Calls refused and not yet reported by an allowed one
+    [[nodiscard]] std::uint64_t pending_suppressed() const noexcept {
+        return suppressed_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::uint32_t per_sec_;
+    std::uint32_t burst_;
+    std::atomic<std::uint64_t> interval_tsc_{0};  // Resolved on first use (after TSC calibration)
+    std::atomic<std::uint64_t> tat_tsc_{0};       // Theoretical arrival time of the next line
+    std::atomic<std::uint64_t> suppressed_{0};
 };
 
+// Drains logger from an AgentRuntime (Config::external_consumer) in place of the
+// consumer thread. Stop the runtime before logger.stop(), which writes out the rest.
+Agent log_consumer_agent(AsyncLogger& logger);
+
 AsyncLogger& hot_logger() noexcept;
 bool init_hot_logger(const AsyncLogger::Config& cfg) noexcept;
 void shutdown_hot_logger() noexcept;
@@ -90,6 +193,17 @@ void shutdown_hot_logger() noexcept;
 #define LOG_HOT_LVL(LVL, CAT, FMT, ...) \
     do { ::util::hot_logger().try_logf((LVL), (CAT), (FMT), ##__VA_ARGS__); } while (0)
 
+// At most PER_SEC lines per second (bursts of BURST) from this call site; the rest
+// are counted and reported by the next line that gets through.
+#define LOG_HOT_RATE_LIMITED(LVL, CAT, PER_SEC, BURST, FMT, ...)                                       \
+    do {                                                                                               \
+        static ::util::LogRateLimiter fx_log_limiter_((PER_SEC), (BURST));                             \
+        std::uint64_t fx_log_suppressed_ = 0;                                                          \
+        if (fx_log_limiter_.allow(::util::rdtsc(), fx_log_suppressed_)) {                              \
+            ::util::hot_logger().try_logf_suppressed((LVL), (CAT), fx_log_suppressed_, (FMT), ##__VA_ARGS__); \
+        }                                                                                              \
+    } while (0)
+
 #define LOG_HOT_TRACE(FMT, ...) LOG_HOT_LVL(::util::LogLevel::Trace, "HOT", (FMT), ##__VA_ARGS__)
 #define LOG_HOT_DEBUG(FMT, ...) LOG_HOT_LVL(::util::LogLevel::Debug, "HOT", (FMT), ##__VA_ARGS__)
 #define LOG_HOT_INFO(FMT, ...)  LOG_HOT_LVL(::util::LogLevel::Info,  "HOT", (FMT), ##__VA_ARGS__)
@@ -0,0 +1,159 @@
+#include "util/cold_start.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "util/tsc_calibration.hpp"
+
+namespace util {
+
+namespace {
+
+std::size_t page_size() noexcept {
+    const long page = ::sysconf(_SC_PAGESIZE);
+    return page > 0 ? static_cast<std::size_t>(page) : 4096;
+}
+
+std::size_t chunk_count(const MemoryRegion& r) noexcept {
+    return (r.bytes + PREFAULT_CHUNK_BYTES - 1) / PREFAULT_CHUNK_BYTES;
+}
+
+// Reads and writes back one byte in every page of [begin, end)
+void touch_pages(std::byte* begin, std::byte* end, std::size_t page) noexcept {
+    for (std::byte* p = begin; p < end; p += page) {
+        volatile std::byte* v = p;
+        *v = *v;
+    }
+    volatile std::byte* last = end - 1;  // begin may sit mid-page: make sure the final page is covered
+    *last = *last;
+}
+
+void prefault_chunk(const MemoryRegion& r, std::size_t chunk, std::size_t page,
+                    std::atomic<bool>& populate_ok) noexcept {
+    std::byte* const base = static_cast<std::byte*>(r.data);
+    std::byte* const begin = base + chunk * PREFAULT_CHUNK_BYTES;
+    std::byte* const end = base + std::min(r.bytes, (chunk + 1) * PREFAULT_CHUNK_BYTES);
+#ifdef MADV_POPULATE_WRITE
+    if (populate_ok.load(std::memory_order_relaxed)) {
+        const auto first = reinterpret_cast<std::uintptr_t>(begin) & ~(page - 1);
+        const auto last = (reinterpret_cast<std::uintptr_t>(end) + page - 1) & ~(page - 1);
+        if (::madvise(reinterpret_cast<void*>(first), last - first, MADV_POPULATE_WRITE) == 0) {
+            return;
+        }
+        populate_ok.store(false, std::memory_order_relaxed);  // Pre-5.14 kernel: touch instead
+    }
+#else
+    (void)populate_ok;
+#endif
+    touch_pages(begin, end, page);
+}
+
+} // namespace
+
+std::size_t prefault_parallel(std::span<const MemoryRegion> regions, std::size_t threads) noexcept {
+    const std::size_t page = page_size();
+    std::size_t total_chunks = 0;
+    std::size_t pages = 0;
+    for (const MemoryRegion& r : regions) {
+        if (r.data == nullptr || r.bytes == 0) {
+            continue;
+        }
+        total_chunks += chunk_count(r);
+        const auto first = reinterpret_cast<std::uintptr_t>(r.data) & ~(page - 1);
+        const auto last = (reinterpret_cast<std::uintptr_t>(r.data) + r.bytes + page - 1) & ~(page - 1);
+        pages += (last - first) / page;
+    }
+    if (total_chunks == 0) {
+        return 0;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> populate_ok{true};
+    const auto worker = [&]() noexcept {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < total_chunks;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            // Regions are few: find the chunk's region by walking them
+            std::size_t chunk = i;
+            for (const MemoryRegion& r : regions) {
+                if (r.data == nullptr || r.bytes == 0) {
+                    continue;
+                }
+                const std::size_t n = chunk_count(r);
+                if (chunk < n) {
+                    prefault_chunk(r, chunk, page, populate_ok);
+                    break;
+                }
+                chunk -= n;
+            }
+        }
+    };
+
+    threads = std::clamp<std::size_t>(threads, 1, total_chunks);
+    std::vector<std::thread> pool;
+    try {
+        pool.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+    } catch (...) {
+        // Fewer helpers than asked for; the caller's share grows
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    return pages;
+}
+
+void run_parallel(std::span<const std::function<void()>> tasks, std::size_t threads) noexcept {
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&]() noexcept {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < tasks.size();
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            tasks[i]();
+        }
+    };
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(tasks.size(), 1));
+    std::vector<std::thread> pool;
+    try {
+        pool.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+    } catch (...) {
+        // Fewer helpers than asked for; the caller's share grows
+    }
+    worker();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+BackgroundCalibration::BackgroundCalibration(std::uint64_t duration_ms) noexcept {
+    try {
+        thread_ = std::thread([this, duration_ms] { calibrate(duration_ms); });
+    } catch (...) {
+        calibrate(duration_ms);  // No thread to spare: calibrate inline
+    }
+}
+
+void BackgroundCalibration::calibrate(std::uint64_t duration_ms) noexcept {
+    const auto begin = std::chrono::steady_clock::now();
+    TscCalibration::instance().calibrate_blocking(duration_ms);
+    elapsed_ns_ = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+
+bool BackgroundCalibration::wait() noexcept {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return TscCalibration::instance().is_calibrated();
+}
+
+} // namespace util
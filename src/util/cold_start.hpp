@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <thread>
+
+namespace util {
+
+// Memory to make resident before the hot path starts
+struct MemoryRegion {
+    void* data{nullptr};
+    std::size_t bytes{0};
+};
+
+inline constexpr std::size_t PREFAULT_CHUNK_BYTES = std::size_t{2} << 20;
+
+// Faults in every page of regions, spread over up to threads threads (the caller
+// included) that claim PREFAULT_CHUNK_BYTES chunks from a shared cursor. Contents
+// are preserved: pages are populated with MADV_POPULATE_WRITE where the kernel has
+// it, otherwise by reading and writing back one byte per page, so nothing else may
+// write the regions meanwhile. Returns the number of pages covered.
+std::size_t prefault_parallel(std::span<const MemoryRegion> regions, std::size_t threads) noexcept;
+
+// Runs every task on up to threads threads (the caller included) and returns once
+// all are done. For large structures whose constructors write every element (the
+// ingest rings), so their pages fault in parallel rather than one after another.
+// An exception escaping a task terminates the process.
+void run_parallel(std::span<const std::function<void()>> tasks, std::size_t threads) noexcept;
+
+// Runs TscCalibration::calibrate_blocking on its own thread, so the ~100ms
+// measurement overlaps the rest of startup instead of adding to it. Until wait()
+// returns, nothing may convert between TSC cycles and ns (ns_to_tsc, tsc_to_ns,
+// rate limiters, timer deadlines): start no hot thread before it.
+//
+// Thread safety: wait() on the constructing thread only.
+class BackgroundCalibration {
+public:
+    explicit BackgroundCalibration(std::uint64_t duration_ms = 100) noexcept;
+    ~BackgroundCalibration() { (void)wait(); }
+
+    BackgroundCalibration(const BackgroundCalibration&) = delete;
+    BackgroundCalibration& operator=(const BackgroundCalibration&) = delete;
+
+    // Joins the calibration. Returns true if the frequency was measured, false if
+    // the default is in use (no invariant TSC).
+    bool wait() noexcept;
+    // Wall time the calibration took (valid after wait())
+    [[nodiscard]] std::uint64_t elapsed_ns() const noexcept { return elapsed_ns_; }
+
+private:
+    void calibrate(std::uint64_t duration_ms) noexcept;
+
+    std::thread thread_{};
+    std::uint64_t elapsed_ns_{0};
+};
+
+// Wall-clock durations of named startup phases. Timed with steady_clock, since the
+// TSC is usually still being calibrated while they run.
+//
+// Thread safety: None. Memory: fixed table of MAX_PHASES.
+class StartupPhases {
+public:
+    static constexpr std::size_t MAX_PHASES = 16;
+
+    struct Phase {
+        const char* name{nullptr};
+        std::uint64_t ns{0};
+    };
+
+    // Runs fn and records how long it took under name
+    template <typename Fn>
+    void time(const char* name, Fn&& fn) {
+        const auto begin = std::chrono::steady_clock::now();
+        std::forward<Fn>(fn)();
+        record(name, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                    std::chrono::steady_clock::now() - begin)
+                                                    .count()));
+    }
+
+    // Adds a phase timed elsewhere; dropped past MAX_PHASES
+    void record(const char* name, std::uint64_t ns) noexcept {
+        if (count_ < MAX_PHASES) {
+            phases_[count_++] = Phase{name, ns};
+        }
+    }
+
+    [[nodiscard]] std::span<const Phase> phases() const noexcept { return {phases_, count_}; }
+
+    // Since construction
+    [[nodiscard]] std::uint64_t elapsed_ns() const noexcept {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_{std::chrono::steady_clock::now()};
+    Phase phases_[MAX_PHASES]{};
+    std::size_t count_{0};
+};
+
+} // namespace util
@@ -0,0 +1,123 @@
+#include "util/cpu_features.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define FX_CPU_X86 1
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define FX_CPU_X86 0
+#endif
+
+namespace util {
+
+namespace {
+
+#if FX_CPU_X86
+
+void cpuid(std::uint32_t (&regs)[4], std::uint32_t leaf, std::uint32_t subleaf) noexcept {
+#ifdef _MSC_VER
+    __cpuidex(reinterpret_cast<int*>(regs), static_cast<int>(leaf), static_cast<int>(subleaf));
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+std::uint64_t xgetbv0() noexcept {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    std::uint32_t lo = 0;
+    std::uint32_t hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+CpuFeatures detect() noexcept {
+    CpuFeatures f{};
+    std::uint32_t regs[4] = {0, 0, 0, 0};
+    cpuid(regs, 0, 0);
+    const std::uint32_t max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return f;
+    }
+
+    cpuid(regs, 1, 0);
+    const std::uint32_t ecx1 = regs[2];
+    f.sse42 = (ecx1 & (1u << 20)) != 0;
+    f.popcnt = (ecx1 & (1u << 23)) != 0;
+    const bool osxsave = (ecx1 & (1u << 27)) != 0;
+    if (osxsave) {
+        const std::uint64_t xcr0 = xgetbv0();
+        f.os_ymm = (xcr0 & 0x6) == 0x6;     // SSE + AVX state
+        f.os_zmm = (xcr0 & 0xE6) == 0xE6;   // + opmask, ZMM_Hi256, Hi16_ZMM
+    }
+
+    if (max_leaf >= 7) {
+        cpuid(regs, 7, 0);
+        const std::uint32_t ebx7 = regs[1];
+        f.bmi1 = (ebx7 & (1u << 3)) != 0;
+        f.avx2 = (ebx7 & (1u << 5)) != 0;
+        f.bmi2 = (ebx7 & (1u << 8)) != 0;
+        f.avx512f = (ebx7 & (1u << 16)) != 0;
+        f.avx512bw = (ebx7 & (1u << 30)) != 0;
+        f.avx512vl = (ebx7 & (1u << 31)) != 0;
+    }
+    return f;
+}
+
+#else
+
+CpuFeatures detect() noexcept { return {}; }
+
+#endif
+
+// FX_ISA caps the dispatch level (e.g. to compare kernels on one host)
+Isa isa_cap_from_env() noexcept {
+    const char* env = std::getenv("FX_ISA");
+    if (!env || std::strcmp(env, "avx512") == 0) {
+        return Isa::Avx512;
+    }
+    if (std::strcmp(env, "avx2") == 0) {
+        return Isa::Avx2;
+    }
+    if (std::strcmp(env, "scalar") == 0) {
+        return Isa::Scalar;
+    }
+    return Isa::Avx512;  // Unknown value: no cap
+}
+
+} // namespace
+
+Isa CpuFeatures::max_isa() const noexcept {
+    const bool avx2_level = os_ymm && avx2 && bmi1 && bmi2 && popcnt;
+    if (!avx2_level) {
+        return Isa::Scalar;
+    }
+    if (os_zmm && avx512f && avx512bw && avx512vl) {
+        return Isa::Avx512;
+    }
+    return Isa::Avx2;
+}
+
+const CpuFeatures& cpu_features() noexcept {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+Isa dispatch_isa() noexcept {
+    static const Isa isa = [] {
+        const Isa detected = cpu_features().max_isa();
+        const Isa cap = isa_cap_from_env();
+        return static_cast<std::uint8_t>(cap) < static_cast<std::uint8_t>(detected) ? cap : detected;
+    }();
+    return isa;
+}
+
+} // namespace util
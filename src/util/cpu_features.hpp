@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+// Per-function ISA targets for runtime-dispatched kernels. Kernels tagged with
+// these compile for the named extensions even when the rest of the build targets
+// the baseline ISA; they must only be called after dispatch_isa() allows it.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define FX_X86_DISPATCH 1
+    #define FX_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+    #define FX_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")))
+#else
+    #define FX_X86_DISPATCH 0
+#endif
+
+namespace util {
+
+// Kernel instruction set levels, ordered: a level implies everything below it.
+//   Avx2:   AVX2 + BMI1/BMI2 (Haswell and later)
+//   Avx512: Avx2 + AVX-512 F/BW/VL (Skylake-SP and later)
+enum class Isa : std::uint8_t { Scalar = 0, Avx2 = 1, Avx512 = 2 };
+
+[[nodiscard]] constexpr const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::Scalar:
+        return "scalar";
+    case Isa::Avx2:
+        return "avx2";
+    case Isa::Avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+struct CpuFeatures {
+    bool sse42{false};
+    bool popcnt{false};
+    bool avx2{false};
+    bool bmi1{false};
+    bool bmi2{false};
+    bool avx512f{false};
+    bool avx512bw{false};
+    bool avx512vl{false};
+    bool os_ymm{false};  // OS saves AVX state (XCR0)
+    bool os_zmm{false};  // OS saves AVX-512 state (XCR0)
+
+    // Highest level whose every requirement (including OS support) is present
+    [[nodiscard]] Isa max_isa() const noexcept;
+};
+
+// Probed with CPUID/XGETBV once, on first use; all zero off x86.
+[[nodiscard]] const CpuFeatures& cpu_features() noexcept;
+
+// Level the dispatched kernels bind to: cpu_features().max_isa(), capped by the
+// FX_ISA environment variable (scalar | avx2 | avx512) if set. Resolved once.
+[[nodiscard]] Isa dispatch_isa() noexcept;
+
+// True if kernels for isa can run on this CPU (ignores FX_ISA); for tests and tools
+[[nodiscard]] inline bool isa_supported(Isa isa) noexcept {
+    return static_cast<std::uint8_t>(isa) <= static_cast<std::uint8_t>(cpu_features().max_isa());
+}
+
+// One kernel's implementations by level. Levels that were not built are nullptr
+// and fall back to the next lower one; scalar must always be set.
+template <typename Fn>
+struct IsaKernels {
+    Fn scalar{nullptr};
+    Fn avx2{nullptr};
+    Fn avx512{nullptr};
+
+    [[nodiscard]] constexpr Fn for_isa(Isa isa) const noexcept {
+        if (isa == Isa::Avx512 && avx512) {
+            return avx512;
+        }
+        if (isa != Isa::Scalar && avx2) {
+            return avx2;
+        }
+        return scalar;
+    }
+
+    // Implementation for this machine (bind once, at startup)
+    [[nodiscard]] Fn bind() const noexcept { return for_isa(dispatch_isa()); }
+};
+
+} // namespace util
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace util {
+
+// DeadlineFifo schedules timers that all share one fixed duration. Their deadlines
+// are now + constant on a non-decreasing clock, so they arrive already sorted: a
+// ring in insertion order is a priority queue. Scheduling is one store at the
+// tail; expiry pops from the front while front.deadline <= now, so a poll costs
+// O(expired) with no bucket math, capacity per tick or rescheduling of long spans.
+//
+// An entry whose deadline is earlier than the newest one (clock skew between
+// sources) is refused rather than inserted out of order; so is any entry when the
+// ring is full. The caller routes those to a general-purpose timer (WheelTimer).
+//
+// Cancellation follows the WheelTimer pattern: entries carry (ref, generation)
+// and the expiry callback drops those whose generation is stale.
+//
+// Thread safety: None. Single-writer only (reconciler thread).
+//
+// Memory: The ring is allocated at construction. No heap allocations afterwards.
+class DeadlineFifo {
+public:
+    static constexpr std::uint64_t NO_DEADLINE = std::numeric_limits<std::uint64_t>::max();
+
+    struct Entry {
+        std::uint32_t ref{0};           // Caller's handle for the timed object
+        std::uint32_t generation{0};
+        std::uint64_t deadline_tsc{0};  // Absolute deadline in TSC cycles
+    };
+
+    static_assert(std::is_trivially_copyable_v<Entry>, "Entry must be trivially copyable");
+    static_assert(sizeof(Entry) == 16, "Entry should stay at 16 bytes");
+
+    struct Stats {
+        std::uint64_t scheduled{0};  // Entries accepted
+        std::uint64_t expired{0};    // Entries popped (callback invoked)
+        std::uint64_t refused{0};    // Entries refused: ring full or deadline out of order
+    };
+
+    // capacity is rounded up to a power of two. Throws std::invalid_argument if 0.
+    explicit DeadlineFifo(std::size_t capacity)
+        : capacity_(capacity == 0 ? 0 : std::bit_ceil(capacity)) {
+        if (capacity_ == 0) {
+            throw std::invalid_argument("DeadlineFifo capacity must be > 0");
+        }
+        entries_ = std::make_unique_for_overwrite<Entry[]>(capacity_);
+    }
+
+    DeadlineFifo(const DeadlineFifo&) = delete;
+    DeadlineFifo& operator=(const DeadlineFifo&) = delete;
+
+    // Appends the entry. Returns false (nothing stored) if the ring is full or
+    // deadline_tsc is earlier than the newest entry's.
+    [[nodiscard]] bool push(std::uint32_t ref, std::uint32_t generation, std::uint64_t deadline_tsc) noexcept {
+        if (tail_ - head_ == capacity_ || (tail_ != head_ && deadline_tsc < back_deadline_tsc_)) {
+            ++stats_.refused;
+            return false;
+        }
+        entries_[tail_ & (capacity_ - 1)] = Entry{ref, generation, deadline_tsc};
+        ++tail_;
+        back_deadline_tsc_ = deadline_tsc;
+        ++stats_.scheduled;
+        return true;
+    }
+
+    // Pops every entry due by now_tsc, oldest first, and invokes
+    // on_expired(uint32_t ref, uint32_t generation) for each. Entries pushed by the
+    // callback are left for the next poll, so a callback that reschedules cannot
+    // keep the loop alive. Returns the number of entries popped.
+    template <typename F>
+    std::size_t poll_expired(std::uint64_t now_tsc, F&& on_expired) noexcept {
+        const std::uint64_t end = tail_;
+        std::size_t popped = 0;
+        while (head_ != end) {
+            const Entry entry = entries_[head_ & (capacity_ - 1)];
+            if (entry.deadline_tsc > now_tsc) {
+                break;
+            }
+            ++head_;
+            ++popped;
+            on_expired(entry.ref, entry.generation);
+        }
+        stats_.expired += popped;
+        return popped;
+    }
+
+    // Deadline of the oldest entry, or NO_DEADLINE when empty. Exact: callers can
+    // skip polling while now_tsc < next_deadline_tsc().
+    [[nodiscard]] std::uint64_t next_deadline_tsc() const noexcept {
+        return head_ == tail_ ? NO_DEADLINE : entries_[head_ & (capacity_ - 1)].deadline_tsc;
+    }
+
+    // Drops every entry (e.g., for end-of-day reset)
+    void reset() noexcept {
+        head_ = 0;
+        tail_ = 0;
+        back_deadline_tsc_ = 0;
+        stats_ = Stats{};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(tail_ - head_); }
+    [[nodiscard]] bool empty() const noexcept { return head_ == tail_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+private:
+    std::size_t capacity_;
+    std::unique_ptr<Entry[]> entries_;
+    std::uint64_t head_{0};  // Next entry to expire
+    std::uint64_t tail_{0};  // Next free slot (monotonic; masked on access)
+    std::uint64_t back_deadline_tsc_{0};
+    Stats stats_{};
+};
+
+} // namespace util
@@ -0,0 +1,184 @@
+#include "util/metrics_exporter.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace util {
+
+// ===== MetricsText =====
+
+void MetricsText::header(const char* name, const char* help, const char* type) {
+    if (last_family_ == name) {
+        return;
+    }
+    last_family_ = name;
+    out_ += "# HELP ";
+    out_ += name;
+    out_ += ' ';
+    out_ += help;
+    out_ += "\n# TYPE ";
+    out_ += name;
+    out_ += ' ';
+    out_ += type;
+    out_ += '\n';
+}
+
+void MetricsText::sample(const char* name, const char* suffix, const char* labels, const char* value) {
+    out_ += name;
+    out_ += suffix;
+    if (labels && labels[0] != '\0') {
+        out_ += '{';
+        out_ += labels;
+        out_ += '}';
+    }
+    out_ += ' ';
+    out_ += value;
+    out_ += '\n';
+}
+
+void MetricsText::counter(const char* name, const char* help, std::uint64_t value, const char* labels) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(value));
+    header(name, help, "counter");
+    sample(name, "_total", labels, buf);
+}
+
+void MetricsText::gauge(const char* name, const char* help, double value, const char* labels) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "%.17g", value);
+    header(name, help, "gauge");
+    sample(name, "", labels, buf);
+}
+
+// ===== MetricsExporter =====
+
+MetricsExporter::MetricsExporter(std::uint16_t port, RenderFn render)
+    : port_(port), render_(std::move(render)) {}
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+bool MetricsExporter::start(std::string& error) {
+    if (!stop_.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error = std::string("metrics socket: ") + std::strerror(errno);
+        return false;
+    }
+    const int reuse = 1;
+    (void)::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port_);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 8) != 0) {
+        error = "metrics bind/listen on 127.0.0.1:" + std::to_string(port_) + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port_ = ntohs(addr.sin_port);
+    }
+
+    listen_fd_ = fd;
+    stop_.store(false, std::memory_order_release);
+    thread_ = std::thread([this] { serve_loop(); });
+    return true;
+}
+
+void MetricsExporter::stop() noexcept {
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+void MetricsExporter::serve_loop() noexcept {
+    while (!stop_.load(std::memory_order_acquire)) {
+        // Short poll timeout so stop() is noticed promptly
+        pollfd pfd{listen_fd_, POLLIN, 0};
+        if (::poll(&pfd, 1, 100) <= 0 || (pfd.revents & POLLIN) == 0) {
+            continue;
+        }
+        const int conn = ::accept(listen_fd_, nullptr, nullptr);
+        if (conn < 0) {
+            continue;
+        }
+        handle_connection(conn);
+        ::close(conn);
+    }
+}
+
+void MetricsExporter::handle_connection(int fd) noexcept {
+    // A slow or idle client must not stall the exporter forever
+    timeval tv{};
+    tv.tv_sec = 1;
+    (void)::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    (void)::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    // Only the request line matters; read until it is complete
+    char req[1024];
+    std::size_t have = 0;
+    while (have < sizeof(req) - 1) {
+        const ssize_t n = ::recv(fd, req + have, sizeof(req) - 1 - have, 0);
+        if (n <= 0) {
+            break;
+        }
+        have += static_cast<std::size_t>(n);
+        req[have] = '\0';
+        if (std::strstr(req, "\r\n") || std::strchr(req, '\n')) {
+            break;
+        }
+    }
+    req[have] = '\0';
+
+    const bool is_metrics = std::strncmp(req, "GET /metrics ", 13) == 0 ||
+                            std::strncmp(req, "GET /metrics?", 13) == 0;
+
+    std::string response;
+    try {
+        if (is_metrics) {
+            text_.clear();
+            render_(text_);
+            const std::string& body = text_.str();
+            response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+            response += body;
+            scrapes_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+    } catch (...) {
+        // Rendering allocates; on failure answer 500 rather than taking the thread down
+        response = "HTTP/1.0 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    std::size_t sent = 0;
+    while (sent < response.size()) {
+        const ssize_t n = ::send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+} // namespace util
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace util {
+
+// Builds a Prometheus text exposition (format 0.0.4, also accepted by OpenMetrics
+// scrapers). Each metric family gets its HELP/TYPE header once; call counter/gauge
+// repeatedly with different labels to add samples to the same family, as long as
+// the samples of one family are written consecutively.
+class MetricsText {
+public:
+    // labels is the inside of the braces, e.g. "source=\"primary\"" (may be empty)
+    void counter(const char* name, const char* help, std::uint64_t value, const char* labels = "");
+    void gauge(const char* name, const char* help, double value, const char* labels = "");
+
+    [[nodiscard]] const std::string& str() const noexcept { return out_; }
+    void clear() noexcept {
+        out_.clear();
+        last_family_.clear();
+    }
+
+private:
+    void header(const char* name, const char* help, const char* type);
+    void sample(const char* name, const char* suffix, const char* labels, const char* value);
+
+    std::string out_;
+    std::string last_family_;
+};
+
+// Serves GET /metrics over HTTP/1.0 on a loopback port from its own thread.
+//
+// Every scrape calls render on the exporter thread; render must only read data
+// that is safe to access concurrently (relaxed atomics, seqlock snapshots, ring
+// depths) so the observed threads are never blocked or slowed. One connection
+// is served at a time; other paths get 404.
+class MetricsExporter {
+public:
+    using RenderFn = std::function<void(MetricsText&)>;
+
+    // port 0 picks an ephemeral port (see port())
+    MetricsExporter(std::uint16_t port, RenderFn render);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Binds 127.0.0.1:port and starts the serving thread. Returns false and fills
+    // error if the socket cannot be set up.
+    bool start(std::string& error);
+    void stop() noexcept;
+
+    [[nodiscard]] std::uint16_t port() const noexcept { return port_; }
+    [[nodiscard]] std::uint64_t scrapes() const noexcept { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    void serve_loop() noexcept;
+    void handle_connection(int fd) noexcept;
+
+    std::uint16_t port_{0};
+    RenderFn render_;
+    int listen_fd_{-1};
+    std::atomic<bool> stop_{true};
+    std::atomic<std::uint64_t> scrapes_{0};
+    std::thread thread_{};
+    MetricsText text_{};
+};
+
+} // namespace util
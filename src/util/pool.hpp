@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "util/arena.hpp"
+
+namespace util {
+
+// 32-bit reference to a Pool slot: slot index in the low IndexBits, generation in
+// the rest. Generations start at 1, so 0 never names a slot.
+using PoolHandle = std::uint32_t;
+inline constexpr PoolHandle NULL_POOL_HANDLE = 0;
+
+// Pool is a fixed-capacity slab of T slots with free-list reuse. Slots are padded
+// to whole cache lines, so a record never shares a line with its neighbour, and
+// are addressed by PoolHandle: resolving one is an index multiply off the slab
+// base, with no hash lookup and no 8-byte pointer to store.
+//
+// Every release bumps the slot's generation, so a handle kept past the release
+// (a timer entry, a queued reference) resolves to nullptr through get() instead of
+// reaching the record that reused the slot. Generations wrap after
+// 2^(32 - IndexBits) - 1 reuses of one slot.
+//
+// The slab is carved once from an Arena; the free list and generations live in a
+// separate metadata array so slot contents are left alone. allocate() hands out
+// raw storage (the caller initializes T; T must be trivially destructible), takes
+// recycled slots first and never allocates.
+//
+// Thread safety: None. Single-writer only (reconciler thread).
+template <typename T, unsigned IndexBits = 22>
+class Pool {
+    static_assert(IndexBits >= 8 && IndexBits <= 28, "IndexBits leaves too few generation bits");
+    static_assert(std::is_trivially_destructible_v<T>, "Pool never runs destructors");
+
+public:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t SLOT_ALIGN = alignof(T) > CACHE_LINE ? alignof(T) : CACHE_LINE;
+    static constexpr std::size_t SLOT_BYTES = (sizeof(T) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+    static constexpr std::size_t MAX_SLOTS = std::size_t{1} << IndexBits;
+
+    // Carves up to max_slots slots (fewer if the arena runs out, at most MAX_SLOTS)
+    // from arena. Throws std::invalid_argument if max_slots is 0.
+    Pool(Arena& arena, std::size_t max_slots) {
+        if (max_slots == 0) {
+            throw std::invalid_argument("Pool max_slots must be > 0");
+        }
+        std::size_t slots = max_slots < MAX_SLOTS ? max_slots : MAX_SLOTS;
+        const std::size_t fit = arena.available(SLOT_ALIGN) / SLOT_BYTES;
+        slots = slots < fit ? slots : fit;
+        if (slots != 0) {
+            slab_ = static_cast<std::byte*>(arena.allocate(slots * SLOT_BYTES, SLOT_ALIGN));
+            meta_ = std::make_unique_for_overwrite<Meta[]>(slots);
+        }
+        capacity_ = slab_ ? slots : 0;
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Reserves a slot; returns NULL_POOL_HANDLE if every slot is in use.
+    [[nodiscard]] PoolHandle allocate() noexcept {
+        std::uint32_t idx;
+        if (free_head_ != NO_SLOT) {
+            idx = free_head_;
+            free_head_ = meta_[idx].next_free;
+            --free_count_;
+        } else if (high_water_ < capacity_) {
+            idx = high_water_++;
+            if (idx >= touched_) {
+                meta_[idx].generation = 1;  // First use of the slot
+                ++touched_;
+            } else {
+                bump_generation(idx);  // Handed out before the last reset()
+            }
+        } else {
+            return NULL_POOL_HANDLE;
+        }
+        ++live_;
+        return make_handle(idx, meta_[idx].generation);
+    }
+
+    // Returns a live slot to the free list and invalidates every handle to it.
+    void release(PoolHandle h) noexcept {
+        const std::uint32_t idx = index_of(h);
+        bump_generation(idx);
+        meta_[idx].next_free = free_head_;
+        free_head_ = idx;
+        ++free_count_;
+        --live_;
+    }
+
+    // Slot of a handle known to be live: no generation check
+    [[nodiscard]] T* at(PoolHandle h) const noexcept {
+        return std::launder(reinterpret_cast<T*>(slab_ + std::size_t{index_of(h)} * SLOT_BYTES));
+    }
+
+    // Slot of h, or nullptr if h is null or its slot was released since
+    [[nodiscard]] T* get(PoolHandle h) const noexcept {
+        const std::uint32_t idx = index_of(h);
+        if (h == NULL_POOL_HANDLE || idx >= high_water_ || meta_[idx].generation != generation_of(h)) {
+            return nullptr;
+        }
+        return at(h);
+    }
+
+    // Current handle of a slot pointer obtained from this pool
+    [[nodiscard]] PoolHandle handle_of(const T* p) const noexcept {
+        const auto idx = static_cast<std::uint32_t>(
+            (reinterpret_cast<const std::byte*>(p) - slab_) / static_cast<std::ptrdiff_t>(SLOT_BYTES));
+        return make_handle(idx, meta_[idx].generation);
+    }
+
+    // Releases every slot at once; outstanding handles stop resolving.
+    void reset() noexcept {
+        high_water_ = 0;
+        free_head_ = NO_SLOT;
+        free_count_ = 0;
+        live_ = 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] std::size_t size() const noexcept { return live_; }
+    // Released slots waiting for reuse
+    [[nodiscard]] std::size_t free_count() const noexcept { return free_count_; }
+
+    [[nodiscard]] static constexpr std::uint32_t index_of(PoolHandle h) noexcept { return h & INDEX_MASK; }
+    [[nodiscard]] static constexpr std::uint32_t generation_of(PoolHandle h) noexcept { return h >> IndexBits; }
+
+private:
+    static constexpr std::uint32_t INDEX_MASK = (std::uint32_t{1} << IndexBits) - 1;
+    static constexpr std::uint32_t GENERATION_MASK = (std::uint32_t{1} << (32 - IndexBits)) - 1;
+    static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    struct Meta {
+        std::uint32_t generation;
+        std::uint32_t next_free;
+    };
+
+    static constexpr PoolHandle make_handle(std::uint32_t idx, std::uint32_t gen) noexcept {
+        return (gen << IndexBits) | idx;
+    }
+
+    void bump_generation(std::uint32_t idx) noexcept {
+        std::uint32_t gen = (meta_[idx].generation + 1) & GENERATION_MASK;
+        meta_[idx].generation = gen == 0 ? 1 : gen;
+    }
+
+    std::byte* slab_{nullptr};
+    std::unique_ptr<Meta[]> meta_;
+    std::size_t capacity_{0};
+    std::uint32_t high_water_{0};  // Slots [0, high_water_) handed out since reset()
+    std::uint32_t touched_{0};     // Slots whose generation has been initialized
+    std::uint32_t free_head_{NO_SLOT};
+    std::size_t free_count_{0};
+    std::size_t live_{0};
+};
+
+} // namespace util
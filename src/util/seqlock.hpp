@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace util {
+
+// SeqlockSnapshot publishes a copy of a trivially copyable value from one writer
+// thread to any number of reader threads.
+//
+// store() never waits: it bumps the sequence to odd, writes the payload and bumps
+// it back to even. load() retries until it reads the same even sequence before and
+// after copying, so readers always see a consistent value and never slow the writer.
+// The payload lives in relaxed atomic words, so concurrent copies are race-free.
+//
+// Thread safety: one writer (store), any number of readers (load, try_load).
+// Memory: all storage is inline; no allocations.
+template <typename T>
+class SeqlockSnapshot {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockSnapshot requires a trivially copyable T");
+
+public:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    void store(const T& value) noexcept {
+        std::uint64_t buf[WORDS]{};
+        std::memcpy(buf, &value, sizeof(T));
+
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Single attempt; false if a store() was in progress or raced the copy.
+    [[nodiscard]] bool try_load(T& out) const noexcept {
+        const std::uint64_t before = seq_.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            return false;
+        }
+        std::uint64_t buf[WORDS];
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    // Retries until a consistent copy is read.
+    [[nodiscard]] T load() const noexcept {
+        T out{};
+        while (!try_load(out)) {
+        }
+        return out;
+    }
+
+    // Number of completed stores (0 = never published)
+    [[nodiscard]] std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, WORDS> words_{};
+};
+
+} // namespace util
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace util {
+
+// SigsafeWriter formats text into a fixed inline buffer and hands it to write(2)
+// when full or on flush(). It uses no stdio, locale or heap, so it may be used
+// from a signal handler (crash dumps).
+//
+// Thread safety: None. One writer per instance (typically on the handler's stack).
+class SigsafeWriter {
+public:
+    explicit SigsafeWriter(int fd) noexcept : fd_(fd) {}
+    ~SigsafeWriter() { flush(); }
+
+    SigsafeWriter(const SigsafeWriter&) = delete;
+    SigsafeWriter& operator=(const SigsafeWriter&) = delete;
+
+    SigsafeWriter& str(const char* s, std::size_t n) noexcept {
+        while (n > 0) {
+            if (len_ == sizeof(buf_)) {
+                flush();
+            }
+            const std::size_t chunk = n < sizeof(buf_) - len_ ? n : sizeof(buf_) - len_;
+            std::memcpy(buf_ + len_, s, chunk);
+            len_ += chunk;
+            s += chunk;
+            n -= chunk;
+        }
+        return *this;
+    }
+    SigsafeWriter& str(const char* s) noexcept { return s ? str(s, std::strlen(s)) : *this; }
+    SigsafeWriter& ch(char c) noexcept { return str(&c, 1); }
+
+    SigsafeWriter& u64(std::uint64_t v) noexcept {
+        char digits[20];
+        std::size_t n = 0;
+        do {
+            digits[sizeof(digits) - 1 - n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        return str(digits + sizeof(digits) - n, n);
+    }
+
+    SigsafeWriter& hex(std::uint64_t v) noexcept {
+        static constexpr char DIGITS[] = "0123456789abcdef";
+        char out[18] = {'0', 'x'};
+        for (int i = 0; i < 16; ++i) {
+            out[17 - i] = DIGITS[(v >> (4 * i)) & 0xF];
+        }
+        return str(out, sizeof(out));
+    }
+
+    // Writes the buffered bytes, retrying short writes and EINTR
+    void flush() noexcept {
+        std::size_t off = 0;
+        while (off < len_ && ok_) {
+            const ssize_t n = ::write(fd_, buf_ + off, len_ - off);
+            if (n > 0) {
+                off += static_cast<std::size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                ok_ = false;
+            }
+        }
+        len_ = 0;
+    }
+
+    // False once a write failed; later output is discarded
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+
+private:
+    int fd_;
+    std::size_t len_{0};
+    bool ok_{true};
+    char buf_[512];
+};
+
+} // namespace util
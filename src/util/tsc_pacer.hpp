@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "util/rdtsc.hpp"
+#include "util/tsc_calibration.hpp"
+
+namespace util {
+
+// TscPacer maps recorded timestamps onto the local TSC so a recording can be
+// replayed with its original inter-arrival times, scaled by a speed factor.
+//
+// The first recorded timestamp is pinned to start_tsc; every later record is due
+// at start_tsc + (recorded_ns - first_ns) / speed. speed <= 0 means "as fast as
+// possible": everything is due immediately. Pacing is absolute, so a late publish
+// does not push back the records after it (the replay catches up instead of
+// drifting).
+class TscPacer {
+public:
+    // Waits longer than this sleep first and spin only for the remainder
+    static constexpr std::uint64_t SPIN_WINDOW_NS = 200'000;  // 200us
+
+    TscPacer(std::uint64_t first_recorded_ns, double speed) noexcept
+        : first_ns_(first_recorded_ns), speed_(speed) {}
+
+    void start(std::uint64_t start_tsc) noexcept { start_tsc_ = start_tsc; }
+
+    [[nodiscard]] bool unpaced() const noexcept { return speed_ <= 0.0; }
+
+    // TSC at which the record stamped recorded_ns is due
+    [[nodiscard]] std::uint64_t due_tsc(std::uint64_t recorded_ns) const noexcept {
+        if (unpaced() || recorded_ns <= first_ns_) {
+            return start_tsc_;
+        }
+        const auto offset_ns = static_cast<std::uint64_t>(static_cast<double>(recorded_ns - first_ns_) / speed_);
+        return start_tsc_ + ns_to_tsc(offset_ns);
+    }
+
+    // Blocks until due_tsc: sleeps while far away, then spins on the TSC.
+    // Returns the TSC observed on release.
+    static std::uint64_t wait_until(std::uint64_t due) noexcept {
+        std::uint64_t now = rdtsc();
+        const std::uint64_t spin_window = ns_to_tsc(SPIN_WINDOW_NS);
+        while (now < due) {
+            if (due - now > spin_window) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(tsc_to_ns(due - now - spin_window)));
+            }
+            now = rdtsc();
+        }
+        return now;
+    }
+
+private:
+    std::uint64_t first_ns_{0};
+    double speed_{1.0};
+    std::uint64_t start_tsc_{0};
+};
+
+// Log2 histogram of publish lag (actual publish time minus due time), in ns.
+// Single-threaded; no allocations.
+class LagHistogram {
+public:
+    static constexpr std::size_t BUCKETS = 48;
+
+    void record(std::uint64_t lag_ns) noexcept {
+        const auto width = static_cast<std::size_t>(std::bit_width(lag_ns));
+        ++buckets_[width < BUCKETS ? width : BUCKETS - 1];
+        ++count_;
+        sum_ns_ += lag_ns;
+        if (lag_ns > max_ns_) {
+            max_ns_ = lag_ns;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] std::uint64_t max_ns() const noexcept { return max_ns_; }
+    [[nodiscard]] std::uint64_t mean_ns() const noexcept { return count_ == 0 ? 0 : sum_ns_ / count_; }
+
+    // Upper bound of the bucket holding quantile q (0..1)
+    [[nodiscard]] std::uint64_t quantile_upper_ns(double q) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < BUCKETS; ++b) {
+            seen += buckets_[b];
+            if (seen > rank || seen == count_) {
+                return b == 0 ? 0 : (std::uint64_t{1} << b) - 1;
+            }
+        }
+        return max_ns_;
+    }
+
+private:
+    std::array<std::uint64_t, BUCKETS> buckets_{};
+    std::uint64_t count_{0};
+    std::uint64_t sum_ns_{0};
+    std::uint64_t max_ns_{0};
+};
+
+} // namespace util
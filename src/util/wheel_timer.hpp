@@ -3,11 +3,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <array>
+#include <bit>
+#include <limits>
 #include <type_traits>
 
 #include "util/fixed_vec.hpp"
 #include "util/tsc_calibration.hpp"
-#include "core/order_state.hpp"  // For OrderKey
 
 namespace util {
 
@@ -17,12 +18,16 @@ namespace util {
 // - Single-level timing wheel with NUM_BUCKETS slots
 // - Each bucket covers TICK_NS nanoseconds (converted to TSC cycles at runtime)
 // - Total coverage = NUM_BUCKETS * TICK_NS (e.g., 256 * 1ms = 256ms)
-// - Deadlines beyond wheel range are placed in future bucket, re-checked on expiry
+// - Deadlines beyond wheel range hash into the bucket of their deadline tick and
+//   stay there across laps (no rescheduling); they fire on the lap that reaches them
+// - Occupancy bitmap over buckets: polling jumps straight to the next non-empty
+//   bucket with ctz instead of stepping through empty ticks after a stall
 // - All timestamps are in TSC cycles for HFT performance
 //
 // Cancellation:
 // - Uses generation counter pattern (no explicit cancel API)
-// - Caller stores (key, generation) when scheduling
+// - Caller stores (ref, generation) when scheduling; ref is an opaque 32-bit
+//   handle (the reconciler passes OrderState::pool_handle) so entries stay 16 bytes
 // - On expiry, caller checks if generation matches current OrderState.timer_generation
 // - If mismatch, the timer was "cancelled" (generation was incremented)
 //
@@ -38,21 +43,26 @@ public:
     static constexpr std::uint64_t WHEEL_SPAN_NS = NUM_BUCKETS * TICK_NS;  // 256ms total coverage
 
     static_assert((NUM_BUCKETS & (NUM_BUCKETS - 1)) == 0, "NUM_BUCKETS must be power of 2");
+    static_assert(NUM_BUCKETS % 64 == 0, "NUM_BUCKETS must be a multiple of 64 for the occupancy bitmap");
+
+    // Returned by next_deadline_tsc() when no entries are pending
+    static constexpr std::uint64_t NO_DEADLINE = std::numeric_limits<std::uint64_t>::max();
 
     // Entry stored in each bucket
     struct Entry {
-        core::OrderKey key{0};
+        std::uint32_t ref{0};           // Caller's handle for the timed object
         std::uint32_t generation{0};
         std::uint64_t deadline_tsc{0};  // Absolute deadline in TSC cycles
     };
 
     static_assert(std::is_trivially_copyable_v<Entry>, "Entry must be trivially copyable");
+    static_assert(sizeof(Entry) == 16, "Entry should stay at 16 bytes");
 
     // Statistics for monitoring
     struct Stats {
         std::uint64_t scheduled{0};         // Total schedules attempted
         std::uint64_t expired{0};           // Entries expired (callback invoked)
-        std::uint64_t rescheduled{0};       // Far-future entries re-scheduled
+        std::uint64_t rescheduled{0};       // Far-future entries visited early and left for a later lap
         std::uint64_t overflow_dropped{0};  // Entries dropped due to bucket overflow
     };
 
@@ -78,36 +88,39 @@ public:
     // Schedule a deadline for an order.
     //
     // Parameters:
-    //   key          - OrderKey identifying the order
+    //   ref          - Handle identifying the order (OrderState::pool_handle)
     //   generation   - Current timer_generation from OrderState (for lazy cancellation)
     //   deadline_tsc - Absolute timestamp (in TSC cycles) when deadline expires
     //
     // Returns: true if scheduled successfully, false if bucket overflowed
     //
     // Note: Deadlines in the past are placed in the current bucket and will expire
-    // on the next poll_expired() call.
-    [[nodiscard]] bool schedule(core::OrderKey key, std::uint32_t generation,
+    // on the next poll_expired() call. Deadlines beyond the wheel span go to the
+    // bucket of their deadline tick and are skipped over until their lap comes up.
+    [[nodiscard]] bool schedule(std::uint32_t ref, std::uint32_t generation,
                                 std::uint64_t deadline_tsc) noexcept {
         ++stats_.scheduled;
 
         const std::uint64_t deadline_tick = deadline_tsc / tick_tsc_;
-        std::uint64_t delta_ticks = (deadline_tick > current_tick_)
-            ? (deadline_tick - current_tick_)
-            : 0;
-
-        // Clamp to wheel range (entry stores deadline_tsc for re-check)
-        if (delta_ticks >= NUM_BUCKETS) {
-            delta_ticks = NUM_BUCKETS - 1;
-        }
-
-        const std::size_t bucket_idx = (current_tick_ + delta_ticks) & (NUM_BUCKETS - 1);
+        const std::uint64_t target_tick = (deadline_tick > current_tick_) ? deadline_tick : current_tick_;
+        const std::size_t bucket_idx = target_tick & (NUM_BUCKETS - 1);
 
         // Try to add to bucket
-        if (!buckets_[bucket_idx].try_emplace_back(key, generation, deadline_tsc)) {
+        if (!buckets_[bucket_idx].try_emplace_back(ref, generation, deadline_tsc)) {
             ++stats_.overflow_dropped;
             return false;
         }
 
+        mark_occupied(bucket_idx);
+
+        // First tick at which the wheel visits this bucket (may be an earlier lap
+        // than the deadline itself for far-future entries)
+        const std::uint64_t visit_tick =
+            current_tick_ + ((target_tick - current_tick_) & (NUM_BUCKETS - 1));
+        if (visit_tick < next_tick_) {
+            next_tick_ = visit_tick;
+        }
+
         return true;
     }
 
@@ -115,59 +128,79 @@ public:
     //
     // Parameters:
     //   now_tsc    - Current timestamp (in TSC cycles)
-    //   on_expired - Callback invoked as on_expired(OrderKey key, uint32_t generation)
+    //   on_expired - Callback invoked as on_expired(uint32_t ref, uint32_t generation)
     //                Caller MUST check generation against OrderState.timer_generation
     //                to detect if timer was cancelled (generation mismatch = skip)
     //
-    // Complexity: O(number of expired entries), NOT O(total scheduled)
+    // Complexity: O(occupied buckets in [current_tick, now_tick) + entries in them).
+    // Empty ticks are skipped via the occupancy bitmap, and each bucket is visited at
+    // most once per poll, so a stall of any length costs at most one wheel lap.
     template <typename F>
     void poll_expired(std::uint64_t now_tsc, F&& on_expired) noexcept {
         const std::uint64_t now_tick = now_tsc / tick_tsc_;
 
-        // Process all ticks from last poll to now
-        while (current_tick_ < now_tick) {
-            const std::size_t bucket_idx = current_tick_ & (NUM_BUCKETS - 1);
-            auto& bucket = buckets_[bucket_idx];
-
-            // Process entries - some may need re-scheduling (far-future)
-            for (std::size_t i = 0; i < bucket.size(); ) {
-                const auto& entry = bucket[i];
-
-                if (entry.deadline_tsc <= now_tsc) {
-                    // Deadline reached - invoke callback
-                    on_expired(entry.key, entry.generation);
-                    ++stats_.expired;
-                    bucket.swap_erase(i);
-                    // Don't increment i - new entry now at position i
-                } else {
-                    // Far-future entry not yet due - re-schedule
-                    const auto key = entry.key;
-                    const auto gen = entry.generation;
-                    const auto deadline = entry.deadline_tsc;
-                    bucket.swap_erase(i);
-
-                    // Re-schedule (may fail if target bucket full)
-                    if (schedule(key, gen, deadline)) {
+        if (now_tick > current_tick_) {
+            const std::uint64_t start_tick = current_tick_;
+            const std::uint64_t span = (now_tick - start_tick < NUM_BUCKETS)
+                ? (now_tick - start_tick)
+                : NUM_BUCKETS;
+
+            std::uint64_t offset = next_occupied_distance(start_tick & (NUM_BUCKETS - 1));
+            while (offset < span) {
+                // Keep current_tick_ on the bucket being processed so callbacks that
+                // schedule past deadlines land in this bucket and fire in this pass
+                current_tick_ = start_tick + offset;
+                const std::size_t bucket_idx = current_tick_ & (NUM_BUCKETS - 1);
+                auto& bucket = buckets_[bucket_idx];
+
+                for (std::size_t i = 0; i < bucket.size(); ) {
+                    const auto& entry = bucket[i];
+
+                    if (entry.deadline_tsc <= now_tsc) {
+                        // Deadline reached - invoke callback
+                        on_expired(entry.ref, entry.generation);
+                        ++stats_.expired;
+                        bucket.swap_erase(i);
+                        // Don't increment i - new entry now at position i
+                    } else {
+                        // Far-future entry belongs to a later lap - leave it in place
                         ++stats_.rescheduled;
+                        ++i;
                     }
-                    // Always decrement scheduled to avoid double-counting, even if reschedule failed
-                    --stats_.scheduled;
-                    // Don't increment i
                 }
+
+                if (bucket.empty()) {
+                    clear_occupied(bucket_idx);
+                }
+
+                ++offset;
+                offset += next_occupied_distance((start_tick + offset) & (NUM_BUCKETS - 1));
             }
 
-            ++current_tick_;
+            current_tick_ = now_tick;
+            refresh_next_tick();
         }
 
         last_poll_tsc_ = now_tsc;
     }
 
+    // Lower bound (tick granularity) on the earliest TSC at which poll_expired() can
+    // fire a callback. Returns NO_DEADLINE when nothing is pending. Callers can skip
+    // polling entirely while now_tsc < next_deadline_tsc().
+    [[nodiscard]] std::uint64_t next_deadline_tsc() const noexcept {
+        if (next_tick_ == NO_DEADLINE) {
+            return NO_DEADLINE;
+        }
+        return (next_tick_ + 1) * tick_tsc_;
+    }
+
     // Advance the wheel without processing expirations.
     // Use poll_expired() in normal operation; this is for testing/edge cases.
     void advance(std::uint64_t now_tsc) noexcept {
         const std::uint64_t now_tick = now_tsc / tick_tsc_;
         if (now_tick > current_tick_) {
             current_tick_ = now_tick;
+            refresh_next_tick();
         }
         last_poll_tsc_ = now_tsc;
     }
@@ -177,6 +210,8 @@ public:
         for (auto& bucket : buckets_) {
             bucket.clear();
         }
+        occupancy_.fill(0);
+        next_tick_ = NO_DEADLINE;
         current_tick_ = start_tsc / tick_tsc_;
         last_poll_tsc_ = start_tsc;
         stats_ = Stats{};
@@ -200,8 +235,50 @@ public:
 private:
     using Bucket = FixedCapacityVec<Entry, BUCKET_CAPACITY>;
 
+    static constexpr std::size_t OCCUPANCY_WORDS = NUM_BUCKETS / 64;
+
+    void mark_occupied(std::size_t bucket_idx) noexcept {
+        occupancy_[bucket_idx >> 6] |= (1ULL << (bucket_idx & 63));
+    }
+
+    void clear_occupied(std::size_t bucket_idx) noexcept {
+        occupancy_[bucket_idx >> 6] &= ~(1ULL << (bucket_idx & 63));
+    }
+
+    // Distance (in buckets, ring order) from from_idx to the first occupied bucket,
+    // including from_idx itself. Returns NUM_BUCKETS if every bucket is empty.
+    [[nodiscard]] std::size_t next_occupied_distance(std::size_t from_idx) const noexcept {
+        std::size_t word_idx = from_idx >> 6;
+        const unsigned bit = static_cast<unsigned>(from_idx & 63);
+
+        const std::uint64_t first = occupancy_[word_idx] >> bit;
+        if (first != 0) {
+            return static_cast<std::size_t>(std::countr_zero(first));
+        }
+
+        // Remaining words in ring order; the last one revisits the low bits of the
+        // starting word (bits below from_idx)
+        std::size_t distance = 64 - bit;
+        for (std::size_t n = 0; n < OCCUPANCY_WORDS; ++n) {
+            word_idx = (word_idx + 1) & (OCCUPANCY_WORDS - 1);
+            const std::uint64_t word = occupancy_[word_idx];
+            if (word != 0) {
+                return distance + static_cast<std::size_t>(std::countr_zero(word));
+            }
+            distance += 64;
+        }
+        return NUM_BUCKETS;
+    }
+
+    void refresh_next_tick() noexcept {
+        const std::size_t distance = next_occupied_distance(current_tick_ & (NUM_BUCKETS - 1));
+        next_tick_ = (distance < NUM_BUCKETS) ? current_tick_ + distance : NO_DEADLINE;
+    }
+
     std::uint64_t tick_tsc_{1};  // TSC cycles per tick (converted from TICK_NS at construction)
     std::array<Bucket, NUM_BUCKETS> buckets_{};
+    std::array<std::uint64_t, OCCUPANCY_WORDS> occupancy_{};  // Bit per non-empty bucket
+    std::uint64_t next_tick_{NO_DEADLINE};  // Earliest tick with an occupied bucket
     std::uint64_t current_tick_{0};
     std::uint64_t last_poll_tsc_{0};
     Stats stats_{};
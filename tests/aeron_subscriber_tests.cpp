@@ -13,6 +13,7 @@
 #include <concurrent/logbuffer/Header.h>
 
 #include "core/exec_event.hpp"
+#include "core/wire_codec.hpp"
 #include "core/wire_exec_event.hpp"
 #include "ingest/aeron_client_view.hpp"
 #include "ingest/aeron_subscriber.hpp"
@@ -99,9 +100,8 @@ TEST_F(AeronSubscriberTest, SubscriberDeliversFragment) {
     ingest::ThreadStats stats;
     std::atomic<bool> stop{false};
 
-    std::vector<std::uint8_t> payload(sizeof(core::WireExecEvent));
-    const auto wire = make_wire();
-    std::memcpy(payload.data(), &wire, sizeof(wire));
+    std::vector<std::uint8_t> payload(core::ExecEventEncoder::MESSAGE_LENGTH);
+    core::ExecEventEncoder::encode(payload.data(), core::from_wire(make_wire(), core::Source::Primary, 0));
 
     auto stub_sub = std::make_shared<StubSubscription>(std::vector{StubSubscription::Fragment{std::move(payload)}});
     auto client = std::make_shared<StubAeronClient>(stub_sub, 1);
@@ -112,7 +112,7 @@ TEST_F(AeronSubscriberTest, SubscriberDeliversFragment) {
     ThreadJoiner joiner{t};
 
     const auto deadline = std::chrono::steady_clock::now() + kMaxWait;
-    while (stats.produced == 0 && std::chrono::steady_clock::now() < deadline) {
+    while (stats.produced.load() == 0 && std::chrono::steady_clock::now() < deadline) {
         std::this_thread::sleep_for(kWaitInterval);
     }
 
@@ -122,7 +122,7 @@ TEST_F(AeronSubscriberTest, SubscriberDeliversFragment) {
 
     core::ExecEvent evt{};
     ASSERT_TRUE(ring->try_pop(evt));
-    EXPECT_EQ(stats.produced, 1);
+    EXPECT_EQ(stats.produced.load(), 1u);
     EXPECT_EQ(std::string_view(evt.exec_id, evt.exec_id_len), "EX1");
 }
 
@@ -141,14 +141,14 @@ TEST_F(AeronSubscriberTest, SubscriberCountsParseFailure) {
     ThreadJoiner joiner{t};
 
     const auto deadline = std::chrono::steady_clock::now() + kMaxWait;
-    while (stats.parse_failures == 0 && std::chrono::steady_clock::now() < deadline) {
+    while (stats.parse_failures.load() == 0 && std::chrono::steady_clock::now() < deadline) {
         std::this_thread::sleep_for(kWaitInterval);
     }
 
     stop.store(true, std::memory_order_release);
 
     ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "Timed out waiting for parse failure";
-    EXPECT_EQ(stats.parse_failures, 1);
+    EXPECT_EQ(stats.parse_failures.load(), 1u);
     EXPECT_EQ(ring->size_approx(), 0u);
 }
 
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ingest/spsc_ring.hpp"
+#include "util/agent_runtime.hpp"
+#include "util/async_file.hpp"
+#include "util/async_log.hpp"
+#include "util/rdtsc.hpp"
+
+namespace {
+
+util::Agent tagger(std::vector<int>& out, int tag, int steps) {
+    for (int i = 0; i < steps; ++i) {
+        out.push_back(tag);
+        co_await util::yield_now();
+    }
+}
+
+util::Agent sleeper(std::vector<int>& out, std::uint64_t ns) {
+    out.push_back(0);
+    co_await util::sleep_for(ns);
+    out.push_back(1);
+}
+
+util::Agent waiter(const bool& flag, std::uint64_t timeout_ns, std::vector<bool>& results) {
+    results.push_back(co_await util::until([&flag] { return flag; }, timeout_ns));
+    results.push_back(co_await util::until([&flag] { return flag; }, timeout_ns));
+}
+
+template <typename Ring>
+util::Agent ring_reader(Ring& ring, std::vector<int>& out, int count) {
+    int v = 0;
+    while (static_cast<int>(out.size()) < count) {
+        co_await util::readable(ring);
+        while (ring.try_pop(v)) {
+            out.push_back(v);
+        }
+    }
+}
+
+} // namespace
+
+// AgentRuntime_YieldInterleavesInSpawnOrder - Each pass resumes runnable agents once, in spawn order
+TEST(AgentRuntimeTest, YieldInterleavesInSpawnOrder) {
+    util::AgentRuntime runtime;
+    std::vector<int> out;
+    ASSERT_TRUE(runtime.spawn(tagger(out, 1, 3)));
+    ASSERT_TRUE(runtime.spawn(tagger(out, 2, 1)));
+    EXPECT_EQ(runtime.agent_count(), 2u);
+    EXPECT_TRUE(out.empty());  // Agents start suspended
+
+    EXPECT_EQ(runtime.run_once(1), 2u);
+    EXPECT_EQ(runtime.run_once(2), 2u);  // Agent 2 finishes and is destroyed
+    EXPECT_EQ(runtime.agent_count(), 1u);
+    EXPECT_EQ(runtime.run_once(3), 1u);
+    EXPECT_EQ(runtime.run_once(4), 1u);
+    EXPECT_EQ(runtime.agent_count(), 0u);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 1, 1}));
+    EXPECT_EQ(runtime.resumes(), 6u);
+}
+
+// AgentRuntime_SleepWakesAtDeadline - A sleeping agent is skipped until its deadline and reported as next wake
+TEST(AgentRuntimeTest, SleepWakesAtDeadline) {
+    util::AgentRuntime runtime;
+    std::vector<int> out;
+    const std::uint64_t t0 = 1'000'000;
+    const std::uint64_t span = util::ns_to_tsc(1'000'000);
+    ASSERT_TRUE(runtime.spawn(sleeper(out, 1'000'000)));
+
+    EXPECT_EQ(runtime.run_once(t0), 1u);
+    EXPECT_EQ(runtime.next_wake_tsc(), t0 + span);
+    EXPECT_EQ(runtime.run_once(t0 + span - 1), 0u);
+    EXPECT_EQ(out, (std::vector<int>{0}));
+    EXPECT_EQ(runtime.run_once(t0 + span), 1u);
+    EXPECT_EQ(out, (std::vector<int>{0, 1}));
+    EXPECT_EQ(runtime.agent_count(), 0u);
+}
+
+// AgentRuntime_UntilReportsTimeout - until() resumes on its predicate or its timeout and says which
+TEST(AgentRuntimeTest, UntilReportsTimeout) {
+    util::AgentRuntime runtime;
+    bool flag = false;
+    std::vector<bool> results;
+    const std::uint64_t span = util::ns_to_tsc(1'000);
+    ASSERT_TRUE(runtime.spawn(waiter(flag, 1'000, results)));
+
+    EXPECT_EQ(runtime.run_once(100), 1u);
+    EXPECT_EQ(runtime.run_once(100 + span - 1), 0u);
+    EXPECT_EQ(runtime.run_once(100 + span), 1u);  // Timed out
+    ASSERT_EQ(results, (std::vector<bool>{false}));
+
+    EXPECT_EQ(runtime.run_once(101 + span), 0u);
+    flag = true;
+    EXPECT_EQ(runtime.run_once(102 + span), 1u);
+    EXPECT_EQ(results, (std::vector<bool>{false, true}));
+    EXPECT_EQ(runtime.agent_count(), 0u);
+}
+
+// AgentRuntime_ReadableWaitsForRing - An agent parked on readable() runs only once the ring has data
+TEST(AgentRuntimeTest, ReadableWaitsForRing) {
+    ingest::SpscRing<int, 16> ring;
+    util::AgentRuntime runtime;
+    std::vector<int> out;
+    ASSERT_TRUE(runtime.spawn(ring_reader(ring, out, 3)));
+
+    EXPECT_EQ(runtime.run_once(1), 1u);
+    EXPECT_EQ(runtime.run_once(2), 0u);
+    ASSERT_TRUE(ring.try_push(7));
+    ASSERT_TRUE(ring.try_push(8));
+    EXPECT_EQ(runtime.run_once(3), 1u);
+    EXPECT_EQ(runtime.run_once(4), 0u);
+    ASSERT_TRUE(ring.try_push(9));
+    EXPECT_EQ(runtime.run_once(5), 1u);
+    EXPECT_EQ(out, (std::vector<int>{7, 8, 9}));
+    EXPECT_EQ(runtime.agent_count(), 0u);
+}
+
+// AgentRuntime_IoCompleteResumesAfterWrite - io_complete() resumes once a submitted write lands
+TEST(AgentRuntimeTest, IoCompleteResumesAfterWrite) {
+    const auto path = std::filesystem::temp_directory_path() / "agent_runtime_io.bin";
+    util::AsyncFileWriter writer;
+    ASSERT_TRUE(writer.open(path.string(), util::AsyncFileWriter::Config{}));
+
+    bool done = false;
+    auto agent = [](util::AsyncFileWriter& w, bool& finished) -> util::Agent {
+        util::AsyncFileWriter::Buffer* buf = w.acquire();
+        std::memcpy(buf->data, "agent", 5);
+        buf->size = 5;
+        w.submit(buf);
+        w.flush();
+        co_await util::io_complete(w);
+        finished = true;
+    };
+    util::AgentRuntime runtime;
+    ASSERT_TRUE(runtime.spawn(agent(writer, done)));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (runtime.agent_count() != 0 && std::chrono::steady_clock::now() < deadline) {
+        (void)runtime.run_once(util::rdtsc());
+    }
+    EXPECT_TRUE(done);
+    EXPECT_EQ(writer.in_flight(), 0u);
+    EXPECT_EQ(writer.offset(), 5u);
+    writer.close();
+}
+
+// AgentRuntime_LogConsumerAgentDrainsLogger - The hot logger runs without its own thread on a runtime
+TEST(AgentRuntimeTest, LogConsumerAgentDrainsLogger) {
+    const auto path = std::filesystem::temp_directory_path() / "agent_runtime_logger.log";
+    util::AsyncLogger logger;
+    util::AsyncLogger::Config cfg{};
+    cfg.capacity_pow2 = 1u << 12;
+    cfg.file_path = path.string();
+    cfg.flush_every = 64;
+    cfg.external_consumer = true;
+    ASSERT_TRUE(logger.start(cfg));
+
+    util::AgentRuntime runtime;
+    ASSERT_TRUE(runtime.spawn(util::log_consumer_agent(logger)));
+    ASSERT_TRUE(runtime.start());
+
+    constexpr int records = 1000;
+    for (int i = 0; i < records; ++i) {
+        while (!logger.try_logf(util::LogLevel::Info, "AGENT", "record-%04d", i)) {
+            std::this_thread::yield();
+        }
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (logger.written() < records / 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(logger.written(), static_cast<std::uint64_t>(records / 2));  // The agent, not stop(), drained these
+
+    runtime.stop();
+    logger.stop();  // Writes out whatever the agent left
+    EXPECT_EQ(logger.written(), static_cast<std::uint64_t>(records));
+
+    std::ifstream in(path);
+    int lines = 0;
+    for (std::string line; std::getline(in, line);) {
+        char tag[16];
+        std::snprintf(tag, sizeof(tag), "record-%04d", lines);
+        ASSERT_NE(line.find(tag), std::string::npos) << line;
+        ++lines;
+    }
+    EXPECT_EQ(lines, records);
+}
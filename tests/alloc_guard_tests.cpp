@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "core/order_state_store.hpp"
+#include "core/reconciler.hpp"
+#include "ingest/fix_parser.hpp"
+#include "ingest/spsc_ring.hpp"
+#include "util/alloc_guard.hpp"
+#include "util/arena.hpp"
+#include "util/async_log.hpp"
+#include "util/soh.hpp"
+#include "util/wheel_timer.hpp"
+
+namespace {
+
+using ExecRing = ingest::SpscRing<core::ExecEvent, 1u << 16>;
+
+// Called through a volatile pointer so the compiler cannot elide the allocation
+void* (*volatile raw_malloc)(std::size_t) = std::malloc;
+
+class AllocGuardTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!util::AllocGuard::enabled) {
+            GTEST_SKIP() << "Built without FX_ALLOC_GUARD";
+        }
+        util::AllocGuard::reset_counters();
+    }
+
+    static core::ExecEvent make_event(core::Source src, std::uint64_t seq, std::uint64_t ts,
+                                      const char* clord_id) {
+        core::ExecEvent ev{};
+        ev.source = src;
+        ev.seq_num = seq;
+        ev.exec_type = core::ExecType::Fill;
+        ev.ord_status = core::OrdStatus::Filled;
+        ev.cum_qty = 100;
+        ev.qty = 100;
+        ev.price_micro = 1'000'000;
+        ev.transact_time = ts;
+        ev.ingest_tsc = ts;
+        ev.set_clord_id(clord_id, std::strlen(clord_id));
+        ev.set_exec_id("EXEC1", 5);
+        return ev;
+    }
+};
+
+// CountsAllocationsInsideHotPhase - malloc on a hot thread is counted
+TEST_F(AllocGuardTest, CountsAllocationsInsideHotPhase) {
+    {
+        util::ScopedHotPhase hot_phase;
+        EXPECT_TRUE(util::AllocGuard::in_hot_phase());
+        void* p = raw_malloc(64);
+        std::free(p);
+    }
+    EXPECT_FALSE(util::AllocGuard::in_hot_phase());
+    EXPECT_EQ(util::AllocGuard::thread_hot_allocations(), 1u);
+    EXPECT_EQ(util::AllocGuard::total_hot_allocations(), 1u);
+    EXPECT_GE(util::AllocGuard::total_hot_bytes(), 64u);
+}
+
+// IgnoresAllocationsOutsideHotPhase - startup allocations are not counted
+TEST_F(AllocGuardTest, IgnoresAllocationsOutsideHotPhase) {
+    void* p = raw_malloc(64);
+    std::free(p);
+    auto s = std::make_unique<std::string>(256, 'x');
+    EXPECT_EQ(s->size(), 256u);
+    EXPECT_EQ(util::AllocGuard::total_hot_allocations(), 0u);
+}
+
+// ReconcilerProcessEventDoesNotAllocate - store upsert, wheel scheduling and divergence output stay off the heap
+TEST_F(AllocGuardTest, ReconcilerProcessEventDoesNotAllocate) {
+    std::atomic<bool> stop_flag{false};
+    auto primary_ring = std::make_unique<ExecRing>();
+    auto dropcopy_ring = std::make_unique<ExecRing>();
+    auto divergence_ring = std::make_unique<core::DivergenceRing>();
+    auto seq_gap_ring = std::make_unique<core::SequenceGapRing>();
+    util::Arena arena{1u << 24};
+    core::OrderStateStore store{arena, 4096};
+    core::ReconCounters counters{};
+    auto wheel = std::make_unique<util::WheelTimer>(0);
+    core::Reconciler recon(stop_flag, *primary_ring, *dropcopy_ring, store, counters,
+                           *divergence_ring, *seq_gap_ring, wheel.get(), core::ReconConfig{});
+
+    char clord[16];
+    {
+        util::ScopedHotPhase hot_phase;
+        for (std::uint64_t i = 1; i <= 1000; ++i) {
+            std::snprintf(clord, sizeof(clord), "CID%llu", static_cast<unsigned long long>(i));
+            recon.process_event_for_test(make_event(core::Source::Primary, i, i * 1000, clord));
+            // Skip a sequence number every 100 events to exercise the gap path
+            const std::uint64_t dc_seq = i + i / 100;
+            recon.process_event_for_test(make_event(core::Source::DropCopy, dc_seq, i * 1000 + 1, clord));
+        }
+        recon.poll_timers(util::ns_to_tsc(10'000'000'000ULL));
+    }
+
+    EXPECT_EQ(counters.internal_events, 1000u);
+    EXPECT_EQ(util::AllocGuard::thread_hot_allocations(), 0u);
+}
+
+// FixParserAndRingDoNotAllocate - ingest-side parse and ring handoff stay off the heap
+TEST_F(AllocGuardTest, FixParserAndRingDoNotAllocate) {
+    auto ring = std::make_unique<ExecRing>();
+    const std::string msg = util::pipe_to_soh(
+        "8=FIX.4.4|35=8|150=2|39=2|17=EXEC1|11=CID1|37=OID1|31=1000000|32=100|14=100|52=1|60=1|");
+    core::ExecEvent evt{};
+    {
+        util::ScopedHotPhase hot_phase;
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(ingest::parse_exec_report(msg.data(), msg.size(), evt), ingest::ParseResult::Ok);
+            ASSERT_TRUE(ring->try_push(evt));
+            ASSERT_TRUE(ring->try_pop(evt));
+        }
+    }
+    EXPECT_EQ(util::AllocGuard::thread_hot_allocations(), 0u);
+}
+
+// AsyncLoggerProducerDoesNotAllocate - try_logf from a hot thread stays off the heap
+TEST_F(AllocGuardTest, AsyncLoggerProducerDoesNotAllocate) {
+    util::AsyncLogger logger;
+    util::AsyncLogger::Config cfg{};
+    cfg.capacity_pow2 = 1u << 10;
+    cfg.file_path = (std::filesystem::temp_directory_path() / "alloc_guard_logger.log").string();
+    cfg.consumer_sleep_ns = 1'000;
+    ASSERT_TRUE(logger.start(cfg));
+    {
+        util::ScopedHotPhase hot_phase;
+        for (int i = 0; i < 100; ++i) {
+            (void)logger.try_logf(util::LogLevel::Warn, "TEST", "hot-%d key=%llu", i, 42ULL);
+        }
+    }
+    logger.stop();
+    EXPECT_EQ(util::AllocGuard::thread_hot_allocations(), 0u);
+}
+
+} // namespace
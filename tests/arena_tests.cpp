@@ -49,4 +49,14 @@ TEST_F(ArenaTest, ResetReuse) {
     EXPECT_EQ(after_reset, first);
 }
 
+TEST(ArenaForOverwriteTest, ExposesBackingStore) {
+    util::Arena arena(4096, util::Arena::for_overwrite);
+    ASSERT_NE(arena.data(), nullptr);
+    EXPECT_EQ(arena.capacity_bytes(), 4096u);
+    void* p = arena.allocate(64, 64);
+    ASSERT_NE(p, nullptr);
+    EXPECT_GE(static_cast<std::byte*>(p), arena.data());
+    EXPECT_EQ(util::Arena(0, util::Arena::for_overwrite).data(), nullptr);
+}
+
 } // namespace
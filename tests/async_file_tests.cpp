@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "util/async_file.hpp"
+
+namespace {
+
+std::filesystem::path temp_path(const std::string& name) { return std::filesystem::temp_directory_path() / name; }
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Writes count buffers of fill bytes ('a', 'b', ...) and returns the expected contents
+std::string write_pattern(util::AsyncFileWriter& writer, std::size_t count, std::size_t fill) {
+    std::string expected;
+    for (std::size_t i = 0; i < count; ++i) {
+        util::AsyncFileWriter::Buffer* buf = writer.acquire();
+        while (!buf) {
+            (void)writer.reap(true);
+            buf = writer.acquire();
+        }
+        const char c = static_cast<char>('a' + i % 26);
+        std::memset(buf->data, c, fill);
+        buf->size = fill;
+        expected.append(fill, c);
+        writer.submit(buf);
+        if (i % 3 == 2) {
+            writer.flush();
+        }
+    }
+    writer.drain();
+    return expected;
+}
+
+} // namespace
+
+// AsyncFileWriter_ThreadPoolWritesInOrder - Buffers land at their submit offsets with pwrite workers
+TEST(AsyncFileWriterTest, ThreadPoolWritesInOrder) {
+    const auto path = temp_path("async_file_pool.bin");
+    util::AsyncFileWriter writer;
+    util::AsyncFileWriter::Config cfg{};
+    cfg.buffer_bytes = 5000;  // Rounded up to 8 KiB
+    cfg.buffer_count = 3;
+    cfg.backend = util::FileIoBackend::ThreadPool;
+    cfg.pool_threads = 2;
+    ASSERT_TRUE(writer.open(path.string(), cfg));
+    EXPECT_EQ(writer.backend(), util::FileIoBackend::ThreadPool);
+
+    const std::string expected = write_pattern(writer, 20, 3000);
+    EXPECT_EQ(writer.in_flight(), 0u);
+    EXPECT_EQ(writer.stats().writes, 20u);
+    EXPECT_EQ(writer.stats().bytes, expected.size());
+    EXPECT_EQ(writer.stats().errors, 0u);
+    EXPECT_LT(writer.stats().batches, 20u);  // Several writes per hand-off
+    writer.close();
+    EXPECT_EQ(read_file(path), expected);
+}
+
+// AsyncFileWriter_IoUringWritesInOrder - Same through io_uring, where the kernel allows it
+TEST(AsyncFileWriterTest, IoUringWritesInOrder) {
+    const auto path = temp_path("async_file_uring.bin");
+    util::AsyncFileWriter writer;
+    util::AsyncFileWriter::Config cfg{};
+    cfg.buffer_bytes = 4096;
+    cfg.buffer_count = 4;
+    cfg.backend = util::FileIoBackend::IoUring;
+    if (!writer.open(path.string(), cfg)) {
+        GTEST_SKIP() << "io_uring unavailable";
+    }
+    EXPECT_EQ(writer.backend(), util::FileIoBackend::IoUring);
+
+    const std::string expected = write_pattern(writer, 50, 4096);
+    EXPECT_EQ(writer.stats().writes, 50u);
+    EXPECT_EQ(writer.stats().errors, 0u);
+    writer.close();
+    EXPECT_EQ(read_file(path), expected);
+}
+
+// AsyncFileWriter_BuffersRecycleOnCompletion - acquire() fails only while every buffer is in flight
+TEST(AsyncFileWriterTest, BuffersRecycleOnCompletion) {
+    const auto path = temp_path("async_file_recycle.bin");
+    util::AsyncFileWriter writer;
+    util::AsyncFileWriter::Config cfg{};
+    cfg.buffer_bytes = 4096;
+    cfg.buffer_count = 2;
+    ASSERT_TRUE(writer.open(path.string(), cfg));
+    EXPECT_NE(writer.backend(), util::FileIoBackend::Auto);
+
+    util::AsyncFileWriter::Buffer* a = writer.acquire();
+    util::AsyncFileWriter::Buffer* b = writer.acquire();
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(writer.acquire(), nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a->data) % util::AsyncFileWriter::BUFFER_ALIGN, 0u);
+
+    writer.submit(b);  // Empty: straight back to the free list
+    EXPECT_EQ(writer.in_flight(), 0u);
+    std::memcpy(a->data, "hello\n", 6);
+    a->size = 6;
+    writer.submit(a);
+    EXPECT_EQ(writer.in_flight(), 1u);
+    ASSERT_NE(writer.acquire(), nullptr);
+    EXPECT_EQ(writer.acquire(), nullptr);
+
+    while (writer.in_flight() != 0) {
+        (void)writer.reap(true);
+    }
+    EXPECT_NE(writer.acquire(), nullptr);
+    writer.close();
+    EXPECT_EQ(read_file(path), "hello\n");
+}
+
+// AsyncFileWriter_DirectKeepsUnalignedTail - O_DIRECT full buffers plus a buffered partial tail
+TEST(AsyncFileWriterTest, DirectKeepsUnalignedTail) {
+    const auto path = temp_path("async_file_direct.bin");
+    util::AsyncFileWriter writer;
+    util::AsyncFileWriter::Config cfg{};
+    cfg.buffer_bytes = 4096;
+    cfg.buffer_count = 4;
+    cfg.direct = true;
+    ASSERT_TRUE(writer.open(path.string(), cfg));
+
+    std::string expected = write_pattern(writer, 3, 4096);
+    expected += write_pattern(writer, 1, 100);
+    expected += write_pattern(writer, 1, 4096);  // Unaligned offset: buffered
+    EXPECT_EQ(writer.stats().errors, 0u);
+    EXPECT_EQ(writer.offset(), expected.size());
+    writer.close();
+    EXPECT_EQ(read_file(path), expected);
+}
+
+// AsyncFileWriter_AppendKeepsContents - Without truncate, writes continue after the existing file
+TEST(AsyncFileWriterTest, AppendKeepsContents) {
+    const auto path = temp_path("async_file_append.bin");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "head:";
+    }
+    util::AsyncFileWriter writer;
+    util::AsyncFileWriter::Config cfg{};
+    cfg.truncate = false;
+    ASSERT_TRUE(writer.open(path.string(), cfg));
+    EXPECT_EQ(writer.offset(), 5u);
+    const std::string tail = write_pattern(writer, 2, 10);
+    writer.close();
+    EXPECT_EQ(read_file(path), "head:" + tail);
+
+    util::AsyncFileWriter::Config bad{};
+    bad.buffer_count = 0;
+    EXPECT_FALSE(writer.open(path.string(), bad));
+}
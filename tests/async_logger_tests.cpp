@@ -1,6 +1,7 @@
 #include <filesystem>
 #include <fstream>
 #include <atomic>
+#include <cstdio>
 #include <thread>
 #include <vector>
 
@@ -90,7 +91,7 @@ TEST(AsyncLoggerTests, ThreadSafetyMultiProducer) {
     std::vector<std::thread> threads;
     threads.reserve(producers);
     for (int p = 0; p < producers; ++p) {
-        threads.emplace_back([&] {
+        threads.emplace_back([&, p] {
             for (int i = 0; i < per_thread; ++i) {
                 logger.try_logf(LogLevel::Debug, "MP", "p%d-%d", p, i);
                 sent.fetch_add(1, std::memory_order_relaxed);
@@ -137,3 +138,102 @@ TEST(AsyncLoggerTests, StableEncoding) {
     EXPECT_NE(line.find("a1=2"), std::string::npos);
 }
 
+
+// AsyncLogger_FileSinkSurvivesBufferPressure - Small I/O buffers force waits; every record lands, in order
+TEST(AsyncLoggerTests, FileSinkSurvivesBufferPressure) {
+    for (const util::FileIoBackend backend : {util::FileIoBackend::Auto, util::FileIoBackend::ThreadPool}) {
+        auto path = make_temp_log_path("async_logger_io_pressure.log");
+        AsyncLogger logger;
+        auto cfg = base_config(path);
+        cfg.capacity_pow2 = 1u << 12;
+        cfg.flush_every = 64;
+        cfg.io_buffer_bytes = 4096;
+        cfg.io_buffers = 2;
+        cfg.io_backend = backend;
+        ASSERT_TRUE(logger.start(cfg));
+        EXPECT_NE(logger.io_backend(), util::FileIoBackend::Auto);
+
+        constexpr int records = 2000;
+        for (int i = 0; i < records; ++i) {
+            while (!logger.try_logf(LogLevel::Info, "IO", "record-%05d", i)) {
+                std::this_thread::yield();
+            }
+        }
+        logger.stop();
+        EXPECT_EQ(logger.io_errors(), 0u);
+
+        std::ifstream in(path);
+        std::string line;
+        int expected = 0;
+        while (std::getline(in, line)) {
+            char tag[16];
+            std::snprintf(tag, sizeof(tag), "record-%05d", expected);
+            ASSERT_NE(line.find(tag), std::string::npos) << line;
+            ++expected;
+        }
+        EXPECT_EQ(expected, records);
+    }
+}
+
+// AsyncLogger_RateLimiterReportsSuppressed - A burst passes, the rest are counted and handed to the next allowed line
+TEST(AsyncLoggerTests, RateLimiterReportsSuppressed) {
+    util::LogRateLimiter limiter(10, 3);  // One line per 100 ms, bursts of 3
+    const std::uint64_t interval = util::ns_to_tsc(100'000'000);
+    const std::uint64_t t0 = interval * 100;
+    std::uint64_t suppressed = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(limiter.allow(t0, suppressed)) << i;
+        EXPECT_EQ(suppressed, 0u);
+    }
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_FALSE(limiter.allow(t0 + interval / 2, suppressed));
+    }
+    EXPECT_EQ(limiter.pending_suppressed(), 500u);
+
+    // One interval later a single token is back
+    ASSERT_TRUE(limiter.allow(t0 + interval, suppressed));
+    EXPECT_EQ(suppressed, 500u);
+    EXPECT_FALSE(limiter.allow(t0 + interval, suppressed));
+    EXPECT_EQ(limiter.pending_suppressed(), 1u);
+
+    // After a long quiet spell the full burst is available again
+    const std::uint64_t later = t0 + interval * 50;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(limiter.allow(later, suppressed)) << i;
+        EXPECT_EQ(suppressed, i == 0 ? 1u : 0u);
+    }
+    EXPECT_FALSE(limiter.allow(later, suppressed));
+}
+
+// AsyncLogger_SuppressedSuffixAlwaysFits - The "...and N more" suffix is appended, truncating long messages
+TEST(AsyncLoggerTests, SuppressedSuffixAlwaysFits) {
+    auto path = make_temp_log_path("async_logger_suppressed.log");
+    AsyncLogger logger;
+    ASSERT_TRUE(logger.start(base_config(path)));
+
+    const std::string long_text(400, 'x');
+    EXPECT_TRUE(logger.try_logf_suppressed(LogLevel::Warn, "RL", 0, "plain-%d", 1));
+    EXPECT_TRUE(logger.try_logf_suppressed(LogLevel::Warn, "RL", 48211, "ring_drop key=%d", 7));
+    EXPECT_TRUE(logger.try_logf_suppressed(LogLevel::Warn, "RL", 5, "%s", long_text.c_str()));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (logger.written() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    logger.stop();
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_NE(lines[0].find("plain-1"), std::string::npos);
+    EXPECT_EQ(lines[0].find("more"), std::string::npos);
+    EXPECT_NE(lines[1].find("ring_drop key=7 ...and 48211 more"), std::string::npos) << lines[1];
+    const std::string suffix = " ...and 5 more";
+    ASSERT_GE(lines[2].size(), suffix.size());
+    EXPECT_EQ(lines[2].substr(lines[2].size() - suffix.size()), suffix);
+    EXPECT_EQ(lines[2].size() - lines[2].find('x'), sizeof(util::LogRecord::message));
+}
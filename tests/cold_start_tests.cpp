@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "util/cold_start.hpp"
+#include "util/tsc_calibration.hpp"
+
+// ColdStart_PrefaultKeepsContents - Pre-faulting covers every page across regions and leaves data untouched
+TEST(ColdStartTest, PrefaultKeepsContents) {
+    constexpr std::size_t big = util::PREFAULT_CHUNK_BYTES * 3 + 12'345;  // Several chunks plus a tail
+    auto a = std::make_unique_for_overwrite<std::uint8_t[]>(big);
+    std::vector<std::uint8_t> b(1000);
+    for (std::size_t i = 0; i < big; i += 4093) {
+        a[i] = static_cast<std::uint8_t>(i * 7);
+    }
+    a[big - 1] = 0x5A;
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        b[i] = static_cast<std::uint8_t>(i);
+    }
+
+    const util::MemoryRegion regions[] = {{a.get(), big}, {nullptr, 64}, {b.data(), b.size()}};
+    const std::size_t pages = util::prefault_parallel(regions, 4);
+    const std::size_t page = 4096;
+    EXPECT_GE(pages, big / page + 1);
+    EXPECT_LE(pages, big / page + 4);
+
+    for (std::size_t i = 0; i < big; i += 4093) {
+        ASSERT_EQ(a[i], static_cast<std::uint8_t>(i * 7)) << i;
+    }
+    EXPECT_EQ(a[big - 1], 0x5A);
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        ASSERT_EQ(b[i], static_cast<std::uint8_t>(i));
+    }
+    EXPECT_EQ(util::prefault_parallel({}, 4), 0u);
+}
+
+// ColdStart_RunParallelRunsEveryTask - Every task runs exactly once, on several threads when allowed
+TEST(ColdStartTest, RunParallelRunsEveryTask) {
+    std::atomic<int> runs[6]{};
+    std::vector<std::thread::id> ids(6);
+    std::vector<std::function<void()>> tasks;
+    for (std::size_t i = 0; i < 6; ++i) {
+        tasks.emplace_back([&, i] {
+            runs[i].fetch_add(1);
+            ids[i] = std::this_thread::get_id();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        });
+    }
+    util::run_parallel(tasks, 3);
+    for (const auto& r : runs) {
+        EXPECT_EQ(r.load(), 1);
+    }
+
+    util::run_parallel(tasks, 1);  // Caller only
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(runs[i].load(), 2);
+        EXPECT_EQ(ids[i], std::this_thread::get_id());
+    }
+    util::run_parallel({}, 4);
+}
+
+// ColdStart_PhasesAndCalibration - Phases are recorded in order; calibration overlaps the caller's work
+TEST(ColdStartTest, PhasesAndCalibration) {
+    util::StartupPhases startup;
+    util::BackgroundCalibration calibration(20);
+    startup.time("work", [] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    bool calibrated = false;
+    startup.time("calibration_wait", [&] { calibrated = calibration.wait(); });
+    startup.record("tsc_calibration", calibration.elapsed_ns());
+
+    ASSERT_EQ(startup.phases().size(), 3u);
+    EXPECT_STREQ(startup.phases()[0].name, "work");
+    EXPECT_GE(startup.phases()[0].ns, 5'000'000u);
+    EXPECT_GE(calibration.elapsed_ns(), startup.phases()[1].ns);  // Part of it ran during "work"
+    EXPECT_GE(startup.elapsed_ns(), startup.phases()[0].ns + startup.phases()[1].ns);
+    EXPECT_EQ(calibrated, util::TscCalibration::instance().is_calibrated());
+    EXPECT_EQ(calibration.wait(), calibrated);  // Idempotent
+
+    for (std::size_t i = 0; i < util::StartupPhases::MAX_PHASES; ++i) {
+        startup.record("extra", 1);
+    }
+    EXPECT_EQ(startup.phases().size(), util::StartupPhases::MAX_PHASES);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/order_soa_mirror.hpp"
+#include "ingest/fix_scan.hpp"
+#include "util/cpu_features.hpp"
+
+namespace {
+
+constexpr util::Isa ALL_ISAS[] = {util::Isa::Scalar, util::Isa::Avx2, util::Isa::Avx512};
+
+// Buffers of every length up to a few vector widths, SOH-dense and SOH-sparse
+std::vector<std::string> sample_buffers() {
+    std::mt19937 rng(88);
+    std::vector<std::string> out;
+    for (std::size_t len = 0; len <= 200; ++len) {
+        for (const unsigned soh_one_in : {3u, 40u}) {
+            std::string s(len, '\0');
+            for (char& c : s) {
+                c = rng() % soh_one_in == 0 ? '\x01' : static_cast<char>(rng() & 0xFF);
+            }
+            out.push_back(std::move(s));
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+// CpuDispatch_LevelsAreConsistent - Detected level implies its features; dispatch never exceeds it
+TEST(CpuDispatchTest, LevelsAreConsistent) {
+    const util::CpuFeatures& f = util::cpu_features();
+    const util::Isa max = f.max_isa();
+    if (max != util::Isa::Scalar) {
+        EXPECT_TRUE(f.avx2 && f.bmi2 && f.os_ymm);
+    }
+    if (max == util::Isa::Avx512) {
+        EXPECT_TRUE(f.avx512f && f.avx512bw && f.os_zmm);
+    }
+    EXPECT_LE(static_cast<int>(util::dispatch_isa()), static_cast<int>(max));
+    EXPECT_TRUE(util::isa_supported(util::Isa::Scalar));
+
+    const util::IsaKernels<int (*)()> partial{[] { return 0; }, [] { return 1; }, nullptr};
+    EXPECT_EQ(partial.for_isa(util::Isa::Avx512)(), 1);  // Falls back to the next level built
+    EXPECT_EQ(partial.for_isa(util::Isa::Scalar)(), 0);
+}
+
+// CpuDispatch_ScanSohMatchesScalar - Every level finds the same SOH offsets, including capped scans
+TEST(CpuDispatchTest, ScanSohMatchesScalar) {
+    const auto& kernels = ingest::scan_soh_kernels();
+    for (const std::string& buf : sample_buffers()) {
+        for (const std::size_t cap : {std::size_t{0}, std::size_t{5}, std::size_t{256}}) {
+            std::vector<std::uint32_t> expected(cap + 1, 0xFFFFFFFF);
+            const std::size_t n_expected = kernels.scalar(buf.data(), buf.size(), expected.data(), cap);
+            for (const util::Isa isa : ALL_ISAS) {
+                if (!util::isa_supported(isa)) {
+                    continue;
+                }
+                std::vector<std::uint32_t> got(cap + 1, 0xFFFFFFFF);
+                const std::size_t n = kernels.for_isa(isa)(buf.data(), buf.size(), got.data(), cap);
+                ASSERT_EQ(n, n_expected) << util::isa_name(isa) << " len " << buf.size();
+                ASSERT_EQ(got, expected) << util::isa_name(isa) << " len " << buf.size();
+            }
+        }
+    }
+}
+
+// CpuDispatch_ChecksumMatchesScalar - Every level computes the same FIX CheckSum
+TEST(CpuDispatchTest, ChecksumMatchesScalar) {
+    const auto& kernels = ingest::fix_checksum_kernels();
+    std::string big(100'000, '\0');
+    for (std::size_t i = 0; i < big.size(); ++i) {
+        big[i] = static_cast<char>(i * 131 + 7);
+    }
+    auto buffers = sample_buffers();
+    buffers.push_back(big);
+    for (const std::string& buf : buffers) {
+        const std::uint8_t expected = kernels.scalar(buf.data(), buf.size());
+        for (const util::Isa isa : ALL_ISAS) {
+            if (util::isa_supported(isa)) {
+                ASSERT_EQ(kernels.for_isa(isa)(buf.data(), buf.size()), expected)
+                    << util::isa_name(isa) << " len " << buf.size();
+            }
+        }
+    }
+}
+
+// CpuDispatch_MismatchBatchMatchesScalar - The mismatch batch agrees across levels
+TEST(CpuDispatchTest, MismatchBatchMatchesScalar) {
+    constexpr std::size_t SLOTS = 301;
+    std::mt19937_64 rng(188);
+    core::OrderSoaMirror mirror(SLOTS);
+    for (std::size_t slot = 0; slot < SLOTS; ++slot) {
+        core::OrderState os{};
+        for (std::size_t side = 0; side < core::SOURCE_COUNT; ++side) {
+            os.seen[side] = (rng() & 3u) != 0;
+            os.cum_qty[side] = static_cast<std::int64_t>(rng() % 3) - 1;
+            os.avg_px[side] = static_cast<std::int64_t>(rng() % 3) << 62;
+            os.exec_id_hash[side] = rng() % 2;
+            os.status[side] = static_cast<core::OrdStatus>(rng() % 3);
+        }
+        mirror.capture(slot, os);
+    }
+
+    std::vector<core::MismatchMask> expected(SLOTS);
+    std::vector<core::MismatchMask> got(SLOTS);
+    for (const std::int64_t tol : {std::int64_t{0}, std::int64_t{1}}) {
+        mirror.evaluate_isa(util::Isa::Scalar, 1, SLOTS - 1, tol, tol, core::DEFAULT_REQUIRED_SIDES, expected.data());
+        for (const util::Isa isa : ALL_ISAS) {
+            if (!util::isa_supported(isa)) {
+                continue;
+            }
+            mirror.evaluate_isa(isa, 1, SLOTS - 1, tol, tol, core::DEFAULT_REQUIRED_SIDES, got.data());
+            for (std::size_t i = 0; i + 1 < SLOTS; ++i) {
+                ASSERT_EQ(got[i].bits(), expected[i].bits()) << util::isa_name(isa) << " slot " << i + 1;
+            }
+        }
+    }
+}
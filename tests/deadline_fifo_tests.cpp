@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "util/deadline_fifo.hpp"
+
+namespace {
+
+struct Fired {
+    std::uint32_t ref;
+    std::uint32_t generation;
+};
+
+} // namespace
+
+// DeadlineFifo_PopsDueEntriesInOrder - Only entries at or before now fire, oldest first
+TEST(DeadlineFifoTest, PopsDueEntriesInOrder) {
+    util::DeadlineFifo fifo(8);
+    EXPECT_EQ(fifo.next_deadline_tsc(), util::DeadlineFifo::NO_DEADLINE);
+    ASSERT_TRUE(fifo.push(1, 10, 100));
+    ASSERT_TRUE(fifo.push(2, 20, 200));
+    ASSERT_TRUE(fifo.push(3, 30, 300));
+    EXPECT_EQ(fifo.next_deadline_tsc(), 100u);
+
+    std::vector<Fired> fired;
+    const auto collect = [&](std::uint32_t ref, std::uint32_t gen) { fired.push_back({ref, gen}); };
+    EXPECT_EQ(fifo.poll_expired(99, collect), 0u);
+    EXPECT_EQ(fifo.poll_expired(200, collect), 2u);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0].ref, 1u);
+    EXPECT_EQ(fired[0].generation, 10u);
+    EXPECT_EQ(fired[1].ref, 2u);
+    EXPECT_EQ(fifo.next_deadline_tsc(), 300u);
+    EXPECT_EQ(fifo.size(), 1u);
+    EXPECT_EQ(fifo.stats().scheduled, 3u);
+    EXPECT_EQ(fifo.stats().expired, 2u);
+}
+
+// DeadlineFifo_RefusesFullAndOutOfOrder - A full ring or an earlier deadline is left to the caller
+TEST(DeadlineFifoTest, RefusesFullAndOutOfOrder) {
+    util::DeadlineFifo fifo(3);
+    ASSERT_EQ(fifo.capacity(), 4u);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(fifo.push(i, 1, 100 + i));
+    }
+    EXPECT_FALSE(fifo.push(9, 1, 500));
+    EXPECT_EQ(fifo.size(), 4u);
+
+    (void)fifo.poll_expired(100, [](std::uint32_t, std::uint32_t) {});
+    EXPECT_FALSE(fifo.push(9, 1, 102));  // Earlier than the newest entry (103)
+    EXPECT_TRUE(fifo.push(9, 1, 103));   // Equal deadlines keep insertion order
+    EXPECT_EQ(fifo.stats().refused, 2u);
+    EXPECT_THROW(util::DeadlineFifo(0), std::invalid_argument);
+}
+
+// DeadlineFifo_CallbackPushesWaitForNextPoll - Rescheduling from a callback cannot loop within one poll
+TEST(DeadlineFifoTest, CallbackPushesWaitForNextPoll) {
+    util::DeadlineFifo fifo(4);
+    ASSERT_TRUE(fifo.push(1, 1, 50));
+    std::size_t calls = 0;
+    const auto reschedule = [&](std::uint32_t ref, std::uint32_t gen) {
+        ++calls;
+        EXPECT_TRUE(fifo.push(ref, gen + 1, 60));  // Already due, but after this poll
+    };
+    EXPECT_EQ(fifo.poll_expired(100, reschedule), 1u);
+    EXPECT_EQ(fifo.size(), 1u);
+    EXPECT_EQ(fifo.poll_expired(100, reschedule), 1u);
+    EXPECT_EQ(calls, 2u);
+}
+
+// DeadlineFifo_WrapsAround - Indices wrap the ring; reset drops everything
+TEST(DeadlineFifoTest, WrapsAround) {
+    util::DeadlineFifo fifo(4);
+    std::uint64_t expired = 0;
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(fifo.push(i, i, i * 10));
+        ASSERT_TRUE(fifo.push(i, i, i * 10 + 5));
+        expired += fifo.poll_expired(i * 10 + 5, [&](std::uint32_t ref, std::uint32_t) { EXPECT_EQ(ref, i); });
+    }
+    EXPECT_EQ(expired, 200u);
+    EXPECT_TRUE(fifo.empty());
+
+    ASSERT_TRUE(fifo.push(1, 1, 5'000));
+    fifo.reset();
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_TRUE(fifo.push(2, 1, 1));  // No ordering constraint after reset
+    EXPECT_EQ(fifo.stats().scheduled, 1u);
+}
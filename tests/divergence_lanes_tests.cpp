@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/divergence_lanes.hpp"
+
+namespace {
+
+core::Divergence make_divergence(core::DivergenceType type, std::uint8_t mask, core::OrderKey key = 0) {
+    core::Divergence div{};
+    div.key = key;
+    div.type = type;
+    div.mismatch_mask = mask;
+    return div;
+}
+
+} // namespace
+
+// DivergenceLanes_PriorityFromTypeAndMask - Existence problems are critical, price drift low
+TEST(DivergenceLanesTest, PriorityFromTypeAndMask) {
+    using core::DivergencePriority;
+    using core::DivergenceType;
+    using M = core::MismatchMask;
+
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::PhantomOrder, M::EXISTENCE)),
+              DivergencePriority::Critical);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::MissingDropCopy, M::EXISTENCE)),
+              DivergencePriority::Critical);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::MissingFill, 0)),
+              DivergencePriority::Critical);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::StateMismatch, M::STATUS)),
+              DivergencePriority::High);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::QuantityMismatch, M::CUM_QTY | M::AVG_PX)),
+              DivergencePriority::High);
+    // classify_divergence_type reports a price-only mismatch as StateMismatch
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::StateMismatch, M::AVG_PX)),
+              DivergencePriority::Low);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::StateMismatch, M::EXEC_ID)),
+              DivergencePriority::Low);
+    // Legacy emissions carry no mask
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::QuantityMismatch, 0)),
+              DivergencePriority::High);
+    EXPECT_EQ(core::divergence_priority(make_divergence(DivergenceType::TimingAnomaly, 0)),
+              DivergencePriority::Low);
+}
+
+// DivergenceLanes_DrainsInStrictPriorityOrder - Pops every critical, then high, then low; FIFO within a lane
+TEST(DivergenceLanesTest, DrainsInStrictPriorityOrder) {
+    using core::DivergenceType;
+    using M = core::MismatchMask;
+    auto lanes = std::make_unique<core::DivergenceLanes>();
+
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::TimingAnomaly, 0, 1)));
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::QuantityMismatch, M::CUM_QTY, 2)));
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::PhantomOrder, M::EXISTENCE, 3)));
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::StateMismatch, M::AVG_PX, 4)));
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::MissingFill, M::STATUS, 5)));
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::StateMismatch, M::STATUS, 6)));
+    EXPECT_EQ(lanes->size_approx(), 6u);
+    EXPECT_EQ(lanes->lane_size_approx(core::DivergencePriority::Critical), 2u);
+
+    std::vector<core::OrderKey> order;
+    core::Divergence out{};
+    while (lanes->try_pop(out)) {
+        order.push_back(out.key);
+    }
+    EXPECT_EQ(order, (std::vector<core::OrderKey>{3, 5, 2, 6, 1, 4}));
+    EXPECT_EQ(lanes->size_approx(), 0u);
+}
+
+// DivergenceLanes_LowFloodDoesNotBlockCritical - A full low lane drops only low-severity output
+TEST(DivergenceLanesTest, LowFloodDoesNotBlockCritical) {
+    using core::DivergencePriority;
+    using core::DivergenceType;
+    auto lanes = std::make_unique<core::DivergenceLanes>();
+
+    const std::size_t usable = core::DivergenceLanes::lane_capacity(DivergencePriority::Low) - 1;
+    for (std::size_t i = 0; i < usable; ++i) {
+        ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::TimingAnomaly, 0, i)));
+    }
+    EXPECT_FALSE(lanes->try_push(make_divergence(DivergenceType::TimingAnomaly, 0)));
+    EXPECT_FALSE(lanes->try_push(make_divergence(DivergenceType::TimingAnomaly, 0)));
+    EXPECT_EQ(lanes->drops(DivergencePriority::Low), 2u);
+
+    ASSERT_TRUE(lanes->try_push(make_divergence(DivergenceType::PhantomOrder, core::MismatchMask::EXISTENCE, 999'999)));
+    EXPECT_EQ(lanes->drops(DivergencePriority::Critical), 0u);
+    EXPECT_EQ(lanes->drops(DivergencePriority::High), 0u);
+
+    core::Divergence out{};
+    ASSERT_TRUE(lanes->try_pop(out));
+    EXPECT_EQ(out.key, 999'999u);
+    EXPECT_EQ(out.type, DivergenceType::PhantomOrder);
+}
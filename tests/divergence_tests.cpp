@@ -7,9 +7,9 @@ namespace {
 TEST(DivergenceTest, PhantomOrderDetection) {
     core::OrderState state{};
     state.key = 1;
-    state.seen_dropcopy = true;
-    state.dropcopy_status = core::OrdStatus::New;
-    state.last_dropcopy_ts = 100;
+    state.seen[core::SideIndex::DROPCOPY] = true;
+    state.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+    state.last_ts[core::SideIndex::DROPCOPY] = 100;
 
     core::Divergence div{};
     ASSERT_TRUE(core::classify_divergence(state, div));
@@ -20,16 +20,16 @@ TEST(DivergenceTest, PhantomOrderDetection) {
 TEST(DivergenceTest, MissingFillDetection) {
     core::OrderState state{};
     state.key = 2;
-    state.seen_internal = true;
-    state.seen_dropcopy = true;
-    state.internal_status = core::OrdStatus::Working;
-    state.internal_cum_qty = 10;
-    state.internal_avg_px = 100;
-    state.last_internal_ts = 200;
-    state.dropcopy_status = core::OrdStatus::Filled;
-    state.dropcopy_cum_qty = 20;
-    state.dropcopy_avg_px = 105;
-    state.last_dropcopy_ts = 150;
+    state.seen[core::SideIndex::PRIMARY] = true;
+    state.seen[core::SideIndex::DROPCOPY] = true;
+    state.status[core::SideIndex::PRIMARY] = core::OrdStatus::Working;
+    state.cum_qty[core::SideIndex::PRIMARY] = 10;
+    state.avg_px[core::SideIndex::PRIMARY] = 100;
+    state.last_ts[core::SideIndex::PRIMARY] = 200;
+    state.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
+    state.cum_qty[core::SideIndex::DROPCOPY] = 20;
+    state.avg_px[core::SideIndex::DROPCOPY] = 105;
+    state.last_ts[core::SideIndex::DROPCOPY] = 150;
 
     core::Divergence div{};
     ASSERT_TRUE(core::classify_divergence(state, div));
@@ -41,12 +41,12 @@ TEST(DivergenceTest, MissingFillDetection) {
 TEST(DivergenceTest, StateMismatchDetection) {
     core::OrderState state{};
     state.key = 3;
-    state.seen_internal = true;
-    state.seen_dropcopy = true;
-    state.internal_status = core::OrdStatus::PartiallyFilled;
-    state.dropcopy_status = core::OrdStatus::Filled;
-    state.internal_cum_qty = 15;
-    state.dropcopy_cum_qty = 15;
+    state.seen[core::SideIndex::PRIMARY] = true;
+    state.seen[core::SideIndex::DROPCOPY] = true;
+    state.status[core::SideIndex::PRIMARY] = core::OrdStatus::PartiallyFilled;
+    state.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
+    state.cum_qty[core::SideIndex::PRIMARY] = 15;
+    state.cum_qty[core::SideIndex::DROPCOPY] = 15;
 
     core::Divergence div{};
     ASSERT_TRUE(core::classify_divergence(state, div));
@@ -58,14 +58,14 @@ TEST(DivergenceTest, StateMismatchDetection) {
 TEST(DivergenceTest, QuantityMismatchDetection) {
     core::OrderState state{};
     state.key = 4;
-    state.seen_internal = true;
-    state.seen_dropcopy = true;
-    state.internal_status = core::OrdStatus::Filled;
-    state.dropcopy_status = core::OrdStatus::Filled;
-    state.internal_cum_qty = 10;
-    state.dropcopy_cum_qty = 20;
-    state.internal_avg_px = 100;
-    state.dropcopy_avg_px = 100;
+    state.seen[core::SideIndex::PRIMARY] = true;
+    state.seen[core::SideIndex::DROPCOPY] = true;
+    state.status[core::SideIndex::PRIMARY] = core::OrdStatus::Filled;
+    state.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
+    state.cum_qty[core::SideIndex::PRIMARY] = 10;
+    state.cum_qty[core::SideIndex::DROPCOPY] = 20;
+    state.avg_px[core::SideIndex::PRIMARY] = 100;
+    state.avg_px[core::SideIndex::DROPCOPY] = 100;
 
     core::Divergence div{};
     ASSERT_TRUE(core::classify_divergence(state, div, 5));
@@ -77,20 +77,20 @@ TEST(DivergenceTest, QuantityMismatchDetection) {
 TEST(DivergenceTest, TimingAnomalyDetection) {
     core::OrderState state{};
     state.key = 5;
-    state.seen_internal = true;
-    state.seen_dropcopy = true;
-    state.internal_status = core::OrdStatus::PartiallyFilled;
-    state.dropcopy_status = core::OrdStatus::PartiallyFilled;
-    state.internal_cum_qty = 10;
-    state.dropcopy_cum_qty = 10;
-    state.last_dropcopy_ts = 100;
-    state.last_internal_ts = 200;
+    state.seen[core::SideIndex::PRIMARY] = true;
+    state.seen[core::SideIndex::DROPCOPY] = true;
+    state.status[core::SideIndex::PRIMARY] = core::OrdStatus::PartiallyFilled;
+    state.status[core::SideIndex::DROPCOPY] = core::OrdStatus::PartiallyFilled;
+    state.cum_qty[core::SideIndex::PRIMARY] = 10;
+    state.cum_qty[core::SideIndex::DROPCOPY] = 10;
+    state.last_ts[core::SideIndex::DROPCOPY] = 100;
+    state.last_ts[core::SideIndex::PRIMARY] = 200;
 
     core::Divergence div{};
     ASSERT_TRUE(core::classify_divergence(state, div, 0, 0, 50));
     EXPECT_EQ(div.type, core::DivergenceType::TimingAnomaly);
-    EXPECT_EQ(div.dropcopy_ts, state.last_dropcopy_ts);
-    EXPECT_EQ(div.internal_ts, state.last_internal_ts);
+    EXPECT_EQ(div.dropcopy_ts, state.last_ts[core::SideIndex::DROPCOPY]);
+    EXPECT_EQ(div.internal_ts, state.last_ts[core::SideIndex::PRIMARY]);
 }
 
 } // namespace
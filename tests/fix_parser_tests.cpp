@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cstdio>
 #include <string>
 #include <string_view>
 #include "ingest/fix_parser.hpp"
@@ -28,4 +29,40 @@ TEST(FixParserTest, MissingRequiredField) {
     EXPECT_EQ(ingest::parse_exec_report(msg.data(), msg.size(), evt), ingest::ParseResult::MissingField);
 }
 
+// Appends a correct CheckSum(10) trailer to a pipe-delimited message
+std::string with_checksum(const std::string& pipe_msg) {
+    const std::string body = util::pipe_to_soh(pipe_msg);
+    unsigned sum = 0;
+    for (const char c : body) {
+        sum += static_cast<unsigned char>(c);
+    }
+    char trailer[16];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum % 256);
+    return body + trailer;
+}
+
+TEST(FixParserTest, ChecksumValidatedWhenPresent) {
+    const std::string fields = "8=FIX.4.4|35=8|150=2|39=2|17=EXEC1|11=CID1|37=OID1|31=1000000|32=100|14=100|52=1|60=1|";
+    const std::string good = with_checksum(fields);
+    core::ExecEvent evt{};
+    EXPECT_EQ(ingest::parse_exec_report(good.data(), good.size(), evt), ingest::ParseResult::Ok);
+
+    std::string bad = good;
+    bad[good.find("17=EXEC1") + 3] = 'F';  // Same length, different byte sum
+    EXPECT_EQ(ingest::parse_exec_report(bad.data(), bad.size(), evt), ingest::ParseResult::Invalid);
+}
+
+TEST(FixParserTest, ManyFieldsFallBackToByteScan) {
+    // More fields than the SOH index holds; tags past it are still parsed
+    std::string fields = "8=FIX.4.4|35=8|150=2|39=2|17=EXEC1|";
+    for (int i = 0; i < 80; ++i) {
+        fields += "58=x|";
+    }
+    fields += "11=CID1|37=OID1|31=1000000|32=100|14=100|52=1|60=1|";
+    const std::string msg = with_checksum(fields);
+    core::ExecEvent evt{};
+    EXPECT_EQ(ingest::parse_exec_report(msg.data(), msg.size(), evt), ingest::ParseResult::Ok);
+    EXPECT_EQ(std::string(evt.clord_id, evt.clord_id_len), "CID1");
+}
+
 } // namespace
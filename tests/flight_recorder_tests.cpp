@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "core/flight_recorder.hpp"
+#include "core/order_state_store.hpp"
+#include "core/reconciler.hpp"
+#include "ingest/spsc_ring.hpp"
+#include "util/arena.hpp"
+#include "util/async_log.hpp"
+
+namespace {
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Dumps to a temp file and returns its text
+std::string dump_to_string(const util::AsyncLogger* logger) {
+    const auto path = std::filesystem::temp_directory_path() / "flight_recorder_dump.txt";
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    EXPECT_GE(fd, 0);
+    core::dump_flight_recorders(fd, logger);
+    ::close(fd);
+    return read_file(path);
+}
+
+core::FlightRecord timer_record(std::uint64_t tsc) {
+    core::FlightRecord rec{};
+    rec.tsc = tsc;
+    rec.kind = core::FlightKind::TimerFire;
+    rec.x = tsc * 10;
+    return rec;
+}
+
+} // namespace
+
+// FlightRecorder_KeepsNewestRecords - The ring overwrites the oldest; iteration is oldest first
+TEST(FlightRecorderTest, KeepsNewestRecords) {
+    core::FlightRecorder recorder("test", 6);  // Rounded up to 8
+    EXPECT_EQ(recorder.capacity(), 8u);
+    EXPECT_STREQ(recorder.name(), "test");
+
+    std::vector<std::uint64_t> seen;
+    recorder.for_each([&](const core::FlightRecord& r) { seen.push_back(r.tsc); });
+    EXPECT_TRUE(seen.empty());
+
+    for (std::uint64_t i = 1; i <= 20; ++i) {
+        recorder.record(timer_record(i));
+    }
+    EXPECT_EQ(recorder.recorded(), 20u);
+    recorder.for_each([&](const core::FlightRecord& r) { seen.push_back(r.tsc); });
+    // The slot the writer overwrites next (the oldest) is skipped
+    EXPECT_EQ(seen, (std::vector<std::uint64_t>{14, 15, 16, 17, 18, 19, 20}));
+
+    EXPECT_THROW(core::FlightRecorder("zero", 0), std::invalid_argument);
+}
+
+// FlightRecorder_DumpRegisteredAndLoggerPending - Dumps cover registered recorders and unconsumed log records
+TEST(FlightRecorderTest, DumpRegisteredAndLoggerPending) {
+    core::FlightRecorder recon("recon", 16);
+    core::FlightRecorder other("other", 16);
+    core::ExecEvent ev{};
+    ev.source = core::Source::DropCopy;
+    ev.exec_type = core::ExecType::Fill;
+    ev.ord_status = core::OrdStatus::Filled;
+    ev.session_id = 9;
+    ev.seq_num = 1234;
+    ev.ingest_tsc = 777;
+    recon.record_event(core::FlightKind::Event, ev, 0xABCD);
+    other.record(timer_record(5));
+
+    ASSERT_TRUE(core::register_flight_recorder(&recon));
+    std::string text = dump_to_string(nullptr);
+    EXPECT_NE(text.find("## recorder=recon recorded=1 capacity=16"), std::string::npos) << text;
+    EXPECT_NE(text.find("tsc=777 event src=1 exec_type=2 status=2 session=9 seq=1234 key=0x000000000000abcd"),
+              std::string::npos) << text;
+    EXPECT_EQ(text.find("recorder=other"), std::string::npos);
+    EXPECT_EQ(text.find("logger"), std::string::npos);
+
+    // Logger consumer parked in a long sleep, so fresh records stay in the ring
+    const auto log_path = std::filesystem::temp_directory_path() / "flight_recorder_logger.log";
+    util::AsyncLogger logger;
+    util::AsyncLogger::Config cfg{};
+    cfg.capacity_pow2 = 1u << 6;
+    cfg.file_path = log_path.string();
+    cfg.consumer_sleep_ns = 500'000'000;
+    ASSERT_TRUE(logger.start(cfg));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(logger.try_logf(util::LogLevel::Warn, "RECON", "store_overflow seq=%d", 42));
+    ASSERT_TRUE(logger.try_log(util::LogLevel::Error, "HOT", "last words", 10, 1, 2));
+
+    text = dump_to_string(&logger);
+    logger.stop();
+    core::unregister_flight_recorder(&recon);
+
+    const auto logger_at = text.find("## logger pending records");
+    ASSERT_NE(logger_at, std::string::npos) << text;
+    EXPECT_NE(text.find("[WARN][RECON] store_overflow seq=42", logger_at), std::string::npos) << text;
+    EXPECT_NE(text.find("[ERROR][HOT] last words | a0=1 a1=2", logger_at), std::string::npos) << text;
+
+    text = dump_to_string(nullptr);
+    EXPECT_EQ(text.find("recorder=recon"), std::string::npos);
+}
+
+// FlightRecorder_Sigusr2DumpsAndContinues - SIGUSR2 writes the dump file; the process carries on
+TEST(FlightRecorderTest, Sigusr2DumpsAndContinues) {
+    const auto path = std::filesystem::temp_directory_path() / "flight_recorder_sigusr2.txt";
+    std::filesystem::remove(path);
+    core::FlightRecorder recorder("sig", 8);
+    recorder.record(timer_record(3));
+    ASSERT_TRUE(core::register_flight_recorder(&recorder));
+
+    EXPECT_FALSE(core::install_flight_dump_handlers("", nullptr));
+    ASSERT_TRUE(core::install_flight_dump_handlers(path.c_str(), nullptr));
+    ASSERT_EQ(std::raise(SIGUSR2), 0);
+    core::uninstall_flight_dump_handlers();
+    core::unregister_flight_recorder(&recorder);
+
+    const std::string text = read_file(path);
+    EXPECT_EQ(text.rfind("# flight recorder dump signal=" + std::to_string(SIGUSR2), 0), 0u) << text;
+    EXPECT_NE(text.find("tsc=3 timer_fire handle=30 gen=0"), std::string::npos) << text;
+}
+
+// FlightRecorder_ReconcilerRecordsEvents - An attached reconciler records every event it takes
+TEST(FlightRecorderTest, ReconcilerRecordsEvents) {
+    using ExecRing = ingest::SpscRing<core::ExecEvent, 1u << 16>;
+    std::atomic<bool> stop_flag{false};
+    auto primary = std::make_unique<ExecRing>();
+    auto dropcopy = std::make_unique<ExecRing>();
+    auto divergences = std::make_unique<core::DivergenceRing>();
+    auto gaps = std::make_unique<core::SequenceGapRing>();
+    util::Arena arena{util::Arena::default_capacity_bytes};
+    core::OrderStateStore store(arena, 128);
+    core::ReconCounters counters{};
+    core::Reconciler reconciler(stop_flag, *primary, *dropcopy, store, counters, *divergences, *gaps);
+    core::FlightRecorder recorder("recon", 64);
+    reconciler.attach_flight_recorder(recorder);
+
+    for (std::uint64_t seq = 1; seq <= 3; ++seq) {
+        core::ExecEvent ev{};
+        ev.source = core::Source::Primary;
+        ev.exec_type = core::ExecType::New;
+        ev.ord_status = core::OrdStatus::New;
+        ev.seq_num = seq;
+        ev.ingest_tsc = 1'000 * seq;
+        ev.set_clord_id("FR1", 3);
+        reconciler.process_event_for_test(ev);
+    }
+
+    std::vector<std::uint64_t> seqs;
+    recorder.for_each([&](const core::FlightRecord& r) {
+        EXPECT_EQ(r.kind, core::FlightKind::Event);
+        EXPECT_EQ(r.tsc, 1'000 * r.x);
+        seqs.push_back(r.x);
+    });
+    EXPECT_EQ(seqs, (std::vector<std::uint64_t>{1, 2, 3}));
+}
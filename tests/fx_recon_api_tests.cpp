@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "api/fx_recon.h"
+#include "core/reconciler.hpp"
+#include "ingest/spsc_ring.hpp"
+
+namespace {
+
+fx_exec make_exec(std::uint64_t seq, const char* clord_id, std::uint8_t exec_type, std::uint8_t ord_status,
+                  std::int64_t cum_qty) {
+    fx_exec ex{};
+    ex.seq_num = seq;
+    ex.price_micro = 1'100'000;
+    ex.qty = cum_qty;
+    ex.cum_qty = cum_qty;
+    ex.clord_id = clord_id;
+    ex.clord_id_len = static_cast<std::uint8_t>(std::strlen(clord_id));
+    ex.exec_type = exec_type;
+    ex.ord_status = ord_status;
+    ex.session_id = 1;
+    return ex;
+}
+
+struct Collected {
+    std::vector<fx_divergence> divs;
+};
+
+void collect(void* ctx, const fx_divergence* div) {
+    static_cast<Collected*>(ctx)->divs.push_back(*div);
+}
+
+} // namespace
+
+// FxReconApi_SpscClaimPublish - A claimed slot is invisible until published and may be abandoned
+TEST(FxReconApiTest, SpscClaimPublish) {
+    ingest::SpscRing<int, 4> ring;
+    int* slot = ring.try_claim();
+    ASSERT_NE(slot, nullptr);
+    *slot = 1;
+    EXPECT_EQ(ring.size_approx(), 0u);
+    slot = ring.try_claim();  // Abandoned: the same slot comes back
+    *slot = 2;
+    ring.publish();
+    ASSERT_NE(ring.try_claim(), nullptr);
+    ring.publish();
+    ASSERT_NE(ring.try_claim(), nullptr);
+    ring.publish();
+    EXPECT_EQ(ring.try_claim(), nullptr);  // One slot always stays empty
+    int v = 0;
+    ASSERT_TRUE(ring.try_pop(v));
+    EXPECT_EQ(v, 2);
+}
+
+// FxReconApi_MismatchReachesHost - Executions submitted in-process come back as a divergence
+TEST(FxReconApiTest, MismatchReachesHost) {
+    EXPECT_EQ(fx_recon_abi_version(), FX_RECON_ABI_VERSION);
+    fx_recon_config cfg;
+    fx_recon_config_init(&cfg);
+    cfg.order_capacity = 1024;
+    cfg.enable_windowed_recon = 0;  // Confirm mismatches immediately
+    fx_recon* recon = fx_recon_create(&cfg);
+    ASSERT_NE(recon, nullptr);
+    ASSERT_EQ(fx_recon_start(recon), FX_RECON_OK);
+    EXPECT_EQ(fx_recon_start(recon), FX_RECON_ESTATE);
+
+    const fx_exec primary = make_exec(1, "API-1", FX_EXEC_FILL, FX_ORD_FILLED, 1'000'000);
+    const fx_exec dropcopy = make_exec(1, "API-1", FX_EXEC_PARTIAL_FILL, FX_ORD_PARTIALLY_FILLED, 400'000);
+    ASSERT_EQ(fx_recon_submit_exec(recon, FX_SIDE_PRIMARY, &primary), FX_RECON_OK);
+    ASSERT_EQ(fx_recon_submit_exec(recon, FX_SIDE_DROPCOPY, &dropcopy), FX_RECON_OK);
+
+    Collected got;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (got.divs.empty() && std::chrono::steady_clock::now() < deadline) {
+        (void)fx_recon_drain_divergences(recon, collect, &got, 16);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(fx_recon_stop(recon), FX_RECON_OK);
+    EXPECT_EQ(fx_recon_stop(recon), FX_RECON_ESTATE);
+
+    ASSERT_FALSE(got.divs.empty());
+    const fx_divergence& div = got.divs.back();
+    EXPECT_NE(div.key, 0u);
+    EXPECT_EQ(div.primary_status, FX_ORD_FILLED);
+    EXPECT_EQ(div.dropcopy_status, FX_ORD_PARTIALLY_FILLED);
+    EXPECT_EQ(div.primary_cum_qty, 1'000'000);
+    EXPECT_EQ(div.dropcopy_cum_qty, 400'000);
+
+    fx_recon_stats stats{};
+    stats.struct_size = sizeof(stats);
+    ASSERT_EQ(fx_recon_stats_get(recon, &stats), FX_RECON_OK);
+    EXPECT_EQ(stats.submitted[FX_SIDE_PRIMARY], 1u);
+    EXPECT_EQ(stats.submitted[FX_SIDE_DROPCOPY], 1u);
+    EXPECT_EQ(stats.events_processed[FX_SIDE_PRIMARY], 1u);  // Published on stop
+    EXPECT_EQ(stats.events_processed[FX_SIDE_DROPCOPY], 1u);
+    EXPECT_GE(stats.divergences, 1u);
+    fx_recon_destroy(recon);
+}
+
+// FxReconApi_SubmitRejectsAndBackpressures - Bad input is refused without queueing; a full ring says so
+TEST(FxReconApiTest, SubmitRejectsAndBackpressures) {
+    fx_recon_config cfg;
+    fx_recon_config_init(&cfg);
+    cfg.order_capacity = 1024;
+    EXPECT_EQ(fx_recon_create(nullptr), nullptr);
+    fx_recon_config too_small = cfg;
+    too_small.struct_size = 8;
+    EXPECT_EQ(fx_recon_create(&too_small), nullptr);
+
+    fx_recon* recon = fx_recon_create(&cfg);  // Not started: nothing drains the rings
+    ASSERT_NE(recon, nullptr);
+    fx_exec ex = make_exec(1, "API-2", FX_EXEC_NEW, FX_ORD_NEW, 0);
+    EXPECT_EQ(fx_recon_submit_exec(recon, FX_SIDE_PRIME_BROKER, &ex), FX_RECON_EINVAL);  // Side not enabled
+    EXPECT_EQ(fx_recon_submit_exec(recon, 7, &ex), FX_RECON_EINVAL);
+    EXPECT_EQ(fx_recon_submit_exec(recon, FX_SIDE_PRIMARY, nullptr), FX_RECON_EINVAL);
+    ex.ord_status = 42;
+    EXPECT_EQ(fx_recon_submit_exec(recon, FX_SIDE_PRIMARY, &ex), FX_RECON_EINVAL);
+    ex.ord_status = FX_ORD_NEW;
+
+    int rc = FX_RECON_OK;
+    std::uint64_t accepted = 0;
+    while ((rc = fx_recon_submit_exec(recon, FX_SIDE_PRIMARY, &ex)) == FX_RECON_OK) {
+        ++ex.seq_num;
+        ++accepted;
+    }
+    EXPECT_EQ(rc, FX_RECON_EFULL);
+    EXPECT_EQ(accepted + 1, core::ExecRing::capacity());
+
+    fx_recon_stats stats{};
+    stats.struct_size = sizeof(stats);
+    ASSERT_EQ(fx_recon_stats_get(recon, &stats), FX_RECON_OK);
+    EXPECT_EQ(stats.submitted[FX_SIDE_PRIMARY], accepted);
+    EXPECT_EQ(stats.submit_full[FX_SIDE_PRIMARY], 1u);
+    EXPECT_EQ(stats.submit_invalid[FX_SIDE_PRIMARY], 1u);
+    EXPECT_EQ(stats.events_processed[FX_SIDE_PRIMARY], 0u);
+
+    fx_recon_stats prefix{};
+    prefix.struct_size = 8;  // An older, shorter struct only gets its own fields
+    ASSERT_EQ(fx_recon_stats_get(recon, &prefix), FX_RECON_OK);
+    EXPECT_EQ(prefix.submitted[FX_SIDE_PRIMARY], 0u);
+    fx_recon_destroy(recon);
+    fx_recon_destroy(nullptr);
+}
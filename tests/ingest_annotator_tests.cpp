@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "core/ingest_annotator.hpp"
+
+namespace {
+
+core::ExecEvent make_event(std::uint16_t session, std::uint64_t seq, const char* clord = "IA1") {
+    core::ExecEvent ev{};
+    ev.source = core::Source::DropCopy;
+    ev.exec_type = core::ExecType::New;
+    ev.ord_status = core::OrdStatus::New;
+    ev.session_id = session;
+    ev.seq_num = seq;
+    ev.ingest_tsc = 1'000 + seq;
+    ev.set_clord_id(clord, std::strlen(clord));
+    return ev;
+}
+
+} // namespace
+
+// IngestAnnotator_RejectsOutOfRangeEnums - Bad enums are dropped; good events get their key
+TEST(IngestAnnotatorTest, RejectsOutOfRangeEnums) {
+    core::IngestAnnotator annotator;
+
+    auto bad_status = make_event(1, 1);
+    bad_status.ord_status = static_cast<core::OrdStatus>(10);
+    auto bad_type = make_event(1, 1);
+    bad_type.exec_type = static_cast<core::ExecType>(7);
+    EXPECT_FALSE(annotator.annotate(bad_status));
+    EXPECT_FALSE(annotator.annotate(bad_type));
+    EXPECT_EQ(annotator.rejected(), 2u);
+    EXPECT_EQ(annotator.session_count(), 0u);
+
+    auto ev = make_event(1, 1);
+    ASSERT_TRUE(annotator.annotate(ev));
+    EXPECT_EQ(ev.ingest_flags, core::IngestFlags::ORDER_KEYED | core::IngestFlags::SEQ_TRACKED);
+    EXPECT_EQ(ev.order_key, core::make_order_key(ev));
+    EXPECT_EQ(core::event_order_key(ev), core::make_order_key(ev));
+}
+
+// IngestAnnotator_FlagsMatchTrackSequence - Per-session verdicts equal a per-session track_sequence run
+TEST(IngestAnnotatorTest, FlagsMatchTrackSequence) {
+    // session 5: gap, duplicate, fill, out of order; session 6 interleaved in order
+    const std::uint64_t seqs5[] = {1, 2, 6, 6, 4, 7, 3, 8};
+    core::IngestAnnotator annotator;
+    core::SequenceTracker reference{};
+    core::SequenceTracker recon_state{};
+    std::uint64_t seq6 = 0;
+
+    for (const std::uint64_t seq : seqs5) {
+        auto other = make_event(6, ++seq6);
+        ASSERT_TRUE(annotator.annotate(other));
+        EXPECT_EQ(other.ingest_flags & core::IngestFlags::SEQ_ANOMALY, 0u);
+
+        auto ev = make_event(5, seq);
+        ASSERT_TRUE(annotator.annotate(ev));
+        core::SequenceGapEvent expected{};
+        const bool expected_gap = core::track_sequence(reference, ev.source, 5, seq, ev.ingest_tsc, &expected);
+
+        core::SequenceGapEvent got{};
+        ASSERT_EQ(core::annotated_gap_event(ev, ev.ingest_tsc, got), expected_gap) << "seq " << seq;
+        if (expected_gap) {
+            EXPECT_EQ(got.kind, expected.kind) << "seq " << seq;
+            EXPECT_EQ(got.expected_seq, expected.expected_seq) << "seq " << seq;
+            EXPECT_EQ(got.seen_seq, expected.seen_seq);
+            EXPECT_EQ(got.gap_closed_by_fill, expected.gap_closed_by_fill);
+        }
+
+        // The reconciler's gap state follows the reference tracker
+        core::apply_annotated_sequence(recon_state, ev, ev.ingest_tsc);
+        EXPECT_EQ(recon_state.gap_open, reference.gap_open) << "seq " << seq;
+        EXPECT_EQ(recon_state.gap_epoch, reference.gap_epoch) << "seq " << seq;
+        EXPECT_EQ(recon_state.expected_seq, reference.expected_seq) << "seq " << seq;
+    }
+    EXPECT_EQ(annotator.session_count(), 2u);
+    EXPECT_EQ(reference.gap_epoch, 1u);
+}
+
+// IngestAnnotator_SessionTableOverflow - Sessions past the table are keyed but not sequence-tracked
+TEST(IngestAnnotatorTest, SessionTableOverflow) {
+    core::IngestAnnotator annotator;
+    for (std::uint16_t s = 0; s < core::IngestAnnotator::MAX_SESSIONS; ++s) {
+        auto ev = make_event(s, 1);
+        ASSERT_TRUE(annotator.annotate(ev));
+    }
+    auto extra = make_event(1'000, 1);
+    ASSERT_TRUE(annotator.annotate(extra));
+    EXPECT_EQ(extra.ingest_flags, core::IngestFlags::ORDER_KEYED);
+    EXPECT_EQ(annotator.session_count(), core::IngestAnnotator::MAX_SESSIONS);
+}
+
+// IngestAnnotator_TagsSessionPartition - Events carry their session's store partition; unassigned sessions get 0
+TEST(IngestAnnotatorTest, TagsSessionPartition) {
+    core::IngestAnnotator annotator;
+    ASSERT_TRUE(annotator.set_session_partition(7, 3));
+
+    auto desk = make_event(7, 1);
+    auto other = make_event(8, 1);
+    ASSERT_TRUE(annotator.annotate(desk));
+    ASSERT_TRUE(annotator.annotate(other));
+    EXPECT_EQ(desk.partition, 3u);
+    EXPECT_EQ(other.partition, 0u);
+
+    for (std::uint16_t s = 100; annotator.session_count() < core::IngestAnnotator::MAX_SESSIONS; ++s) {
+        ASSERT_TRUE(annotator.set_session_partition(s, 1));
+    }
+    EXPECT_FALSE(annotator.set_session_partition(1'000, 1));
+}
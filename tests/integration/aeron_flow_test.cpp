@@ -20,8 +20,10 @@
 
 #include "core/order_state_store.hpp"
 #include "core/reconciler.hpp"
+#include "core/wire_codec.hpp"
 #include "core/wire_exec_event.hpp"
 #include "ingest/aeron_subscriber.hpp"
+#include "util/alloc_guard.hpp"
 #include "util/arena.hpp"
 
 namespace {
@@ -117,8 +119,8 @@ core::WireExecEvent make_wire_exec(std::size_t seq) {
 }
 
 bool publish(aeron::Publication& pub, const core::WireExecEvent& evt) {
-    std::array<std::uint8_t, sizeof(core::WireExecEvent)> buffer{};
-    std::memcpy(buffer.data(), &evt, sizeof(core::WireExecEvent));
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buffer{};
+    core::ExecEventEncoder::encode(buffer.data(), core::from_wire(evt, core::Source::Primary, 0));
 
     aeron::concurrent::AtomicBuffer atomic_buffer(buffer.data(), buffer.size());
     return pub.offer(atomic_buffer, 0, static_cast<aeron::util::index_t>(buffer.size())) > 0;
@@ -215,6 +217,7 @@ TEST(AeronFlowIntegrationTest, EndToEndConsumesBothStreams) {
                                          client,
                                          stop_flag);
 
+    util::AllocGuard::reset_counters();
     std::thread primary_thread([&] { primary_sub.run(); });
     std::thread dropcopy_thread([&] { dropcopy_sub.run(); });
     std::thread recon_thread([&] { recon.run(); });
@@ -260,4 +263,10 @@ TEST(AeronFlowIntegrationTest, EndToEndConsumesBothStreams) {
 
     EXPECT_TRUE(consumed_primary);
     EXPECT_TRUE(consumed_dropcopy);
+
+    // Subscriber and reconciler loops run inside hot phases; with the allocation
+    // guard compiled in they must not have touched the heap.
+    if (util::AllocGuard::enabled) {
+        EXPECT_EQ(util::AllocGuard::total_hot_allocations(), 0u);
+    }
 }
@@ -281,9 +281,7 @@ TEST_F(ReconcilerWindowedTest, MismatchPersists_ConfirmedDivergence) {
     EXPECT_EQ(os->recon_state, ReconState::InGrace);
 
     // Advance time past grace (t=200ms, no correction arrives)
-    timer_wheel->poll_expired(ns_to_tsc(200'000'000), [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(ns_to_tsc(200'000'000));
 
     // Divergence confirmed
     auto divs = drain_divergences(*divergence_ring);
@@ -326,14 +324,12 @@ TEST_F(ReconcilerWindowedTest, PrimaryNeverArrives_PhantomOrder) {
     OrderState* os = store.find(key);
     ASSERT_NE(os, nullptr);
     EXPECT_EQ(os->recon_state, ReconState::InGrace);
-    EXPECT_FALSE(os->seen_internal);
-    EXPECT_TRUE(os->seen_dropcopy);
+    EXPECT_FALSE(os->seen[core::SideIndex::PRIMARY]);
+    EXPECT_TRUE(os->seen[core::SideIndex::DROPCOPY]);
     EXPECT_EQ(counters_.mismatch_observed, 1u);
 
     // Advance time past grace period - primary never arrives
-    timer_wheel->poll_expired(ns_to_tsc(200'000'000), [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(ns_to_tsc(200'000'000));
 
     // Divergence should be emitted (PhantomOrder - dropcopy seen, primary not)
     auto divs = drain_divergences(*divergence_ring);
@@ -373,17 +369,15 @@ TEST_F(ReconcilerWindowedTest, DropcopyNeverArrives_MissingDropCopy) {
     OrderState* os = store.find(key);
     ASSERT_NE(os, nullptr);
     EXPECT_EQ(os->recon_state, ReconState::InGrace);
-    EXPECT_TRUE(os->seen_internal);
-    EXPECT_FALSE(os->seen_dropcopy);
+    EXPECT_TRUE(os->seen[core::SideIndex::PRIMARY]);
+    EXPECT_FALSE(os->seen[core::SideIndex::DROPCOPY]);
     EXPECT_EQ(counters_.mismatch_observed, 1u);
 
     // No divergence yet (timer scheduled, waiting for dropcopy or expiration)
     EXPECT_TRUE(drain_divergences(*divergence_ring).empty());
 
     // Advance time past grace period - dropcopy never arrives
-    timer_wheel->poll_expired(ns_to_tsc(200'000'000), [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(ns_to_tsc(200'000'000));
 
     // Divergence should be emitted (MissingDropCopy - primary seen, dropcopy not)
     auto divs = drain_divergences(*divergence_ring);
@@ -583,9 +577,7 @@ TEST_F(ReconcilerWindowedTest, ReplayDeterminism) {
         }
 
         // Fire timers at deterministic time
-        timer_wheel->poll_expired(ns_to_tsc(200'000'000), [&](OrderKey k, std::uint32_t g) {
-            reconciler.on_grace_deadline_expired(k, g);
-        });
+        reconciler.poll_timers(ns_to_tsc(200'000'000));
 
         std::vector<Divergence> result;
         Divergence div;
@@ -739,9 +731,7 @@ TEST_F(ReconcilerWindowedTest, DivergedConfirmed_ResolvesToMatched) {
     ASSERT_NE(os, nullptr);
 
     // Confirm divergence by expiring timer
-    timer_wheel->poll_expired(ns_to_tsc(50'000'000), [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(ns_to_tsc(50'000'000));
 
     EXPECT_EQ(os->recon_state, ReconState::DivergedConfirmed);
     EXPECT_EQ(counters_.mismatch_confirmed, 1u);
@@ -827,17 +817,16 @@ TEST_F(ReconcilerWindowedTest, TimerWheelStats_Tracked) {
                                ns_to_tsc(1'000'000), "ORD1", 1, "EX1");
     reconciler.process_event_for_test(dropcopy);
 
-    // Check timer was scheduled
-    const auto& stats = timer_wheel->stats();
-    EXPECT_GE(stats.scheduled, 1u);
+    // Check timer was scheduled (on the grace FIFO, not the wheel)
+    EXPECT_GE(reconciler.timer_stats().scheduled, 1u);
+    EXPECT_EQ(timer_wheel->stats().scheduled, 0u);
 
     // Fire timer
-    timer_wheel->poll_expired(ns_to_tsc(50'000'000), [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(ns_to_tsc(50'000'000));
 
     // Check timer expired
-    EXPECT_GE(stats.expired, 1u);
+    EXPECT_GE(reconciler.timer_stats().expired, 1u);
+    EXPECT_EQ(reconciler.pending_timers(), 0u);
 }
 
 // ============================================================================
@@ -935,9 +924,7 @@ TEST_F(ReconcilerWindowedTest, GapClosesAfterTimeout) {
     // otherwise timer reschedules use stale time causing infinite loop.
     const auto poll_time = ns_to_tsc(200'000'000);
     reconciler.set_last_poll_tsc_for_test(poll_time);
-    timer_wheel->poll_expired(poll_time, [&](OrderKey k, std::uint32_t g) {
-        reconciler.on_grace_deadline_expired(k, g);
-    });
+    reconciler.poll_timers(poll_time);
 
     // Gap should be closed by timeout
     EXPECT_GE(counters_.gaps_closed_by_timeout, 1u);
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/order_soa_mirror.hpp"
+#include "core/order_state_store.hpp"
+#include "util/arena.hpp"
+
+namespace {
+
+constexpr std::int64_t I64_MIN = std::numeric_limits<std::int64_t>::min();
+constexpr std::int64_t I64_MAX = std::numeric_limits<std::int64_t>::max();
+
+// Random per-side values drawn from a small pool so sides often agree, with
+// extremes mixed in to exercise the overflow-safe difference
+core::OrderState random_state(std::mt19937_64& rng) {
+    static constexpr std::int64_t VALUES[] = {0, 1, 100, 101, 1'000'000, -5, I64_MIN, I64_MAX};
+    static constexpr std::uint64_t EXEC_IDS[] = {0, 0xABCD, 0xABCE};
+    static constexpr core::OrdStatus STATUSES[] = {core::OrdStatus::New, core::OrdStatus::PartiallyFilled,
+                                                   core::OrdStatus::Filled, core::OrdStatus::Canceled};
+    core::OrderState os{};
+    for (std::size_t side = 0; side < core::SOURCE_COUNT; ++side) {
+        os.seen[side] = (rng() & 3u) != 0;
+        os.cum_qty[side] = VALUES[rng() % std::size(VALUES)];
+        os.avg_px[side] = VALUES[rng() % std::size(VALUES)];
+        os.exec_id_hash[side] = EXEC_IDS[rng() % std::size(EXEC_IDS)];
+        os.status[side] = STATUSES[rng() % std::size(STATUSES)];
+    }
+    return os;
+}
+
+core::ExecEvent make_event(core::Source src, const std::string& cid, core::OrdStatus status, std::int64_t cum_qty) {
+    core::ExecEvent ev{};
+    ev.source = src;
+    ev.ord_status = status;
+    ev.exec_type = core::ExecType::New;
+    ev.cum_qty = cum_qty;
+    ev.price_micro = 1'000'000;
+    ev.set_clord_id(cid.data(), cid.size());
+    ev.set_exec_id("E1", 2);
+    return ev;
+}
+
+// Mirror verdict of every bucket equals compute_mismatch on the bucket's record
+void expect_mirror_matches_store(const core::OrderStateStore& store) {
+    const core::OrderSoaMirror& mirror = *store.mirror();
+    std::vector<core::MismatchMask> masks(store.bucket_count());
+    mirror.evaluate(0, masks.size(), 0, 0, core::DEFAULT_REQUIRED_SIDES, masks.data());
+    for (std::size_t slot = 0; slot < masks.size(); ++slot) {
+        const core::OrderState* os = store.slot_state(slot);
+        const core::MismatchMask expected = os ? core::compute_mismatch(*os) : core::MismatchMask{};
+        ASSERT_EQ(masks[slot].bits(), expected.bits()) << "slot " << slot;
+    }
+}
+
+} // namespace
+
+// OrderSoaMirror_MatchesComputeMismatch - Kernel output equals compute_mismatch for every slot and range
+TEST(OrderSoaMirrorTest, MatchesComputeMismatch) {
+    constexpr std::size_t SLOTS = 1000;
+    std::mt19937_64 rng(86);
+    std::vector<core::OrderState> states(SLOTS);
+    core::OrderSoaMirror mirror(SLOTS);
+    for (std::size_t slot = 0; slot < SLOTS; ++slot) {
+        states[slot] = random_state(rng);
+        mirror.capture(slot, states[slot]);
+    }
+
+    struct Params {
+        std::int64_t qty_tol;
+        std::int64_t px_tol;
+        std::uint8_t required;
+    };
+    const Params params[] = {
+        {0, 0, core::DEFAULT_REQUIRED_SIDES},
+        {1, 5, core::DEFAULT_REQUIRED_SIDES},
+        {I64_MAX, 0, core::DEFAULT_REQUIRED_SIDES},
+        {-1, -1, core::DEFAULT_REQUIRED_SIDES},  // Converts to the largest unsigned tolerance
+        {0, 0, 0},
+        {0, 0, static_cast<std::uint8_t>((1u << core::SOURCE_COUNT) - 1)},
+    };
+    // Unaligned starts and lengths leave scalar tails on both ends
+    const std::size_t ranges[][2] = {{0, SLOTS}, {3, 517}, {SLOTS - 7, 7}, {11, 1}};
+
+    std::vector<core::MismatchMask> masks(SLOTS);
+    for (const Params& p : params) {
+        for (const auto& r : ranges) {
+            mirror.evaluate(r[0], r[1], p.qty_tol, p.px_tol, p.required, masks.data());
+            for (std::size_t i = 0; i < r[1]; ++i) {
+                const core::MismatchMask expected =
+                    core::compute_mismatch(states[r[0] + i], p.qty_tol, p.px_tol, p.required);
+                ASSERT_EQ(masks[i].bits(), expected.bits())
+                    << "slot " << r[0] + i << " kernel " << core::OrderSoaMirror::kernel_name();
+            }
+        }
+    }
+}
+
+// OrderSoaMirror_ForEachMismatchVisitsOnlyMismatches - Cleared slots and agreeing orders are skipped
+TEST(OrderSoaMirrorTest, ForEachMismatchVisitsOnlyMismatches) {
+    core::OrderSoaMirror mirror(600);
+
+    core::OrderState agree{};
+    agree.seen[0] = agree.seen[1] = true;
+    agree.cum_qty[0] = agree.cum_qty[1] = 100;
+    core::OrderState differ = agree;
+    differ.cum_qty[1] = 90;
+
+    for (std::size_t slot = 0; slot < 600; ++slot) {
+        mirror.capture(slot, slot % 100 == 42 ? differ : agree);
+    }
+    mirror.capture(300, differ);
+    mirror.clear(300);
+
+    std::vector<std::size_t> visited;
+    const std::size_t found = mirror.for_each_mismatch(
+        0, 600, 0, 0, core::DEFAULT_REQUIRED_SIDES, [&](std::size_t slot, core::MismatchMask m) {
+            EXPECT_TRUE(m.has(core::MismatchMask::CUM_QTY));
+            visited.push_back(slot);
+        });
+    EXPECT_EQ(found, 6u);
+    EXPECT_EQ(visited, (std::vector<std::size_t>{42, 142, 242, 342, 442, 542}));
+}
+
+// OrderSoaMirror_StoreKeepsSlotsAligned - Upserts, refreshes, compaction shifts and resets track the store
+TEST(OrderSoaMirrorTest, StoreKeepsSlotsAligned) {
+    util::Arena arena{1 << 20};
+    core::OrderStateStore store(arena, 8);  // Small table so clusters form and erase shifts entries
+    core::OrderSoaMirror too_small(store.bucket_count() - 1);
+    EXPECT_FALSE(store.attach_mirror(&too_small));
+
+    std::vector<std::string> cids;
+    for (int i = 0; i < 8; ++i) {
+        const std::string cid = "SOA" + std::to_string(i);
+        core::OrderState* os = store.upsert(make_event(core::Source::Primary, cid, core::OrdStatus::New, 0));
+        ASSERT_NE(os, nullptr);
+        ASSERT_TRUE(core::apply_exec(*os, make_event(core::Source::Primary, cid, core::OrdStatus::New, 0)));
+        cids.push_back(cid);
+    }
+
+    // Attaching captures what is already live
+    core::OrderSoaMirror mirror(store.bucket_count());
+    ASSERT_TRUE(store.attach_mirror(&mirror));
+    expect_mirror_matches_store(store);
+
+    // Half the orders get a matching drop copy, one a disagreeing fill
+    for (std::size_t i = 0; i < cids.size(); i += 2) {
+        const auto dc = make_event(core::Source::DropCopy, cids[i], core::OrdStatus::New, 0);
+        core::OrderState* os = store.upsert(dc);
+        ASSERT_TRUE(core::apply_exec(*os, dc));
+        store.refresh_mirror(*os);
+    }
+    const auto fill = make_event(core::Source::DropCopy, cids[1], core::OrdStatus::PartiallyFilled, 10);
+    core::OrderState* filled = store.upsert(fill);
+    ASSERT_TRUE(core::apply_exec(*filled, fill));
+    store.refresh_mirror(*filled);
+    expect_mirror_matches_store(store);
+
+    for (std::size_t i = 0; i < cids.size(); i += 3) {
+        ASSERT_TRUE(store.compact(core::make_order_key(make_event(core::Source::Primary, cids[i],
+                                                                  core::OrdStatus::New, 0))));
+    }
+    expect_mirror_matches_store(store);
+
+    store.reset_epoch();
+    std::vector<core::MismatchMask> masks(store.bucket_count());
+    EXPECT_EQ(mirror.for_each_mismatch(0, masks.size(), 0, 0, core::DEFAULT_REQUIRED_SIDES,
+                                       [](std::size_t, core::MismatchMask) {}),
+              0u);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -109,4 +111,261 @@ TEST_F(OrderStateStoreTest, OverflowPath) {
     EXPECT_GE(store.overflow_count(), failed_inserts);
 }
 
+TEST_F(OrderStateStoreTest, CompactReplacesStateWithTombstone) {
+    core::OrderStateStore store(arena_, 64);
+    auto ev = make_event("DONE1");
+    ev.ord_status = core::OrdStatus::Filled;
+    ev.cum_qty = 1'000'000;
+    const auto key = core::make_order_key(ev);
+
+    core::OrderState* st = store.upsert(ev);
+    ASSERT_NE(st, nullptr);
+    st->status[core::SideIndex::PRIMARY] = core::OrdStatus::Filled;
+    st->cum_qty[core::SideIndex::PRIMARY] = 1'000'000;
+
+    EXPECT_TRUE(store.compact(key));
+    EXPECT_EQ(store.find(key), nullptr);
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_EQ(store.tombstone_count(), 1u);
+    EXPECT_EQ(store.compacted_count(), 1u);
+    EXPECT_EQ(store.free_pool_size(), 1u);
+
+    const core::OrderTombstone* tomb = store.find_tombstone(key);
+    ASSERT_NE(tomb, nullptr);
+    EXPECT_EQ(tomb->key, key);
+    EXPECT_EQ(tomb->final_status, core::OrdStatus::Filled);
+    EXPECT_TRUE(core::tombstone_matches(*tomb, ev));
+
+    ev.cum_qty = 2'000'000;
+    EXPECT_FALSE(core::tombstone_matches(*tomb, ev));
+
+    EXPECT_FALSE(store.compact(key));
+}
+
+TEST_F(OrderStateStoreTest, UpsertDoesNotRecreateTombstonedOrder) {
+    core::OrderStateStore store(arena_, 64);
+    const auto ev = make_event("LATE1");
+    const auto key = core::make_order_key(ev);
+
+    ASSERT_NE(store.upsert(ev), nullptr);
+    ASSERT_TRUE(store.compact(key));
+
+    EXPECT_EQ(store.upsert(ev), nullptr);
+    EXPECT_EQ(store.find(key), nullptr);
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_EQ(store.overflow_count(), 0u);
+    EXPECT_EQ(store.free_pool_size(), 1u);
+}
+
+TEST_F(OrderStateStoreTest, FreePoolRecyclesCompactedRecords) {
+    util::Arena small_arena(sizeof(core::OrderState) * 2 + 64);
+    core::OrderStateStore store(small_arena, 16);
+
+    const auto a = make_event("POOL_A");
+    const auto b = make_event("POOL_B");
+    const auto c = make_event("POOL_C");
+
+    core::OrderState* sa = store.upsert(a);
+    core::OrderState* sb = store.upsert(b);
+    ASSERT_NE(sa, nullptr);
+    ASSERT_NE(sb, nullptr);
+    sa->divergence_count = 7;
+
+    // The arena held two slots; only a recycled record can satisfy the next insert
+    ASSERT_TRUE(store.compact(core::make_order_key(a)));
+    core::OrderState* sc = store.upsert(c);
+    ASSERT_EQ(sc, sa);
+    EXPECT_EQ(sc->key, core::make_order_key(c));
+    EXPECT_EQ(sc->divergence_count, 0u);
+    EXPECT_EQ(sc->recon_state, core::ReconState::Unknown);
+    EXPECT_EQ(store.free_pool_size(), 0u);
+    EXPECT_EQ(store.find(core::make_order_key(b)), sb);
+}
+
+TEST_F(OrderStateStoreTest, PoolHandleDetectsRecycledRecord) {
+    util::Arena small_arena(sizeof(core::OrderState) * 2 + 64);
+    core::OrderStateStore store(small_arena, 16);
+    EXPECT_EQ(store.pool_capacity(), 2u);
+
+    const auto a = make_event("HANDLE_A");
+    core::OrderState* sa = store.upsert(a);
+    ASSERT_NE(sa, nullptr);
+    const std::uint32_t handle_a = sa->pool_handle;
+    ASSERT_NE(handle_a, 0u);
+    EXPECT_EQ(store.resolve(handle_a), sa);
+
+    ASSERT_TRUE(store.compact(core::make_order_key(a)));
+    EXPECT_EQ(store.resolve(handle_a), nullptr);
+
+    // Same slot, new generation: the old handle must not reach the new order
+    core::OrderState* sb = store.upsert(make_event("HANDLE_B"));
+    ASSERT_EQ(sb, sa);
+    EXPECT_NE(sb->pool_handle, handle_a);
+    EXPECT_EQ(store.resolve(handle_a), nullptr);
+    EXPECT_EQ(store.resolve(sb->pool_handle), sb);
+
+    const std::uint32_t handle_b = sb->pool_handle;
+    store.reset_epoch();
+    EXPECT_EQ(store.resolve(handle_b), nullptr);
+    ASSERT_NE(store.upsert(make_event("HANDLE_C")), nullptr);
+    EXPECT_EQ(store.resolve(handle_b), nullptr);
+}
+
+TEST_F(OrderStateStoreTest, CompactKeepsCollidingKeysReachable) {
+    core::OrderStateStore store(arena_, 32);
+
+    std::vector<core::ExecEvent> events;
+    for (int i = 0; i < 48; ++i) {
+        events.push_back(make_event("CLUSTER" + std::to_string(i)));
+    }
+    std::vector<core::OrderState*> states;
+    for (const auto& ev : events) {
+        states.push_back(store.upsert(ev));
+        ASSERT_NE(states.back(), nullptr);
+    }
+
+    // Remove every third order; backward-shift deletion must keep the rest findable
+    for (std::size_t i = 0; i < events.size(); i += 3) {
+        ASSERT_TRUE(store.compact(core::make_order_key(events[i])));
+    }
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const auto key = core::make_order_key(events[i]);
+        if (i % 3 == 0) {
+            EXPECT_EQ(store.find(key), nullptr);
+            EXPECT_NE(store.find_tombstone(key), nullptr);
+        } else {
+            EXPECT_EQ(store.find(key), states[i]);
+            EXPECT_EQ(store.find_tombstone(key), nullptr);
+        }
+    }
+    EXPECT_EQ(store.size() + store.tombstone_count(), events.size());
+}
+
+TEST_F(OrderStateStoreTest, CompactSweepHonoursBudgetAndPredicate) {
+    core::OrderStateStore store(arena_, 32);
+    for (int i = 0; i < 20; ++i) {
+        core::OrderState* st = store.upsert(make_event("SWEEP" + std::to_string(i)));
+        ASSERT_NE(st, nullptr);
+        st->divergence_count = static_cast<std::uint32_t>(i);
+    }
+
+    const auto even = [](core::OrderState& os) { return os.divergence_count % 2 == 0; };
+
+    std::size_t compacted = store.compact_sweep(1, even);
+    EXPECT_LE(compacted, 1u);
+
+    // A full pass over the table compacts every matching order exactly once
+    compacted += store.compact_sweep(store.bucket_count(), even);
+    compacted += store.compact_sweep(store.bucket_count(), even);
+    EXPECT_EQ(compacted, 10u);
+    EXPECT_EQ(store.size(), 10u);
+    EXPECT_EQ(store.tombstone_count(), 10u);
+}
+
+TEST_F(OrderStateStoreTest, TombstoneTableOverflowKeepsFullRecord) {
+    core::OrderStateStore store(arena_, 64, 1);
+    const std::size_t tomb_slots = store.tombstone_bucket_count();
+
+    std::size_t compacted = 0;
+    std::vector<core::OrderKey> keys;
+    for (std::size_t i = 0; i < tomb_slots + 4; ++i) {
+        const auto ev = make_event("TOMB" + std::to_string(i));
+        ASSERT_NE(store.upsert(ev), nullptr);
+        keys.push_back(core::make_order_key(ev));
+    }
+    for (const auto key : keys) {
+        if (store.compact(key)) {
+            ++compacted;
+        } else {
+            EXPECT_NE(store.find(key), nullptr);
+        }
+    }
+
+    EXPECT_EQ(compacted, tomb_slots);
+    EXPECT_EQ(store.tombstone_overflow_count(), keys.size() - tomb_slots);
+}
+
+TEST_F(OrderStateStoreTest, ResetEpochClearsTombstones) {
+    core::OrderStateStore store(arena_, 8);
+    const auto ev = make_event("RESET_TOMB");
+    const auto key = core::make_order_key(ev);
+
+    ASSERT_NE(store.upsert(ev), nullptr);
+    ASSERT_TRUE(store.compact(key));
+    store.reset_epoch();
+
+    EXPECT_EQ(store.find_tombstone(key), nullptr);
+    EXPECT_EQ(store.tombstone_count(), 0u);
+    EXPECT_EQ(store.free_pool_size(), 0u);
+    EXPECT_NE(store.upsert(ev), nullptr);
+}
+
+TEST_F(OrderStateStoreTest, TombstoneFootprintIsTenfoldSmaller) {
+    // Full record: OrderState plus two index buckets (key + pointer each)
+    constexpr std::size_t full_bytes = sizeof(core::OrderState) + 2 * (sizeof(core::OrderKey) + sizeof(void*));
+    static_assert(sizeof(core::OrderTombstone) == 16);
+    EXPECT_GT(full_bytes, 10 * sizeof(core::OrderTombstone));
+
+    // Tombstone table is sized for ~80% load: 1.25 slots (20 bytes) per compacted order
+    core::OrderStateStore store(arena_, 1000);
+    EXPECT_EQ(store.tombstone_bucket_count(), 1250u);
+    EXPECT_GT(full_bytes, 10 * (store.tombstone_bucket_count() * sizeof(core::OrderTombstone)) / 1000);
+}
+
+// OrderStateStore_PartitionQuotaIsolatesRunawayFlow - A flooding partition overflows only its own quota
+TEST_F(OrderStateStoreTest, PartitionQuotaIsolatesRunawayFlow) {
+    const std::size_t quotas[] = {4, 4};
+    core::OrderStateStore store(arena_, quotas);
+    ASSERT_EQ(store.partition_count(), 2u);
+    EXPECT_GE(store.bucket_count(), 16u);  // Load stays <= 50% with both partitions full
+
+    std::vector<core::OrderKey> runaway;
+    for (int i = 0; i < 10; ++i) {
+        auto ev = make_event("RUNAWAY" + std::to_string(i));
+        ev.partition = 1;
+        if (core::OrderState* st = store.upsert(ev)) {
+            EXPECT_EQ(st->partition, 1u);
+            runaway.push_back(st->key);
+        }
+    }
+    EXPECT_EQ(runaway.size(), 4u);
+    EXPECT_EQ(store.partition_stats(1).live, 4u);
+    EXPECT_EQ(store.partition_stats(1).overflow, 6u);
+
+    // The other desk still has its full quota
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NE(store.upsert(make_event("DESK0_" + std::to_string(i))), nullptr);
+    }
+    EXPECT_EQ(store.partition_stats(0).live, 4u);
+    EXPECT_EQ(store.partition_stats(0).overflow, 0u);
+
+    // Compaction returns quota to its partition
+    ASSERT_TRUE(store.compact(runaway.front()));
+    EXPECT_EQ(store.partition_stats(1).live, 3u);
+    auto again = make_event("RUNAWAY_AGAIN");
+    again.partition = 1;
+    EXPECT_NE(store.upsert(again), nullptr);
+
+    // Tags beyond the configured partitions are charged to partition 0
+    auto stray = make_event("STRAY");
+    stray.partition = 9;
+    EXPECT_EQ(store.partition_of(stray), 0u);
+    EXPECT_EQ(store.upsert(stray), nullptr);
+    EXPECT_EQ(store.partition_stats(0).overflow, 1u);
+
+    store.reset_epoch();
+    EXPECT_EQ(store.partition_stats(1).live, 0u);
+    EXPECT_EQ(store.partition_stats(1).overflow, 0u);
+    EXPECT_EQ(store.partition_stats(1).quota, 4u);
+}
+
+// OrderStateStore_PartitionQuotasValidated - Empty, zero or too many quotas are rejected
+TEST_F(OrderStateStoreTest, PartitionQuotasValidated) {
+    const std::size_t zero[] = {4, 0};
+    const std::size_t too_many[core::MAX_STORE_PARTITIONS + 1] = {};
+    EXPECT_THROW(core::OrderStateStore(arena_, std::span<const std::size_t>{}), std::invalid_argument);
+    EXPECT_THROW(core::OrderStateStore(arena_, zero), std::invalid_argument);
+    EXPECT_THROW(core::OrderStateStore(arena_, too_many), std::invalid_argument);
+}
+
 } // namespace
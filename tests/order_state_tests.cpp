@@ -27,21 +27,21 @@ TEST(OrderStateTest, CreateOrderStateInitialization) {
     ASSERT_NE(state, nullptr);
 
     EXPECT_EQ(state->key, expected_key);
-    EXPECT_EQ(state->internal_cum_qty, 0);
-    EXPECT_EQ(state->internal_avg_px, 0);
-    EXPECT_EQ(state->dropcopy_cum_qty, 0);
-    EXPECT_EQ(state->dropcopy_avg_px, 0);
-    EXPECT_EQ(state->internal_status, core::OrdStatus::Unknown);
-    EXPECT_EQ(state->dropcopy_status, core::OrdStatus::Unknown);
-    EXPECT_EQ(state->last_internal_exec_id_len, 0);
-    EXPECT_EQ(state->last_dropcopy_exec_id_len, 0);
-    EXPECT_FALSE(state->seen_internal);
-    EXPECT_FALSE(state->seen_dropcopy);
+    EXPECT_EQ(state->cum_qty[core::SideIndex::PRIMARY], 0);
+    EXPECT_EQ(state->avg_px[core::SideIndex::PRIMARY], 0);
+    EXPECT_EQ(state->cum_qty[core::SideIndex::DROPCOPY], 0);
+    EXPECT_EQ(state->avg_px[core::SideIndex::DROPCOPY], 0);
+    EXPECT_EQ(state->status[core::SideIndex::PRIMARY], core::OrdStatus::Unknown);
+    EXPECT_EQ(state->status[core::SideIndex::DROPCOPY], core::OrdStatus::Unknown);
+    EXPECT_EQ(state->exec_id_hash[core::SideIndex::PRIMARY], 0u);
+    EXPECT_EQ(state->exec_id_hash[core::SideIndex::DROPCOPY], 0u);
+    EXPECT_FALSE(state->seen[core::SideIndex::PRIMARY]);
+    EXPECT_FALSE(state->seen[core::SideIndex::DROPCOPY]);
     EXPECT_FALSE(state->has_divergence);
     EXPECT_FALSE(state->has_gap);
     EXPECT_EQ(state->divergence_count, 0);
-    EXPECT_EQ(state->last_internal_exec_id[0], '\0');
-    EXPECT_EQ(state->last_dropcopy_exec_id[0], '\0');
+    EXPECT_FALSE(state->seen[core::SideIndex::PRIME_BROKER]);
+    EXPECT_EQ(state->status[core::SideIndex::PRIME_BROKER], core::OrdStatus::Unknown);
 }
 
 // ============================================================================
@@ -55,8 +55,8 @@ TEST(OrderStateTest, DefaultInit_ReconFieldsZeroed) {
 
     // Verify recon overlay fields are properly initialized
     EXPECT_EQ(state->recon_state, core::ReconState::Unknown);
-    EXPECT_EQ(state->primary_last_seen_tsc, 0u);
-    EXPECT_EQ(state->dropcopy_last_seen_tsc, 0u);
+    EXPECT_EQ(state->last_seen_tsc[core::SideIndex::PRIMARY], 0u);
+    EXPECT_EQ(state->last_seen_tsc[core::SideIndex::DROPCOPY], 0u);
     EXPECT_EQ(state->mismatch_first_seen_tsc, 0u);
     EXPECT_EQ(state->recon_deadline_tsc, 0u);
     EXPECT_EQ(state->timer_generation, 0u);
@@ -66,8 +66,8 @@ TEST(OrderStateTest, DefaultInit_ReconFieldsZeroed) {
 
 TEST(ComputeMismatchTest, NoneSeen_ReturnsEmpty) {
     core::OrderState os{};
-    os.seen_internal = false;
-    os.seen_dropcopy = false;
+    os.seen[core::SideIndex::PRIMARY] = false;
+    os.seen[core::SideIndex::DROPCOPY] = false;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.none());
@@ -75,8 +75,8 @@ TEST(ComputeMismatchTest, NoneSeen_ReturnsEmpty) {
 
 TEST(ComputeMismatchTest, ExistenceMismatch_PrimaryOnly) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = false;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = false;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::EXISTENCE));
@@ -87,8 +87,8 @@ TEST(ComputeMismatchTest, ExistenceMismatch_PrimaryOnly) {
 
 TEST(ComputeMismatchTest, ExistenceMismatch_DropCopyOnly) {
     core::OrderState os{};
-    os.seen_internal = false;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = false;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::EXISTENCE));
@@ -98,10 +98,10 @@ TEST(ComputeMismatchTest, ExistenceMismatch_DropCopyOnly) {
 
 TEST(ComputeMismatchTest, StatusMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::Working;
-    os.dropcopy_status = core::OrdStatus::Filled;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::Working;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::STATUS));
@@ -109,12 +109,12 @@ TEST(ComputeMismatchTest, StatusMismatch) {
 
 TEST(ComputeMismatchTest, CumQtyMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::PartiallyFilled;
-    os.dropcopy_status = core::OrdStatus::PartiallyFilled;
-    os.internal_cum_qty = 100;
-    os.dropcopy_cum_qty = 200;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::PartiallyFilled;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::PartiallyFilled;
+    os.cum_qty[core::SideIndex::PRIMARY] = 100;
+    os.cum_qty[core::SideIndex::DROPCOPY] = 200;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::CUM_QTY));
@@ -122,12 +122,12 @@ TEST(ComputeMismatchTest, CumQtyMismatch) {
 
 TEST(ComputeMismatchTest, AvgPxMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::Filled;
-    os.dropcopy_status = core::OrdStatus::Filled;
-    os.internal_avg_px = 1000000;  // micro-units
-    os.dropcopy_avg_px = 1000500;  // micro-units
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::Filled;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
+    os.avg_px[core::SideIndex::PRIMARY] = 1000000;  // micro-units
+    os.avg_px[core::SideIndex::DROPCOPY] = 1000500;  // micro-units
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::AVG_PX));
@@ -135,14 +135,12 @@ TEST(ComputeMismatchTest, AvgPxMismatch) {
 
 TEST(ComputeMismatchTest, ExecIdMismatch_LenDiffers) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::New;
-    os.dropcopy_status = core::OrdStatus::New;
-    std::memcpy(os.last_internal_exec_id, "EXEC1", 5);
-    os.last_internal_exec_id_len = 5;
-    std::memcpy(os.last_dropcopy_exec_id, "EXEC123", 7);
-    os.last_dropcopy_exec_id_len = 7;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::New;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+    os.exec_id_hash[core::SideIndex::PRIMARY] = core::exec_id_fingerprint("EXEC1", 5);
+    os.exec_id_hash[core::SideIndex::DROPCOPY] = core::exec_id_fingerprint("EXEC123", 7);
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::EXEC_ID));
@@ -150,14 +148,12 @@ TEST(ComputeMismatchTest, ExecIdMismatch_LenDiffers) {
 
 TEST(ComputeMismatchTest, ExecIdMismatch_ContentDiffers) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::New;
-    os.dropcopy_status = core::OrdStatus::New;
-    std::memcpy(os.last_internal_exec_id, "EXEC1", 5);
-    os.last_internal_exec_id_len = 5;
-    std::memcpy(os.last_dropcopy_exec_id, "EXEC2", 5);
-    os.last_dropcopy_exec_id_len = 5;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::New;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+    os.exec_id_hash[core::SideIndex::PRIMARY] = core::exec_id_fingerprint("EXEC1", 5);
+    os.exec_id_hash[core::SideIndex::DROPCOPY] = core::exec_id_fingerprint("EXEC2", 5);
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::EXEC_ID));
@@ -165,14 +161,12 @@ TEST(ComputeMismatchTest, ExecIdMismatch_ContentDiffers) {
 
 TEST(ComputeMismatchTest, ExecIdMatches_NoMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::New;
-    os.dropcopy_status = core::OrdStatus::New;
-    std::memcpy(os.last_internal_exec_id, "SAME1", 5);
-    os.last_internal_exec_id_len = 5;
-    std::memcpy(os.last_dropcopy_exec_id, "SAME1", 5);
-    os.last_dropcopy_exec_id_len = 5;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::New;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+    os.exec_id_hash[core::SideIndex::PRIMARY] = core::exec_id_fingerprint("SAME1", 5);
+    os.exec_id_hash[core::SideIndex::DROPCOPY] = core::exec_id_fingerprint("SAME1", 5);
 
     auto mask = core::compute_mismatch(os);
     EXPECT_FALSE(mask.has(core::MismatchMask::EXEC_ID));
@@ -180,17 +174,17 @@ TEST(ComputeMismatchTest, ExecIdMatches_NoMismatch) {
 
 TEST(ComputeMismatchTest, MultipleBits) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
     // Status mismatch
-    os.internal_status = core::OrdStatus::Working;
-    os.dropcopy_status = core::OrdStatus::Filled;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::Working;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
     // CumQty mismatch
-    os.internal_cum_qty = 100;
-    os.dropcopy_cum_qty = 200;
+    os.cum_qty[core::SideIndex::PRIMARY] = 100;
+    os.cum_qty[core::SideIndex::DROPCOPY] = 200;
     // AvgPx mismatch
-    os.internal_avg_px = 1000;
-    os.dropcopy_avg_px = 2000;
+    os.avg_px[core::SideIndex::PRIMARY] = 1000;
+    os.avg_px[core::SideIndex::DROPCOPY] = 2000;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.has(core::MismatchMask::STATUS));
@@ -202,12 +196,12 @@ TEST(ComputeMismatchTest, LeavesQtyNotComputed_V1) {
     // LEAVES_QTY is not computed in v1 because order_qty is not tracked.
     // Verify it remains unset regardless of other mismatches.
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::PartiallyFilled;
-    os.dropcopy_status = core::OrdStatus::PartiallyFilled;
-    os.internal_cum_qty = 50;
-    os.dropcopy_cum_qty = 50;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::PartiallyFilled;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::PartiallyFilled;
+    os.cum_qty[core::SideIndex::PRIMARY] = 50;
+    os.cum_qty[core::SideIndex::DROPCOPY] = 50;
 
     auto mask = core::compute_mismatch(os);
     // LEAVES_QTY should never be set in v1
@@ -216,22 +210,84 @@ TEST(ComputeMismatchTest, LeavesQtyNotComputed_V1) {
 
 TEST(ComputeMismatchTest, BothSeenAndMatch_ReturnsEmpty) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
-    os.internal_status = core::OrdStatus::Filled;
-    os.dropcopy_status = core::OrdStatus::Filled;
-    os.internal_cum_qty = 100;
-    os.dropcopy_cum_qty = 100;
-    os.internal_avg_px = 1000;
-    os.dropcopy_avg_px = 1000;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::Filled;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::Filled;
+    os.cum_qty[core::SideIndex::PRIMARY] = 100;
+    os.cum_qty[core::SideIndex::DROPCOPY] = 100;
+    os.avg_px[core::SideIndex::PRIMARY] = 1000;
+    os.avg_px[core::SideIndex::DROPCOPY] = 1000;
     // Empty exec IDs
-    os.last_internal_exec_id_len = 0;
-    os.last_dropcopy_exec_id_len = 0;
+    os.exec_id_hash[core::SideIndex::PRIMARY] = 0;
+    os.exec_id_hash[core::SideIndex::DROPCOPY] = 0;
 
     auto mask = core::compute_mismatch(os);
     EXPECT_TRUE(mask.none());
 }
 
+// ============================================================================
+// Three-way (pairwise) mismatch
+// ============================================================================
+
+TEST(PairwiseMismatchTest, PrimeBrokerQtyDiffers_OnlyPrimeBrokerPairsFlagged) {
+    core::OrderState os{};
+    for (std::size_t i = 0; i < core::SOURCE_COUNT; ++i) {
+        os.seen[i] = true;
+        os.status[i] = core::OrdStatus::Filled;
+        os.cum_qty[i] = 100;
+        os.avg_px[i] = 1000;
+    }
+    os.cum_qty[core::SideIndex::PRIME_BROKER] = 90;
+
+    const auto pairs = core::compute_pairwise_mismatch(os, 0, 0);
+    EXPECT_TRUE(pairs.between(core::Source::Primary, core::Source::DropCopy).none());
+    EXPECT_TRUE(pairs.between(core::Source::Primary, core::Source::PrimeBroker).has(core::MismatchMask::CUM_QTY));
+    EXPECT_TRUE(pairs.between(core::Source::PrimeBroker, core::Source::DropCopy).has(core::MismatchMask::CUM_QTY));
+    EXPECT_EQ(pairs.combined().bits(), core::MismatchMask::CUM_QTY);
+}
+
+TEST(PairwiseMismatchTest, PrimeBrokerNotRequired_AbsenceIsNotExistence) {
+    core::OrderState os{};
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::New;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+
+    EXPECT_TRUE(core::compute_mismatch(os).none());
+}
+
+TEST(PairwiseMismatchTest, PrimeBrokerRequired_AbsenceIsExistence) {
+    core::OrderState os{};
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
+    os.status[core::SideIndex::PRIMARY] = core::OrdStatus::New;
+    os.status[core::SideIndex::DROPCOPY] = core::OrdStatus::New;
+
+    const std::uint8_t all_sides = core::DEFAULT_REQUIRED_SIDES | core::source_bit(core::Source::PrimeBroker);
+    const auto pairs = core::compute_pairwise_mismatch(os, 0, 0, all_sides);
+    EXPECT_TRUE(pairs.between(core::Source::Primary, core::Source::DropCopy).none());
+    EXPECT_EQ(pairs.between(core::Source::Primary, core::Source::PrimeBroker).bits(), core::MismatchMask::EXISTENCE);
+    EXPECT_EQ(pairs.between(core::Source::DropCopy, core::Source::PrimeBroker).bits(), core::MismatchMask::EXISTENCE);
+}
+
+TEST(PairwiseMismatchTest, ApplyExec_UsesEventSourceSlot) {
+    core::ExecEvent ev{};
+    ev.source = core::Source::PrimeBroker;
+    ev.ord_status = core::OrdStatus::New;
+    ev.cum_qty = 7;
+    ev.set_clord_id("CID", 3);
+    ev.set_exec_id("PB1", 3);
+    core::OrderState os{};
+    os.key = core::make_order_key(ev);
+
+    ASSERT_TRUE(core::apply_exec(os, ev));
+    EXPECT_TRUE(os.seen[core::SideIndex::PRIME_BROKER]);
+    EXPECT_FALSE(os.seen[core::SideIndex::PRIMARY]);
+    EXPECT_EQ(os.cum_qty[core::SideIndex::PRIME_BROKER], 7);
+    EXPECT_EQ(os.exec_id_hash[core::SideIndex::PRIME_BROKER], core::exec_id_fingerprint("PB1", 3));
+}
+
 // ============================================================================
 // FX-7053 Part 1: Divergence Deduplication Tests
 // ============================================================================
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "util/arena.hpp"
+#include "util/pool.hpp"
+
+namespace {
+
+struct Record {
+    std::uint64_t id;
+    std::uint32_t value;
+};
+
+using RecordPool = util::Pool<Record>;
+
+} // namespace
+
+// Pool_SlotsAreCacheLineAligned - Each slot starts on its own cache line
+TEST(PoolTest, SlotsAreCacheLineAligned) {
+    static_assert(RecordPool::SLOT_BYTES == 64);
+    util::Arena arena{1 << 12};
+    RecordPool pool(arena, 8);
+    ASSERT_EQ(pool.capacity(), 8u);
+
+    const util::PoolHandle a = pool.allocate();
+    const util::PoolHandle b = pool.allocate();
+    ASSERT_NE(a, util::NULL_POOL_HANDLE);
+    ASSERT_NE(b, util::NULL_POOL_HANDLE);
+    const auto pa = reinterpret_cast<std::uintptr_t>(pool.at(a));
+    const auto pb = reinterpret_cast<std::uintptr_t>(pool.at(b));
+    EXPECT_EQ(pa % 64, 0u);
+    EXPECT_EQ(pb - pa, 64u);
+    EXPECT_EQ(pool.handle_of(pool.at(b)), b);
+}
+
+// Pool_ReleasedHandleGoesStale - A reused slot gets a new handle; the old one resolves to nullptr
+TEST(PoolTest, ReleasedHandleGoesStale) {
+    util::Arena arena{1 << 12};
+    RecordPool pool(arena, 4);
+
+    const util::PoolHandle a = pool.allocate();
+    pool.at(a)->id = 1;
+    EXPECT_EQ(pool.get(a), pool.at(a));
+    EXPECT_EQ(pool.size(), 1u);
+
+    pool.release(a);
+    EXPECT_EQ(pool.get(a), nullptr);
+    EXPECT_EQ(pool.free_count(), 1u);
+
+    const util::PoolHandle b = pool.allocate();
+    EXPECT_EQ(RecordPool::index_of(b), RecordPool::index_of(a));  // Recycled before fresh slots
+    EXPECT_NE(b, a);
+    EXPECT_EQ(pool.get(a), nullptr);
+    EXPECT_EQ(pool.get(b), pool.at(b));
+    EXPECT_EQ(pool.free_count(), 0u);
+    EXPECT_EQ(pool.get(util::NULL_POOL_HANDLE), nullptr);
+}
+
+// Pool_CapacityBoundedByArena - The slab takes only what the arena holds; a full pool returns null
+TEST(PoolTest, CapacityBoundedByArena) {
+    // Three slots fit however the backing buffer happens to be aligned, four never do
+    util::Arena arena{RecordPool::SLOT_BYTES * 4 - 1};
+    RecordPool pool(arena, 1000);
+    ASSERT_EQ(pool.capacity(), 3u);
+
+    std::vector<util::PoolHandle> handles;
+    for (int i = 0; i < 3; ++i) {
+        handles.push_back(pool.allocate());
+        ASSERT_NE(handles.back(), util::NULL_POOL_HANDLE);
+    }
+    EXPECT_EQ(pool.allocate(), util::NULL_POOL_HANDLE);
+
+    pool.release(handles[1]);
+    EXPECT_NE(pool.allocate(), util::NULL_POOL_HANDLE);
+    EXPECT_THROW(RecordPool(arena, 0), std::invalid_argument);
+}
+
+// Pool_ResetInvalidatesHandles - Handles from before reset never resolve, even once slots are reused
+TEST(PoolTest, ResetInvalidatesHandles) {
+    util::Arena arena{1 << 12};
+    RecordPool pool(arena, 4);
+
+    const util::PoolHandle a = pool.allocate();
+    const util::PoolHandle b = pool.allocate();
+    pool.reset();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.get(a), nullptr);
+
+    const util::PoolHandle c = pool.allocate();
+    const util::PoolHandle d = pool.allocate();
+    EXPECT_EQ(RecordPool::index_of(c), RecordPool::index_of(a));
+    EXPECT_EQ(pool.get(a), nullptr);
+    EXPECT_EQ(pool.get(b), nullptr);
+    EXPECT_EQ(pool.get(c), pool.at(c));
+    EXPECT_EQ(pool.get(d), pool.at(d));
+}
+
+// Pool_GenerationWrapSkipsNull - After the generation wraps a handle is still never null
+TEST(PoolTest, GenerationWrapSkipsNull) {
+    util::Arena arena{1 << 12};
+    using NarrowPool = util::Pool<Record, 28>;  // 4 generation bits
+    NarrowPool pool(arena, 1);
+    for (int i = 0; i < 40; ++i) {
+        const util::PoolHandle h = pool.allocate();
+        ASSERT_NE(h, util::NULL_POOL_HANDLE);
+        ASSERT_NE(NarrowPool::generation_of(h), 0u);
+        pool.release(h);
+    }
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/event_capture.hpp"
+#include "core/recon_backtest.hpp"
+#include "core/recon_config.hpp"
+#include "util/tsc_calibration.hpp"
+
+namespace {
+
+constexpr std::uint64_t MS = 1'000'000ULL;
+
+class ReconBacktestTest : public ::testing::Test {
+protected:
+    std::uint64_t primary_seq_{1};
+    std::uint64_t dropcopy_seq_{1};
+
+    core::ExecEvent make_fill(core::Source src, const char* clord_id, std::int64_t qty, std::uint64_t ts_ns) {
+        core::ExecEvent ev{};
+        ev.source = src;
+        ev.seq_num = src == core::Source::Primary ? primary_seq_++ : dropcopy_seq_++;
+        ev.exec_type = core::ExecType::Fill;
+        ev.ord_status = core::OrdStatus::Filled;
+        ev.qty = qty;
+        ev.cum_qty = qty;
+        ev.price_micro = 1'100'000;
+        ev.transact_time = ts_ns;
+        ev.ingest_tsc = util::ns_to_tsc(ts_ns);
+        ev.set_clord_id(clord_id, std::strlen(clord_id));
+        const std::string exec_id = std::string("E-") + clord_id;
+        ev.set_exec_id(exec_id.data(), exec_id.size());
+        return ev;
+    }
+
+    // Primary fills at t, the drop copy reports the same fill 50ms later
+    std::vector<core::ExecEvent> late_dropcopy_stream() {
+        const std::uint64_t t0 = 1'000 * MS;
+        return {make_fill(core::Source::Primary, "CID1", 100, t0),
+                make_fill(core::Source::DropCopy, "CID1", 100, t0 + 50 * MS)};
+    }
+
+    std::string temp_path(const char* name) const {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+};
+
+core::ReconConfig with_grace_ms(std::uint64_t grace_ms) {
+    core::ReconConfig cfg = core::default_recon_config();
+    cfg.grace_period_ns = grace_ms * MS;
+    return cfg;
+}
+
+} // namespace
+
+// Capture_RoundTrip - Events survive write_capture/load_capture
+TEST_F(ReconBacktestTest, Capture_RoundTrip) {
+    const auto events = late_dropcopy_stream();
+    const std::string path = temp_path("fx_recon_backtest_roundtrip.cap");
+
+    std::string error;
+    ASSERT_TRUE(core::write_capture(path.c_str(), events, error)) << error;
+
+    std::vector<core::ExecEvent> loaded;
+    ASSERT_TRUE(core::load_capture(path.c_str(), loaded, error)) << error;
+    std::remove(path.c_str());
+
+    ASSERT_EQ(loaded.size(), events.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(loaded[i].source, events[i].source);
+        EXPECT_EQ(loaded[i].seq_num, events[i].seq_num);
+        EXPECT_EQ(loaded[i].ord_status, events[i].ord_status);
+        EXPECT_EQ(loaded[i].cum_qty, events[i].cum_qty);
+        EXPECT_EQ(loaded[i].price_micro, events[i].price_micro);
+        EXPECT_EQ(core::make_order_key(loaded[i]), core::make_order_key(events[i]));
+        // Stored as ns; fixed-point TSC conversion may round by up to 1ns
+        EXPECT_NEAR(static_cast<double>(util::tsc_to_ns(loaded[i].ingest_tsc)),
+                    static_cast<double>(util::tsc_to_ns(events[i].ingest_tsc)), 1.0);
+    }
+}
+
+// Capture_RawRecordsKeepNanoseconds - load_capture_records returns wire records with ns timestamps for replay
+TEST_F(ReconBacktestTest, Capture_RawRecordsKeepNanoseconds) {
+    const auto events = late_dropcopy_stream();
+    const std::string path = temp_path("fx_recon_backtest_records.cap");
+
+    std::string error;
+    ASSERT_TRUE(core::write_capture(path.c_str(), events, error)) << error;
+    std::vector<core::CaptureRecord> records;
+    ASSERT_TRUE(core::load_capture_records(path.c_str(), records, error)) << error;
+    std::remove(path.c_str());
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].source, static_cast<std::uint8_t>(core::Source::Primary));
+    EXPECT_EQ(records[1].source, static_cast<std::uint8_t>(core::Source::DropCopy));
+    const std::uint64_t gap_ns = records[1].ingest_ns - records[0].ingest_ns;
+    EXPECT_NEAR(static_cast<double>(gap_ns), 50.0 * MS, 2.0);
+    EXPECT_EQ(std::string(records[0].wire.clord_id, records[0].wire.clord_id_len), "CID1");
+}
+
+// Capture_RejectsForeignFile - A file without the capture magic is refused
+TEST_F(ReconBacktestTest, Capture_RejectsForeignFile) {
+    const std::string path = temp_path("fx_recon_backtest_foreign.cap");
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const char junk[64] = "8=FIX.4.4|35=8|";
+    std::fwrite(junk, sizeof(junk), 1, f);
+    std::fclose(f);
+
+    std::vector<core::ExecEvent> loaded;
+    std::string error;
+    EXPECT_FALSE(core::load_capture(path.c_str(), loaded, error));
+    EXPECT_FALSE(error.empty());
+    std::remove(path.c_str());
+}
+
+// Backtest_GracePeriodDecidesOutcome - A 50ms-late drop copy is confirmed under a
+// 10ms grace period and absorbed under a 200ms one
+TEST_F(ReconBacktestTest, Backtest_GracePeriodDecidesOutcome) {
+    const auto events = late_dropcopy_stream();
+
+    const auto tight = core::run_backtest_variant(events, with_grace_ms(10));
+    ASSERT_TRUE(tight.completed);
+    EXPECT_EQ(tight.events, events.size());
+    EXPECT_EQ(tight.counters.mismatch_observed, 1u);
+    EXPECT_EQ(tight.counters.mismatch_confirmed, 1u);
+    EXPECT_EQ(tight.counters.false_positive_avoided, 0u);
+    EXPECT_GE(tight.divergences_emitted, 1u);
+
+    const auto loose = core::run_backtest_variant(events, with_grace_ms(200));
+    ASSERT_TRUE(loose.completed);
+    EXPECT_EQ(loose.counters.mismatch_observed, 1u);
+    EXPECT_EQ(loose.counters.mismatch_confirmed, 0u);
+    EXPECT_EQ(loose.counters.false_positive_avoided, 1u);
+    EXPECT_EQ(loose.divergences_emitted, 0u);
+    EXPECT_GE(loose.timer_stats.scheduled, 1u);
+}
+
+// Backtest_ParallelMatchesSerial - Running variants across threads gives the same
+// counters as running each one alone, in variant order
+TEST_F(ReconBacktestTest, Backtest_ParallelMatchesSerial) {
+    std::vector<core::ExecEvent> events;
+    const std::uint64_t t0 = 1'000 * MS;
+    for (int i = 0; i < 64; ++i) {
+        const std::string clord = "CID" + std::to_string(i);
+        const std::uint64_t ts = t0 + static_cast<std::uint64_t>(i) * MS;
+        events.push_back(make_fill(core::Source::Primary, clord.c_str(), 100, ts));
+        // Every fourth order's drop copy disagrees on quantity; the rest arrive late
+        const std::int64_t dc_qty = (i % 4 == 0) ? 90 : 100;
+        events.push_back(make_fill(core::Source::DropCopy, clord.c_str(), dc_qty,
+                                   ts + static_cast<std::uint64_t>(i % 8) * 20 * MS));
+    }
+
+    std::vector<core::ReconConfig> variants;
+    for (const std::uint64_t grace : {5u, 50u, 100u, 500u}) {
+        for (const std::int64_t qty_tol : {0, 20}) {
+            core::ReconConfig cfg = with_grace_ms(grace);
+            cfg.qty_tolerance = qty_tol;
+            variants.push_back(cfg);
+        }
+    }
+
+    core::BacktestOptions options{};
+    options.threads = 4;
+    const auto parallel = core::run_backtest(events, variants, options);
+    ASSERT_EQ(parallel.size(), variants.size());
+
+    for (std::size_t i = 0; i < variants.size(); ++i) {
+        const auto serial = core::run_backtest_variant(events, variants[i]);
+        ASSERT_TRUE(parallel[i].completed);
+        EXPECT_EQ(parallel[i].config.grace_period_ns, variants[i].grace_period_ns);
+        EXPECT_EQ(parallel[i].counters.mismatch_observed, serial.counters.mismatch_observed);
+        EXPECT_EQ(parallel[i].counters.mismatch_confirmed, serial.counters.mismatch_confirmed);
+        EXPECT_EQ(parallel[i].counters.false_positive_avoided, serial.counters.false_positive_avoided);
+        EXPECT_EQ(parallel[i].divergences_emitted, serial.divergences_emitted);
+        EXPECT_EQ(parallel[i].timer_stats.scheduled, serial.timer_stats.scheduled);
+    }
+
+    // Tolerating the 10-lot break removes those confirmations
+    EXPECT_LT(parallel[7].counters.mismatch_confirmed, parallel[6].counters.mismatch_confirmed);
+}
@@ -18,6 +18,7 @@ TEST(ReconConfigTest, DefaultValues) {
 
     EXPECT_TRUE(config.enable_windowed_recon);
     EXPECT_TRUE(config.enable_gap_suppression);
+    EXPECT_EQ(config.stream_liveness_timeout_ns, 0u);  // Liveness monitor off unless configured
 }
 
 // ReconConfig_IsTriviallyCopyable - Static assert for trivially copyable
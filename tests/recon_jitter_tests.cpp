@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/recon_jitter.hpp"
+#include "core/reconciler.hpp"
+#include "util/arena.hpp"
+#include "util/rdtsc.hpp"
+#include "util/wheel_timer.hpp"
+
+namespace {
+
+class ReconJitterTest : public ::testing::Test {
+protected:
+    // Large inline incident ring; keep it off the stack
+    std::unique_ptr<core::ReconJitterMonitor> monitor_ = std::make_unique<core::ReconJitterMonitor>(1000);
+
+    // Runs one iteration with the given per-stage costs starting at start_tsc
+    bool run_iteration(std::uint64_t start_tsc, std::uint64_t ingest, std::uint64_t timers,
+                       std::uint64_t housekeeping) {
+        monitor_->begin_iteration(start_tsc);
+        monitor_->end_stage(core::ReconStage::Ingest, start_tsc + ingest);
+        monitor_->end_stage(core::ReconStage::TimerPoll, start_tsc + ingest + timers);
+        const std::uint64_t end = start_tsc + ingest + timers + housekeeping;
+        monitor_->end_stage(core::ReconStage::Housekeeping, end);
+        return monitor_->end_iteration(end);
+    }
+};
+
+// ReconJitter_BucketFor_Log2 - Histogram buckets are bit widths, clamped at the top
+TEST_F(ReconJitterTest, BucketFor_Log2) {
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(0), 0u);
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(1), 1u);
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(3), 2u);
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(4), 3u);
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(1023), 10u);
+    EXPECT_EQ(core::ReconJitterMonitor::bucket_for(~0ULL), core::ReconJitterMonitor::HISTOGRAM_BUCKETS - 1);
+}
+
+// ReconJitter_EndIteration_TracksHistogramAndMax - Every iteration is recorded
+TEST_F(ReconJitterTest, EndIteration_TracksHistogramAndMax) {
+    EXPECT_FALSE(run_iteration(100, 10, 0, 5));    // 15 cycles
+    EXPECT_FALSE(run_iteration(200, 100, 50, 0));  // 150 cycles
+    EXPECT_FALSE(run_iteration(500, 2, 0, 1));     // 3 cycles
+
+    EXPECT_EQ(monitor_->iterations(), 3u);
+    EXPECT_EQ(monitor_->max_cycles(), 150u);
+    EXPECT_EQ(monitor_->histogram_count(core::ReconJitterMonitor::bucket_for(15)), 1u);
+    EXPECT_EQ(monitor_->histogram_count(core::ReconJitterMonitor::bucket_for(150)), 1u);
+    EXPECT_EQ(monitor_->histogram_count(core::ReconJitterMonitor::bucket_for(3)), 1u);
+    EXPECT_EQ(monitor_->incidents(), 0u);
+}
+
+// ReconJitter_QuantileUpperCycles - Quantiles resolve to histogram bucket bounds
+TEST_F(ReconJitterTest, QuantileUpperCycles) {
+    EXPECT_EQ(monitor_->quantile_upper_cycles(0.5), 0u);  // Empty
+
+    for (int i = 0; i < 99; ++i) {
+        (void)run_iteration(0, 10, 0, 0);  // bucket 4: [8, 16)
+    }
+    (void)run_iteration(0, 600, 0, 0);     // bucket 10: [512, 1024)
+
+    EXPECT_EQ(monitor_->quantile_upper_cycles(0.5), 15u);
+    EXPECT_EQ(monitor_->quantile_upper_cycles(0.98), 15u);
+    EXPECT_EQ(monitor_->quantile_upper_cycles(1.0), 1023u);
+}
+
+// ReconJitter_SlowIteration_CapturesIncident - Threshold breach captures stages and context
+TEST_F(ReconJitterTest, SlowIteration_CapturesIncident) {
+    EXPECT_FALSE(run_iteration(0, 10, 10, 10));
+    ASSERT_TRUE(run_iteration(1000, 100, 1500, 20));
+
+    core::JitterContext ctx{};
+    ctx.primary_depth = 7;
+    ctx.dropcopy_depth = 3;
+    ctx.pending_timers = 42;
+    ctx.burst_events = 12;
+    monitor_->capture_incident(ctx);
+    EXPECT_EQ(monitor_->incidents(), 1u);
+
+    std::vector<core::JitterIncident> seen;
+    EXPECT_EQ(monitor_->drain_incidents([&](const core::JitterIncident& inc) { seen.push_back(inc); }), 1u);
+    ASSERT_EQ(seen.size(), 1u);
+
+    const core::JitterIncident& inc = seen.front();
+    EXPECT_EQ(inc.iteration, 1u);
+    EXPECT_EQ(inc.start_tsc, 1000u);
+    EXPECT_EQ(inc.total_cycles, 1620u);
+    EXPECT_EQ(inc.stage_cycles[0], 100u);
+    EXPECT_EQ(inc.stage_cycles[1], 1500u);
+    EXPECT_EQ(inc.stage_cycles[2], 20u);
+    EXPECT_EQ(inc.slowest_stage, core::ReconStage::TimerPoll);
+    EXPECT_EQ(inc.context.primary_depth, 7u);
+    EXPECT_EQ(inc.context.dropcopy_depth, 3u);
+    EXPECT_EQ(inc.context.pending_timers, 42u);
+    EXPECT_EQ(inc.context.burst_events, 12u);
+}
+
+// ReconJitter_ThresholdZero_DisablesCapture - Histogram only when threshold is 0
+TEST_F(ReconJitterTest, ThresholdZero_DisablesCapture) {
+    monitor_->set_threshold_tsc(0);
+    EXPECT_FALSE(run_iteration(0, 1'000'000, 0, 0));
+    EXPECT_EQ(monitor_->iterations(), 1u);
+    EXPECT_EQ(monitor_->max_cycles(), 1'000'000u);
+}
+
+// ReconJitter_FullIncidentRing_CountsDrops - Lagging reporter drops incidents, never blocks
+TEST_F(ReconJitterTest, FullIncidentRing_CountsDrops) {
+    const std::size_t attempts = core::JitterIncidentRing::capacity() + 10;
+    for (std::size_t i = 0; i < attempts; ++i) {
+        ASSERT_TRUE(run_iteration(0, 5000, 0, 0));
+        monitor_->capture_incident(core::JitterContext{});
+    }
+
+    EXPECT_EQ(monitor_->incidents(), attempts);
+    // One slot is kept free to tell full from empty
+    const std::size_t stored = core::JitterIncidentRing::capacity() - 1;
+    EXPECT_EQ(monitor_->incident_drops(), attempts - stored);
+    EXPECT_EQ(monitor_->drain_incidents([](const core::JitterIncident&) {}), stored);
+}
+
+// ReconJitter_ReconcilerRun_RecordsIterations - Live loop feeds the monitor
+TEST_F(ReconJitterTest, ReconcilerRun_RecordsIterations) {
+    using ExecRing = ingest::SpscRing<core::ExecEvent, 1u << 16>;
+    auto primary = std::make_unique<ExecRing>();
+    auto dropcopy = std::make_unique<ExecRing>();
+    auto divergence = std::make_unique<core::DivergenceRing>();
+    auto seq_gap = std::make_unique<core::SequenceGapRing>();
+    util::Arena arena{1 << 20};
+    core::OrderStateStore store(arena, 64);
+    core::ReconCounters counters{};
+    util::WheelTimer wheel{util::rdtsc()};
+    std::atomic<bool> stop{false};
+
+    core::ReconConfig config{};
+    config.jitter_threshold_ns = 1;  // Capture every iteration
+    auto recon = std::make_unique<core::Reconciler>(stop, *primary, *dropcopy, store, counters,
+                                                    *divergence, *seq_gap, &wheel, config);
+
+    std::thread t([&] { recon->run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stop.store(true, std::memory_order_release);
+    t.join();
+
+    core::ReconJitterMonitor& jitter = recon->jitter_monitor();
+    EXPECT_GT(jitter.iterations(), 0u);
+    EXPECT_GT(jitter.max_cycles(), 0u);
+    EXPECT_GT(jitter.incidents(), 0u);
+    EXPECT_GT(jitter.drain_incidents([](const core::JitterIncident&) {}), 0u);
+}
+
+} // namespace
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "core/recon_metrics.hpp"
+#include "core/reconciler.hpp"
+#include "util/arena.hpp"
+#include "util/metrics_exporter.hpp"
+#include "util/seqlock.hpp"
+
+namespace {
+
+struct Wide {
+    std::uint64_t v[16];
+};
+
+std::string http_get(std::uint16_t port, const char* path) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return {};
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    std::string response;
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) {
+        const std::string req = std::string("GET ") + path + " HTTP/1.0\r\n\r\n";
+        (void)::send(fd, req.data(), req.size(), 0);
+        char buf[4096];
+        ssize_t n = 0;
+        while ((n = ::recv(fd, buf, sizeof(buf), 0)) > 0) {
+            response.append(buf, static_cast<std::size_t>(n));
+        }
+    }
+    ::close(fd);
+    return response;
+}
+
+// Metric family names declared by "# TYPE" lines; fails on duplicates
+std::set<std::string> families(const std::string& text) {
+    std::set<std::string> names;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("# TYPE ", 0) == 0) {
+            const std::string name = line.substr(7, line.find(' ', 7) - 7);
+            EXPECT_TRUE(names.insert(name).second) << "duplicate family " << name;
+        }
+    }
+    return names;
+}
+
+} // namespace
+
+// SeqlockSnapshot_StoreLoad - Readers see the last stored value and the store count
+TEST(SeqlockSnapshotTest, StoreLoad) {
+    util::SeqlockSnapshot<Wide> snap;
+    EXPECT_EQ(snap.version(), 0u);
+
+    Wide w{};
+    for (std::uint64_t i = 0; i < 16; ++i) {
+        w.v[i] = i * 7;
+    }
+    snap.store(w);
+
+    const Wide r = snap.load();
+    EXPECT_EQ(std::memcmp(&r, &w, sizeof(Wide)), 0);
+    EXPECT_EQ(snap.version(), 1u);
+}
+
+// SeqlockSnapshot_ConcurrentReadsAreConsistent - A reader never sees a half-written value
+TEST(SeqlockSnapshotTest, ConcurrentReadsAreConsistent) {
+    util::SeqlockSnapshot<Wide> snap;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        Wide w{};
+        for (std::uint64_t n = 1; n <= 200'000; ++n) {
+            for (std::uint64_t& x : w.v) {
+                x = n;
+            }
+            snap.store(w);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::uint64_t last = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        const Wide r = snap.load();
+        for (const std::uint64_t x : r.v) {
+            ASSERT_EQ(x, r.v[0]);
+        }
+        ASSERT_GE(r.v[0], last);
+        last = r.v[0];
+    }
+    writer.join();
+    EXPECT_EQ(snap.load().v[15], 200'000u);
+}
+
+// ReconMetrics_SnapshotPublishesCounters - stats_snapshot reflects the last publish, not live fields
+TEST(ReconMetricsTest, SnapshotPublishesCounters) {
+    std::atomic<bool> stop{false};
+    auto primary = std::make_unique<core::ExecRing>();
+    auto dropcopy = std::make_unique<core::ExecRing>();
+    auto divergence = std::make_unique<core::DivergenceRing>();
+    auto seq_gap = std::make_unique<core::SequenceGapRing>();
+    util::Arena arena{util::Arena::default_capacity_bytes};
+    core::OrderStateStore store(arena, 64);
+    core::ReconCounters counters{};
+    util::WheelTimer wheel{0};
+    core::Reconciler recon(stop, *primary, *dropcopy, store, counters, *divergence, *seq_gap, &wheel);
+
+    core::ExecEvent ev{};
+    ev.source = core::Source::Primary;
+    ev.seq_num = 1;
+    ev.exec_type = core::ExecType::New;
+    ev.ord_status = core::OrdStatus::New;
+    ev.ingest_tsc = 1'000;
+    ev.set_clord_id("CID_M1", 6);
+    recon.process_event_for_test(ev);
+
+    EXPECT_EQ(recon.stats_snapshot().published_tsc, 0u);
+    recon.publish_stats_snapshot(2'000);
+
+    const core::ReconStatsSnapshot snap = recon.stats_snapshot();
+    EXPECT_EQ(snap.published_tsc, 2'000u);
+    EXPECT_EQ(snap.counters.internal_events, 1u);
+    EXPECT_EQ(snap.counters.mismatch_observed, 1u);
+    EXPECT_EQ(snap.timer.scheduled, 1u);
+    EXPECT_EQ(snap.pending_timers, 1u);
+}
+
+// ReconMetrics_RendersEveryCounterOnce - Every ReconCounters field is exported, one family each
+TEST(ReconMetricsTest, RendersEveryCounterOnce) {
+    core::ReconStatsSnapshot snap{};
+    snap.counters.mismatch_confirmed = 42;
+    snap.counters.transition_ring_drops = 3;
+    snap.store_partition_count = 2;
+    snap.store_partitions[1] = core::StorePartitionStats{8, 8, 5};
+
+    ingest::ThreadStats primary_stats;
+    ingest::ThreadStats dropcopy_stats;
+    ingest::ThreadStats::bump(primary_stats.produced);
+    ingest::ThreadStats::bump(dropcopy_stats.drops);
+    const core::IngestMetricsSource sources[] = {{core::Source::Primary, &primary_stats},
+                                                 {core::Source::DropCopy, &dropcopy_stats}};
+    const core::RingDepth rings[] = {{"primary", 5}, {"dropcopy", 0}};
+    core::ReconJitterMonitor jitter;
+    util::AsyncLogger logger;
+
+    util::MetricsText out;
+    core::append_recon_metrics(out, snap);
+    core::append_ingest_metrics(out, sources);
+    core::append_ring_depths(out, rings);
+    auto lanes = std::make_unique<core::DivergenceLanes>();
+    core::Divergence phantom{};
+    phantom.type = core::DivergenceType::PhantomOrder;
+    ASSERT_TRUE(lanes->try_push(phantom));
+    core::append_divergence_lane_metrics(out, *lanes);
+    core::append_jitter_metrics(out, jitter);
+    core::append_logger_metrics(out, logger);
+    const std::string& text = out.str();
+
+    const auto names = families(text);
+    std::size_t recon_counters = 0;
+    for (const std::string& name : names) {
+        recon_counters += name.rfind("fx_recon_", 0) == 0 ? 1 : 0;
+    }
+    EXPECT_GE(recon_counters, sizeof(core::ReconCounters) / sizeof(std::uint64_t));
+
+    EXPECT_NE(text.find("fx_recon_mismatch_confirmed_total 42\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_transition_ring_drops_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_ingest_produced_total{source=\"primary\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_ingest_drops_total{source=\"dropcopy\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_ring_depth{ring=\"primary\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_divergence_lane_depth{lane=\"critical\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_divergence_lane_drops_total{lane=\"low\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_loop_latency_ns{quantile=\"0.99\"}"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_log_dropped_total 0\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_store_partition_overflow_total{partition=\"1\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("fx_recon_store_partition_quota{partition=\"1\"} 8\n"), std::string::npos);
+}
+
+// MetricsExporter_ServesMetricsOverLoopback - GET /metrics returns the rendered page, other paths 404
+TEST(MetricsExporterTest, ServesMetricsOverLoopback) {
+    std::atomic<std::uint64_t> value{7};
+    util::MetricsExporter exporter(0, [&](util::MetricsText& out) {
+        out.counter("fx_test_events", "Test events", value.load());
+    });
+    std::string error;
+    if (!exporter.start(error)) {
+        GTEST_SKIP() << "Loopback sockets unavailable: " << error;
+    }
+    ASSERT_NE(exporter.port(), 0u);
+
+    const std::string ok = http_get(exporter.port(), "/metrics");
+    EXPECT_EQ(ok.rfind("HTTP/1.0 200 OK", 0), 0u);
+    EXPECT_NE(ok.find("# TYPE fx_test_events counter\n"), std::string::npos);
+    EXPECT_NE(ok.find("fx_test_events_total 7\n"), std::string::npos);
+
+    value.store(8);
+    EXPECT_NE(http_get(exporter.port(), "/metrics").find("fx_test_events_total 8\n"), std::string::npos);
+    EXPECT_EQ(exporter.scrapes(), 2u);
+
+    EXPECT_EQ(http_get(exporter.port(), "/").rfind("HTTP/1.0 404", 0), 0u);
+    exporter.stop();
+}
@@ -18,6 +18,7 @@ protected:
     core::OrderState make_order_state(core::OrderKey key) {
         core::OrderState os{};
         os.key = key;
+        os.pool_handle = static_cast<std::uint32_t>(key);  // Stand-in for the store's handle
         os.timer_generation = 0;
         os.recon_deadline_tsc = 0;
         return os;
@@ -220,9 +221,9 @@ TEST_F(ReconTimerTest, FullCycle_ScheduleCancelReschedule) {
     EXPECT_FALSE(core::is_timer_valid(os, gen1));
 
     // Step 5: Verify the wheel integration - poll and check callbacks
-    std::vector<std::pair<core::OrderKey, std::uint32_t>> expired_entries;
-    auto on_expired = [&](core::OrderKey key, std::uint32_t gen) {
-        expired_entries.emplace_back(key, gen);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> expired_entries;
+    auto on_expired = [&](std::uint32_t ref, std::uint32_t gen) {
+        expired_entries.emplace_back(ref, gen);
     };
 
     // Poll past all deadlines - multiple entries should expire
@@ -232,8 +233,8 @@ TEST_F(ReconTimerTest, FullCycle_ScheduleCancelReschedule) {
     // The wheel may have multiple entries (from schedule/refresh)
     // but only the latest generation should be valid
     bool found_valid = false;
-    for (const auto& [key, gen] : expired_entries) {
-        if (key == os.key) {
+    for (const auto& [ref, gen] : expired_entries) {
+        if (ref == os.pool_handle) {
             if (core::is_timer_valid(os, gen)) {
                 // This is the valid timer
                 EXPECT_EQ(gen, gen3);
@@ -3,7 +3,9 @@
 #include <atomic>
 #include <cstring>
 #include <memory>
+#include <vector>
 
+#include "core/ingest_annotator.hpp"
 #include "core/reconciler.hpp"
 #include "core/order_state_store.hpp"
 #include "ingest/spsc_ring.hpp"
@@ -95,4 +97,52 @@ TEST_F(ReconcilerSequenceTest, DropcopyDuplicateDetected) {
     EXPECT_EQ(h.counters.sequence_gap_ring_drops, 0);
 }
 
+TEST_F(ReconcilerSequenceTest, AnnotatedEventsUseIngestVerdict) {
+    Harness h;
+    core::IngestAnnotator annotator;
+
+    // Two primary sessions interleaved: in order per session, not per source
+    std::vector<core::ExecEvent> events;
+    for (std::uint64_t seq = 1; seq <= 3; ++seq) {
+        for (const std::uint16_t session : {std::uint16_t{1}, std::uint16_t{2}}) {
+            auto ev = make_seq_event(core::Source::Primary, seq * 10 + session, "CA1");
+            ev.seq_num = seq;
+            ev.session_id = session;
+            events.push_back(ev);
+        }
+    }
+    auto gap_ev = make_seq_event(core::Source::Primary, 99, "CA2");
+    gap_ev.seq_num = 7;
+    gap_ev.session_id = 2;
+    events.push_back(gap_ev);
+
+    for (core::ExecEvent& ev : events) {
+        ASSERT_TRUE(annotator.annotate(ev));
+        h.reconciler.process_event_for_test(ev);
+    }
+
+    core::SequenceGapEvent gap{};
+    ASSERT_TRUE(h.seq_gap_ring->try_pop(gap));
+    EXPECT_FALSE(h.seq_gap_ring->try_pop(gap));
+    EXPECT_EQ(gap.kind, core::GapKind::Gap);
+    EXPECT_EQ(gap.session_id, 2u);
+    EXPECT_EQ(gap.expected_seq, 4u);
+    EXPECT_EQ(gap.seen_seq, 7u);
+    EXPECT_EQ(h.counters.primary_seq_gaps, 1u);
+    EXPECT_EQ(h.counters.primary_seq_out_of_order, 0u);
+    EXPECT_EQ(h.store.size(), 2u);
+    EXPECT_NE(h.store.find(core::make_order_key(gap_ev)), nullptr);
+}
+
+TEST_F(ReconcilerSequenceTest, OutOfRangeEnumsDropped) {
+    Harness h;
+    auto ev = make_seq_event(core::Source::Primary, 1, "CE1");
+    ev.ord_status = static_cast<core::OrdStatus>(200);
+    h.reconciler.process_event_for_test(ev);
+
+    EXPECT_EQ(h.counters.invalid_events, 1u);
+    EXPECT_EQ(h.counters.internal_events, 0u);
+    EXPECT_EQ(h.store.size(), 0u);
+}
+
 } // namespace
@@ -0,0 +1,338 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "core/order_state_store.hpp"
+#include "core/reconciler.hpp"
+#include "core/recon_config.hpp"
+#include "core/session_index.hpp"
+#include "ingest/spsc_ring.hpp"
+#include "util/arena.hpp"
+#include "util/tsc_calibration.hpp"
+#include "util/wheel_timer.hpp"
+
+namespace {
+
+using ExecRing = ingest::SpscRing<core::ExecEvent, 1u << 16>;
+
+struct SessionHarness {
+    std::atomic<bool> stop_flag{false};
+    std::unique_ptr<ExecRing> primary_ring = std::make_unique<ExecRing>();
+    std::unique_ptr<ExecRing> dropcopy_ring = std::make_unique<ExecRing>();
+    std::unique_ptr<core::DivergenceRing> divergence_ring = std::make_unique<core::DivergenceRing>();
+    std::unique_ptr<core::SequenceGapRing> seq_gap_ring = std::make_unique<core::SequenceGapRing>();
+    util::Arena arena{util::Arena::default_capacity_bytes};
+    core::OrderStateStore store{arena, 256};
+    core::ReconCounters counters{};
+    util::WheelTimer timer_wheel{0};
+    std::unique_ptr<core::Reconciler> reconciler = std::make_unique<core::Reconciler>(
+        stop_flag, *primary_ring, *dropcopy_ring, store, counters, *divergence_ring, *seq_gap_ring,
+        &timer_wheel, core::ReconConfig{});
+
+    void use_config(const core::ReconConfig& config) {
+        reconciler = std::make_unique<core::Reconciler>(stop_flag, *primary_ring, *dropcopy_ring, store, counters,
+                                                        *divergence_ring, *seq_gap_ring, &timer_wheel, config);
+    }
+
+    std::size_t drain_divergences() {
+        std::size_t n = 0;
+        core::Divergence div{};
+        while (divergence_ring->try_pop(div)) {
+            ++n;
+        }
+        return n;
+    }
+};
+
+class ReconcilerSessionTest : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t DC_SESSION = 7;
+    static constexpr std::uint16_t OTHER_DC_SESSION = 8;
+
+    std::uint64_t primary_seq_{1};
+    std::uint64_t dropcopy_seq_{1};
+
+    core::ExecEvent make_event(core::Source src, core::OrdStatus status, std::int64_t cum_qty,
+                               std::uint64_t ts, const std::string& clord_id,
+                               std::uint16_t session_id = DC_SESSION) {
+        core::ExecEvent ev{};
+        ev.source = src;
+        ev.seq_num = src == core::Source::Primary ? primary_seq_++ : dropcopy_seq_++;
+        ev.session_id = session_id;
+        ev.ord_status = status;
+        ev.exec_type = core::ExecType::New;
+        ev.cum_qty = cum_qty;
+        ev.qty = cum_qty;
+        ev.price_micro = 100;
+        ev.transact_time = ts;
+        ev.ingest_tsc = ts;
+        ev.set_clord_id(clord_id.data(), clord_id.size());
+        ev.set_exec_id("EX", 2);
+        return ev;
+    }
+
+    static core::SessionEvent session_event(core::SessionEventKind kind, std::uint64_t tsc,
+                                            std::uint16_t session_id = DC_SESSION) {
+        core::SessionEvent sev{};
+        sev.source = core::Source::DropCopy;
+        sev.session_id = session_id;
+        sev.kind = kind;
+        sev.tsc = tsc;
+        return sev;
+    }
+
+    static core::OrderKey key_of(const std::string& clord_id) {
+        core::ExecEvent ev{};
+        ev.set_clord_id(clord_id.data(), clord_id.size());
+        return core::make_order_key(ev);
+    }
+
+    // Primary and dropcopy both Working, but dropcopy lags on cum qty -> InGrace
+    void make_in_grace(SessionHarness& h, const std::string& cid, std::uint64_t ts,
+                       std::uint16_t session_id = DC_SESSION) {
+        h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Working, 0, ts, cid, 1));
+        h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 0, ts, cid, session_id));
+        h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::PartiallyFilled, 50, ts + 1, cid, 1));
+    }
+};
+
+// SessionIndex_UpsertLinksOrdersPerSession - Orders are listed under each session they were seen on
+TEST_F(ReconcilerSessionTest, SessionIndex_UpsertLinksOrdersPerSession) {
+    SessionHarness h;
+    make_in_grace(h, "S_A", 1000);
+    make_in_grace(h, "S_B", 1000);
+    make_in_grace(h, "S_C", 1000, OTHER_DC_SESSION);
+
+    auto& sessions = h.store.sessions();
+    const auto* dc = sessions.find(core::Source::DropCopy, DC_SESSION);
+    const auto* other = sessions.find(core::Source::DropCopy, OTHER_DC_SESSION);
+    const auto* primary = sessions.find(core::Source::Primary, 1);
+    ASSERT_NE(dc, nullptr);
+    ASSERT_NE(other, nullptr);
+    ASSERT_NE(primary, nullptr);
+    EXPECT_EQ(dc->order_count, 2u);
+    EXPECT_EQ(other->order_count, 1u);
+    EXPECT_EQ(primary->order_count, 3u);
+
+    // Compaction unlinks the order from both of its sessions
+    ASSERT_TRUE(h.store.compact(key_of("S_A")));
+    EXPECT_EQ(dc->order_count, 1u);
+    EXPECT_EQ(primary->order_count, 2u);
+    std::size_t visited = sessions.for_each_order(*dc, [](core::OrderState& os) {
+        EXPECT_EQ(os.key, key_of("S_B"));
+    });
+    EXPECT_EQ(visited, 1u);
+}
+
+// Logout_ParksInGraceOrdersWithoutTimers - Logout cancels grace timers in one pass, no divergences
+TEST_F(ReconcilerSessionTest, Logout_ParksInGraceOrdersWithoutTimers) {
+    SessionHarness h;
+    for (int i = 0; i < 10; ++i) {
+        make_in_grace(h, "LO" + std::to_string(i), 1000);
+    }
+    make_in_grace(h, "LO_OTHER", 1000, OTHER_DC_SESSION);
+    ASSERT_EQ(h.store.find(key_of("LO0"))->recon_state, core::ReconState::InGrace);
+
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::Logout, 2000));
+
+    EXPECT_EQ(h.counters.session_logouts, 1u);
+    EXPECT_EQ(h.counters.session_orders_suspended, 10u);
+    for (int i = 0; i < 10; ++i) {
+        const core::OrderState* os = h.store.find(key_of("LO" + std::to_string(i)));
+        EXPECT_EQ(os->recon_state, core::ReconState::SuppressedByGap);
+        EXPECT_EQ(os->recon_deadline_tsc, 0u);
+        EXPECT_NE(os->session_flags & core::SessionFlags::DROPCOPY_DOWN, 0);
+    }
+    EXPECT_EQ(h.store.find(key_of("LO_OTHER"))->recon_state, core::ReconState::InGrace);
+
+    // Only the other session's order can still confirm when the wheel fires
+    const std::uint64_t after_grace = 2000 + util::ns_to_tsc(core::ReconConfig{}.grace_period_ns) * 2;
+    h.reconciler->set_last_poll_tsc_for_test(after_grace);
+    h.reconciler->poll_timers(after_grace);
+    EXPECT_EQ(h.drain_divergences(), 1u);
+    EXPECT_GE(h.counters.stale_timers_skipped, 10u);
+}
+
+// Logout_NewMismatchIsSuppressed - While the session is down, new mismatches schedule no timer
+TEST_F(ReconcilerSessionTest, Logout_NewMismatchIsSuppressed) {
+    SessionHarness h;
+    const std::string cid = "LO_NEW";
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Working, 0, 1000, cid, 1));
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 0, 1000, cid));
+    ASSERT_EQ(h.store.find(key_of(cid))->recon_state, core::ReconState::Matched);
+
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::Logout, 1500));
+    const std::size_t pending_before = h.reconciler->pending_timers();
+
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::PartiallyFilled, 10, 2000, cid, 1));
+
+    EXPECT_EQ(h.store.find(key_of(cid))->recon_state, core::ReconState::SuppressedByGap);
+    EXPECT_EQ(h.reconciler->pending_timers(), pending_before);
+    EXPECT_EQ(h.counters.session_suppressions, 1u);
+}
+
+// Logon_ReevaluatesParkedOrdersInBulk - Resolved orders match, still-mismatched ones re-enter grace
+TEST_F(ReconcilerSessionTest, Logon_ReevaluatesParkedOrdersInBulk) {
+    SessionHarness h;
+    make_in_grace(h, "LN_FIX", 1000);
+    make_in_grace(h, "LN_BAD", 1000);
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::Logout, 1500));
+
+    // LN_FIX catches up once the session replays; fix it up directly while parked
+    core::OrderState* fixed = h.store.find(key_of("LN_FIX"));
+    fixed->status[core::SideIndex::DROPCOPY] = core::OrdStatus::PartiallyFilled;
+    fixed->cum_qty[core::SideIndex::DROPCOPY] = 50;
+
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::Logon, 3000));
+
+    EXPECT_EQ(h.counters.session_logons, 1u);
+    EXPECT_EQ(h.counters.session_orders_resumed, 2u);
+    EXPECT_EQ(fixed->recon_state, core::ReconState::Matched);
+    EXPECT_EQ(fixed->session_flags, 0);
+
+    const core::OrderState* bad = h.store.find(key_of("LN_BAD"));
+    EXPECT_EQ(bad->recon_state, core::ReconState::InGrace);
+    EXPECT_EQ(bad->recon_deadline_tsc, 3000 + util::ns_to_tsc(core::ReconConfig{}.grace_period_ns));
+    EXPECT_FALSE(h.store.sessions().find(core::Source::DropCopy, DC_SESSION)->down);
+}
+
+// MassCancel_ExpectsOtherSideThenConfirmsOnce - One session deadline resolves every pending cancel
+TEST_F(ReconcilerSessionTest, MassCancel_ExpectsOtherSideThenConfirmsOnce) {
+    SessionHarness h;
+    for (const char* cid : {"MC_1", "MC_2", "MC_3"}) {
+        h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Working, 0, 1000, cid, 1));
+        h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 0, 1000, cid));
+    }
+    const std::size_t pending_before = h.reconciler->pending_timers();
+
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::MassCancel, 2000));
+
+    EXPECT_EQ(h.counters.session_orders_mass_canceled, 3u);
+    EXPECT_EQ(h.reconciler->pending_timers(), pending_before);
+    for (const char* cid : {"MC_1", "MC_2", "MC_3"}) {
+        const core::OrderState* os = h.store.find(key_of(cid));
+        EXPECT_EQ(os->status[core::SideIndex::DROPCOPY], core::OrdStatus::Canceled);
+        EXPECT_EQ(os->recon_state, core::ReconState::AwaitingPrimary);
+    }
+
+    // OMS confirms two of the cancels
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::CancelPending, 0, 2100, "MC_1", 1));
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Canceled, 0, 2200, "MC_1", 1));
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::CancelPending, 0, 2100, "MC_2", 1));
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Canceled, 0, 2200, "MC_2", 1));
+    EXPECT_EQ(h.store.find(key_of("MC_1"))->recon_state, core::ReconState::Matched);
+    EXPECT_EQ(h.store.find(key_of("MC_2"))->recon_state, core::ReconState::Matched);
+
+    // Before the deadline nothing is confirmed
+    h.reconciler->check_session_deadlines(2500);
+    EXPECT_EQ(h.drain_divergences(), 0u);
+
+    const std::uint64_t deadline = 2000 + util::ns_to_tsc(core::ReconConfig{}.grace_period_ns);
+    h.reconciler->check_session_deadlines(deadline);
+    EXPECT_EQ(h.store.find(key_of("MC_3"))->recon_state, core::ReconState::DivergedConfirmed);
+    EXPECT_EQ(h.drain_divergences(), 1u);
+
+    // Deadline is one-shot
+    h.reconciler->check_session_deadlines(deadline + 1);
+    EXPECT_EQ(h.drain_divergences(), 0u);
+}
+
+// SessionReset_RestartsSequenceTracking - Sequence numbers may restart after a reset
+TEST_F(ReconcilerSessionTest, SessionReset_RestartsSequenceTracking) {
+    SessionHarness h;
+    for (int i = 0; i < 5; ++i) {
+        h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 0, 1000, "SR" + std::to_string(i)));
+    }
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::SessionReset, 2000));
+    EXPECT_EQ(h.counters.session_resets, 1u);
+
+    dropcopy_seq_ = 1;
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 0, 3000, "SR_NEW"));
+    EXPECT_EQ(h.counters.dropcopy_seq_duplicates, 0u);
+    EXPECT_EQ(h.counters.dropcopy_seq_out_of_order, 0u);
+    EXPECT_EQ(h.counters.dropcopy_seq_gaps, 0u);
+}
+
+// StreamDown_ParksOrdersUntilTheStreamResumes - A silent drop-copy feed parks grace entries instead of confirming them
+TEST_F(ReconcilerSessionTest, StreamDown_ParksOrdersUntilTheStreamResumes) {
+    SessionHarness h;
+    core::ReconConfig config{};
+    config.stream_liveness_timeout_ns = 100'000'000;  // Below the 500ms grace period
+    h.use_config(config);
+    const std::uint64_t timeout = util::ns_to_tsc(config.stream_liveness_timeout_ns);
+    const std::uint64_t grace = util::ns_to_tsc(config.grace_period_ns);
+
+    make_in_grace(h, "SD_OLD", 1000);
+    ASSERT_EQ(h.store.find(key_of("SD_OLD"))->recon_state, core::ReconState::InGrace);
+
+    // Drop copy goes silent; the primary keeps trading
+    const std::uint64_t t1 = 1000 + timeout + 10;
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::New, 0, t1, "SD_NEW", 1));
+    h.reconciler->advance_to(t1 + 1);
+    EXPECT_TRUE(h.reconciler->degraded());
+    EXPECT_TRUE(h.reconciler->stream_liveness().is_down(core::Source::DropCopy));
+    EXPECT_FALSE(h.reconciler->stream_liveness().is_down(core::Source::Primary));
+    EXPECT_FALSE(h.reconciler->stream_liveness().is_down(core::Source::PrimeBroker));
+    EXPECT_EQ(h.counters.stream_downs, 1u);
+    for (const char* cid : {"SD_OLD", "SD_NEW"}) {
+        const core::OrderState* os = h.store.find(key_of(cid));
+        EXPECT_EQ(os->recon_state, core::ReconState::SuppressedByGap) << cid;
+        EXPECT_NE(os->session_flags & core::SessionFlags::STREAM_PARKED, 0) << cid;
+    }
+
+    // New orders while degraded schedule no timer at all
+    const std::size_t pending_before = h.reconciler->pending_timers();
+    for (int i = 0; i < 20; ++i) {
+        h.reconciler->process_event_for_test(
+            make_event(core::Source::Primary, core::OrdStatus::New, 0, t1 + 2, "SD_BURST" + std::to_string(i), 1));
+    }
+    EXPECT_EQ(h.reconciler->pending_timers(), pending_before);
+    EXPECT_EQ(h.counters.stream_orders_parked, 22u);
+
+    // Well past every grace deadline: nothing confirms while the stream is down
+    const std::uint64_t t2 = t1 + grace * 2;
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::New, 0, t2, "SD_KEEPALIVE", 1));
+    h.reconciler->advance_to(t2);
+    EXPECT_EQ(h.drain_divergences(), 0u);
+    EXPECT_EQ(h.counters.mismatch_confirmed, 0u);
+
+    // The drop copy comes back: SD_NEW is reported and matches on arrival, the rest
+    // are re-evaluated in one pass with a fresh grace window
+    const std::uint64_t t3 = t2 + 10;
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::New, 0, t3, "SD_NEW"));
+    EXPECT_EQ(h.store.find(key_of("SD_NEW"))->recon_state, core::ReconState::Matched);
+    h.reconciler->advance_to(t3 + 1);
+    EXPECT_FALSE(h.reconciler->degraded());
+    EXPECT_EQ(h.counters.stream_ups, 1u);
+    EXPECT_EQ(h.counters.stream_orders_resumed, 22u);  // SD_OLD, 20 bursts, SD_KEEPALIVE
+    const core::OrderState* old_order = h.store.find(key_of("SD_OLD"));
+    EXPECT_EQ(old_order->recon_state, core::ReconState::InGrace);
+    EXPECT_EQ(old_order->session_flags & core::SessionFlags::STREAM_PARKED, 0);
+    EXPECT_EQ(old_order->recon_deadline_tsc, t3 + 1 + grace);
+}
+
+// Heartbeat_KeepsQuietStreamUp - Heartbeats count as activity for the source and its session
+TEST_F(ReconcilerSessionTest, Heartbeat_KeepsQuietStreamUp) {
+    SessionHarness h;
+    core::ReconConfig config{};
+    config.stream_liveness_timeout_ns = 100'000'000;
+    h.use_config(config);
+    const std::uint64_t timeout = util::ns_to_tsc(config.stream_liveness_timeout_ns);
+
+    make_in_grace(h, "HB", 1000);
+    const std::uint64_t t1 = 1000 + timeout + 10;
+    h.reconciler->on_session_event(session_event(core::SessionEventKind::Heartbeat, t1 - timeout / 2));
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::New, 0, t1, "HB_P", 1));
+    h.reconciler->advance_to(t1);
+
+    EXPECT_FALSE(h.reconciler->degraded());
+    EXPECT_EQ(h.counters.stream_downs, 0u);
+    EXPECT_EQ(h.store.find(key_of("HB"))->recon_state, core::ReconState::InGrace);
+    EXPECT_EQ(h.store.sessions().find(core::Source::DropCopy, DC_SESSION)->last_activity_tsc, t1 - timeout / 2);
+    EXPECT_EQ(h.counters.session_logouts + h.counters.session_logons, 0u);
+}
+
+} // namespace
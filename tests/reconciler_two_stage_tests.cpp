@@ -3,13 +3,17 @@
 #include <atomic>
 #include <cstring>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "core/divergence.hpp"
 #include "core/order_state_store.hpp"
 #include "core/reconciler.hpp"
 #include "core/recon_config.hpp"
+#include "core/recon_transition.hpp"
 #include "ingest/spsc_ring.hpp"
 #include "util/arena.hpp"
+#include "util/tsc_calibration.hpp"
 #include "util/wheel_timer.hpp"
 
 namespace {
@@ -95,8 +99,8 @@ TEST_F(ReconcilerTwoStageTest, NewConstructorCompiles) {
 // Reconciler_BothSidesSeen_TrueWhenBothTrue - Helper returns correct value
 TEST_F(ReconcilerTwoStageTest, BothSidesSeen_TrueWhenBothTrue) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     EXPECT_TRUE(core::Reconciler::both_sides_seen(os));
 }
@@ -104,8 +108,8 @@ TEST_F(ReconcilerTwoStageTest, BothSidesSeen_TrueWhenBothTrue) {
 // Reconciler_BothSidesSeen_FalseWhenOnlyPrimary - Helper returns false
 TEST_F(ReconcilerTwoStageTest, BothSidesSeen_FalseWhenOnlyPrimary) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = false;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = false;
 
     EXPECT_FALSE(core::Reconciler::both_sides_seen(os));
 }
@@ -113,8 +117,8 @@ TEST_F(ReconcilerTwoStageTest, BothSidesSeen_FalseWhenOnlyPrimary) {
 // Reconciler_BothSidesSeen_FalseWhenOnlyDropcopy - Helper returns false
 TEST_F(ReconcilerTwoStageTest, BothSidesSeen_FalseWhenOnlyDropcopy) {
     core::OrderState os{};
-    os.seen_internal = false;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = false;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     EXPECT_FALSE(core::Reconciler::both_sides_seen(os));
 }
@@ -122,8 +126,8 @@ TEST_F(ReconcilerTwoStageTest, BothSidesSeen_FalseWhenOnlyDropcopy) {
 // Reconciler_BothSidesSeen_FalseWhenNeitherSeen - Helper returns false
 TEST_F(ReconcilerTwoStageTest, BothSidesSeen_FalseWhenNeitherSeen) {
     core::OrderState os{};
-    os.seen_internal = false;
-    os.seen_dropcopy = false;
+    os.seen[core::SideIndex::PRIMARY] = false;
+    os.seen[core::SideIndex::DROPCOPY] = false;
 
     EXPECT_FALSE(core::Reconciler::both_sides_seen(os));
 }
@@ -281,8 +285,8 @@ TEST_F(ReconcilerTwoStageTest, BackwardCompatibility) {
 // classify_divergence_type tests
 TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_MissingDropCopy) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = false;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = false;
 
     core::MismatchMask mismatch{};
     mismatch.set(core::MismatchMask::EXISTENCE);
@@ -292,8 +296,8 @@ TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_MissingDropCopy) {
 
 TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_PhantomOrder) {
     core::OrderState os{};
-    os.seen_internal = false;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = false;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     core::MismatchMask mismatch{};
     mismatch.set(core::MismatchMask::EXISTENCE);
@@ -303,8 +307,8 @@ TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_PhantomOrder) {
 
 TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_StateMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     core::MismatchMask mismatch{};
     mismatch.set(core::MismatchMask::STATUS);
@@ -314,8 +318,8 @@ TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_StateMismatch) {
 
 TEST_F(ReconcilerTwoStageTest, ClassifyDivergenceType_QuantityMismatch) {
     core::OrderState os{};
-    os.seen_internal = true;
-    os.seen_dropcopy = true;
+    os.seen[core::SideIndex::PRIMARY] = true;
+    os.seen[core::SideIndex::DROPCOPY] = true;
 
     core::MismatchMask mismatch{};
     mismatch.set(core::MismatchMask::CUM_QTY);
@@ -386,8 +390,8 @@ TEST_F(ReconcilerTwoStageTest, TwoStage_PrimaryOnly_AwaitingDropcopy) {
     ASSERT_NE(os, nullptr);
     // Note: With FX-7053, one-sided orders enter InGrace (EXISTENCE mismatch)
     EXPECT_EQ(os->recon_state, core::ReconState::InGrace);
-    EXPECT_TRUE(os->seen_internal);
-    EXPECT_FALSE(os->seen_dropcopy);
+    EXPECT_TRUE(os->seen[core::SideIndex::PRIMARY]);
+    EXPECT_FALSE(os->seen[core::SideIndex::DROPCOPY]);
     EXPECT_EQ(h.counters.mismatch_observed, 1u);
 }
 
@@ -405,8 +409,8 @@ TEST_F(ReconcilerTwoStageTest, TwoStage_DropcopyOnly_AwaitingPrimary) {
     ASSERT_NE(os, nullptr);
     // Note: With FX-7053, one-sided orders enter InGrace (EXISTENCE mismatch)
     EXPECT_EQ(os->recon_state, core::ReconState::InGrace);
-    EXPECT_FALSE(os->seen_internal);
-    EXPECT_TRUE(os->seen_dropcopy);
+    EXPECT_FALSE(os->seen[core::SideIndex::PRIMARY]);
+    EXPECT_TRUE(os->seen[core::SideIndex::DROPCOPY]);
     EXPECT_EQ(h.counters.mismatch_observed, 1u);
 }
 
@@ -804,7 +808,7 @@ TEST_F(ReconcilerTwoStageTest, OnDeadlineExpired_RespectsQtyTolerance) {
     std::uint32_t gen = os->timer_generation;
     
     // Manually update dropcopy qty to be within tolerance (95, difference of 5)
-    os->dropcopy_cum_qty = 95;
+    os->cum_qty[core::SideIndex::DROPCOPY] = 95;
     
     // Fire timer - it should re-check mismatch with tolerance and find no mismatch
     h.reconciler->on_grace_deadline_expired(key, gen);
@@ -855,7 +859,7 @@ TEST_F(ReconcilerTwoStageTest, OnDeadlineExpired_RespectsPxTolerance) {
     std::uint32_t gen = os->timer_generation;
     
     // Manually update dropcopy price to be within tolerance (97, difference of 3)
-    os->dropcopy_avg_px = 97;
+    os->avg_px[core::SideIndex::DROPCOPY] = 97;
     
     // Fire timer - it should re-check mismatch with tolerance and find no mismatch
     h.reconciler->on_grace_deadline_expired(key, gen);
@@ -900,9 +904,9 @@ TEST_F(ReconcilerTwoStageTest, EmitConfirmedDivergence_NoRecordOnPushFailure) {
     ASSERT_NE(os, nullptr);
     EXPECT_EQ(os->recon_state, core::ReconState::InGrace);
     
-    // Pre-fill the divergence ring to capacity (minus 1 for safety)
-    // DivergenceRing capacity is 1 << 16 = 65536
-    const std::size_t fill_count = h.divergence_ring->capacity() - 1;
+    // Pre-fill the lane this divergence routes to (High: CUM_QTY mismatch) to capacity
+    // (minus 1 for safety). Default-constructed dummies are StateMismatch, also High.
+    const std::size_t fill_count = core::DivergenceLanes::lane_capacity(core::DivergencePriority::High) - 1;
     for (std::size_t i = 0; i < fill_count; ++i) {
         core::Divergence dummy{};
         dummy.key = i;
@@ -927,6 +931,7 @@ TEST_F(ReconcilerTwoStageTest, EmitConfirmedDivergence_NoRecordOnPushFailure) {
     
     // Verify divergence_ring_drops was incremented
     EXPECT_GE(h.counters.divergence_ring_drops, 1u);
+    EXPECT_GE(h.divergence_ring->drops(core::DivergencePriority::High), 1u);
     
     // Key verification: last_divergence_emit_tsc should NOT have been updated
     // because the push failed and we returned early (the bug fix)
@@ -984,4 +989,292 @@ TEST_F(ReconcilerTwoStageTest, EmitConfirmedDivergence_DeduplicationWorksAfterSu
     EXPECT_GE(h.counters.divergence_deduped, 1u);
 }
 
+// ===== Tombstone compaction =====
+
+// Reconciler_CompactQuietOrders_TombstonesFinishedOrder - Matched terminal order compacted after quiet period
+TEST_F(ReconcilerTwoStageTest, CompactQuietOrders_TombstonesFinishedOrder) {
+    TwoStageHarness h;
+    const std::uint64_t ts = 1'000'000;
+
+    const auto primary_ev = make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_TOMB1", "EX_T1");
+    const auto dropcopy_ev = make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts + 1, "CID_TOMB1", "EX_T1");
+    h.reconciler->process_event_for_test(primary_ev);
+    h.reconciler->process_event_for_test(dropcopy_ev);
+
+    const core::OrderKey key = core::make_order_key(primary_ev);
+    ASSERT_NE(h.store.find(key), nullptr);
+    ASSERT_EQ(h.store.find(key)->recon_state, core::ReconState::Matched);
+
+    const std::uint64_t quiet_tsc = util::ns_to_tsc(h.config.compaction_quiet_period_ns);
+
+    // Still inside the quiet period: nothing compacted
+    EXPECT_EQ(h.reconciler->compact_quiet_orders(ts + 1), 0u);
+    EXPECT_NE(h.store.find(key), nullptr);
+
+    h.config.compaction_sweep_budget = static_cast<std::uint32_t>(h.store.bucket_count());
+    h.reconciler = std::make_unique<core::Reconciler>(
+        h.stop_flag, *h.primary_ring, *h.dropcopy_ring, h.store, h.counters,
+        *h.divergence_ring, *h.seq_gap_ring, &h.timer_wheel, h.config);
+
+    EXPECT_EQ(h.reconciler->compact_quiet_orders(ts + 1 + quiet_tsc), 1u);
+    EXPECT_EQ(h.store.find(key), nullptr);
+    EXPECT_NE(h.store.find_tombstone(key), nullptr);
+    EXPECT_EQ(h.counters.orders_compacted, 1u);
+}
+
+// Reconciler_CompactQuietOrders_SkipsUnfinishedOrders - Non-terminal or unmatched orders are kept
+TEST_F(ReconcilerTwoStageTest, CompactQuietOrders_SkipsUnfinishedOrders) {
+    TwoStageHarness h;
+    h.config.compaction_sweep_budget = static_cast<std::uint32_t>(h.store.bucket_count());
+    h.reconciler = std::make_unique<core::Reconciler>(
+        h.stop_flag, *h.primary_ring, *h.dropcopy_ring, h.store, h.counters,
+        *h.divergence_ring, *h.seq_gap_ring, &h.timer_wheel, h.config);
+    const std::uint64_t ts = 1'000'000;
+
+    // Matched but still working
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Working, 50, 100, ts, "CID_OPEN", "EX_O1"));
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Working, 50, 100, ts, "CID_OPEN", "EX_O1"));
+    // Filled on one side only
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_HALF", "EX_H1"));
+
+    const std::uint64_t later = ts + util::ns_to_tsc(h.config.compaction_quiet_period_ns) * 2;
+    EXPECT_EQ(h.reconciler->compact_quiet_orders(later), 0u);
+    EXPECT_EQ(h.store.size(), 2u);
+    EXPECT_EQ(h.store.tombstone_count(), 0u);
+}
+
+// Reconciler_TombstonedOrder_LateEventsRecognised - Late events counted without re-creating state
+TEST_F(ReconcilerTwoStageTest, TombstonedOrder_LateEventsRecognised) {
+    TwoStageHarness h;
+    const std::uint64_t ts = 1'000'000;
+
+    const auto primary_ev = make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_TOMB2", "EX_T2");
+    const auto dropcopy_ev = make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts, "CID_TOMB2", "EX_T2");
+    h.reconciler->process_event_for_test(primary_ev);
+    h.reconciler->process_event_for_test(dropcopy_ev);
+    ASSERT_TRUE(h.store.compact(core::make_order_key(primary_ev)));
+
+    const std::size_t size_before = h.store.size();
+    const auto internal_before = h.counters.internal_events;
+
+    // Duplicate of the final fill
+    auto dup = dropcopy_ev;
+    dup.seq_num = seq_seed_++;
+    h.reconciler->process_event_for_test(dup);
+    EXPECT_EQ(h.counters.tombstone_duplicates, 1u);
+
+    // Late fill that disagrees with the agreed final quantity
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Filled, 150, 100, ts + 5, "CID_TOMB2", "EX_T3"));
+    EXPECT_EQ(h.counters.tombstone_late_mismatch, 1u);
+
+    EXPECT_EQ(h.store.size(), size_before);
+    EXPECT_EQ(h.store.find(core::make_order_key(primary_ev)), nullptr);
+    EXPECT_EQ(h.counters.internal_events, internal_before);
+    EXPECT_EQ(h.counters.store_overflow, 0u);
+}
+
+// ===== Three-way reconciliation (prime-broker side) =====
+
+// Reconciler_ThreeWay_SingleStateForAllFeeds - PB events land in the same OrderState
+TEST_F(ReconcilerTwoStageTest, ThreeWay_SingleStateForAllFeeds) {
+    TwoStageHarness h;
+    const std::uint64_t ts = 1'000'000;
+
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_3W1", "EX_3W"));
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts + 1, "CID_3W1", "EX_3W"));
+    const auto pb_ev = make_event(core::Source::PrimeBroker, core::OrdStatus::Filled, 100, 100, ts + 2, "CID_3W1", "EX_3W");
+    h.reconciler->process_event_for_test(pb_ev);
+
+    EXPECT_EQ(h.store.size(), 1u);
+    EXPECT_EQ(h.counters.prime_broker_events, 1u);
+    const core::OrderState* os = h.store.find(core::make_order_key(pb_ev));
+    ASSERT_NE(os, nullptr);
+    EXPECT_TRUE(os->seen[core::SideIndex::PRIME_BROKER]);
+    EXPECT_EQ(os->last_seen_tsc[core::SideIndex::PRIME_BROKER], ts + 2);
+    EXPECT_EQ(os->recon_state, core::ReconState::Matched);
+}
+
+// Reconciler_ThreeWay_PrimeBrokerDisagrees_ConfirmedWithPairMasks - PB-only break is attributed per pair
+TEST_F(ReconcilerTwoStageTest, ThreeWay_PrimeBrokerDisagrees_ConfirmedWithPairMasks) {
+    TwoStageHarness h;
+    const std::uint64_t ts = 1'000'000;
+
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_3W2", "EX_3W"));
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts, "CID_3W2", "EX_3W"));
+    const auto pb_ev = make_event(core::Source::PrimeBroker, core::OrdStatus::Filled, 80, 100, ts, "CID_3W2", "EX_3W");
+    h.reconciler->process_event_for_test(pb_ev);
+
+    const core::OrderKey key = core::make_order_key(pb_ev);
+    core::OrderState* os = h.store.find(key);
+    ASSERT_NE(os, nullptr);
+    ASSERT_EQ(os->recon_state, core::ReconState::InGrace);
+    EXPECT_TRUE(os->current_mismatch.has(core::MismatchMask::CUM_QTY));
+
+    h.reconciler->on_grace_deadline_expired(key, os->timer_generation);
+    EXPECT_EQ(os->recon_state, core::ReconState::DivergedConfirmed);
+
+    core::Divergence div{};
+    ASSERT_TRUE(h.divergence_ring->try_pop(div));
+    EXPECT_EQ(div.prime_broker_cum_qty, 80);
+    EXPECT_EQ(div.pair_mismatch[core::side_pair_index(core::Source::Primary, core::Source::DropCopy)], 0u);
+    EXPECT_EQ(div.pair_mismatch[core::side_pair_index(core::Source::Primary, core::Source::PrimeBroker)],
+              core::MismatchMask::CUM_QTY);
+    EXPECT_EQ(div.pair_mismatch[core::side_pair_index(core::Source::DropCopy, core::Source::PrimeBroker)],
+              core::MismatchMask::CUM_QTY);
+}
+
+// Reconciler_ThreeWay_RequiredPrimeBroker_MissingIsExistence - Strict three-way waits for the PB give-up
+TEST_F(ReconcilerTwoStageTest, ThreeWay_RequiredPrimeBroker_MissingIsExistence) {
+    TwoStageHarness h;
+    h.config.required_sides = core::DEFAULT_REQUIRED_SIDES | core::source_bit(core::Source::PrimeBroker);
+    h.reconciler = std::make_unique<core::Reconciler>(
+        h.stop_flag, *h.primary_ring, *h.dropcopy_ring, h.store, h.counters,
+        *h.divergence_ring, *h.seq_gap_ring, &h.timer_wheel, h.config);
+    const std::uint64_t ts = 1'000'000;
+
+    const auto primary_ev = make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_3W3", "EX_3W");
+    h.reconciler->process_event_for_test(primary_ev);
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts, "CID_3W3", "EX_3W"));
+
+    core::OrderState* os = h.store.find(core::make_order_key(primary_ev));
+    ASSERT_NE(os, nullptr);
+    EXPECT_EQ(os->recon_state, core::ReconState::InGrace);
+    EXPECT_EQ(os->current_mismatch.bits(), core::MismatchMask::EXISTENCE);
+
+    // PB give-up arrives within grace
+    h.reconciler->process_event_for_test(make_event(core::Source::PrimeBroker, core::OrdStatus::Filled, 100, 100, ts + 10, "CID_3W3", "EX_3W"));
+    EXPECT_EQ(os->recon_state, core::ReconState::Matched);
+    EXPECT_EQ(h.counters.false_positive_avoided, 1u);
+}
+
+
+// ===== Change-data-capture transition stream =====
+
+// Reconciler_Cdc_GraceThenMatch_PublishesEachTransition - Every ReconState change lands on the ring in order
+TEST_F(ReconcilerTwoStageTest, Cdc_GraceThenMatch_PublishesEachTransition) {
+    TwoStageHarness h;
+    auto cdc = std::make_unique<core::ReconTransitionRing>();
+    h.reconciler->attach_transition_ring(*cdc);
+    const std::uint64_t ts = 1'000'000;
+
+    const auto primary_ev = make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_CDC1");
+    h.reconciler->process_event_for_test(primary_ev);
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts + 50, "CID_CDC1"));
+
+    core::ReconTransition tr{};
+    ASSERT_TRUE(cdc->try_pop(tr));
+    EXPECT_EQ(tr.key, core::make_order_key(primary_ev));
+    EXPECT_EQ(tr.seq, 1u);
+    EXPECT_EQ(tr.tsc, ts);
+    EXPECT_EQ(tr.from, core::ReconState::Unknown);
+    EXPECT_EQ(tr.to, core::ReconState::InGrace);
+    EXPECT_EQ(tr.mismatch, core::MismatchMask::EXISTENCE);
+
+    ASSERT_TRUE(cdc->try_pop(tr));
+    EXPECT_EQ(tr.seq, 2u);
+    EXPECT_EQ(tr.tsc, ts + 50);
+    EXPECT_EQ(tr.from, core::ReconState::InGrace);
+    EXPECT_EQ(tr.to, core::ReconState::Matched);
+    EXPECT_EQ(tr.mismatch, 0u);
+
+    EXPECT_FALSE(cdc->try_pop(tr));
+    EXPECT_EQ(h.counters.transitions_published, 2u);
+    EXPECT_EQ(h.counters.transition_ring_drops, 0u);
+}
+
+// Reconciler_Cdc_DeadlineConfirm_PublishedFromTimerPath - Grace expiry publishes InGrace -> DivergedConfirmed
+TEST_F(ReconcilerTwoStageTest, Cdc_DeadlineConfirm_PublishedFromTimerPath) {
+    TwoStageHarness h;
+    auto cdc = std::make_unique<core::ReconTransitionRing>();
+    h.reconciler->attach_transition_ring(*cdc);
+    const std::uint64_t ts = 1'000'000;
+
+    const auto primary_ev = make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_CDC2");
+    h.reconciler->process_event_for_test(primary_ev);
+    core::OrderState* os = h.store.find(core::make_order_key(primary_ev));
+    ASSERT_NE(os, nullptr);
+
+    h.reconciler->set_last_poll_tsc_for_test(ts + 7);
+    h.reconciler->on_grace_deadline_expired(os->key, os->timer_generation);
+
+    core::ReconTransition tr{};
+    ASSERT_TRUE(cdc->try_pop(tr));
+    ASSERT_TRUE(cdc->try_pop(tr));
+    EXPECT_EQ(tr.from, core::ReconState::InGrace);
+    EXPECT_EQ(tr.to, core::ReconState::DivergedConfirmed);
+    EXPECT_EQ(tr.tsc, ts + 7);
+    EXPECT_EQ(tr.mismatch, core::MismatchMask::EXISTENCE);
+}
+
+// Reconciler_Cdc_FullRing_DropsAndCounts - A lagging consumer costs records, never blocks the reconciler
+TEST_F(ReconcilerTwoStageTest, Cdc_FullRing_DropsAndCounts) {
+    TwoStageHarness h;
+    auto cdc = std::make_unique<core::ReconTransitionRing>();
+    h.reconciler->attach_transition_ring(*cdc);
+    while (cdc->try_push(core::ReconTransition{})) {
+    }
+
+    const std::uint64_t ts = 1'000'000;
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::Filled, 100, 100, ts, "CID_CDC3"));
+    h.reconciler->process_event_for_test(make_event(core::Source::DropCopy, core::OrdStatus::Filled, 100, 100, ts + 1, "CID_CDC3"));
+
+    EXPECT_EQ(h.counters.transitions_published, 0u);
+    EXPECT_EQ(h.counters.transition_ring_drops, 2u);
+    EXPECT_EQ(h.counters.orders_matched, 1u);
+}
+
+// ReconTransitionPublisher_BatchesAndCountsMissed - Batches are bounded and sequence gaps are reported
+TEST(ReconTransitionPublisherTest, BatchesAndCountsMissed) {
+    auto ring = std::make_unique<core::ReconTransitionRing>();
+    const std::size_t total = core::ReconTransitionPublisher::BATCH_SIZE + 10;
+    for (std::uint64_t seq = 1; seq <= total + 3; ++seq) {
+        if (seq == 5 || seq == 6 || seq == 7) {
+            continue;  // Dropped by the producer
+        }
+        core::ReconTransition tr{};
+        tr.seq = seq;
+        ASSERT_TRUE(ring->try_push(tr));
+    }
+
+    core::ReconTransitionPublisher publisher(*ring);
+    std::vector<std::size_t> batch_sizes;
+    const std::size_t published = publisher.publish([&](std::span<const core::ReconTransition> batch) {
+        batch_sizes.push_back(batch.size());
+    });
+
+    EXPECT_EQ(published, total);
+    ASSERT_EQ(batch_sizes.size(), 2u);
+    EXPECT_EQ(batch_sizes[0], core::ReconTransitionPublisher::BATCH_SIZE);
+    EXPECT_EQ(batch_sizes[1], 10u);
+    EXPECT_EQ(publisher.batches(), 2u);
+    EXPECT_EQ(publisher.missed(), 3u);
+    EXPECT_EQ(publisher.last_seq(), total + 3);
+    EXPECT_EQ(publisher.publish([](std::span<const core::ReconTransition>) {}), 0u);
+}
+
 } // namespace
+
+// Reconciler_GraceTimers_SkewedDeadlineSpillsToWheel - An earlier deadline behind the FIFO tail goes to the wheel and still fires
+TEST_F(ReconcilerTwoStageTest, GraceTimers_SkewedDeadlineSpillsToWheel) {
+    TwoStageHarness h;
+    const std::uint64_t ts = 2'000'000;
+    const std::uint64_t grace = util::ns_to_tsc(h.config.grace_period_ns);
+
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::New, 0, 100, ts, "CID_FIFO1"));
+    EXPECT_EQ(h.timer_wheel.stats().scheduled, 0u);
+    // Another ingest thread's clock lags: its deadline sorts before the FIFO tail
+    h.reconciler->process_event_for_test(make_event(core::Source::Primary, core::OrdStatus::New, 0, 100, ts - 1'000, "CID_FIFO2"));
+    EXPECT_EQ(h.timer_wheel.stats().scheduled, 1u);
+    EXPECT_EQ(h.reconciler->timer_stats().scheduled, 2u);
+    EXPECT_EQ(h.reconciler->pending_timers(), 2u);
+    EXPECT_LE(h.reconciler->next_timer_deadline_tsc(), ts + grace);
+
+    h.reconciler->poll_timers(ts - 1);
+    EXPECT_EQ(h.counters.mismatch_confirmed, 0u);
+    const std::uint64_t after = ts + grace + 2 * h.timer_wheel.tick_tsc();
+    h.reconciler->set_last_poll_tsc_for_test(after);
+    h.reconciler->poll_timers(after);
+    EXPECT_EQ(h.counters.mismatch_confirmed, 2u);
+    EXPECT_EQ(h.reconciler->pending_timers(), 0u);
+    EXPECT_EQ(h.reconciler->next_timer_deadline_tsc(), util::WheelTimer::NO_DEADLINE);
+}
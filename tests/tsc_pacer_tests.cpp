@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "util/rdtsc.hpp"
+#include "util/tsc_calibration.hpp"
+#include "util/tsc_pacer.hpp"
+
+// TscPacer_RealTime_PreservesOffsets - At speed 1 a record is due at its recorded offset
+TEST(TscPacerTest, RealTime_PreservesOffsets) {
+    util::TscPacer pacer(5'000'000'000ULL, 1.0);
+    pacer.start(1'000);
+
+    EXPECT_EQ(pacer.due_tsc(5'000'000'000ULL), 1'000u);
+    EXPECT_EQ(pacer.due_tsc(5'002'000'000ULL), 1'000u + util::ns_to_tsc(2'000'000));
+}
+
+// TscPacer_Speedup_CompressesOffsets - At speed 10 offsets shrink tenfold
+TEST(TscPacerTest, Speedup_CompressesOffsets) {
+    util::TscPacer pacer(0, 10.0);
+    pacer.start(0);
+
+    EXPECT_EQ(pacer.due_tsc(10'000'000), util::ns_to_tsc(1'000'000));
+    EXPECT_EQ(pacer.due_tsc(1'000'000'000), util::ns_to_tsc(100'000'000));
+}
+
+// TscPacer_Unpaced_EverythingDueAtStart - Speed 0 replays as fast as possible
+TEST(TscPacerTest, Unpaced_EverythingDueAtStart) {
+    util::TscPacer pacer(100, 0.0);
+    pacer.start(42);
+
+    EXPECT_TRUE(pacer.unpaced());
+    EXPECT_EQ(pacer.due_tsc(100), 42u);
+    EXPECT_EQ(pacer.due_tsc(1'000'000'000'000ULL), 42u);
+}
+
+// TscPacer_WaitUntil_ReleasesAtOrAfterDue - Sleep-then-spin never releases early
+TEST(TscPacerTest, WaitUntil_ReleasesAtOrAfterDue) {
+    const std::uint64_t due = util::rdtsc() + util::ns_to_tsc(2'000'000);  // 2ms
+    const std::uint64_t released = util::TscPacer::wait_until(due);
+    EXPECT_GE(released, due);
+
+    // Past deadlines return immediately
+    EXPECT_GT(util::TscPacer::wait_until(0), 0u);
+}
+
+// LagHistogram_Quantiles - Quantiles are bucket upper bounds; max and mean are exact
+TEST(LagHistogramTest, Quantiles) {
+    util::LagHistogram lag;
+    EXPECT_EQ(lag.quantile_upper_ns(0.99), 0u);
+
+    for (int i = 0; i < 99; ++i) {
+        lag.record(100);  // bucket [64, 128)
+    }
+    lag.record(1'000'000);
+
+    EXPECT_EQ(lag.count(), 100u);
+    EXPECT_EQ(lag.max_ns(), 1'000'000u);
+    EXPECT_EQ(lag.mean_ns(), (99u * 100u + 1'000'000u) / 100u);
+    EXPECT_EQ(lag.quantile_upper_ns(0.50), 127u);
+    EXPECT_EQ(lag.quantile_upper_ns(0.98), 127u);
+    EXPECT_GE(lag.quantile_upper_ns(0.999), 1'000'000u);
+}
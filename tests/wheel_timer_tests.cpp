@@ -20,7 +20,7 @@ protected:
 
 // ScheduleAndExpire - Schedule entry, advance time, verify callback invoked
 TEST_F(WheelTimerTest, ScheduleAndExpire) {
-    const core::OrderKey key = 12345;
+    const std::uint32_t key = 12345;
     const std::uint32_t gen = 1;
     const std::uint64_t deadline = ms_to_tsc(5);  // 5ms from start
 
@@ -29,11 +29,11 @@ TEST_F(WheelTimerTest, ScheduleAndExpire) {
     EXPECT_EQ(timer_.stats().scheduled, 1u);
 
     // Track callback invocations
-    core::OrderKey callback_key = 0;
+    std::uint32_t callback_key = 0;
     std::uint32_t callback_gen = 0;
     int callback_count = 0;
 
-    auto on_expired = [&](core::OrderKey k, std::uint32_t g) {
+    auto on_expired = [&](std::uint32_t k, std::uint32_t g) {
         callback_key = k;
         callback_gen = g;
         ++callback_count;
@@ -64,7 +64,7 @@ TEST_F(WheelTimerTest, ScheduleMultipleSameBucket) {
     EXPECT_EQ(timer_.total_pending(), 3u);
 
     int callback_count = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t) {
         ++callback_count;
     };
 
@@ -83,8 +83,8 @@ TEST_F(WheelTimerTest, ScheduleDifferentBuckets) {
     ASSERT_TRUE(timer_.schedule(300, 3, ms_to_tsc(15)));  // expires at 15ms
     EXPECT_EQ(timer_.total_pending(), 3u);
 
-    std::vector<core::OrderKey> expired_keys;
-    auto on_expired = [&](core::OrderKey k, std::uint32_t) {
+    std::vector<std::uint32_t> expired_keys;
+    auto on_expired = [&](std::uint32_t k, std::uint32_t) {
         expired_keys.push_back(k);
     };
 
@@ -113,7 +113,7 @@ TEST_F(WheelTimerTest, GenerationPassedToCallback) {
     ASSERT_TRUE(timer_.schedule(100, expected_gen, ms_to_tsc(5)));
 
     std::uint32_t received_gen = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t g) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t g) {
         received_gen = g;
     };
 
@@ -165,7 +165,7 @@ TEST_F(WheelTimerTest, PastDeadlineExpiresImmediately) {
     EXPECT_EQ(timer_.total_pending(), 1u);
 
     int callback_count = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t) {
         ++callback_count;
     };
 
@@ -175,18 +175,18 @@ TEST_F(WheelTimerTest, PastDeadlineExpiresImmediately) {
     EXPECT_EQ(timer_.total_pending(), 0u);
 }
 
-// FarFutureDeadlineRescheduled - Deadline beyond wheel range is re-scheduled until due
+// FarFutureDeadlineRescheduled - Deadline beyond wheel range is deferred to a later lap until due
 TEST_F(WheelTimerTest, FarFutureDeadlineRescheduled) {
     // Schedule a deadline far beyond the wheel span (256ms)
     const std::uint64_t far_deadline = ms_to_tsc(500);  // 500ms
     ASSERT_TRUE(timer_.schedule(100, 1, far_deadline));
 
     int callback_count = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t) {
         ++callback_count;
     };
 
-    // Poll at 260ms - should re-schedule, not expire (deadline is 500ms)
+    // Poll at 260ms - bucket visited but entry deferred, not expired (deadline is 500ms)
     timer_.poll_expired(ms_to_tsc(260), on_expired);
     EXPECT_EQ(callback_count, 0);
     EXPECT_GE(timer_.stats().rescheduled, 1u);
@@ -209,7 +209,7 @@ TEST_F(WheelTimerTest, WheelWrapAround) {
     ASSERT_TRUE(wrap_timer.schedule(100, 1, deadline));
 
     int callback_count = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t) {
         ++callback_count;
     };
 
@@ -232,7 +232,7 @@ TEST_F(WheelTimerTest, ResetClearsAllBuckets) {
 
     // Force some stats
     int dummy = 0;
-    timer_.poll_expired(ms_to_tsc(6), [&](core::OrderKey, std::uint32_t) { ++dummy; });
+    timer_.poll_expired(ms_to_tsc(6), [&](std::uint32_t, std::uint32_t) { ++dummy; });
     EXPECT_GT(timer_.stats().expired, 0u);
 
     // Reset with new start time
@@ -250,7 +250,7 @@ TEST_F(WheelTimerTest, ResetClearsAllBuckets) {
 // PollEmptyWheelNoOp - Polling empty wheel doesn't crash, no callbacks
 TEST_F(WheelTimerTest, PollEmptyWheelNoOp) {
     int callback_count = 0;
-    auto on_expired = [&](core::OrderKey, std::uint32_t) {
+    auto on_expired = [&](std::uint32_t, std::uint32_t) {
         ++callback_count;
     };
 
@@ -279,7 +279,7 @@ TEST_F(WheelTimerTest, StatsAccuracy) {
 
     // Expire 2 entries
     int dummy = 0;
-    timer_.poll_expired(ms_to_tsc(11), [&](core::OrderKey, std::uint32_t) { ++dummy; });
+    timer_.poll_expired(ms_to_tsc(11), [&](std::uint32_t, std::uint32_t) { ++dummy; });
     EXPECT_EQ(timer_.stats().expired, 2u);
     EXPECT_EQ(timer_.stats().scheduled, 3u);  // Scheduled count unchanged
 
@@ -322,7 +322,7 @@ TEST_F(WheelTimerTest, AdvanceDoesNotProcessExpirations) {
 
 // Additional test: Multiple entries with same key but different generations
 TEST_F(WheelTimerTest, MultipleEntriesSameKeyDifferentGenerations) {
-    const core::OrderKey key = 42;
+    const std::uint32_t key = 42;
     
     // Schedule same key with different generations
     ASSERT_TRUE(timer_.schedule(key, 1, ms_to_tsc(5)));
@@ -331,7 +331,7 @@ TEST_F(WheelTimerTest, MultipleEntriesSameKeyDifferentGenerations) {
     EXPECT_EQ(timer_.total_pending(), 3u);
 
     std::vector<std::uint32_t> expired_gens;
-    auto on_expired = [&](core::OrderKey k, std::uint32_t g) {
+    auto on_expired = [&](std::uint32_t k, std::uint32_t g) {
         EXPECT_EQ(k, key);
         expired_gens.push_back(g);
     };
@@ -345,4 +345,84 @@ TEST_F(WheelTimerTest, MultipleEntriesSameKeyDifferentGenerations) {
     EXPECT_NE(std::find(expired_gens.begin(), expired_gens.end(), 3), expired_gens.end());
 }
 
+// NextDeadlineEmptyWheel - No pending entries reports NO_DEADLINE
+TEST_F(WheelTimerTest, NextDeadlineEmptyWheel) {
+    EXPECT_EQ(timer_.next_deadline_tsc(), WheelTimer::NO_DEADLINE);
+
+    ASSERT_TRUE(timer_.schedule(100, 1, ms_to_tsc(5)));
+    timer_.poll_expired(ms_to_tsc(6), [](std::uint32_t, std::uint32_t) {});
+    EXPECT_EQ(timer_.next_deadline_tsc(), WheelTimer::NO_DEADLINE);
+}
+
+// NextDeadlineTracksEarliestBucket - Query returns the end of the earliest occupied tick
+TEST_F(WheelTimerTest, NextDeadlineTracksEarliestBucket) {
+    ASSERT_TRUE(timer_.schedule(200, 1, ms_to_tsc(40)));
+    EXPECT_EQ(timer_.next_deadline_tsc(), 41 * timer_.tick_tsc());
+
+    ASSERT_TRUE(timer_.schedule(100, 1, ms_to_tsc(10)));
+    EXPECT_EQ(timer_.next_deadline_tsc(), 11 * timer_.tick_tsc());
+
+    // Nothing can fire before next_deadline_tsc()
+    int callback_count = 0;
+    auto on_expired = [&](std::uint32_t, std::uint32_t) { ++callback_count; };
+    timer_.poll_expired(timer_.next_deadline_tsc() - 1, on_expired);
+    EXPECT_EQ(callback_count, 0);
+
+    timer_.poll_expired(timer_.next_deadline_tsc(), on_expired);
+    EXPECT_EQ(callback_count, 1);
+    EXPECT_EQ(timer_.next_deadline_tsc(), 41 * timer_.tick_tsc());
+}
+
+// LongStallExpiresEverything - A stall spanning many laps expires all due entries in one poll
+TEST_F(WheelTimerTest, LongStallExpiresEverything) {
+    ASSERT_TRUE(timer_.schedule(100, 1, ms_to_tsc(3)));
+    ASSERT_TRUE(timer_.schedule(200, 1, ms_to_tsc(200)));
+    ASSERT_TRUE(timer_.schedule(300, 1, ms_to_tsc(700)));
+
+    std::vector<std::uint32_t> expired_keys;
+    timer_.poll_expired(ms_to_tsc(10'000), [&](std::uint32_t k, std::uint32_t) {
+        expired_keys.push_back(k);
+    });
+
+    EXPECT_EQ(expired_keys.size(), 3u);
+    EXPECT_EQ(timer_.total_pending(), 0u);
+    EXPECT_EQ(timer_.current_tick(), 10'000u);
+    EXPECT_EQ(timer_.next_deadline_tsc(), WheelTimer::NO_DEADLINE);
+}
+
+// FarFutureEntryNotMoved - Entries for later laps stay in their bucket until due
+TEST_F(WheelTimerTest, FarFutureEntryNotMoved) {
+    // 1000ms deadline is almost four laps out; it is visited on each lap but never moved
+    ASSERT_TRUE(timer_.schedule(100, 1, ms_to_tsc(1000)));
+
+    int callback_count = 0;
+    auto on_expired = [&](std::uint32_t, std::uint32_t) { ++callback_count; };
+    for (std::uint64_t ms = 100; ms <= 1000; ms += 100) {
+        timer_.poll_expired(ms_to_tsc(ms), on_expired);
+        EXPECT_EQ(timer_.total_pending(), 1u);
+    }
+    EXPECT_EQ(callback_count, 0);
+    EXPECT_EQ(timer_.stats().rescheduled, 3u);  // One early visit per earlier lap
+
+    timer_.poll_expired(ms_to_tsc(1001), on_expired);
+    EXPECT_EQ(callback_count, 1);
+    EXPECT_EQ(timer_.stats().scheduled, 1u);
+}
+
+// ScheduleFromCallbackPastDeadline - Entries scheduled during poll with past deadlines fire in the same poll
+TEST_F(WheelTimerTest, ScheduleFromCallbackPastDeadline) {
+    ASSERT_TRUE(timer_.schedule(100, 1, ms_to_tsc(5)));
+
+    std::vector<std::uint32_t> expired_keys;
+    timer_.poll_expired(ms_to_tsc(50), [&](std::uint32_t k, std::uint32_t) {
+        expired_keys.push_back(k);
+        if (k == 100) {
+            ASSERT_TRUE(timer_.schedule(200, 1, ms_to_tsc(5)));
+        }
+    });
+
+    EXPECT_EQ(expired_keys.size(), 2u);
+    EXPECT_EQ(timer_.total_pending(), 0u);
+}
+
 } // namespace
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "core/wire_codec.hpp"
+
+namespace {
+
+core::ExecEvent make_exec() {
+    core::ExecEvent ev{};
+    ev.exec_type = core::ExecType::PartialFill;
+    ev.ord_status = core::OrdStatus::PartiallyFilled;
+    ev.seq_num = 0x0102030405060708ULL;
+    ev.session_id = 0xBEEF;
+    ev.price_micro = -1'234'567;
+    ev.qty = 500;
+    ev.cum_qty = 1'500;
+    ev.sending_time = 111;
+    ev.transact_time = 222;
+    ev.set_exec_id("EXEC-1", 6);
+    ev.set_order_id("ORD-1", 5);
+    ev.set_clord_id("CID-1", 5);
+    return ev;
+}
+
+std::uint16_t le16(const std::uint8_t* p) { return static_cast<std::uint16_t>(p[0] | (p[1] << 8)); }
+
+} // namespace
+
+// WireCodec_ExecEventRoundTrip - Every field survives encode/decode; ingest fields come from the receiver
+TEST(WireCodecTest, ExecEventRoundTrip) {
+    const core::ExecEvent in = make_exec();
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buf{};
+    core::ExecEventEncoder::encode(buf.data(), in);
+
+    core::ExecEvent out{};
+    ASSERT_TRUE(core::decode_exec_event(buf.data(), buf.size(), core::Source::DropCopy, 77, out));
+    EXPECT_EQ(out.source, core::Source::DropCopy);
+    EXPECT_EQ(out.ingest_tsc, 77u);
+    EXPECT_EQ(out.exec_type, in.exec_type);
+    EXPECT_EQ(out.ord_status, in.ord_status);
+    EXPECT_EQ(out.seq_num, in.seq_num);
+    EXPECT_EQ(out.session_id, in.session_id);
+    EXPECT_EQ(out.price_micro, in.price_micro);
+    EXPECT_EQ(out.qty, in.qty);
+    EXPECT_EQ(out.cum_qty, in.cum_qty);
+    EXPECT_EQ(out.sending_time, in.sending_time);
+    EXPECT_EQ(out.transact_time, in.transact_time);
+    EXPECT_EQ(std::string_view(out.exec_id, out.exec_id_len), "EXEC-1");
+    EXPECT_EQ(std::string_view(out.order_id, out.order_id_len), "ORD-1");
+    EXPECT_EQ(std::string_view(out.clord_id, out.clord_id_len), "CID-1");
+    EXPECT_EQ(core::make_order_key(out), core::make_order_key(in));
+}
+
+// WireCodec_LayoutIsAlignedLittleEndian - Header and 8-byte fields sit at fixed aligned offsets, LE
+TEST(WireCodecTest, LayoutIsAlignedLittleEndian) {
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buf{};
+    core::ExecEventEncoder::encode(buf.data(), make_exec());
+
+    EXPECT_EQ(buf.size(), 160u);
+    EXPECT_EQ(le16(buf.data() + 0), core::ExecEventDecoder::BLOCK_LENGTH);
+    EXPECT_EQ(le16(buf.data() + 2), core::ExecEventDecoder::TEMPLATE_ID);
+    EXPECT_EQ(le16(buf.data() + 4), core::WIRE_SCHEMA_ID);
+    EXPECT_EQ(le16(buf.data() + 6), core::WIRE_SCHEMA_VERSION);
+
+    // seq_num is the first body field: least significant byte first
+    const std::uint8_t* body = buf.data() + core::MessageHeaderFlyweight::ENCODED_LENGTH;
+    for (std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(body[i], 8 - i);
+    }
+    EXPECT_EQ(le16(body + 48), 0xBEEF);
+
+    const core::ExecEventDecoder d(body);
+    EXPECT_EQ(d.seq_num(), 0x0102030405060708ULL);
+    EXPECT_EQ(d.clord_id(), "CID-1");
+}
+
+// WireCodec_RejectsForeignAndTruncated - Other schemas, templates and short buffers do not decode
+TEST(WireCodecTest, RejectsForeignAndTruncated) {
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buf{};
+    core::ExecEventEncoder::encode(buf.data(), make_exec());
+
+    core::ExecEvent out{};
+    out.seq_num = 99;
+    EXPECT_FALSE(core::decode_exec_event(buf.data(), buf.size() - 1, core::Source::Primary, 0, out));
+    EXPECT_FALSE(core::decode_exec_event(buf.data(), 4, core::Source::Primary, 0, out));
+
+    auto foreign = buf;
+    foreign[4] ^= 0xFF;  // schema id
+    EXPECT_FALSE(core::decode_exec_event(foreign.data(), foreign.size(), core::Source::Primary, 0, out));
+
+    core::SequenceGapEvent gap{};
+    EXPECT_FALSE(core::decode_sequence_gap(buf.data(), buf.size(), gap));  // ExecEvent template
+    EXPECT_EQ(out.seq_num, 99u);
+
+    // The old 151-byte packed struct is not a framed message
+    std::vector<std::uint8_t> legacy(sizeof(core::WireExecEvent), 0);
+    EXPECT_FALSE(core::decode_exec_event(legacy.data(), legacy.size(), core::Source::Primary, 0, out));
+}
+
+// WireCodec_AcceptsNewerVersionWithLongerBlock - Fields appended by a newer sender are skipped
+TEST(WireCodecTest, AcceptsNewerVersionWithLongerBlock) {
+    constexpr std::uint16_t v2_block = core::ExecEventDecoder::BLOCK_LENGTH + 16;
+    std::vector<std::uint8_t> buf(core::MessageHeaderFlyweight::ENCODED_LENGTH + v2_block, 0xAB);
+    core::ExecEventEncoder::encode(buf.data(), make_exec());
+    buf[0] = static_cast<std::uint8_t>(v2_block & 0xFF);
+    buf[1] = static_cast<std::uint8_t>(v2_block >> 8);
+    buf[6] = 2;  // version
+
+    core::ExecEvent out{};
+    ASSERT_TRUE(core::decode_exec_event(buf.data(), buf.size(), core::Source::Primary, 0, out));
+    EXPECT_EQ(out.cum_qty, 1'500);
+    EXPECT_EQ(std::string_view(out.clord_id, out.clord_id_len), "CID-1");
+
+    // A block shorter than version 1's cannot hold its fields
+    buf[0] = 8;
+    buf[1] = 0;
+    EXPECT_FALSE(core::decode_exec_event(buf.data(), buf.size(), core::Source::Primary, 0, out));
+}
+
+// WireCodec_ClampsCorruptIdLength - An id length beyond capacity never reads past its field
+TEST(WireCodecTest, ClampsCorruptIdLength) {
+    std::array<std::uint8_t, core::ExecEventEncoder::MESSAGE_LENGTH> buf{};
+    core::ExecEventEncoder::encode(buf.data(), make_exec());
+    buf[core::MessageHeaderFlyweight::ENCODED_LENGTH + 54] = 0xFF;  // clord_id_len
+
+    core::ExecEvent out{};
+    ASSERT_TRUE(core::decode_exec_event(buf.data(), buf.size(), core::Source::Primary, 0, out));
+    EXPECT_EQ(out.clord_id_len, core::ExecEvent::id_capacity);
+}
+
+// WireCodec_DivergenceAndGapRoundTrip - Divergence and sequence-gap messages round-trip
+TEST(WireCodecTest, DivergenceAndGapRoundTrip) {
+    core::Divergence div{};
+    div.key = 0xFEEDFACECAFEBEEFULL;
+    div.type = core::DivergenceType::QuantityMismatch;
+    div.internal_status = core::OrdStatus::Filled;
+    div.dropcopy_status = core::OrdStatus::PartiallyFilled;
+    div.prime_broker_status = core::OrdStatus::Filled;
+    div.internal_cum_qty = 100;
+    div.dropcopy_cum_qty = 60;
+    div.internal_avg_px = -7;
+    div.dropcopy_avg_px = 7;
+    div.internal_ts = 1;
+    div.dropcopy_ts = 2;
+    div.detect_tsc = 3;
+    div.mismatch_mask = core::MismatchMask::CUM_QTY;
+    div.pair_mismatch[0] = core::MismatchMask::CUM_QTY;
+    div.pair_mismatch[2] = core::MismatchMask::STATUS;
+    div.prime_broker_cum_qty = 100;
+    div.prime_broker_avg_px = -7;
+    div.prime_broker_ts = 4;
+
+    std::array<std::uint8_t, core::DivergenceEncoder::MESSAGE_LENGTH> dbuf{};
+    core::DivergenceEncoder::encode(dbuf.data(), div);
+    core::Divergence dout{};
+    ASSERT_TRUE(core::decode_divergence(dbuf.data(), dbuf.size(), dout));
+    EXPECT_EQ(dout.key, div.key);
+    EXPECT_EQ(dout.type, div.type);
+    EXPECT_EQ(dout.internal_status, div.internal_status);
+    EXPECT_EQ(dout.dropcopy_status, div.dropcopy_status);
+    EXPECT_EQ(dout.prime_broker_status, div.prime_broker_status);
+    EXPECT_EQ(dout.dropcopy_cum_qty, 60);
+    EXPECT_EQ(dout.internal_avg_px, -7);
+    EXPECT_EQ(dout.detect_tsc, 3u);
+    EXPECT_EQ(dout.mismatch_mask, div.mismatch_mask);
+    EXPECT_EQ(std::memcmp(dout.pair_mismatch, div.pair_mismatch, sizeof(div.pair_mismatch)), 0);
+    EXPECT_EQ(dout.prime_broker_ts, 4u);
+
+    core::SequenceGapEvent gap{};
+    gap.source = core::Source::PrimeBroker;
+    gap.session_id = 12;
+    gap.expected_seq = 10;
+    gap.seen_seq = 15;
+    gap.kind = core::GapKind::GapFill;
+    gap.detect_ts = 999;
+    gap.gap_closed_by_fill = true;
+
+    std::array<std::uint8_t, core::SequenceGapEncoder::MESSAGE_LENGTH> gbuf{};
+    core::SequenceGapEncoder::encode(gbuf.data(), gap);
+    core::SequenceGapEvent gout{};
+    ASSERT_TRUE(core::decode_sequence_gap(gbuf.data(), gbuf.size(), gout));
+    EXPECT_EQ(gout.source, gap.source);
+    EXPECT_EQ(gout.session_id, 12u);
+    EXPECT_EQ(gout.expected_seq, 10u);
+    EXPECT_EQ(gout.seen_seq, 15u);
+    EXPECT_EQ(gout.kind, core::GapKind::GapFill);
+    EXPECT_EQ(gout.detect_ts, 999u);
+    EXPECT_TRUE(gout.gap_closed_by_fill);
+}